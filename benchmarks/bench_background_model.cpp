@@ -0,0 +1,98 @@
+/**
+ * background_subtractor_mog2 / _knn at 1080p: the old items built a fresh
+ * cv::BackgroundSubtractor on every frame (the model never learned and paid
+ * the full allocation each time); BackgroundModel keeps one per cache_id and
+ * updates it in parallel strips, optionally at reduced model resolution.
+ *
+ * Frames are synthetic: a fixed textured background with sensor noise and a
+ * few moving blocks, so the persistent models see a learnable scene.
+ */
+
+#include "interpreter/items/advanced_items.h"
+#include "bench_common.h"
+
+#include <opencv2/imgproc.hpp>
+#include <opencv2/video.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace visionpipe;
+
+namespace {
+
+std::vector<cv::Mat> syntheticFrames(int count, cv::Size size) {
+    cv::RNG rng(101);
+    cv::Mat background(size, CV_8UC3);
+    rng.fill(background, cv::RNG::UNIFORM, 40, 200);
+    cv::GaussianBlur(background, background, cv::Size(0, 0), 6);
+
+    std::vector<cv::Mat> frames;
+    for (int i = 0; i < count; ++i) {
+        cv::Mat frame = background.clone();
+        for (int k = 0; k < 4; ++k) {
+            const int x = (i * (9 + 4 * k) + k * 400) % (size.width - 200);
+            const int y = 150 + k * 200;
+            cv::rectangle(frame, cv::Rect(x, y, 200, 160), cv::Scalar(30 + 50 * k, 220, 90), cv::FILLED);
+        }
+        cv::Mat noise(size, CV_16SC3);
+        rng.fill(noise, cv::RNG::NORMAL, 0, 3);
+        cv::add(frame, noise, frame, cv::noArray(), CV_8U);
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+// The frames cycle, so each timed call sees the next frame of the clip.
+struct Clip {
+    const std::vector<cv::Mat>& frames;
+    size_t next = 0;
+    const cv::Mat& frame() { return frames[next++ % frames.size()]; }
+};
+
+void run(const std::string& algorithm, const std::vector<cv::Mat>& frames, int runs) {
+    bench::header(algorithm + " at " + std::to_string(frames[0].cols) + "x" +
+                  std::to_string(frames[0].rows) + ", ms per frame");
+
+    Clip clip{frames};
+    const double recreate = bench::medianMs([&] {
+        cv::Ptr<cv::BackgroundSubtractor> sub;
+        if (algorithm == "mog2") sub = cv::createBackgroundSubtractorMOG2(500, 16.0, true);
+        else sub = cv::createBackgroundSubtractorKNN(500, 400.0, true);
+        cv::Mat mask;
+        sub->apply(clip.frame(), mask);
+    }, runs);
+    bench::row("recreate every frame (old items)", recreate);
+
+    struct Case { const char* name; double scale; int strips; };
+    const Case cases[] = {
+        {"persistent, 1 strip", 1.0, 1},
+        {"persistent, parallel strips", 1.0, 0},
+        {"persistent, parallel strips, model 1/2", 0.5, 0},
+        {"persistent, parallel strips, model 1/4", 0.25, 0},
+    };
+    for (const Case& c : cases) {
+        BackgroundModelConfig cfg;
+        cfg.algorithm  = algorithm;
+        cfg.threshold  = algorithm == "mog2" ? 16.0 : 400.0;
+        cfg.modelScale = c.scale;
+        cfg.strips     = c.strips;
+        BackgroundModel model(cfg);
+        // Let the model learn the scene before timing the steady state
+        for (size_t i = 0; i < frames.size(); ++i) model.apply(clip.frame(), -1, 30);
+
+        const double ms = bench::medianMs([&] { model.apply(clip.frame(), -1); }, runs);
+        bench::row(c.name, ms, recreate);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int runs = argc > 1 ? std::max(1, std::atoi(argv[1])) : 50;
+    const std::vector<cv::Mat> frames = syntheticFrames(60, cv::Size(1920, 1080));
+    run("mog2", frames, runs);
+    run("knn", frames, runs);
+    return 0;
+}
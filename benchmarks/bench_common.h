@@ -0,0 +1,48 @@
+#pragma once
+
+/**
+ * @file bench_common.h
+ * @brief Timing and reporting helpers for the benchmark executables.
+ */
+
+#include <opencv2/core.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace visionpipe {
+namespace bench {
+
+/// Median wall time of @p fn in milliseconds over @p runs calls, after @p warmup untimed calls.
+template <typename Fn>
+double medianMs(Fn&& fn, int runs, int warmup = 3) {
+    for (int i = 0; i < warmup; ++i) fn();
+    std::vector<double> ms(static_cast<size_t>(runs));
+    for (int i = 0; i < runs; ++i) {
+        const int64_t t0 = cv::getTickCount();
+        fn();
+        ms[static_cast<size_t>(i)] = (cv::getTickCount() - t0) * 1000.0 / cv::getTickFrequency();
+    }
+    std::nth_element(ms.begin(), ms.begin() + runs / 2, ms.end());
+    return ms[static_cast<size_t>(runs / 2)];
+}
+
+/// Table title; @p unit heads the value column.
+inline void header(const std::string& title, const char* unit = "ms") {
+    std::printf("\n%s (%d threads)\n", title.c_str(), cv::getNumThreads());
+    std::printf("  %-44s %12s %10s\n", "case", unit, "speedup");
+}
+
+/// One result line; speedup is relative to @p baselineMs (omitted when <= 0).
+inline void row(const std::string& name, double ms, double baselineMs = 0) {
+    if (baselineMs > 0) {
+        std::printf("  %-44s %12.3f %9.2fx\n", name.c_str(), ms, baselineMs / ms);
+    } else {
+        std::printf("  %-44s %12.3f %10s\n", name.c_str(), ms, "");
+    }
+}
+
+} // namespace bench
+} // namespace visionpipe
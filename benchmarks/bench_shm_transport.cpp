@@ -0,0 +1,103 @@
+/**
+ * shm_write -> shm_read of 4K BGR frames, end to end.
+ *
+ *  - copy path (before): the producing item allocates its output on the
+ *    heap, shmFrameWrite() memcpy's it into the region, shmFrameRead()
+ *    memcpy's it out again -- two copies per frame;
+ *  - placed path: the producing statement runs under a ShmOutputScope (as
+ *    the interpreter arms one before shm_write), so its output lands in the
+ *    region's next buffer, shmFrameWrite() only bumps the sequence, and the
+ *    reader wraps the buffer with shmFrameReadView() and checks it with
+ *    shmFrameValidate() -- no copies.
+ *
+ * Writer and reader share the process here; the region and its protocol
+ * are the same as across processes.  Copies are the transport's own count
+ * of frame memcpy's (shmFrameCopyCount()), divided by timed frames.
+ * POSIX shm backend only.
+ */
+
+#include "utils/shm_frame_transport.h"
+#include "bench_common.h"
+
+#include <opencv2/core.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace visionpipe;
+
+namespace {
+
+const char* const kRegion = "vp_bench_4k";
+
+// The item in front of shm_write: one pass producing a new frame.
+void produce(const cv::Mat& src, cv::Mat& dst) {
+    cv::bitwise_not(src, dst);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int runs = argc > 1 ? std::max(1, std::atoi(argv[1])) : 100;
+    const cv::Size size(3840, 2160);
+    const int type = CV_8UC3;
+
+    if (!shmFrameCreate(kRegion, size.width, size.height, type)) {
+        std::fprintf(stderr, "shm_create failed\n");
+        return 1;
+    }
+    cv::Mat src(size, type);
+    cv::randu(src, cv::Scalar::all(0), cv::Scalar::all(256));
+
+    bench::header("4K CV_8UC3 shm_write -> shm_read, ms per frame");
+
+    const double produceOnly = bench::medianMs([&] {
+        cv::Mat out;
+        produce(src, out);
+    }, runs);
+    bench::row("producing item alone", produceOnly);
+
+    // Copy path
+    int64_t frames = 0;
+    uint64_t copies0 = shmFrameCopyCount();
+    cv::Mat readBack;
+    const double copyPath = bench::medianMs([&] {
+        cv::Mat out;
+        produce(src, out);
+        shmFrameWrite(kRegion, out);
+        shmFrameRead(kRegion, readBack);
+        ++frames;
+    }, runs);
+    const double copyPathCopies = static_cast<double>(shmFrameCopyCount() - copies0) / frames;
+    bench::row("copy path (heap output, shmFrameRead)", copyPath);
+
+    // Placed path
+    frames = 0;
+    copies0 = shmFrameCopyCount();
+    int failed = 0;
+    int torn = 0;
+    const double placedPath = bench::medianMs([&] {
+        cv::Mat out;
+        {
+            ShmOutputScope scope(kRegion);
+            produce(src, out);
+        }
+        failed += !shmFrameWrite(kRegion, out);
+
+        cv::Mat view;
+        uint64_t seq = 0;
+        shmFrameReadView(kRegion, view, seq);
+        volatile uchar sink = view.data[view.total() * view.elemSize() - 1];
+        (void)sink;
+        torn += !shmFrameValidate(kRegion, seq);
+        ++frames;
+    }, runs);
+    const double placedPathCopies = static_cast<double>(shmFrameCopyCount() - copies0) / frames;
+    bench::row("placed path (ShmOutputScope, read view)", placedPath, copyPath);
+
+    std::printf("\n  copies per frame: %.2f -> %.2f", copyPathCopies, placedPathCopies);
+    std::printf("  (%d failed writes, %d torn frames)\n", failed, torn);
+
+    shmFrameDestroy(kRegion);
+    return 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * Per-label cost of overlay text on a 1080p frame: cv::putText (what
+ * put_text / draw_labeled_rect / draw_detections called before) against
+ * TextRenderer::putText per label and one putTextBatch for all labels,
+ * plus the cached getTextSize used to size label backgrounds.
+ *
+ * Labels look like draw_detections output ("person 0.87") in its font,
+ * scattered over the frame, 50 and 100 per frame.
+ */
+
+#include "utils/text_renderer.h"
+#include "bench_common.h"
+
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace visionpipe;
+
+namespace {
+
+std::vector<TextRenderer::Label> randomLabels(cv::RNG& rng, int count, cv::Size frame) {
+    const char* const classes[] = {"person", "car", "bicycle", "dog", "traffic light"};
+    std::vector<TextRenderer::Label> labels;
+    for (int i = 0; i < count; ++i) {
+        const std::string score = std::to_string(rng.uniform(50, 100));
+        labels.push_back({std::string(classes[rng.uniform(0, 5)]) + " 0." + score,
+                          cv::Point(rng.uniform(0, frame.width - 120), rng.uniform(20, frame.height)),
+                          cv::Scalar(255, 255, 255)});
+    }
+    return labels;
+}
+
+void run(int count, int lineType, int runs) {
+    const cv::Size size(1920, 1080);
+    const int font = cv::FONT_HERSHEY_SIMPLEX;
+    const double scale = 0.5;
+    const int thickness = 1;
+
+    cv::RNG rng(118);
+    const std::vector<TextRenderer::Label> labels = randomLabels(rng, count, size);
+    cv::Mat frame(size, CV_8UC3, cv::Scalar(40, 90, 60));
+    TextRenderer& renderer = TextRenderer::instance();
+    const double perLabel = 1000.0 / count;   // ms per frame -> us per label
+
+    bench::header(std::to_string(count) + " labels, " +
+                  (lineType == cv::LINE_AA ? "LINE_AA" : "LINE_8") + ", 1080p BGR", "us/label");
+
+    const double reference = perLabel * bench::medianMs([&] {
+        for (const auto& l : labels) {
+            cv::putText(frame, l.text, l.org, font, scale, l.color, thickness, lineType);
+        }
+    }, runs);
+    bench::row("cv::putText", reference);
+
+    const double single = perLabel * bench::medianMs([&] {
+        for (const auto& l : labels) {
+            renderer.putText(frame, l.text, l.org, font, scale, l.color, thickness, lineType);
+        }
+    }, runs);
+    bench::row("TextRenderer::putText", single, reference);
+
+    const double batch = perLabel * bench::medianMs([&] {
+        renderer.putTextBatch(frame, labels, font, scale, thickness, lineType);
+    }, runs);
+    bench::row("TextRenderer::putTextBatch", batch, reference);
+
+    int baseline = 0;
+    const double sizeReference = perLabel * bench::medianMs([&] {
+        for (const auto& l : labels) cv::getTextSize(l.text, font, scale, thickness, &baseline);
+    }, runs);
+    bench::row("cv::getTextSize", sizeReference);
+
+    const double sizeCached = perLabel * bench::medianMs([&] {
+        for (const auto& l : labels) renderer.getTextSize(l.text, font, scale, thickness, &baseline);
+    }, runs);
+    bench::row("TextRenderer::getTextSize", sizeCached, sizeReference);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int runs = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+    for (int lineType : {cv::LINE_8, cv::LINE_AA}) {
+        run(50, lineType, runs);
+        run(100, lineType, runs);
+    }
+    return 0;
+}
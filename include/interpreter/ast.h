@@ -2,6 +2,7 @@
 #define VISIONPIPE_AST_H
 
 #include "interpreter/lexer.h"
+#include "interpreter/cache_key.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -59,6 +60,7 @@ struct ParameterDecl {
  */
 struct CacheOutput {
     std::string cacheId;
+    CacheKey cacheKey;  // Interned by the parser (invalid when isDynamic)
     bool isGlobal;
     bool isDynamic;   // true if cacheId comes from a variable
     SourceLocation location;
@@ -176,6 +178,10 @@ struct FunctionCallExpr : Expression {
     // Named (keyword) arguments: func(param=value)
     // These are ordered as written; resolved to positional in the interpreter.
     std::vector<std::pair<std::string, std::shared_ptr<Expression>>> namedArguments;
+    // Interned string literal arguments, parallel to arguments / namedArguments
+    // (invalid for non-literals), handed to items as ExecutionContext::argKeys.
+    std::vector<CacheKey> argKeys;
+    std::vector<CacheKey> namedArgKeys;
     std::optional<CacheOutput> cacheOutput;  // -> "cache_id"
     
     FunctionCallExpr() : Expression(ASTNodeType::FUNCTION_CALL_EXPR) {}
@@ -213,6 +219,7 @@ struct UnaryExpr : Expression {
  */
 struct CacheAccessExpr : Expression {
     std::string cacheId;
+    CacheKey cacheKey;
     bool isGlobal;
     
     CacheAccessExpr() : Expression(ASTNodeType::CACHE_ACCESS_EXPR), isGlobal(false) {}
@@ -255,6 +262,7 @@ struct ParamRefExpr : Expression {
  */
 struct CacheLoadExpr : Expression {
     std::string cacheId;               // Cache identifier
+    CacheKey cacheKey;                 // Interned cacheId (invalid when isDynamic)
     bool isDynamic = false;            // true if cacheId is from a variable
     bool isGlobal = false;             // Whether to load from global cache
     std::shared_ptr<FunctionCallExpr> targetCall;  // The function to call with cached Mat
@@ -401,10 +409,22 @@ struct ExecRtMultiStmt : Statement {
  * Mat is UNCHANGED (bypasses through to the next item).  The background
  * thread receives a deep-clone of the Mat and fully private interpreter
  * state; the only shared resource is the global cache (thread-safe).
+ *
+ * The named form takes optional pool options:
+ *   exec_nasync <pipeline> workers=4 order=strict
+ *   - workers: interpreter clones sharing one bounded input queue (default 1)
+ *   - order:   latest (default) drops the oldest queued frame when full and
+ *              never publishes a result older than one already published;
+ *              strict rejects new frames when full and publishes global-cache
+ *              results in input order
  */
 struct ExecNasyncStmt : Statement {
     /// Named pipeline mode: non-null when a pipeline reference is given.
     std::shared_ptr<Expression> pipelineRef;
+    /// Pool size (named mode only); null = 1 worker.
+    std::shared_ptr<Expression> workers;
+    /// order=strict: publish results in input sequence order.
+    bool strictOrder = false;
     /// Inline block mode: non-empty when exec_nasync start ... end is used.
     std::vector<std::shared_ptr<Statement>> body;
 
@@ -453,6 +473,7 @@ struct DebugEndStmt : Statement {
  */
 struct UseStmt : Statement {
     std::string cacheId;
+    CacheKey cacheKey;
     bool isGlobal;
     std::optional<CacheOutput> cacheOutput;  // Optional: use("a") -> "b"
     
@@ -466,6 +487,7 @@ struct UseStmt : Statement {
  */
 struct CacheStmt : Statement {
     std::string cacheId;
+    CacheKey cacheKey;
     std::shared_ptr<Expression> value;
     bool isGlobal;
     
@@ -545,6 +567,7 @@ struct ImportStmt : Statement {
  */
 struct GlobalStmt : Statement {
     std::string cacheId;
+    CacheKey cacheKey;
     std::optional<std::shared_ptr<Expression>> initialValue;
     
     GlobalStmt() : Statement(ASTNodeType::GLOBAL_STMT) {}
@@ -563,6 +586,7 @@ struct ParamEntry {
     std::string                              name;
     std::string                              typeName;   ///< "int", "float", "string", "bool"
     std::optional<std::shared_ptr<Expression>> defaultValue;
+    std::vector<std::shared_ptr<Expression>> tunableValues;  ///< @tunable(v1, v2, ...) candidates
     SourceLocation                           location;
 };
 
@@ -570,6 +594,8 @@ struct ParamEntry {
  * @brief params [ brightness:int=50, gain:float=1.0, ... ]
  *
  * Top-level statement that declares parameters readable from the TCP server.
+ * An entry may end with @tunable(v1, v2, ...) to list the values
+ * `visionpipe tune` explores for it.
  */
 struct ParamDeclStmt : Statement {
     std::vector<ParamEntry> entries;
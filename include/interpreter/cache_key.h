@@ -0,0 +1,77 @@
+#ifndef VISIONPIPE_CACHE_KEY_H
+#define VISIONPIPE_CACHE_KEY_H
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace visionpipe {
+
+/**
+ * @brief Interned cache identifier
+ *
+ * Cache ids written in a script are interned by the parser, so the
+ * interpreter and items address cache entries by a dense integer index
+ * instead of hashing the string on every access.
+ */
+struct CacheKey {
+    static constexpr uint32_t kInvalid = UINT32_MAX;
+
+    uint32_t index = kInvalid;
+
+    bool valid() const { return index != kInvalid; }
+    bool operator==(const CacheKey& o) const { return index == o.index; }
+    bool operator!=(const CacheKey& o) const { return index != o.index; }
+};
+
+/**
+ * @brief A cache id resolved at runtime
+ *
+ * The interned key when the id has one, otherwise the id itself, which the
+ * CacheManager then stores by name (see CacheSlots).
+ */
+struct CacheRef {
+    CacheKey key;
+    std::string id;     ///< Set only when key is invalid
+};
+
+/**
+ * @brief Process-wide symbol table of cache ids
+ *
+ * Handles are never released, so a handle stays valid (and names stay
+ * addressable) for the lifetime of the process.  Only ids fixed at load
+ * time (script literals, numeric keys) are interned; ids built at runtime
+ * are looked up with find() and otherwise cached by name.
+ */
+class CacheKeyTable {
+public:
+    static CacheKeyTable& instance();
+
+    /// Handle for @p id, allocating one on first use.
+    CacheKey intern(const std::string& id);
+
+    /// Handle for @p id if it was ever interned, else an invalid key.
+    CacheKey find(const std::string& id) const;
+
+    /// Handle for the legacy numeric cache keys (CacheManager::set(uint16_t, ...)).
+    CacheKey numeric(uint16_t key);
+
+    /// Name of a valid handle; the reference stays valid for the process lifetime.
+    const std::string& name(CacheKey key) const;
+
+    size_t size() const;
+
+private:
+    CacheKeyTable() = default;
+
+    mutable std::shared_mutex _mutex;
+    std::unordered_map<std::string, uint32_t> _index;
+    std::deque<std::string> _names;                 ///< Stable addresses
+    std::unordered_map<uint16_t, uint32_t> _numeric;
+};
+
+} // namespace visionpipe
+
+#endif // VISIONPIPE_CACHE_KEY_H
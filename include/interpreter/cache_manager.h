@@ -3,6 +3,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <unordered_map>
 #include <mutex>
 #include <shared_mutex>
@@ -10,6 +11,7 @@
 #include <optional>
 #include <atomic>
 #include <opencv2/core/mat.hpp>
+#include "interpreter/cache_key.h"
 
 namespace visionpipe {
 
@@ -27,7 +29,67 @@ struct CacheEntry {
     bool isGlobal;              // Whether this is a global cache entry
     uint64_t shmSeq = 0;        // SHM writeSeq when this entry was last populated
                                 // from the arena (0 = not from SHM / stale)
-    CacheEntry() : timestamp(0), accessCount(0), isGlobal(false), shmSeq(0) {}
+    uint64_t generation = 0;    // Process-wide counter value of the last write;
+                                // changes whenever the entry is set again
+    CacheEntry() : timestamp(0), accessCount(0), isGlobal(false), shmSeq(0), generation(0) {}
+};
+
+/**
+ * @brief Cache entries indexed by CacheKey
+ *
+ * A sparse key -> slot table over densely packed entries, so a lookup is a
+ * bounds check and an array load, and clear() only touches live entries.
+ * Pointers returned by find() are invalidated by the next insert()/erase().
+ *
+ * Ids built at runtime are never interned (that would grow the key table
+ * and every slot table without bound); they live in a name-keyed map
+ * instead.  If such an id is interned later, by a script loaded after the
+ * write, the keyed lookups still find its entry and move it over on the
+ * next insert.
+ */
+class CacheSlots {
+public:
+    const CacheEntry* find(CacheKey key) const {
+        if (key.index >= _slot.size() || _slot[key.index] == 0) {
+            return _dynamic.empty() ? nullptr : findDynamic(key);
+        }
+        return &_entries[_slot[key.index] - 1];
+    }
+
+    CacheEntry* find(CacheKey key) {
+        return const_cast<CacheEntry*>(static_cast<const CacheSlots*>(this)->find(key));
+    }
+
+    /// Entry for @p key, default-constructed if absent.
+    CacheEntry& insert(CacheKey key);
+
+    bool erase(CacheKey key);
+
+    /// Name-keyed counterparts, for ids that were never interned.
+    const CacheEntry* find(const std::string& id) const;
+    CacheEntry* find(const std::string& id);
+    CacheEntry& insert(const std::string& id);
+    bool erase(const std::string& id);
+
+    void clear();
+
+    /// Keyed entries only; dynamic() holds the rest.
+    size_t size() const { return _entries.size(); }
+    bool empty() const { return _entries.empty() && _dynamic.empty(); }
+    CacheKey keyAt(size_t i) const { return _keys[i]; }
+    CacheEntry& entryAt(size_t i) { return _entries[i]; }
+    const CacheEntry& entryAt(size_t i) const { return _entries[i]; }
+
+    std::unordered_map<std::string, CacheEntry>& dynamic() { return _dynamic; }
+    const std::unordered_map<std::string, CacheEntry>& dynamic() const { return _dynamic; }
+
+private:
+    const CacheEntry* findDynamic(CacheKey key) const;
+
+    std::vector<uint32_t> _slot;        ///< Key index -> entry position + 1 (0 = absent)
+    std::vector<CacheEntry> _entries;
+    std::vector<CacheKey> _keys;        ///< Parallel to _entries
+    std::unordered_map<std::string, CacheEntry> _dynamic;   ///< Never-interned ids
 };
 
 /**
@@ -38,7 +100,7 @@ struct GlobalCacheData {
     // shared_mutex allows concurrent reads (e.g. multiple exec_multi workers
     // all reading the same ccm_matrix) while serialising writes.
     mutable std::shared_mutex mutex;
-    std::unordered_map<std::string, CacheEntry> entries;
+    CacheSlots entries;
 };
 
 /**
@@ -49,6 +111,12 @@ struct GlobalCacheData {
  * 
  * Multiple CacheManager instances can share the same GlobalCacheData
  * (e.g. for parallel pipeline execution via exec_multi).
+ *
+ * Every operation takes either a CacheKey (interned by the parser for ids
+ * written in the script) or a string.  The string overloads look the id up
+ * without interning it: a known id forwards to the CacheKey path, any other
+ * id is stored and read by name (see CacheSlots), so runtime-built ids cost
+ * a hash but never grow the key table.
  */
 class CacheManager {
 public:
@@ -106,6 +174,7 @@ public:
      * @param source Source identifier (pipeline name, etc.)
      */
     void setGlobal(const std::string& id, const cv::Mat& mat, const std::string& source = "");
+    void setGlobal(CacheKey key, const cv::Mat& mat, const std::string& source = "");
     
     /**
      * @brief Get a Mat from the global cache
@@ -113,21 +182,52 @@ public:
      * @return Mat if found, empty Mat otherwise
      */
     cv::Mat getGlobal(const std::string& id) const;
+    cv::Mat getGlobal(CacheKey key) const;
+    cv::Mat getGlobal(const CacheRef& ref) const;
     
     /**
      * @brief Check if a global cache entry exists
      */
     bool hasGlobal(const std::string& id) const;
+    bool hasGlobal(CacheKey key) const;
     
     /**
      * @brief Remove a global cache entry
      */
     void removeGlobal(const std::string& id);
+    void removeGlobal(CacheKey key);
     
     /**
      * @brief Clear all global cache entries
      */
     void clearGlobal();
+
+    // =========================================================================
+    // Staged global writes (exec_nasync pools)
+    // =========================================================================
+
+    struct StagedGlobals {
+        std::vector<std::pair<CacheKey, CacheEntry>> keyed;
+        std::vector<std::pair<std::string, CacheEntry>> dynamic;   ///< Never-interned ids
+    };
+
+    /**
+     * @brief Hold setGlobal() writes in a private buffer instead of the shared store
+     *
+     * While staging, getGlobal()/hasGlobal() on this manager see its own
+     * staged entries first, so a pipeline reads back what it wrote; other
+     * managers see nothing until commitGlobals().
+     */
+    void setStageGlobals(bool on) {
+        _stageGlobals = on;
+        if (!on) _staged.clear();
+    }
+
+    /// Move the staged writes out, leaving the buffer empty.
+    StagedGlobals takeStagedGlobals();
+
+    /// Publish staged writes to the shared store under one lock.
+    void commitGlobals(StagedGlobals& staged);
     
     /**
      * @brief Get all global cache IDs
@@ -153,16 +253,19 @@ public:
      * @brief Store a Mat in the current local scope
      */
     void setLocal(const std::string& id, const cv::Mat& mat, const std::string& source = "");
+    void setLocal(CacheKey key, const cv::Mat& mat, const std::string& source = "");
     
     /**
      * @brief Get a Mat from local cache (searches from current scope upward)
      */
     cv::Mat getLocal(const std::string& id) const;
+    cv::Mat getLocal(CacheKey key) const;
     
     /**
      * @brief Check if a local cache entry exists
      */
     bool hasLocal(const std::string& id) const;
+    bool hasLocal(CacheKey key) const;
     
     /**
      * @brief Clear the current local scope
@@ -184,28 +287,44 @@ public:
      * @brief Store a Mat (local by default, global if specified)
      */
     void set(const std::string& id, const cv::Mat& mat, bool isGlobal = false, const std::string& source = "");
+    void set(CacheKey key, const cv::Mat& mat, bool isGlobal = false, const std::string& source = "");
+    void set(const CacheRef& ref, const cv::Mat& mat, bool isGlobal = false, const std::string& source = "");
     
     /**
      * @brief Get a Mat (searches local first, then global)
      */
     cv::Mat get(const std::string& id) const;
+    cv::Mat get(CacheKey key) const;
+    cv::Mat get(const CacheRef& ref) const;
     
     /**
      * @brief Check if a cache entry exists (local or global)
      */
     bool has(const std::string& id) const;
+    bool has(CacheKey key) const;
     
     /**
      * @brief Get cache entry with metadata
      */
     std::optional<CacheEntry> getEntry(const std::string& id) const;
+    std::optional<CacheEntry> getEntry(CacheKey key) const;
+    
+    /**
+     * @brief Generation of the entry get() would return (0 if none)
+     *
+     * Every set() gives the entry a new generation, so a consumer that
+     * derives something expensive from an entry (e.g. a remap plan) can
+     * tell whether it was rewritten without reading the Mat.  Writes into
+     * the stored Mat's buffer without a set() are not seen.
+     */
+    uint64_t generation(const std::string& id) const;
     
     // =========================================================================
     // Numeric key support (for compatibility with existing Pipeline)
     // =========================================================================
     
     /**
-     * @brief Store using numeric key (converts to string)
+     * @brief Store using numeric key (interned as "__num_<key>")
      */
     void set(uint16_t key, const cv::Mat& mat);
     
@@ -244,6 +363,10 @@ private:
     // Global cache (shared across all pipelines and, optionally, across threads)
     std::shared_ptr<GlobalCacheData> _sharedGlobal;
 
+    // Staged global writes (see setStageGlobals)
+    bool _stageGlobals = false;
+    CacheSlots _staged;
+
     // SHM bridge flags
     bool _isForkChild     = false;  ///< True in fork() child — setGlobal writes to arena
     bool _hasForkChildren = false;  ///< True in parent — getGlobal reads from arena
@@ -256,7 +379,21 @@ private:
     // Local cache stack — strictly owned by this CacheManager instance.
     // No mutex needed: local scopes are only accessed by the thread that owns
     // this CacheManager (each child interpreter has its own instance).
-    std::vector<std::unordered_map<std::string, CacheEntry>> _localScopes;
+    // Popped scopes are cleared but kept, so pipeline calls reuse their slot
+    // tables instead of reallocating them; _scopeDepth counts the live ones.
+    std::vector<CacheSlots> _localScopes;
+    size_t _scopeDepth = 1;
+
+    // Shared bodies of the CacheKey and never-interned string overloads;
+    // Id is CacheKey or std::string (defined in cache_manager.cpp).
+    template <typename Id> void setGlobalImpl(const Id& id, const cv::Mat& mat, const std::string& source);
+    template <typename Id> cv::Mat getGlobalImpl(const Id& id) const;
+    template <typename Id> bool hasGlobalImpl(const Id& id) const;
+    template <typename Id> void setLocalImpl(const Id& id, const cv::Mat& mat, const std::string& source);
+    template <typename Id> cv::Mat getLocalImpl(const Id& id) const;
+    template <typename Id> bool hasLocalImpl(const Id& id) const;
+    template <typename Id> std::optional<CacheEntry> getEntryImpl(const Id& id) const;
+    template <typename Id> uint64_t generationImpl(const Id& id) const;
     
     // Helper to estimate Mat memory
     static size_t estimateMatMemory(const cv::Mat& mat);
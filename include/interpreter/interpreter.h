@@ -14,6 +14,9 @@
 #include <functional>
 #include <stack>
 #include <queue>
+#include <deque>
+#include <map>
+#include <chrono>
 #include <condition_variable>
 #include <climits>
 #include <sys/types.h>  // pid_t
@@ -24,6 +27,25 @@ namespace visionpipe {
 class Pipeline;
 class PipelineThreadedGroup;
 struct ShmArena;  // defined in utils/shm_zero_copy.h
+struct MemoryPlan;  // defined in interpreter/memory_planner.h
+
+/**
+ * @brief Snapshot of one exec_nasync worker pool
+ */
+struct NasyncPoolStats {
+    std::string pipeline;
+    int      workers       = 1;
+    bool     strictOrder   = false;
+    size_t   queueDepth    = 0;   ///< Frames waiting for a worker
+    size_t   maxQueueDepth = 0;
+    size_t   reorderDepth  = 0;   ///< strict: results held back for an earlier frame
+    uint64_t submitted     = 0;   ///< Frames accepted into the queue
+    uint64_t dropped       = 0;   ///< Frames rejected (strict) or displaced (latest) by a full queue
+    uint64_t published     = 0;   ///< Results published to the global cache
+    uint64_t stale         = 0;   ///< latest: results discarded as older than one already published
+    double   avgLatencyMs  = 0;   ///< Submission to publication
+    double   maxLatencyMs  = 0;
+};
 
 /**
  * @brief Interpreter configuration
@@ -49,6 +71,14 @@ struct InterpreterConfig {
     // of) the throughput table.  Works for both in-process pipelines and
     // exec_fork child processes (via the shared ShmArena).
     bool   latencyMode              = false;
+
+    // ── Memory planning ─────────────────────────────────────────────────────
+    // Opt-in.  With memoryPlanning, each pipeline's intermediate frames are
+    // placed in an arena planned for the input shape (see
+    // interpreter/memory_planner.h).  memoryPlanReport prints every plan as
+    // it is built.
+    bool   memoryPlanning           = false;
+    bool   memoryPlanReport         = false;
 };
 
 /**
@@ -155,6 +185,12 @@ public:
                             const std::vector<RuntimeValue>& args = {},
                             const cv::Mat& input = cv::Mat());
     
+    /**
+     * @brief Start a new frame for callers that drive pipelines one frame at
+     *        a time from native code (renews ExecutionContext::frameGeneration)
+     */
+    void beginFrame() { _context.nextFrame(); }
+    
     // =========================================================================
     // Cache access
     // =========================================================================
@@ -227,11 +263,23 @@ public:
      * @brief Get last error message
      */
     const std::string& lastError() const { return _lastError; }
+
+    /**
+     * @brief Reset the error flag (e.g. between batch inputs)
+     */
+    void clearError() { _hasError = false; _lastError.clear(); }
     
     /**
      * @brief Get number of frames processed in exec_loop
      */
     uint64_t framesProcessed() const { return _framesProcessed; }
+
+    /**
+     * @brief Queue depth, drops and latency of each exec_nasync pool
+     *
+     * Call from the thread running this interpreter.
+     */
+    std::vector<NasyncPoolStats> nasyncPoolStats() const;
     
 private:
     InterpreterConfig _config;
@@ -336,30 +384,127 @@ private:
     std::mutex _intervalMutex;  // protect _intervalWorkers map
 
     // =========================================================================
-    // exec_nasync persistent worker pool
+    // exec_nasync persistent worker pools
     //
     // Instead of spawning a detached thread + constructing a full Interpreter
-    // on every exec_nasync call, we maintain persistent worker threads that
-    // sleep between frames.  If the worker is still busy from the previous
-    // frame, the new invocation is skipped (preserving fire-and-forget
-    // semantics).
+    // on every exec_nasync call, each named pipeline is backed by N persistent
+    // worker interpreters sharing one bounded input queue (capacity N).  When
+    // the queue is full, order=latest displaces the oldest waiting frame and
+    // order=strict rejects the new one.
+    //
+    // With more than one worker, results could land out of order, so each
+    // worker stages its global-cache writes and hands them to the pool:
+    // strict mode publishes them in input sequence order through a reorder
+    // buffer; latest mode publishes immediately unless a newer frame's result
+    // is already out.
     // =========================================================================
-    struct NasyncWorkerSync {
+    struct NasyncJob {
+        uint64_t                         seq{0};
+        std::vector<RuntimeValue>        args;
+        cv::Mat                          inputMat;
+        std::shared_ptr<GlobalCacheData> global;
+        std::shared_ptr<ParameterStore>  paramStore;
+        std::chrono::steady_clock::time_point submitted;
+    };
+    struct NasyncPoolSync {
+        // Immutable after creation
+        std::string             pipelineName;
+        int                     workers{1};
+        bool                    strictOrder{false};
+        bool                    staged{false};       ///< workers > 1
+
+        // Input queue (guarded by mtx)
         std::mutex              mtx;
         std::condition_variable cv;
-        bool                    hasWork{false};
-        bool                    busy{false};
+        std::deque<NasyncJob>   queue;
+        size_t                  capacity{1};
         bool                    shutdown{false};
-        std::string             pipelineName;
-        std::vector<RuntimeValue> args;
-        cv::Mat                 inputMat;
+        uint64_t                nextSeq{0};
+        uint64_t                submittedCount{0};
+        uint64_t                droppedCount{0};
+        size_t                  maxQueueDepth{0};
+
+        // Publication (guarded by publishMtx)
+        std::mutex              publishMtx;
+        uint64_t                nextPublish{0};      ///< strict: next seq due; latest: newest published + 1
+        struct Finished {
+            CacheManager::StagedGlobals           writes;
+            std::chrono::steady_clock::time_point submitted;
+        };
+        std::map<uint64_t, Finished> reorder;        ///< strict: results finished ahead of an earlier frame
+        uint64_t                publishedCount{0};
+        uint64_t                staleCount{0};
+        uint64_t                totalLatencyNs{0};
+        uint64_t                maxLatencyNs{0};
+
+        NasyncPoolStats snapshot();
     };
     struct NasyncWorker {
-        std::unique_ptr<Interpreter>    interp;
-        std::shared_ptr<NasyncWorkerSync> sync;
-        std::thread                     thread;
+        std::unique_ptr<Interpreter> interp;
+        std::thread                  thread;
+    };
+    struct NasyncPool {
+        std::shared_ptr<NasyncPoolSync> sync;
+        std::vector<NasyncWorker>       workers;
     };
-    std::unordered_map<std::string, std::shared_ptr<NasyncWorker>> _nasyncWorkers;
+    std::unordered_map<std::string, std::shared_ptr<NasyncPool>> _nasyncPools;
+
+    static void publishNasync(NasyncPoolSync& pool, const NasyncJob& job,
+                              CacheManager::StagedGlobals writes, CacheManager& cache);
+
+    // =========================================================================
+    // map_rois worker pools
+    //
+    // map_rois(<pipeline>, "detections", max_parallel) runs a sub-pipeline
+    // once per detection, on a view of the current frame cropped to that
+    // detection's box.  One pool of max_parallel pre-cloned interpreters with
+    // persistent threads is kept per sub-pipeline; a call publishes a
+    // RoiBatch and the workers claim ROIs from it through an atomic counter
+    // until it is drained.  Results land in the batch's slot for each ROI, so
+    // the gathered list stays aligned with the detection rows.
+    // =========================================================================
+    struct RoiBatch {
+        std::string               pipelineName;
+        size_t                    paramCount{0};   ///< Sub-pipeline parameters to fill
+        cv::Mat                   frame;
+        cv::Mat                   detections;      ///< CV_32F rows, [x, y, w, h, ...]
+        std::vector<cv::Rect>     rois;            ///< Clipped to the frame
+        std::vector<RuntimeValue> results;         ///< Aligned with rois
+        std::vector<std::string>  errors;          ///< Aligned with rois ("" = ok)
+        std::atomic<size_t>       next{0};
+    };
+    struct RoiPoolSync {
+        std::mutex              mtx;
+        std::condition_variable startCv;
+        std::condition_variable doneCv;
+        uint64_t                generation{0};  ///< Bumped per published batch
+        size_t                  active{0};      ///< Workers still draining it
+        bool                    shutdown{false};
+        RoiBatch*               batch{nullptr};
+    };
+    struct RoiWorker {
+        std::unique_ptr<Interpreter> interp;
+        std::thread                  thread;
+    };
+    struct RoiPool {
+        std::shared_ptr<RoiPoolSync> sync;
+        std::vector<RoiWorker>       workers;
+    };
+    std::unordered_map<std::string, std::shared_ptr<RoiPool>> _roiPools;
+
+    // =========================================================================
+    // Static memory plans
+    //
+    // Plans per pipeline for the last few input shapes it was called with,
+    // most recently used first, so a pipeline fed alternating shapes does not
+    // replan on every call.  Plans are per interpreter, so worker
+    // interpreters never share an arena.
+    // =========================================================================
+    static constexpr size_t kMemoryPlansPerPipeline = 4;
+    std::unordered_map<const PipelineDecl*, std::vector<std::shared_ptr<MemoryPlan>>> _memoryPlans;
+
+    /// Plan for @p pipeline at @p input's shape, or nullptr when disabled.
+    std::shared_ptr<const MemoryPlan> memoryPlanFor(const PipelineDecl* pipeline, const cv::Mat& input);
 
     // =========================================================================
     // exec_fork child process tracking
@@ -431,6 +576,9 @@ private:
         std::atomic<ShmArena*> forkArena{nullptr};
         std::unordered_map<std::string, uint64_t> forkSnapCounts;
 
+        // exec_nasync pools reported below the tables (guarded by mutex)
+        std::vector<std::shared_ptr<NasyncPoolSync>> nasyncPools;
+
         void record(const std::string& name, uint64_t durationNs);
         void startPrinter(double intervalSec);
         void stopPrinter();
@@ -481,6 +629,7 @@ private:
     RuntimeValue evalCacheLoad(CacheLoadExpr* expr);
     RuntimeValue evalArray(ArrayExpr* expr);
     RuntimeValue evalParamRef(ParamRefExpr* expr);
+    RuntimeValue evalMapRois(FunctionCallExpr* expr);
     
     // Pipeline execution
     cv::Mat executePipelineDecl(PipelineDecl* pipeline, 
@@ -505,6 +654,10 @@ private:
                           std::shared_ptr<GlobalCacheData> sharedGlobal);
     void shutdownMultiWorkers();
     void shutdownNasyncWorkers();
+
+    // map_rois helpers
+    RoiPool& acquireRoiPool(const std::string& pipelineName, int workers);
+    void shutdownRoiPools();
 };
 
 } // namespace visionpipe
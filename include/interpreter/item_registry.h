@@ -9,6 +9,7 @@
 #include <unordered_map>
 #include <variant>
 #include <opencv2/core/mat.hpp>
+#include "interpreter/cache_key.h"
 
 // Forward declarations for tensor types
 namespace visionpipe {
@@ -22,6 +23,7 @@ namespace visionpipe {
 class Pipeline;
 class PipelineItem;
 class CacheManager;
+struct SourceLocation;
 
 /**
  * @brief Base type enumeration for interpreter values
@@ -153,8 +155,45 @@ struct ExecutionContext {
     bool shouldReturn = false;
     bool frameNotReady = false;             // Set by use(global) when fork-child frame not yet available
     RuntimeValue returnValue;
+
+    // Parse-time keys of the current item's string literal arguments, by
+    // position (set by the interpreter for the duration of execute()).
+    const std::vector<CacheKey>* argKeys = nullptr;
+
+    // Source location of the item call being executed (set by the
+    // interpreter alongside argKeys; null for items run from native code).
+    const SourceLocation* callSite = nullptr;
+
+    // Process-unique id of the frame being processed, renewed by reset() at
+    // every frame boundary.  Caches keyed by a Mat's address include it, so
+    // a buffer refilled in place on the next frame is not mistaken for the
+    // old one.  0 = unknown (never shared).
+    uint64_t frameGeneration = 0;
+
+    /// Start a new frame: take a fresh frameGeneration.
+    void nextFrame();
+
+    /**
+     * @brief Cache id for string argument @p index
+     *
+     * The parser's key when the argument was a literal, otherwise the
+     * runtime string (or @p fallback when the argument is absent), resolved
+     * without interning it.
+     */
+    CacheRef cacheRefArg(const std::vector<RuntimeValue>& args, size_t index,
+                         const std::string& fallback = "") const;
+
+    /**
+     * @brief Id unique to the current call site: "<prefix>@file:line:column"
+     *
+     * Default key for items that keep state between frames, so two calls
+     * without an explicit cache_id do not share (and corrupt) one model.
+     * Falls back to @p prefix when there is no call site.
+     */
+    std::string callSiteId(const std::string& prefix) const;
     
     void reset() {
+        nextFrame();
         shouldBreak = false;
         shouldContinue = false;
         shouldReturn = false;
@@ -163,6 +202,26 @@ struct ExecutionContext {
     }
 };
 
+/**
+ * @brief Static size and type of a frame, as seen by the memory planner
+ */
+struct FrameShape {
+    int rows = 0;
+    int cols = 0;
+    int type = -1;
+
+    bool valid() const { return rows > 0 && cols > 0 && type >= 0; }
+    size_t bytes() const { return valid() ? static_cast<size_t>(rows) * cols * CV_ELEM_SIZE(type) : 0; }
+
+    static FrameShape of(const cv::Mat& m) {
+        if (m.dims != 2 || m.empty()) return FrameShape{};
+        return FrameShape{m.rows, m.cols, m.type()};
+    }
+
+    bool operator==(const FrameShape& o) const { return rows == o.rows && cols == o.cols && type == o.type; }
+    bool operator!=(const FrameShape& o) const { return !(*this == o); }
+};
+
 /**
  * @brief Result of executing an interpreter item
  */
@@ -287,6 +346,19 @@ public:
      */
     virtual bool isPure() const { return false; }
     
+    /**
+     * @brief Shape of the Mat this item returns, for static memory planning
+     *
+     * Called with the item's literal arguments (defaults filled in) and the
+     * shape of the incoming frame.  Override only when the output is one
+     * freshly allocated frame whose shape follows from these alone; the
+     * default (nullopt) keeps the statement out of the plan.
+     */
+    virtual std::optional<FrameShape> inferOutputShape(const std::vector<RuntimeValue>& /*args*/,
+                                                       const FrameShape& /*input*/) const {
+        return std::nullopt;
+    }
+    
     /**
      * @brief Generate documentation for this item
      */
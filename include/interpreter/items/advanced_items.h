@@ -2,10 +2,15 @@
 #define VISIONPIPE_ADVANCED_ITEMS_H
 
 #include "interpreter/item_registry.h"
+#include "utils/keyed_registry.h"
 #include <opencv2/opencv.hpp>
 #include <opencv2/video.hpp>
 #include <opencv2/photo.hpp>
 #include <opencv2/stitching.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 namespace visionpipe {
 
@@ -33,10 +38,118 @@ public:
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
 };
 
+/**
+ * @brief Persistent DIS dense optical flow for one stream.
+ *
+ * Keeps the previous gray frame and the previous flow field, so each call
+ * converts only the new frame and DIS starts from last frame's motion
+ * instead of zero (temporal warm start).  A size change resets the state.
+ */
+class DenseFlowState {
+public:
+    /// preset: "ultrafast", "fast" or "medium" (cv::DISOpticalFlow presets).
+    explicit DenseFlowState(const std::string& preset);
+
+    /// Flow from the previous frame to `frame` (CV_32FC2), averaged down by
+    /// `stride` with vectors in output-grid pixels.  The result is the
+    /// caller's own; an empty Mat on the first frame of a stream.
+    cv::Mat compute(const cv::Mat& frame, bool warmStart, int stride = 1);
+
+    /// Preset the state was built with; KeyedRegistry rebuilds the state when it changes.
+    const std::string& config() const { return _preset; }
+    uint64_t frameCount() const { return _frames; }
+
+private:
+    std::string _preset;
+    cv::Ptr<cv::DISOpticalFlow> _dis;
+    cv::Mat  _prevGray;
+    cv::Mat  _gray;
+    cv::Mat  _flow;        ///< Last flow, fed back as the initial estimate
+    std::atomic<uint64_t> _frames{0};   ///< Read by frameCount() without the lock
+    std::mutex _mutex;
+};
+
+/// Dense flow states keyed by cache_id, rebuilt when the preset changes.
+using DenseFlowRegistry = KeyedRegistry<DenseFlowState>;
+
+class DenseFlowItem : public InterpreterItem {
+public:
+    DenseFlowItem();
+    ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+};
+
 // ============================================================================
 // Background Subtraction
 // ============================================================================
 
+/**
+ * @brief Construction parameters of a persistent background model.
+ *
+ * Two models with equal configs are interchangeable; any difference forces
+ * the model to be rebuilt (and its learned state discarded).
+ */
+struct BackgroundModelConfig {
+    std::string algorithm = "mog2";  ///< "mog2" or "knn"
+    int    history        = 500;
+    double threshold      = 16.0;    ///< var_threshold (MOG2) / dist2_threshold (KNN)
+    bool   detectShadows  = true;
+    double modelScale     = 1.0;     ///< Resolution the model learns at (1, 0.5, 0.25 …)
+    int    strips         = 0;       ///< Horizontal strips updated in parallel (0 = auto)
+
+    bool operator==(const BackgroundModelConfig& o) const {
+        return algorithm == o.algorithm && history == o.history &&
+               threshold == o.threshold && detectShadows == o.detectShadows &&
+               modelScale == o.modelScale && strips == o.strips;
+    }
+    bool operator!=(const BackgroundModelConfig& o) const { return !(*this == o); }
+};
+
+/**
+ * @brief Persistent, strip-parallel background model.
+ *
+ * The frame (optionally downscaled to `modelScale`) is split into horizontal
+ * strips, each owning an independent cv::BackgroundSubtractor.  MOG2 and KNN
+ * are per-pixel models, so the strips are exact and can be updated
+ * concurrently on OpenCV's thread pool.  The foreground mask is upsampled
+ * with nearest-neighbour so shadow labels (127) survive.
+ *
+ * Learning-rate schedule: during the first `warmupFrames` frames the rate is
+ * raised to at least 1/(n+1), so a fresh model converges in a handful of
+ * frames instead of `history` frames; afterwards the requested rate
+ * (-1 = OpenCV automatic) is used unchanged.
+ */
+class BackgroundModel {
+public:
+    explicit BackgroundModel(const BackgroundModelConfig& cfg) : _cfg(cfg) {}
+
+    /// Update the model with `frame` and return the full-resolution foreground mask.
+    cv::Mat apply(const cv::Mat& frame, double learningRate, int warmupFrames = 0);
+
+    /// Current background estimate at model resolution (empty before first frame).
+    cv::Mat background();
+
+    const BackgroundModelConfig& config() const { return _cfg; }
+    uint64_t frameCount() const { return _frames; }
+    cv::Size modelSize() const { return _modelSize; }
+    int stripCount() const { return static_cast<int>(_strips.size()); }
+
+private:
+    void allocate(const cv::Size& modelSize, int type);
+
+    BackgroundModelConfig _cfg;
+    std::vector<cv::Ptr<cv::BackgroundSubtractor>> _strips;
+    std::vector<cv::Range> _rowRanges;
+    cv::Size _modelSize;
+    int      _type   = -1;
+    uint64_t _frames = 0;
+    cv::Mat  _small;       ///< Reused downscaled input
+    cv::Mat  _smallMask;   ///< Reused model-resolution mask
+    std::mutex _mutex;
+};
+
+/// Background models keyed by cache_id; rebuilt when the config changes.
+using BackgroundModelRegistry = KeyedRegistry<BackgroundModel>;
+
 class BackgroundSubtractorMOG2Item : public InterpreterItem {
 public:
     BackgroundSubtractorMOG2Item();
@@ -121,6 +234,20 @@ public:
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
 };
 
+/**
+ * @brief Streaming exposure fusion for interleaved (alternating-exposure) streams
+ *
+ * Each call stores the current frame in its exposure slot and returns the
+ * fusion of the latest frame of every slot, so output runs at the input
+ * rate.  Until every slot has been filled the frame is passed through.
+ * See utils/exposure_fusion.h for the fixed-point pipeline.
+ */
+class ExposureFusionItem : public InterpreterItem {
+public:
+    ExposureFusionItem();
+    ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+};
+
 class TonemapItem : public InterpreterItem {
 public:
     TonemapItem();
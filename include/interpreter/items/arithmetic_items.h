@@ -193,6 +193,24 @@ public:
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
 };
 
+/**
+ * @brief O(1) mean and variance of a window of the current frame
+ * 
+ * Served from the shared integral images of the frame (built once, reused
+ * by later queries and box-statistics items on the same frame).
+ * 
+ * Parameters:
+ * - x, y, width, height: Window in pixels (clipped to the frame)
+ * - channel: Channel index (default: 0)
+ * 
+ * Returns: [mean, variance]
+ */
+class WindowStatsItem : public InterpreterItem {
+public:
+    WindowStatsItem();
+    ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+};
+
 /**
  * @brief Calculates sum of all elements
  * 
@@ -395,6 +413,63 @@ public:
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
 };
 
+/**
+ * @brief Linear filtering in the frequency domain (filter2D semantics)
+ * 
+ * Pads to the optimal DFT size, multiplies by the kernel spectrum cached under
+ * the kernel's cache ID and crops, in one call. Small kernels fall back to
+ * cv::filter2D, which is faster below ~11x11.
+ * 
+ * Parameters:
+ * - kernel_cache: Cache ID of a single-channel kernel
+ * - anchor_x, anchor_y: Kernel anchor (-1 = center)
+ * - border: replicate, reflect, reflect_101, wrap, constant
+ * - mode: "correlation" (like filter2d) or "convolution" (flipped kernel)
+ * - ddepth: Output depth (-1 = same as input)
+ * - generation: Bump to force the cached spectrum to be rebuilt
+ */
+class FFTConvolveItem : public InterpreterItem {
+public:
+    FFTConvolveItem();
+    ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+};
+
+/**
+ * @brief Applies a zero-phase transfer function in the frequency domain
+ * 
+ * Parameters:
+ * - type: lowpass, highpass, bandpass, bandstop
+ * - cutoff: Cutoff frequency as a fraction of Nyquist (band low edge)
+ * - cutoff_high: Band high edge as a fraction of Nyquist
+ * - shape: gaussian, butterworth, ideal
+ * - order: Butterworth order
+ * - response_cache: Cache ID of a centered custom response (overrides type)
+ * - cache_id: Spectrum slot, one per filter in a pipeline
+ * - ddepth: Output depth (-1 = same as input)
+ */
+class FFTFilterItem : public InterpreterItem {
+public:
+    FFTFilterItem();
+    ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+};
+
+/**
+ * @brief Estimates global translation by phase correlation
+ * 
+ * Parameters:
+ * - reference_cache: Cache ID of the reference frame, or the tracking slot
+ * - track: Correlate against the previous frame instead (default: false)
+ * - window: Apply a Hann window (default: true)
+ * - generation: Bump to force the cached reference spectrum to be rebuilt
+ * 
+ * Returns: [dx, dy, response]; the current Mat is passed through
+ */
+class PhaseCorrelateItem : public InterpreterItem {
+public:
+    PhaseCorrelateItem();
+    ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+};
+
 // ============================================================================
 // Random Operations
 // ============================================================================
@@ -37,6 +37,8 @@ class ColorConvertItem : public InterpreterItem {
 public:
     ColorConvertItem();
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+    std::optional<FrameShape> inferOutputShape(const std::vector<RuntimeValue>& args,
+                                               const FrameShape& input) const override;
 };
 
 /**
@@ -73,6 +73,38 @@ public:
     bool modifiesMat() const override { return false; }
 };
 
+/**
+ * @brief Define a confidence-gated cascade of loaded models
+ * 
+ * The cascade runs through model_infer under its own id. Each stage's gate
+ * decides whether the next stage runs; otherwise that stage's output is the
+ * result. Gates combine score bands, class sets and box counts, and fire
+ * when any rule matches (an empty gate always escalates).
+ * 
+ * Syntax:
+ *   model_cascade("cascade_id", ["light", "heavy"], "score:0.3,0.7")
+ *   model_cascade("cascade_id", ["det", "cls"], "classes:0,2", ["detect", "classify"], true)
+ */
+class ModelCascadeItem : public InterpreterItem {
+public:
+    ModelCascadeItem();
+    ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+    bool modifiesMat() const override { return false; }
+};
+
+/**
+ * @brief Per-stage hit rates and average cost of a cascade
+ * 
+ * Syntax:
+ *   cascade_stats("cascade_id")
+ */
+class CascadeStatsItem : public InterpreterItem {
+public:
+    CascadeStatsItem();
+    ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+    bool modifiesMat() const override { return false; }
+};
+
 // ============================================================================
 // Inference Items
 // ============================================================================
@@ -160,6 +192,36 @@ public:
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
 };
 
+/**
+ * @brief Decode YOLO instance segmentation output (v8/v11 -seg models)
+ * 
+ * Masks are computed per surviving detection, inside its box only, and
+ * cached together as an instance map: 0 = background, i + 1 = detection row i.
+ * 
+ * Syntax:
+ *   model_infer("yoloseg", cache_id="out")
+ *   decode_yolo_seg("out_1", 0.25) -> "detections"  # out_1 = mask prototypes
+ */
+class DecodeYoloSegItem : public InterpreterItem {
+public:
+    DecodeYoloSegItem();
+    ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+};
+
+/**
+ * @brief Decode YOLO pose output (v8/v11 -pose models)
+ * 
+ * Keypoints are cached as [N, K * 3] rows of (x, y, confidence).
+ * 
+ * Syntax:
+ *   decode_yolo_pose(0.25) -> "detections"
+ */
+class DecodeYoloPoseItem : public InterpreterItem {
+public:
+    DecodeYoloPoseItem();
+    ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+};
+
 /**
  * @brief Apply Non-Maximum Suppression
  * 
@@ -243,6 +305,24 @@ public:
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
 };
 
+/**
+ * @brief Overlay a semantic segmentation output on the current frame
+ * 
+ * Argmax runs at model resolution; only the uint8 label map is upsampled,
+ * inside the same pass that colorizes and blends.  Caches the label map as
+ * <cache_id>_labels and per-class frame pixel counts as <cache_id>_counts.
+ * 
+ * Syntax:
+ *   model_infer("deeplab", cache_id="out")
+ *   seg_overlay("out_0", 0.5)
+ *   seg_overlay("out_0", 0.5, "edge", [0.0, 0.6, 0.6])  # per-class thresholds
+ */
+class SegOverlayItem : public InterpreterItem {
+public:
+    SegOverlayItem();
+    ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+};
+
 // ============================================================================
 // Tensor Output Conversion Items
 // ============================================================================
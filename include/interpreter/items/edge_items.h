@@ -278,10 +278,19 @@ public:
 /**
  * @brief Detects lines using Hough transform
  * 
+ * Runs on a persistent HoughEngine (per cache_id).  With angle_window set
+ * and an edge map straight from canny as input, each edge pixel votes only
+ * near its gradient orientation.
+ * 
  * Parameters:
  * - rho: Distance resolution (default: 1)
- * - theta: Angle resolution in radians (default: PI/180)
+ * - theta: Angle resolution in degrees (default: 1)
  * - threshold: Accumulator threshold (default: 100)
+ * - angle_window: Vote half-width around the gradient in degrees (default: 0 = all)
+ * - min_angle / max_angle: Searched theta range in degrees (default: 0..180)
+ * - roi_x, roi_y, roi_w, roi_h: Search region (default: full frame)
+ * - max_lines: Keep the N strongest (default: 0 = all)
+ * - output_cache: Cache ID for N x 3 [rho, theta, votes] (default: none)
  */
 class HoughLinesItem : public InterpreterItem {
 public:
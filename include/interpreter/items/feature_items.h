@@ -346,6 +346,29 @@ public:
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
 };
 
+/**
+ * @brief Batch template matching returning top-k peaks per template
+ * 
+ * Templates are matched coarse-to-fine on a shared image pyramid, with
+ * FFT correlation for large templates (see utils/template_matcher.h).
+ * Results are stored as an N x 6 detection Mat [x, y, w, h, template_index,
+ * score], the format used by nms_boxes and draw_detections.
+ * 
+ * Parameters:
+ * - templates: Array of template cache IDs
+ * - method: "ccoeff_normed", "ccorr_normed", "sqdiff_normed" (default: "ccoeff_normed")
+ * - top_k: Peaks per template (default: 1)
+ * - threshold: Minimum score (default: 0.8)
+ * - levels: Pyramid levels (-1 = auto)
+ * - output_cache: Cache ID for detections (default: "matches")
+ * - cache_id: Template bank ID (default: "match_templates")
+ */
+class MatchTemplatesItem : public InterpreterItem {
+public:
+    MatchTemplatesItem();
+    ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+};
+
 /**
  * @brief Finds location of minimum and maximum values
  * 
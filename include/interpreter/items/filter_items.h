@@ -25,6 +25,8 @@ class GaussianBlurItem : public InterpreterItem {
 public:
     GaussianBlurItem();
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+    std::optional<FrameShape> inferOutputShape(const std::vector<RuntimeValue>& args,
+                                               const FrameShape& input) const override;
 };
 
 /**
@@ -37,6 +39,8 @@ class MedianBlurItem : public InterpreterItem {
 public:
     MedianBlurItem();
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+    std::optional<FrameShape> inferOutputShape(const std::vector<RuntimeValue>& args,
+                                               const FrameShape& input) const override;
 };
 
 /**
@@ -73,6 +77,8 @@ class BlurItem : public InterpreterItem {
 public:
     BlurItem();
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+    std::optional<FrameShape> inferOutputShape(const std::vector<RuntimeValue>& args,
+                                               const FrameShape& input) const override;
 };
 
 /**
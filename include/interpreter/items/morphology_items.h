@@ -24,6 +24,8 @@ class ThresholdItem : public InterpreterItem {
 public:
     ThresholdItem();
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+    std::optional<FrameShape> inferOutputShape(const std::vector<RuntimeValue>& args,
+                                               const FrameShape& input) const override;
 };
 
 /**
@@ -127,7 +129,7 @@ public:
 /**
  * @brief Morphological skeleton
  * 
- * Extracts skeleton/medial axis of binary shape
+ * Extracts a one-pixel-wide skeleton of a binary shape (Zhang-Suen thinning)
  */
 class SkeletonizeItem : public InterpreterItem {
 public:
@@ -139,7 +141,7 @@ public:
  * @brief Morphological thinning
  * 
  * Parameters:
- * - type: "zhang_suen" or "guo_hall" (default: "zhang_suen")
+ * - type: "zhangsuen" or "guohall" (default: "zhangsuen")
  */
 class ThinningItem : public InterpreterItem {
 public:
@@ -197,6 +199,38 @@ public:
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
 };
 
+/**
+ * @brief Fused threshold + blob labelling + filtering on run-length segments
+ * 
+ * Labels foreground runs with union-find (strip-parallel) and accumulates
+ * area, bounding box, centroid and central moments per blob without
+ * materialising a label image.  The frame passes through unchanged.
+ * 
+ * Parameters:
+ * - threshold: Foreground is value > threshold (default: 127)
+ * - invert: Foreground is value <= threshold (default: false)
+ * - min_area / max_area: Area bounds in pixels (0 = unbounded)
+ * - connectivity: 4 or 8 (default: 8)
+ * - cache_prefix: Output prefix (default: "blobs")
+ * - min_aspect / max_aspect: Bounding-box width/height bounds (0 = unbounded)
+ * - min_extent: Minimum area / bounding-box area (0 = unbounded)
+ * - max_blobs: Keep the N largest blobs (0 = all)
+ * 
+ * Cache outputs (one row per blob, largest first):
+ * - <prefix>_stats: N x 5 CV_32S [left, top, width, height, area]
+ * - <prefix>_centroids: N x 2 CV_64F [cx, cy]
+ * - <prefix>_moments: N x 4 CV_64F [mu20, mu02, mu11, angle_deg]
+ * - <prefix>_detections: N x 6 CV_32F [x, y, w, h, classId = 0, confidence = 1],
+ *   the draw_detections / NMS layout (areas are in _stats)
+ * 
+ * Returns the number of blobs kept.
+ */
+class BlobAnalyzeItem : public InterpreterItem {
+public:
+    BlobAnalyzeItem();
+    ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+};
+
 // ============================================================================
 // Distance Transform
 // ============================================================================
@@ -8,7 +8,8 @@
  * Provides:
  *   shm_create(name, width, height, channels)  – allocate a named shm region
  *   shm_write(name)                            – publish currentMat to shm
- *   shm_read(name)                             – fetch latest frame from shm
+ *   shm_read(name, zero_copy)                  – fetch latest frame from shm
+ *   shm_validate(name)                         – check a zero-copy read is intact
  */
 
 #include "interpreter/item_registry.h"
@@ -42,6 +43,15 @@ public:
                             ExecutionContext& ctx) override;
 };
 
+// ── shm_validate ────────────────────────────────────────────────────────────
+
+class ShmValidateItem : public InterpreterItem {
+public:
+    ShmValidateItem();
+    ExecutionResult execute(const std::vector<RuntimeValue>& args,
+                            ExecutionContext& ctx) override;
+};
+
 // ── Registration ────────────────────────────────────────────────────────────
 
 void registerShmItems(ItemRegistry& registry);
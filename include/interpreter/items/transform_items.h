@@ -2,7 +2,10 @@
 #define VISIONPIPE_TRANSFORM_ITEMS_H
 
 #include "interpreter/item_registry.h"
+#include "utils/fisheye_views.h"
+#include "utils/keyed_registry.h"
 #include <opencv2/opencv.hpp>
+#include <memory>
 
 namespace visionpipe {
 
@@ -26,6 +29,8 @@ class ResizeItem : public InterpreterItem {
 public:
     ResizeItem();
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+    std::optional<FrameShape> inferOutputShape(const std::vector<RuntimeValue>& args,
+                                               const FrameShape& input) const override;
 };
 
 /**
@@ -54,6 +59,8 @@ class Rotate90Item : public InterpreterItem {
 public:
     Rotate90Item();
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+    std::optional<FrameShape> inferOutputShape(const std::vector<RuntimeValue>& args,
+                                               const FrameShape& input) const override;
 };
 
 /**
@@ -66,6 +73,8 @@ class FlipItem : public InterpreterItem {
 public:
     FlipItem();
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+    std::optional<FrameShape> inferOutputShape(const std::vector<RuntimeValue>& args,
+                                               const FrameShape& input) const override;
 };
 
 /**
@@ -217,6 +226,28 @@ public:
     ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
 };
 
+/// Fisheye view sets keyed by cache_id.
+using FisheyeViewsRegistry = KeyedRegistry<FisheyeViewSet>;
+
+/**
+ * @brief Dewarps a fisheye frame into several virtual views in one pass
+ *
+ * Parameters:
+ * - views: View list, e.g. "ptz:0,30,60,640x480; equirect:1440x360"
+ * - model: Lens model: equidistant, equisolid, fisheye (cv::fisheye calibration)
+ * - fov: Field of view of the image circle in degrees
+ * - cache_id: View i is cached as <cache_id>_<i>; also keys the maps
+ * - mount: wall or ceiling (pan/tilt convention)
+ * - center_x, center_y, radius: Image circle (default: centered, inscribed)
+ * - camera_matrix, dist_coeffs: Cache IDs of K and D for the fisheye model
+ * - interpolation: nearest, linear, cubic, lanczos
+ */
+class FisheyeViewsItem : public InterpreterItem {
+public:
+    FisheyeViewsItem();
+    ExecutionResult execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) override;
+};
+
 // ============================================================================
 // Image Pyramids
 // ============================================================================
@@ -0,0 +1,60 @@
+#ifndef VISIONPIPE_MEMORY_PLANNER_H
+#define VISIONPIPE_MEMORY_PLANNER_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "interpreter/item_registry.h"
+
+namespace visionpipe {
+
+struct PipelineDecl;
+class FrameArena;
+
+/**
+ * @brief Static placement of a pipeline's intermediate frames
+ *
+ * Built once per pipeline and input shape.  Every statement whose output
+ * shape can be inferred ahead of time (see InterpreterItem::inferOutputShape)
+ * and whose frame is consumed within the pipeline gets a buffer; buffers
+ * with disjoint lifetimes share bytes of one arena.
+ */
+struct MemoryPlan {
+    struct Buffer {
+        size_t statement = 0;      ///< Index in the pipeline body of the producer
+        std::string item;          ///< Producing item
+        FrameShape shape;
+        size_t firstUse = 0;       ///< Producer statement
+        size_t lastUse = 0;        ///< Last statement reading the frame
+        size_t offset = 0;         ///< Byte offset in the arena
+    };
+
+    std::string pipeline;
+    FrameShape input;
+    std::vector<Buffer> buffers;
+    std::vector<int> slotOf;       ///< Per body statement: buffer index, or -1
+    size_t inferred = 0;           ///< Statements with a statically known output shape
+    size_t arenaBytes = 0;         ///< Bytes with liveness-based reuse
+    size_t naiveBytes = 0;         ///< Bytes with one buffer per frame
+    std::shared_ptr<FrameArena> arena;
+
+    /// Human-readable summary (arena size, reuse, per-buffer placement).
+    std::string report() const;
+};
+
+/**
+ * @brief Plan the intermediate frames of @p pipeline for frames of @p input
+ *
+ * Only plain item calls with literal arguments are planned; pipeline
+ * calls, control flow and anything else end the shape chain.  Outputs that
+ * are cached or that leave the pipeline are not planned.  Returns a plan
+ * without an arena when nothing could be placed.
+ */
+std::shared_ptr<MemoryPlan> planPipelineMemory(
+    const PipelineDecl& pipeline, const FrameShape& input, const ItemRegistry& registry,
+    const std::unordered_map<std::string, std::shared_ptr<PipelineDecl>>& pipelines);
+
+} // namespace visionpipe
+
+#endif // VISIONPIPE_MEMORY_PLANNER_H
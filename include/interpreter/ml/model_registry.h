@@ -6,6 +6,7 @@
 #include <memory>
 #include <unordered_map>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 namespace visionpipe {
@@ -29,6 +30,79 @@ struct ModelInfo {
     }
 };
 
+/**
+ * @brief When a cascade stage hands the frame on to the next stage
+ * 
+ * The stage escalates if any configured rule matches its output.  A gate
+ * without rules always escalates.  Scores are compared as the model
+ * emits them (probabilities for softmax heads, logits otherwise).
+ */
+struct CascadeGate {
+    bool useScoreBand = false;
+    float scoreLow = 0.0f;             ///< Escalate when the top score is in [scoreLow, scoreHigh)
+    float scoreHigh = 1.0f;
+    std::vector<int> classes;          ///< Escalate when the top class / any box class is listed
+    int minBoxes = -1;                 ///< Escalate when the box count is in [minBoxes, maxBoxes]
+    int maxBoxes = -1;                 ///< -1 = unbounded
+    
+    /**
+     * @brief Parse "score:0.3,0.7; classes:0,2; boxes:1,5" (any subset, ';'-separated)
+     * @return false with @p error set on malformed input
+     */
+    static bool parse(const std::string& spec, CascadeGate& gate, std::string& error);
+    
+    bool hasBoxRule() const { return minBoxes >= 0 || maxBoxes >= 0; }
+    bool empty() const { return !useScoreBand && classes.empty() && !hasBoxRule(); }
+};
+
+/**
+ * @brief One model in a cascade
+ */
+struct CascadeStage {
+    std::string modelId;
+    std::string task = "classify";     ///< How the output is read for gating: classify, detect
+    std::string yoloVersion = "v8";    ///< detect: output format (see Postprocessing::decodeYolo)
+    float confThreshold = 0.25f;       ///< detect: box confidence threshold
+    CascadeGate gate;                  ///< Escalation to the next stage; unused on the last stage
+};
+
+/**
+ * @brief Cheap-to-expensive model chain served under one model id
+ * 
+ * Stages run in order; a stage whose gate does not fire ends the cascade
+ * and its result is returned as the cascade's result, so consumers see the
+ * same output format as when running that model directly.
+ * 
+ * With roi set and a detect stage before the last one, the last stage runs
+ * on each gated box (crop of the input) instead of the whole frame.  This
+ * changes the result format: it holds one primary output per box, named
+ * "roi_<i>" (so the primary output is the first box's), followed by a
+ * "rois" [N x 4] CV_32F matrix of x, y, w, h.  When the gate fires but no
+ * box passes it, the detect stage's result is returned instead.
+ */
+struct CascadeConfig {
+    std::vector<CascadeStage> stages;
+    bool roi = false;
+    int roiPadding = 0;                ///< Pixels added around each ROI
+};
+
+struct CascadeStats {
+    struct Stage {
+        std::string modelId;
+        size_t runs = 0;               ///< Frames (or ROIs) this stage ran on
+        size_t escalations = 0;        ///< Runs whose gate fired
+        double totalTimeMs = 0.0;
+        
+        double hitRate() const { return runs > 0 ? static_cast<double>(escalations) / runs : 0.0; }
+        double averageTimeMs() const { return runs > 0 ? totalTimeMs / runs : 0.0; }
+    };
+    std::vector<Stage> stages;
+    size_t frames = 0;
+    double totalTimeMs = 0.0;
+    
+    double averageTimeMs() const { return frames > 0 ? totalTimeMs / frames : 0.0; }
+};
+
 /**
  * @brief Central registry for managing ML models
  * 
@@ -72,6 +146,12 @@ public:
      */
     bool hasModel(const std::string& id) const;
     
+    /**
+     * @brief Check if @p id names a loaded model or a defined cascade,
+     *        i.e. anything runInference() accepts
+     */
+    bool exists(const std::string& id) const;
+    
     /**
      * @brief Get information about a loaded model
      * @param id Model identifier
@@ -95,13 +175,39 @@ public:
     void clear();
     
     /**
-     * @brief Run inference on a model
-     * @param id Model identifier
+     * @brief Run inference on a model or cascade
+     * @param id Model or cascade identifier
      * @param input Input image
      * @return Inference result
      */
     InferenceResult runInference(const std::string& id, const cv::Mat& input);
     
+    /**
+     * @brief Register a cascade of loaded models under a new id
+     * 
+     * The id is then accepted by runInference() like a model id.  Redefining
+     * an existing cascade replaces it and resets its statistics.
+     * 
+     * @return false with @p error set if a stage model is missing or the
+     *         configuration is inconsistent
+     */
+    bool defineCascade(const std::string& id, const CascadeConfig& config, std::string& error);
+    
+    /**
+     * @brief Check if a cascade is defined
+     */
+    bool hasCascade(const std::string& id) const;
+    
+    /**
+     * @brief Per-stage hit rates and costs of a cascade
+     */
+    std::optional<CascadeStats> getCascadeStats(const std::string& id) const;
+    
+    /**
+     * @brief List all cascade IDs
+     */
+    std::vector<std::string> listCascades() const;
+    
     /**
      * @brief Register a custom model factory
      * @param backend Backend name
@@ -138,11 +244,18 @@ private:
     ModelRegistry& operator=(const ModelRegistry&) = delete;
     
     std::shared_ptr<MLModel> createModel(const std::string& backend);
+    InferenceResult runCascade(const std::string& id, const CascadeConfig& config, const cv::Mat& input);
+    
+    struct Cascade {
+        CascadeConfig config;
+        CascadeStats stats;
+    };
     
     mutable std::mutex _mutex;
     std::unordered_map<std::string, std::shared_ptr<MLModel>> _models;
     std::unordered_map<std::string, ModelInfo> _modelInfo;
     std::unordered_map<std::string, ModelFactory> _backends;
+    std::unordered_map<std::string, Cascade> _cascades;
     
     static bool s_verbose;
 };
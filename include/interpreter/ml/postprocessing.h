@@ -84,6 +84,40 @@ public:
                                                 cv::Size inputSize,
                                                 float confThreshold);
     
+    /**
+     * @brief Decode YOLOv8/v11 instance segmentation output
+     *
+     * NMS runs first; only surviving instances get a mask, computed as
+     * coefficients x prototypes inside the instance's box at prototype
+     * resolution, then upsampled (that crop only) in parallel across
+     * instances.  No full-frame per-instance mask tensor is built.
+     *
+     * @param output Detection head [1, 4 + classes + maskDim, anchors] (either orientation)
+     * @param protos Mask prototypes [1, maskDim, maskH, maskW]
+     * @param maskThreshold Probability above which a pixel belongs to the instance
+     * @return Detections; Detection::mask is CV_8UC1 the size of Detection::box (255 = inside)
+     */
+    static std::vector<Detection> decodeYoloSeg(const cv::Mat& output,
+                                                 const cv::Mat& protos,
+                                                 cv::Size imageSize,
+                                                 cv::Size inputSize,
+                                                 float confThreshold,
+                                                 float nmsThreshold = 0.45f,
+                                                 float maskThreshold = 0.5f);
+    
+    /**
+     * @brief Decode YOLOv8/v11 pose output
+     * @param output Detection head [1, 4 + classes + keypoints * 3, anchors] (either orientation)
+     * @param numClasses Number of class scores before the keypoints (1 for COCO pose)
+     * @return Detections with keypoints and keypointConfidences in image coordinates
+     */
+    static std::vector<Detection> decodeYoloPose(const cv::Mat& output,
+                                                  cv::Size imageSize,
+                                                  cv::Size inputSize,
+                                                  float confThreshold,
+                                                  float nmsThreshold = 0.45f,
+                                                  int numClasses = 1);
+    
     /**
      * @brief Apply softmax to tensor
      */
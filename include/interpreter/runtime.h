@@ -137,6 +137,15 @@ public:
      * @brief Load a .vsp file without executing
      */
     void load(const std::string& filename);
+
+    /**
+     * @brief Load a .vsp file's pipelines, globals and params without
+     *        running its top-level exec statements
+     *
+     * Used when the caller drives pipelines itself (e.g. `visionpipe batch`).
+     * No param server is started.
+     */
+    void loadDefinitions(const std::string& filename);
     
     /**
      * @brief Execute a specific pipeline
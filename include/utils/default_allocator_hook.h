@@ -0,0 +1,60 @@
+#pragma once
+
+/**
+ * @file default_allocator_hook.h
+ * @brief Install a wrapping cv::MatAllocator only while something needs it.
+ *
+ * Output placement (ShmOutputScope, FrameArenaScope) works by wrapping
+ * cv::Mat's default allocator.  The wrapper only matters while a scope is
+ * armed, so a DefaultAllocatorHook puts it in front of the current default
+ * when the first user arrives and restores the previous default when the
+ * last one leaves.  Mats keep the allocator that created them, so swapping
+ * the default never strands a live Mat.
+ *
+ * If another wrapper was installed on top in the meantime, the hook cannot
+ * take itself out of the chain; it stays installed as a pass-through and is
+ * reused by the next acquire() instead of being wrapped a second time.
+ */
+
+#include <opencv2/core/mat.hpp>
+#include <atomic>
+#include <mutex>
+
+namespace visionpipe {
+
+class DefaultAllocatorHook {
+public:
+    explicit DefaultAllocatorHook(cv::MatAllocator* self) : _self(self) {}
+
+    /// Make the wrapper the default allocator (first user installs it).
+    void acquire() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_users++ == 0 && !_installed) {
+            _fallback.store(cv::Mat::getDefaultAllocator(), std::memory_order_release);
+            cv::Mat::setDefaultAllocator(_self);
+            _installed = true;
+        }
+    }
+
+    /// Drop a user; the last one restores the previous default if it can.
+    void release() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (--_users > 0) return;
+        if (cv::Mat::getDefaultAllocator() == _self) {
+            cv::Mat::setDefaultAllocator(_fallback.load(std::memory_order_acquire));
+            _installed = false;
+        }
+    }
+
+    /// Allocator the wrapper forwards to (kept valid after release()).
+    cv::MatAllocator* fallback() const { return _fallback.load(std::memory_order_acquire); }
+
+private:
+    cv::MatAllocator* _self;
+    std::atomic<cv::MatAllocator*> _fallback{nullptr};
+    std::mutex _mutex;
+    int  _users = 0;
+    bool _installed = false;
+};
+
+} // namespace visionpipe
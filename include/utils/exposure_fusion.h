@@ -0,0 +1,116 @@
+#pragma once
+
+/**
+ * @file exposure_fusion.h
+ * @brief Streaming Mertens exposure fusion in 16-bit fixed point.
+ *
+ * cv::MergeMertens fuses a full bracket in float at full resolution on every
+ * call.  For cameras that alternate exposures frame by frame, almost all of
+ * that work is repeated: only one exposure changed since the last output.
+ *
+ * ExposureFusion keeps one slot per exposure.  When a frame arrives, only
+ * its slot is updated:
+ *
+ *  - a Laplacian pyramid in CV_16S, Q3 fixed point (pixel << 3), built into
+ *    buffers reused across frames;
+ *  - a raw Mertens weight map (contrast x saturation x well-exposedness)
+ *    computed on the slot's Gaussian level `weightLevel` (1/4 resolution by
+ *    default), which the pyramid build yields for free.
+ *
+ * fuse() then normalises the weights across slots at that reduced
+ * resolution, expands them into Q14 Gaussian pyramids, blends each
+ * Laplacian level with an integer multiply-accumulate and collapses the
+ * result back to 8 bits.  One output is produced per input frame, so the
+ * output runs at the camera rate.
+ */
+
+#include "utils/keyed_registry.h"
+
+#include <opencv2/core.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace visionpipe {
+
+struct ExposureFusionConfig {
+    int    exposures   = 3;     ///< Slots in the bracket
+    int    weightLevel = 2;     ///< Pyramid level the weights are computed at (2 = 1/4 res)
+    double contrast    = 1.0;   ///< Mertens weight exponents
+    double saturation  = 1.0;
+    double exposedness = 1.0;
+
+    /// Copy with out-of-range values clamped; this is what an engine stores.
+    ExposureFusionConfig clamped() const {
+        ExposureFusionConfig c = *this;
+        c.exposures = std::max(1, c.exposures);
+        c.weightLevel = std::max(0, c.weightLevel);
+        return c;
+    }
+
+    /// Compares clamped values, so a request matches the engine built from it.
+    bool operator==(const ExposureFusionConfig& o) const {
+        const ExposureFusionConfig a = clamped(), b = o.clamped();
+        return a.exposures == b.exposures && a.weightLevel == b.weightLevel &&
+               a.contrast == b.contrast && a.saturation == b.saturation &&
+               a.exposedness == b.exposedness;
+    }
+    bool operator!=(const ExposureFusionConfig& o) const { return !(*this == o); }
+};
+
+class ExposureFusion {
+public:
+    explicit ExposureFusion(const ExposureFusionConfig& cfg);
+
+    /**
+     * @brief Store `frame` (8-bit, 1 or 3 channels) as exposure `slot`.
+     *
+     * slot < 0 picks the next slot in round-robin order.  A frame whose
+     * size or type differs from the other slots invalidates them.
+     */
+    void update(const cv::Mat& frame, int slot = -1);
+
+    /// True once every slot holds a frame of the current size.
+    bool ready() const;
+
+    /// Fuse the latest frame of every slot (8-bit, same channels as input).
+    cv::Mat fuse();
+
+    const ExposureFusionConfig& config() const { return _cfg; }
+    uint64_t frameCount() const { return _frames; }
+    int levels() const { return _levels; }
+
+private:
+    struct Slot {
+        std::vector<cv::Mat> lap;   ///< CV_16S Laplacian pyramid, Q3; top level is Gaussian
+        cv::Mat weight;             ///< CV_32F raw weight at _weightLevel
+        bool valid = false;
+    };
+
+    void reset(const cv::Size& size, int type);
+
+    ExposureFusionConfig _cfg;
+    std::vector<Slot> _slots;
+    cv::Size _size;
+    int _type        = -1;
+    int _levels      = 0;
+    int _weightLevel = 0;
+    int _next        = 0;
+    uint64_t _frames = 0;
+
+    // Buffers reused across frames
+    std::vector<cv::Mat> _gauss;                  ///< Gaussian pyramid scratch (Q3)
+    cv::Mat _expanded;                            ///< pyrUp scratch
+    std::vector<std::vector<cv::Mat>> _weights;   ///< Per-slot Q14 weight pyramids
+    std::vector<cv::Mat> _blend;                  ///< Fused Laplacian pyramid
+    cv::Mat _weightSum;
+    mutable std::mutex _mutex;
+};
+
+/// Fusion engines keyed by cache_id, rebuilt when the config changes.
+using ExposureFusionRegistry = KeyedRegistry<ExposureFusion>;
+
+} // namespace visionpipe
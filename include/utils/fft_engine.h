@@ -0,0 +1,138 @@
+#pragma once
+
+/**
+ * @file fft_engine.h
+ * @brief Frequency-domain filtering with cached spectra and reused buffers.
+ *
+ * Chaining `dft -> mul_spectrums -> idft` in a script converts, allocates and
+ * transforms three times per frame, recomputes the (static) filter spectrum
+ * every call and runs cv::dft on whatever size the frame happens to have.
+ * The engine fuses the chain:
+ *
+ *  - every transform is padded to cv::getOptimalDFTSize in both dimensions;
+ *  - filter spectra (convolution kernels, transfer functions, phase
+ *    correlation references) are computed once and cached by id, and rebuilt
+ *    only when their generation changes (different source buffer, size,
+ *    padding or an explicit generation bump);
+ *  - the per-frame forward / multiply / inverse chain runs in per-thread
+ *    workspaces, so a steady-state call allocates nothing but its output.
+ *
+ * Real spectra use OpenCV's packed CCS layout (half the work of a complex
+ * transform).  Only phase correlation, which needs per-bin normalisation,
+ * uses full complex output.
+ *
+ * Typical use:
+ *
+ *   auto& fft = FFTEngine::instance();
+ *   fft.convolve(src, dst, kernel, "psf", cv::Point(-1, -1),
+ *                cv::BORDER_REFLECT_101, -1, false);
+ */
+
+#include <opencv2/core.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace visionpipe {
+
+/// Cached spectrum of a filter, immutable once built.
+struct FrequencyPlan {
+    uint64_t stamp = 0;      ///< Hash of everything the spectrum depends on
+    cv::Size padSize;        ///< Transform size (getOptimalDFTSize per axis)
+    cv::Mat  spectrum;       ///< CCS-packed CV_32F, or CV_32FC2 for phase references
+    cv::Mat  source;         ///< Keeps the source buffer alive so its address
+                             ///< cannot be recycled under the same stamp
+};
+
+/**
+ * @brief Real, zero-phase transfer function applied by FFTEngine::filter().
+ *
+ * Radial frequency is normalised to Nyquist: 0 = DC, 1 = half the sampling
+ * rate along an axis.  `custom` holds a centred (DC in the middle, as after
+ * fft_shift) real response of any size; it is sampled at the transform's
+ * frequencies and must be symmetric for the result to stay real.
+ */
+struct FrequencyResponse {
+    enum class Kind { LOWPASS, HIGHPASS, BANDPASS, BANDSTOP, CUSTOM };
+    enum class Shape { GAUSSIAN, BUTTERWORTH, IDEAL };
+
+    Kind   kind   = Kind::LOWPASS;
+    Shape  shape  = Shape::GAUSSIAN;
+    double cutoff     = 0.1;   ///< Low edge (or the only edge for low/high pass)
+    double cutoffHigh = 0.3;   ///< High edge for band pass / stop
+    int    order      = 2;     ///< Butterworth order
+    cv::Mat     custom;        ///< Response samples for Kind::CUSTOM
+    std::string id;            ///< Spectrum cache slot; give each filter of a pipeline its own
+    int    generation = 0;
+};
+
+/// Result of FFTEngine::phaseCorrelate().
+struct PhaseShift {
+    cv::Point2d shift;         ///< Translation of the frame relative to the reference
+    double response = 0.0;     ///< Peak energy in [0, 1]; low values mean no reliable match
+    bool   valid    = false;   ///< False when no reference was available yet
+};
+
+class FFTEngine {
+public:
+    static FFTEngine& instance();
+
+    /// getOptimalDFTSize applied to both dimensions.
+    static cv::Size optimalSize(const cv::Size& minSize);
+
+    /**
+     * @brief Linear filtering with a cached kernel spectrum.
+     *
+     * Equivalent to cv::filter2D(src, dst, ddepth, kernel, anchor, 0, border)
+     * (correlation); with `convolution` the kernel is flipped first, as in a
+     * true convolution.  Each channel is filtered independently with the same
+     * single-channel kernel.  `kernelId` names the spectrum cache slot.
+     *
+     * @return false if the kernel is empty or has more than one channel.
+     */
+    bool convolve(const cv::Mat& src, cv::Mat& dst, const cv::Mat& kernel,
+                  const std::string& kernelId, cv::Point anchor, int borderType,
+                  int ddepth, bool convolution, int generation = 0);
+
+    /// Multiply the spectrum of each channel by a cached transfer function.
+    void filter(const cv::Mat& src, cv::Mat& dst, const FrequencyResponse& response, int ddepth);
+
+    /**
+     * @brief Global translation between `frame` and a reference.
+     *
+     * With `track` the reference is the previous frame seen under `refId`
+     * and the current frame's spectrum replaces it afterwards, so
+     * frame-to-frame motion costs one forward transform per frame; the first
+     * call returns an invalid result.  Otherwise `reference` is transformed
+     * once and cached until its generation changes.  Colour inputs are
+     * converted to gray; `window` applies a Hann window before transforming.
+     */
+    PhaseShift phaseCorrelate(const cv::Mat& frame, const std::string& refId,
+                              const cv::Mat& reference, bool window, bool track,
+                              int generation = 0);
+
+    /// Drop all cached spectra.
+    void clear();
+
+    struct Stats {
+        uint64_t hits   = 0;
+        uint64_t builds = 0;
+        size_t   plans  = 0;
+    };
+    Stats stats() const;
+
+private:
+    FFTEngine() = default;
+
+    /// Cached plan for `id` if its stamp matches, otherwise build and replace it.
+    template <typename F>
+    std::shared_ptr<const FrequencyPlan> acquire(const std::string& id, uint64_t stamp, F&& build);
+
+    mutable std::mutex _mutex;
+    std::unordered_map<std::string, std::shared_ptr<const FrequencyPlan>> _plans;
+    Stats _stats;
+};
+
+} // namespace visionpipe
@@ -0,0 +1,133 @@
+#pragma once
+
+/**
+ * @file fisheye_views.h
+ * @brief Several dewarped views of one fisheye frame in a single tiled pass.
+ *
+ * A FisheyeViewSet holds, for every virtual view (a PTZ-style perspective
+ * view or an equirectangular overview), a fixed-point remap plan split into
+ * destination tiles.  Each tile stores CV_16SC2 + CV_16UC1 maps relative to
+ * the bounding box of the source pixels it reads, so a tile is remapped
+ * from a small source ROI.
+ *
+ * Maps are built once.  When the view list changes (e.g. a PTZ view is
+ * panned) only the views whose parameters differ are rebuilt; the lens,
+ * source size or interpolation changing rebuilds everything.
+ *
+ * render() processes the tiles of all views together, ordered by the source
+ * region they read, on OpenCV's thread pool.  Neighbouring tiles in that
+ * order -- usually from different views -- read the same source rows, so
+ * each source band is pulled into cache about once per frame instead of
+ * once per view.
+ */
+
+#include <opencv2/core.hpp>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace visionpipe {
+
+struct FisheyeLens {
+    enum class Model { EQUIDISTANT, EQUISOLID, KANNALA_BRANDT };
+    enum class Mount { WALL, CEILING };
+
+    Model model = Model::EQUIDISTANT;
+    Mount mount = Mount::WALL;
+    double fovDeg = 180.0;    ///< Full field of view covered by the image circle
+    cv::Point2d center;       ///< Image circle center (pixels)
+    double radius = 0;        ///< Image circle radius (pixels)
+    cv::Matx33d K;            ///< KANNALA_BRANDT only: cv::fisheye intrinsics
+    cv::Vec4d D;              ///< KANNALA_BRANDT only: k1..k4
+
+    bool operator==(const FisheyeLens& o) const;
+    bool operator!=(const FisheyeLens& o) const { return !(*this == o); }
+};
+
+/**
+ * @brief One virtual view.
+ *
+ * PERSPECTIVE: pinhole camera looking at (pan, tilt) with horizontal field
+ * of view fovDeg (the zoom).  Wall mount: pan is yaw, tilt is pitch (up is
+ * positive), both 0 along the optical axis.  Ceiling mount: pan is the
+ * azimuth around the optical axis, tilt the angle away from it.
+ *
+ * EQUIRECT: longitude x latitude grid.  Wall mount: lonSpanDeg x latSpanDeg
+ * centered on the optical axis.  Ceiling mount: a panorama of lonSpanDeg of
+ * azimuth starting at pan, rows from the rim of the image circle inwards
+ * over latSpanDeg.
+ */
+struct FisheyeView {
+    enum class Kind { PERSPECTIVE, EQUIRECT };
+
+    Kind kind = Kind::PERSPECTIVE;
+    cv::Size size{640, 480};
+    double pan = 0;
+    double tilt = 0;
+    double fovDeg = 60;
+    double lonSpanDeg = 0;    ///< EQUIRECT; 0 = mount default
+    double latSpanDeg = 0;    ///< EQUIRECT; 0 = mount default
+
+    bool operator==(const FisheyeView& o) const;
+    bool operator!=(const FisheyeView& o) const { return !(*this == o); }
+};
+
+/**
+ * @brief Parse a view list such as
+ *        "ptz:0,30,60,640x480; ptz:90,30,45,640x480; equirect:1440x360"
+ *
+ * ptz:pan,tilt,fov,WxH    perspective view (degrees)
+ * equirect:WxH[,lon[,lat[,pan]]]
+ *
+ * @return false with @p error set on malformed input
+ */
+bool parseFisheyeViews(const std::string& spec, std::vector<FisheyeView>& views, std::string& error);
+
+class FisheyeViewSet {
+public:
+    struct Stats {
+        size_t views = 0;
+        size_t tiles = 0;
+        size_t rebuilt = 0;      ///< Views rebuilt by the last configure()
+        size_t mapBytes = 0;
+    };
+
+    /**
+     * @brief Bring the plans up to date; only changed views are rebuilt.
+     * @return Number of views rebuilt
+     */
+    size_t configure(const FisheyeLens& lens, const cv::Size& srcSize,
+                     const std::vector<FisheyeView>& views, int interpolation);
+
+    /// Render every view of @p src into @p dst (one Mat per view).
+    void render(const cv::Mat& src, std::vector<cv::Mat>& dst,
+                const cv::Scalar& borderValue = cv::Scalar()) const;
+
+    Stats stats() const;
+    std::mutex& mutex() { return _mutex; }
+
+private:
+    struct Tile {
+        cv::Rect dst;     ///< In the view
+        cv::Rect src;     ///< Source pixels read (empty: tile entirely outside the lens)
+        cv::Mat  map1;    ///< CV_16SC2, relative to src.tl()
+        cv::Mat  map2;    ///< CV_16UC1 (empty for nearest)
+    };
+    struct Plan {
+        FisheyeView view;
+        std::vector<Tile> tiles;
+    };
+
+    void buildPlan(Plan& plan) const;
+    void buildSchedule();
+
+    FisheyeLens _lens;
+    cv::Size _srcSize;
+    int _interpolation = -1;
+    std::vector<Plan> _plans;
+    std::vector<std::pair<int, int>> _schedule;   ///< (plan, tile) in source order
+    size_t _lastRebuilt = 0;
+    std::mutex _mutex;
+};
+
+} // namespace visionpipe
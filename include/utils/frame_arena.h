@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * @file frame_arena.h
+ * @brief Planned placement of intermediate frames in one contiguous buffer.
+ *
+ * The memory planner gives every intermediate frame of a pipeline a slot
+ * (offset + shape) in a FrameArena; slots whose lifetimes do not overlap
+ * share bytes.  A FrameArenaScope around the statement producing a frame
+ * serves its output allocation from the slot, so steady-state frames do not
+ * touch the heap for intermediates.
+ *
+ * The plan is only a hint.  A slot is used while no Mat placed in it, or in
+ * a slot sharing its bytes, is still alive (e.g. one that was cached or
+ * escaped the pipeline); otherwise the allocation falls back to the heap,
+ * exactly as it would without a plan.
+ */
+
+#include <opencv2/core.hpp>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace visionpipe {
+
+class FrameArena {
+public:
+    struct Slot {
+        size_t offset = 0;
+        int    rows   = 0;
+        int    cols   = 0;
+        int    type   = -1;
+
+        size_t bytes() const { return static_cast<size_t>(rows) * cols * CV_ELEM_SIZE(type); }
+    };
+
+    /// Allocates @p bytes once; every slot must lie inside it.
+    FrameArena(std::vector<Slot> slots, size_t bytes);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    size_t bytes() const { return _bytes; }
+    const std::vector<Slot>& slots() const { return _slots; }
+
+    /// True if no Mat lives in @p slot or in a slot overlapping it.
+    bool available(size_t slot) const;
+
+    uint8_t* slotData(size_t slot) const { return _data + _slots[slot].offset; }
+    void retain(size_t slot)  { _live[slot].fetch_add(1, std::memory_order_relaxed); }
+    /// Releases pair with the acquire in available(): a slot is only reused
+    /// after the last Mat's accesses to it have happened.
+    void release(size_t slot) { _live[slot].fetch_sub(1, std::memory_order_release); }
+
+    /// Allocations served from a slot / scopes that fell back to the heap.
+    uint64_t placements() const { return _placements.load(std::memory_order_relaxed); }
+    uint64_t fallbacks() const  { return _fallbacks.load(std::memory_order_relaxed); }
+    void countPlacement() { _placements.fetch_add(1, std::memory_order_relaxed); }
+    void countFallback()  { _fallbacks.fetch_add(1, std::memory_order_relaxed); }
+
+private:
+    std::vector<Slot> _slots;
+    std::vector<std::vector<size_t>> _overlaps;    ///< Per slot: other slots sharing bytes
+    std::unique_ptr<std::atomic<int>[]> _live;     ///< Per slot: Mats placed and still alive
+    size_t   _bytes = 0;
+    uint8_t* _data  = nullptr;
+    std::atomic<uint64_t> _placements{0};
+    std::atomic<uint64_t> _fallbacks{0};
+};
+
+/**
+ * @brief Serve the next matching cv::Mat allocation from an arena slot.
+ *
+ * While the scope is alive, the first allocation on the calling thread
+ * whose size and type match the slot is placed in it; other allocations
+ * and other threads are unaffected.  The scope does not arm when another
+ * placement scope is active on this thread or the slot is still occupied.
+ * Placed Mats keep the arena alive.
+ */
+class FrameArenaScope {
+public:
+    FrameArenaScope(const std::shared_ptr<FrameArena>& arena, size_t slot);
+    ~FrameArenaScope();
+
+    FrameArenaScope(const FrameArenaScope&) = delete;
+    FrameArenaScope& operator=(const FrameArenaScope&) = delete;
+
+    bool armed() const { return _armed; }
+
+private:
+    bool _armed = false;
+};
+
+} // namespace visionpipe
@@ -0,0 +1,117 @@
+#pragma once
+
+/**
+ * @file hough_engine.h
+ * @brief Standard Hough line transform with orientation-gated voting.
+ *
+ * cv::HoughLines allocates a fresh accumulator per call and lets every edge
+ * pixel vote in every angle bin.  HoughEngine keeps its accumulators and
+ * trig tables across frames, and when the edge map came from canny (which
+ * publishes its Sobel derivatives to GradientStore) and angleWindow is set,
+ * each edge pixel only votes within +/- angleWindow of its gradient
+ * orientation; a line's own pixels all vote for it, so peaks survive while
+ * clutter votes vanish.  Gating is off by default, matching cv::HoughLines.
+ *
+ * Voting is split over OpenCV's thread pool with one accumulator per chunk
+ * of edge points, merged before peak extraction.  An ROI and an angle range
+ * restrict the search, e.g. for trackers refining last frame's line.
+ */
+
+#include "utils/keyed_registry.h"
+
+#include <opencv2/core.hpp>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace visionpipe {
+
+/**
+ * @brief Recent edge maps and the Sobel derivatives they were built from.
+ *
+ * canny publishes (edges, dx, dy); consumers of the edge map look the
+ * derivatives up by the edge Mat's identity instead of recomputing them
+ * from the binary map, which has no useful orientation.
+ */
+class GradientStore {
+public:
+    static GradientStore& instance();
+
+    void publish(const cv::Mat& edges, const cv::Mat& dx, const cv::Mat& dy);
+
+    /// True and fills @p dx / @p dy (CV_16S) if @p edges was published.
+    bool lookup(const cv::Mat& edges, cv::Mat& dx, cv::Mat& dy);
+
+private:
+    GradientStore() = default;
+
+    struct Entry {
+        cv::Mat edges;   ///< Held so the address stays unique while cached
+        cv::Mat dx;
+        cv::Mat dy;
+    };
+
+    static constexpr size_t kCapacity = 4;
+
+    std::mutex _mutex;
+    std::deque<Entry> _entries;
+};
+
+struct HoughLineConfig {
+    double rho         = 1.0;              ///< Distance resolution (px)
+    double thetaStep   = CV_PI / 180.0;    ///< Angle resolution (rad)
+    double minTheta    = 0.0;              ///< Searched angle range (rad), within [0, pi]
+    double maxTheta    = CV_PI;
+    double angleWindow = 0.0;              ///< Vote half-width around the gradient (0 = all angles)
+
+    bool operator==(const HoughLineConfig& o) const {
+        return rho == o.rho && thetaStep == o.thetaStep && minTheta == o.minTheta &&
+               maxTheta == o.maxTheta && angleWindow == o.angleWindow;
+    }
+    bool operator!=(const HoughLineConfig& o) const { return !(*this == o); }
+};
+
+struct HoughLine {
+    float rho;     ///< In full-frame coordinates
+    float theta;
+    int   votes;
+};
+
+class HoughEngine {
+public:
+    /**
+     * @brief Detect lines in the non-zero pixels of @p edges inside @p roi.
+     *
+     * @param dx, dy    Optional CV_16S derivatives matching @p edges; empty
+     *                  disables orientation gating
+     * @param maxLines  Keep the strongest N (0 = all)
+     */
+    std::vector<HoughLine> detectLines(const cv::Mat& edges, const cv::Mat& dx, const cv::Mat& dy,
+                                       const HoughLineConfig& cfg, cv::Rect roi,
+                                       int threshold, int maxLines = 0);
+
+private:
+    void prepare(const HoughLineConfig& cfg, const cv::Size& size);
+
+    std::mutex _mutex;
+    HoughLineConfig _cfg;
+    cv::Size _size;
+    bool _prepared = false;
+    int _numAngle = 0;
+    int _numRho   = 0;
+    std::vector<float> _cos;             ///< cos(theta_n) / rho
+    std::vector<float> _sin;             ///< sin(theta_n) / rho
+
+    // Reused across frames
+    std::vector<cv::Point> _points;
+    std::vector<float> _orientation;     ///< Gradient angle per point (rad, [0, pi))
+    std::vector<cv::Mat> _partials;      ///< Per-chunk CV_32S accumulators, padded by 1
+    cv::Mat _acc;
+};
+
+/// Hough engines keyed by cache_id.
+using HoughEngineRegistry = KeyedRegistry<HoughEngine>;
+
+} // namespace visionpipe
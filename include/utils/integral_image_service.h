@@ -0,0 +1,146 @@
+#pragma once
+
+/**
+ * @file integral_image_service.h
+ * @brief Shared integral images (summed-area tables) per frame.
+ *
+ * box_filter, blur and adaptive_threshold("mean") each run their own
+ * windowed-sum pass.  When several of them read the same frame (branches,
+ * cache loads, parallel pipelines), the sums are recomputed every time.
+ *
+ * IntegralImageService keeps a few recent frames' integral images:
+ *
+ *  - sum and squared-sum planes are built once per frame, strip-parallel on
+ *    OpenCV's thread pool (cv::integral per strip plus a carry pass); the
+ *    tilted plane is built on request;
+ *  - the frame is border-padded before integration, so dense box filters
+ *    computed from the tables match cv::boxFilter at the image edges for
+ *    the same border mode;
+ *  - any window mean/variance is then an O(1) query.
+ *
+ * Frames are identified by data pointer, geometry and the interpreter's
+ * frame generation (ExecutionContext::frameGeneration, fresh for every
+ * frame), so a buffer refilled in place by a capture device or shared
+ * memory on the next frame never returns the previous frame's sums.  The
+ * service holds a reference to each frame so its buffer cannot be recycled
+ * under the same address within a frame.  Generation 0 means "unknown":
+ * such frames are never shared.
+ *
+ * Lookups take a shared lock; only publishing a new entry is exclusive.
+ * Entries are immutable once published and shared via shared_ptr.
+ */
+
+#include <opencv2/core.hpp>
+#include <cstdint>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+namespace visionpipe {
+
+class IntegralImage {
+public:
+    enum Planes : int {
+        SUM    = 1,
+        SQSUM  = 2,
+        TILTED = 4
+    };
+
+    /// Sum of channel @p ch over @p window (frame coordinates, clipped to the frame).
+    double windowSum(const cv::Rect& window, int ch = 0) const;
+    double windowSqSum(const cv::Rect& window, int ch = 0) const;
+    double windowMean(const cv::Rect& window, int ch = 0) const;
+    double windowVariance(const cv::Rect& window, int ch = 0) const;
+
+    /**
+     * @brief Dense box filter equivalent to cv::boxFilter with this entry's border.
+     *
+     * Requires margin() to cover the kernel (see IntegralImageService::acquire).
+     * @param ddepth Output depth (-1 = source depth)
+     */
+    void boxFilter(cv::Mat& dst, const cv::Size& ksize, cv::Point anchor,
+                   bool normalize, int ddepth) const;
+
+    int margin() const { return _margin; }
+    int border() const { return _border; }
+    int planes() const { return _planes; }
+    const cv::Mat& sum() const { return _sum; }
+    const cv::Mat& sqsum() const { return _sqsum; }
+    const cv::Mat& tilted() const { return _tilted; }
+
+private:
+    friend class IntegralImageService;
+
+    double planeSum(const cv::Mat& plane, const cv::Rect& window, int ch) const;
+
+    cv::Mat  _source;       ///< Held so the frame's address stays unique
+    int      _border = 0;
+    int      _margin = 0;
+    int      _planes = 0;
+    cv::Mat  _sum;          ///< (rows + 2m + 1) x (cols + 2m + 1), CV_32S or CV_64F
+    cv::Mat  _sqsum;        ///< Same geometry, CV_64F
+    cv::Mat  _tilted;
+};
+
+class IntegralImageService {
+public:
+    static IntegralImageService& instance();
+
+    /**
+     * @brief Integral images of @p frame covering at least @p planes and a
+     *        padding of @p margin pixels in @p border mode.
+     *
+     * Reuses a cached entry for the same frame and @p generation when it is
+     * sufficient; otherwise builds (and caches, unless @p generation is 0)
+     * a new one.
+     */
+    std::shared_ptr<const IntegralImage> acquire(const cv::Mat& frame, uint64_t generation,
+                                                 int planes, int margin = 0,
+                                                 int border = cv::BORDER_REFLECT_101);
+
+    /**
+     * @brief Register a box-statistics consumer of @p frame.
+     *
+     * Returns true when it should be served from integral images: an entry
+     * for the frame already exists, or another consumer already read it.
+     * A lone consumer is cheaper on its direct (running-sum) path.
+     */
+    bool shouldRoute(const cv::Mat& frame, uint64_t generation, int border);
+
+    /// Padding needed for a kernel of @p ksize anchored at @p anchor.
+    static int marginFor(const cv::Size& ksize, cv::Point anchor);
+
+    void clear();
+
+private:
+    IntegralImageService() = default;
+
+    struct Slot {
+        const uchar* data = nullptr;
+        cv::Size size;
+        int type = -1;
+        size_t step = 0;
+        uint64_t generation = 0;
+        int border = 0;
+        std::atomic<int> consumers{0};
+        std::atomic<uint64_t> lastUse{0};
+        cv::Mat source;
+        std::shared_ptr<const IntegralImage> image;   ///< Written under the exclusive lock
+    };
+
+    /// Slot for the frame, or nullptr; caller holds the lock (either mode).
+    Slot* find(const cv::Mat& frame, uint64_t generation, int border);
+    /// Slot for the frame, created (evicting the least recently used) if needed;
+    /// caller holds the exclusive lock.
+    Slot& insert(const cv::Mat& frame, uint64_t generation, int border);
+
+    static constexpr size_t kCapacity = 4;
+
+    std::shared_mutex _mutex;
+    std::list<Slot> _slots;
+    std::atomic<uint64_t> _clock{0};
+};
+
+} // namespace visionpipe
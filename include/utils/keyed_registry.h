@@ -0,0 +1,137 @@
+#pragma once
+
+/**
+ * @file keyed_registry.h
+ * @brief Process-wide map from cache_id to persistent per-item state.
+ *
+ * Stateful items (background models, flow, template banks, Hough engines,
+ * exposure fusion, fisheye view sets) keep their state between frames under
+ * the script's cache_id.  KeyedRegistry<T> is the one implementation of
+ * that map: a singleton per T, guarded by a mutex, handing out shared_ptrs
+ * so an entry removed or rebuilt while another thread uses it stays alive
+ * until that thread is done.
+ *
+ * Several streams can run the same script in one process (batch workers).
+ * A StateNamespace on the calling thread prefixes every id, so each stream
+ * gets its own state under the same cache_ids; StateNamespace::drop()
+ * releases a finished stream's entries in every registry at once.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace visionpipe {
+
+class StateNamespace {
+public:
+    /// Prefix ids looked up from this thread with @p prefix until destroyed.
+    explicit StateNamespace(std::string prefix) : _previous(std::move(current())) {
+        current() = std::move(prefix);
+    }
+    ~StateNamespace() { current() = std::move(_previous); }
+
+    StateNamespace(const StateNamespace&) = delete;
+    StateNamespace& operator=(const StateNamespace&) = delete;
+
+    /// This thread's prefix ("" outside any namespace).
+    static std::string& current() {
+        thread_local std::string prefix;
+        return prefix;
+    }
+
+    /// Remove every registry entry whose (prefixed) id starts with @p prefix.
+    static void drop(const std::string& prefix) {
+        std::lock_guard<std::mutex> lock(droppersMutex());
+        for (const auto& d : droppers()) d(prefix);
+    }
+
+    /// Called once by each KeyedRegistry<T> singleton.
+    static void addDropper(std::function<void(const std::string&)> d) {
+        std::lock_guard<std::mutex> lock(droppersMutex());
+        droppers().push_back(std::move(d));
+    }
+
+private:
+    static std::mutex& droppersMutex() {
+        static std::mutex m;
+        return m;
+    }
+    static std::vector<std::function<void(const std::string&)>>& droppers() {
+        static std::vector<std::function<void(const std::string&)>> d;
+        return d;
+    }
+
+    std::string _previous;
+};
+
+template <typename T>
+class KeyedRegistry {
+public:
+    static KeyedRegistry& instance() {
+        static KeyedRegistry inst;
+        return inst;
+    }
+
+    /// Entry for @p id, created on first use (from the id when T takes one).
+    std::shared_ptr<T> acquire(const std::string& id) {
+        const std::string key = StateNamespace::current() + id;
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& entry = _entries[key];
+        if (!entry) {
+            if constexpr (std::is_constructible_v<T, const std::string&>) {
+                entry = std::make_shared<T>(id);
+            } else {
+                entry = std::make_shared<T>();
+            }
+        }
+        return entry;
+    }
+
+    /// Entry for @p id built from @p cfg; rebuilt (state discarded) when its config() differs.
+    template <typename Config>
+    std::shared_ptr<T> acquire(const std::string& id, const Config& cfg) {
+        const std::string key = StateNamespace::current() + id;
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& entry = _entries[key];
+        if (!entry || !(entry->config() == cfg)) {
+            entry = std::make_shared<T>(cfg);
+        }
+        return entry;
+    }
+
+    /// Entry for @p id, or nullptr if none was created yet.
+    std::shared_ptr<T> find(const std::string& id) {
+        const std::string key = StateNamespace::current() + id;
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _entries.find(key);
+        return it != _entries.end() ? it->second : nullptr;
+    }
+
+    void remove(const std::string& id) {
+        const std::string key = StateNamespace::current() + id;
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.erase(key);
+    }
+
+private:
+    KeyedRegistry() {
+        StateNamespace::addDropper([this](const std::string& prefix) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto it = _entries.begin(); it != _entries.end();) {
+                if (it->first.compare(0, prefix.size(), prefix) == 0) it = _entries.erase(it);
+                else ++it;
+            }
+        });
+    }
+
+    std::mutex _mutex;
+    std::unordered_map<std::string, std::shared_ptr<T>> _entries;
+};
+
+} // namespace visionpipe
@@ -0,0 +1,110 @@
+#pragma once
+
+/**
+ * @file mjpeg_decoder.h
+ * @brief JPEG decoding for MJPEG capture, inline or on a worker pool.
+ *
+ * decodeMjpeg() is the single decode path: it supports libjpeg's
+ * DCT-domain reduced decoding (1/2, 1/4, 1/8 -- the IDCT produces the
+ * smaller image directly instead of decoding full size and resizing) and a
+ * gray-only mode that decodes the luma component and skips chroma upsampling
+ * and color conversion entirely.
+ *
+ * MjpegDecoderPool runs that path on N threads.  Compressed buffers are
+ * tagged with a sequence number on submit() and next() hands frames back in
+ * submission order, so a capture loop can keep pulling buffers from the
+ * driver while earlier frames are still being decoded.  The pool knows
+ * nothing about V4L2: feeding it a recorded JPEG sequence exercises exactly
+ * the code path used for live capture.
+ */
+
+#include <opencv2/core.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace visionpipe {
+
+struct MjpegDecodeOptions {
+    int  scale = 1;      ///< Output reduction: 1, 2, 4 or 8 (others round down to one of these)
+    bool gray  = false;  ///< Decode luma only -> CV_8UC1
+};
+
+/// Normalize @p scale to one supported by the JPEG IDCT (1, 2, 4, 8).
+int mjpegDecodeScale(int scale);
+
+/// Decode one JPEG buffer.  Returns an empty Mat on corrupt input.
+cv::Mat decodeMjpeg(const uint8_t* data, size_t size, const MjpegDecodeOptions& opts);
+
+class MjpegDecoderPool {
+public:
+    /**
+     * @param threads  Decoder threads (at least 1)
+     * @param opts     Applied to every frame
+     * @param capacity Frames submitted but not yet returned by next() before
+     *                 submit() blocks; 0 = 2 per thread
+     */
+    MjpegDecoderPool(int threads, MjpegDecodeOptions opts, size_t capacity = 0);
+    ~MjpegDecoderPool();
+
+    MjpegDecoderPool(const MjpegDecoderPool&) = delete;
+    MjpegDecoderPool& operator=(const MjpegDecoderPool&) = delete;
+
+    /**
+     * @brief Queue a compressed frame.
+     *
+     * Blocks while the pool is at capacity.  Returns false once close() has
+     * been called; otherwise @p seq (if given) receives the frame's sequence
+     * number.
+     */
+    bool submit(std::vector<uint8_t> jpeg, uint64_t* seq = nullptr);
+
+    /**
+     * @brief Next decoded frame in submission order.
+     *
+     * Returns false on timeout (@p timeoutMs < 0 waits forever) or when the
+     * pool is closed and drained.  A frame that failed to decode is returned
+     * as an empty Mat so the sequence stays intact.
+     */
+    bool next(cv::Mat& frame, int timeoutMs = -1, uint64_t* seq = nullptr);
+
+    /// Stop accepting frames and wake every waiter.  Frames already queued
+    /// are still decoded and can be drained with next().
+    void close();
+
+    const MjpegDecodeOptions& options() const { return _opts; }
+    uint64_t decoded() const { return _decoded.load(std::memory_order_relaxed); }
+    uint64_t failed() const { return _failed.load(std::memory_order_relaxed); }
+
+private:
+    struct Job {
+        uint64_t seq;
+        std::vector<uint8_t> data;
+    };
+
+    void worker();
+
+    MjpegDecodeOptions _opts;
+    size_t _capacity;
+
+    std::mutex _mutex;
+    std::condition_variable _jobReady;     // workers: a job was queued / closed
+    std::condition_variable _frameReady;   // next(): a result landed / closed
+    std::condition_variable _spaceFree;    // submit(): next() consumed a frame / closed
+    std::deque<Job> _jobs;
+    std::map<uint64_t, cv::Mat> _done;     // decoded, waiting for their turn
+    uint64_t _nextSubmit = 0;
+    uint64_t _nextOut = 0;
+    bool _closed = false;
+
+    std::atomic<uint64_t> _decoded{0};
+    std::atomic<uint64_t> _failed{0};
+    std::vector<std::thread> _threads;
+};
+
+} // namespace visionpipe
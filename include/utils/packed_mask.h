@@ -0,0 +1,86 @@
+#pragma once
+
+/**
+ * @file packed_mask.h
+ * @brief Bit-packed 3 x 3 binary morphology.
+ *
+ * Masks travel between items as 8-bit Mats, one byte per binary pixel.
+ * erode / dilate / morphology_ex, when they chain several 3 x 3 passes
+ * (iterations, open / close / gradient / top-hat / black-hat), pack the mask
+ * once at 64 pixels per word, run every pass on bits and unpack the result:
+ *
+ *  - erode / dilate is shifts plus AND / OR of neighbouring words,
+ *    horizontally within a row and vertically across three rows;
+ *  - the compound operations combine passes with andNot().
+ *
+ * Every pass touches an eighth of the memory of the byte mask.  Packing
+ * also verifies that the input is binary (0 and one other value), so the
+ * items fall back to OpenCV for grayscale input.  The results match
+ * cv::erode / cv::dilate / cv::morphologyEx with the default border.
+ */
+
+#include <opencv2/core.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace visionpipe {
+
+class PackedMask {
+public:
+    enum Shape { RECT, CROSS };   ///< 3 x 3 structuring elements
+
+    PackedMask() = default;
+
+    /**
+     * @brief Pack a CV_8UC1 mask; bit x of row y is set where src(y, x) != 0.
+     * @return false (and @p dst undefined) if @p src is not CV_8UC1 or holds
+     *         more than one non-zero value
+     */
+    static bool pack(const cv::Mat& src, PackedMask& dst);
+
+    /// Back to CV_8UC1 with 0 and the packed mask's foreground value.
+    void unpack(cv::Mat& dst) const;
+
+    int rows() const { return _rows; }
+    int cols() const { return _cols; }
+    bool empty() const { return _words.empty(); }
+
+    /// Foreground value restored by unpack() (255 unless packed from another value).
+    uchar onValue() const { return _on; }
+
+    /// this &= ~other (same size), for the compound morphology operations.
+    void andNot(const PackedMask& other);
+
+    /// 3 x 3 erosion, @p iterations times; outside the image counts as foreground (as in cv::erode).
+    void erode(Shape shape, int iterations = 1);
+
+    /// 3 x 3 dilation, @p iterations times; outside the image counts as background.
+    void dilate(Shape shape, int iterations = 1);
+
+private:
+    void morph(Shape shape, bool erodeOp);
+    uint64_t tailMask() const;
+
+    int _rows = 0;
+    int _cols = 0;
+    int _stride = 0;                ///< Words per row
+    uchar _on = 255;
+    std::vector<uint64_t> _words;   ///< Row-major; pixel x is bit (x % 64) of word x / 64; tail bits zero
+};
+
+/**
+ * @brief cv::morphologyEx() on packed bits for 3 x 3 rect / cross kernels
+ *
+ * Only taken when the op makes at least two elementary passes (iterations,
+ * or open / close / gradient / tophat / blackhat): packing and unpacking
+ * cost about one byte pass each, every pass in between an eighth of one.
+ *
+ * @param op          cv::MORPH_* operation
+ * @param morphShape  cv::MORPH_RECT / cv::MORPH_CROSS
+ * @return false (and @p result untouched) for anything else, including
+ *         non-binary input; the caller then runs OpenCV
+ */
+bool packedMorphology(const cv::Mat& input, int op, int ksize, int morphShape,
+                      int iterations, cv::Mat& result);
+
+} // namespace visionpipe
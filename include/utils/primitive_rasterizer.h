@@ -0,0 +1,99 @@
+#pragma once
+
+/**
+ * @file primitive_rasterizer.h
+ * @brief Batch rasterization of lines, arrows, rectangles, circles and points.
+ *
+ * Items that draw thousands of primitives (flow arrows, keypoints) pay
+ * cv::line / cv::circle's per-call setup -- argument checks, clipping,
+ * fixed-point conversion -- once per primitive, on one thread.
+ * PrimitiveBatch collects primitives instead and rasterizes them together:
+ *
+ *  1. every primitive is bounded and clipped against the image once;
+ *  2. it is binned into the 64 x 64 tiles it touches (lines only into tiles
+ *     within reach of the segment, not their whole bounding box);
+ *  3. tiles are rasterized in parallel on OpenCV's thread pool, each tile
+ *     drawing its primitives in submission order, so overlaps resolve
+ *     exactly as sequential drawing would.
+ *
+ * Coverage is evaluated per row span from the primitive's distance field
+ * (segment / ring / disc / box) in branch-free loops that the compiler
+ * vectorizes, then blended into the row with blendCoverageRow().  With
+ * antialiasing the coverage is fractional; without it the result is a
+ * binary, 8-connected shape like cv::LINE_8.
+ *
+ * Output is visually equivalent to OpenCV's drawing functions but not
+ * bit-exact.  Only 8-bit images with 1, 3 or 4 channels are rasterized
+ * here; other types fall back to the OpenCV calls.
+ */
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace visionpipe {
+
+/// x / 255 rounded, exact for x in [0, 255 * 255]; the scalar blend step.
+inline unsigned div255(unsigned x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+/**
+ * @brief dst = dst * (1 - a) + color * a over @p n pixels of @p cn channels.
+ *
+ * @p alpha holds one coverage value (0..255) per pixel.  Vectorized for 1-
+ * and 3-channel rows.  Shared by the rasterizer and the text renderer.
+ */
+void blendCoverageRow(uchar* dst, const uchar* alpha, int n, int cn, const uchar* color);
+
+class PrimitiveBatch {
+public:
+    /// Segment from @p a to @p b.
+    void line(cv::Point2f a, cv::Point2f b, const cv::Scalar& color, int thickness = 1);
+
+    /// Segment with an arrow head at @p b, like cv::arrowedLine.
+    void arrow(cv::Point2f a, cv::Point2f b, const cv::Scalar& color, int thickness = 1,
+               double tipLength = 0.1);
+
+    /// Rectangle outline, or filled when @p thickness < 0.
+    void rect(const cv::Rect2f& r, const cv::Scalar& color, int thickness = 1);
+
+    /// Circle outline, or filled disc when @p thickness < 0.
+    void circle(cv::Point2f center, float radius, const cv::Scalar& color, int thickness = 1);
+
+    /// Square dot of @p size pixels centered on @p p.
+    void point(cv::Point2f p, const cv::Scalar& color, int size = 1);
+
+    size_t size() const { return _prims.size(); }
+    bool empty() const { return _prims.empty(); }
+    void clear() { _prims.clear(); }
+    void reserve(size_t n) { _prims.reserve(n); }
+
+    /**
+     * @brief Rasterize every primitive onto @p img in submission order.
+     * @param lineType cv::LINE_AA for antialiased edges, anything else for binary
+     */
+    void render(cv::Mat& img, int lineType = cv::LINE_8) const;
+
+private:
+    enum Kind : uint8_t { LINE, RING, DISC, BOX };
+
+    struct Prim {
+        Kind  kind;
+        uchar color[4];
+        float x0, y0, x1, y1;   ///< LINE: endpoints; RING / DISC: center, radius; BOX: corners
+        float halfWidth;        ///< LINE / RING stroke half width
+    };
+
+    struct Prepared;   ///< Prim with clipped bounds and per-shape constants
+
+    void push(Kind kind, const cv::Scalar& color, float x0, float y0, float x1, float y1, float halfWidth);
+    void renderFallback(cv::Mat& img, int lineType) const;
+    static void rasterize(cv::Mat& img, const Prepared& s, const cv::Rect& clip, uchar* alpha, bool aa);
+
+    std::vector<Prim> _prims;
+};
+
+} // namespace visionpipe
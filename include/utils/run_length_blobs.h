@@ -0,0 +1,70 @@
+#pragma once
+
+/**
+ * @file run_length_blobs.h
+ * @brief Blob analysis on run-length segments without a label image.
+ *
+ * The script-level chain threshold -> connected_components_with_stats ->
+ * filter makes several full-frame passes and allocates a 32-bit label image
+ * even when the scene is almost empty.  analyzeBlobs() fuses the chain:
+ *
+ *  1. each row is thresholded straight into foreground runs [start, end);
+ *     8-bit rows skip background eight pixels at a time;
+ *  2. runs are labelled with union-find against the runs of the previous
+ *     row, independently per horizontal strip on OpenCV's thread pool;
+ *  3. a serial merge step unites runs across strip boundaries;
+ *  4. area, bounding box, centroid and second-order central moments are
+ *     accumulated per run in closed form, then filtered.
+ *
+ * Work is proportional to the number of runs, not pixels, after the scan,
+ * so sparse scenes are dominated by the (cheap) background skip.
+ */
+
+#include <opencv2/core.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace visionpipe {
+
+struct BlobStats {
+    int64_t     area = 0;
+    cv::Rect    bbox;
+    cv::Point2d centroid;
+    double mu20 = 0.0;   ///< Central second moments normalised by area
+    double mu02 = 0.0;
+    double mu11 = 0.0;
+
+    /// Major-axis orientation in radians, from the central moments.
+    double orientation() const;
+};
+
+/// Constraints applied to every component; zero disables a bound.
+struct BlobFilter {
+    int64_t minArea   = 0;
+    int64_t maxArea   = 0;
+    double  minAspect = 0.0;   ///< bbox width / height
+    double  maxAspect = 0.0;
+    double  minExtent = 0.0;   ///< area / bbox area
+    int     maxBlobs  = 0;     ///< Keep the largest N
+};
+
+struct BlobAnalysisParams {
+    double threshold    = 127.0;   ///< Foreground: value > threshold
+    bool   invert       = false;   ///< Foreground: value <= threshold
+    int    connectivity = 8;       ///< 4 or 8
+    int    strips       = 0;       ///< Parallel strips (0 = thread count)
+    BlobFilter filter;
+};
+
+struct BlobAnalysisResult {
+    std::vector<BlobStats> blobs;   ///< Filtered, largest first
+    size_t runs       = 0;          ///< Foreground runs found
+    size_t components = 0;          ///< Components before filtering
+    int    strips     = 0;
+};
+
+/// Analyse a single-channel image (8U, 16U or 32F; other depths are
+/// converted to 32F, colour input to gray).
+BlobAnalysisResult analyzeBlobs(const cv::Mat& image, const BlobAnalysisParams& params);
+
+} // namespace visionpipe
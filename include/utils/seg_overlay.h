@@ -0,0 +1,61 @@
+#pragma once
+
+/**
+ * @file seg_overlay.h
+ * @brief Semantic segmentation overlay without full-resolution float passes.
+ *
+ * The scripted route (argmax on the logits, resize to the frame, colormap,
+ * add_weighted) touches several float or 3-channel images at frame size.
+ * Here the argmax runs once at model resolution, a row of every class plane
+ * at a time, and produces a uint8 label map.  segOverlay() then upsamples
+ * labels on the fly while it blends palette colors into the frame, so the
+ * only full-resolution pass is the blend itself.
+ *
+ * Upsampling is nearest, or edge-aware: where the four surrounding label
+ * samples disagree, each frame pixel takes the label whose sample's color
+ * (from the frame reduced to label resolution) is closest to its own, so
+ * class borders follow image edges instead of the label grid.
+ */
+
+#include <opencv2/core.hpp>
+#include <vector>
+
+namespace visionpipe {
+
+/// Label of pixels below their class threshold.
+constexpr uchar kSegIgnore = 255;
+
+/**
+ * @brief Per-pixel argmax over the channels of a [1, C, H, W] or [C, H, W] CV_32F tensor.
+ *
+ * @param thresholds Empty, one value for every class, or one per class; a
+ *                   pixel whose best score is below its class' threshold is
+ *                   labelled kSegIgnore
+ * @param labels     CV_8UC1 H x W
+ * @return Number of classes C, or 0 if the tensor is not a supported layout
+ *         (C must be at most 254: label 255 is kSegIgnore)
+ */
+int segArgmax(const cv::Mat& scores, const std::vector<float>& thresholds, cv::Mat& labels);
+
+/// Pascal VOC style palette: distinct BGR colors for @p numClasses labels.
+std::vector<cv::Vec3b> segPalette(int numClasses);
+
+struct SegOverlayOptions {
+    double alpha = 0.5;       ///< Palette weight in the blend
+    bool edgeAware = false;   ///< Guided instead of nearest label upsampling
+    int skipClass = 0;        ///< Label left unblended (usually background), -1 = none
+};
+
+/**
+ * @brief Blend each pixel's palette color into @p img (8-bit, 3 or 4 channels).
+ *
+ * @p labels may be smaller than @p img; it is upsampled inside the blend.
+ * Labels without a palette entry are not drawn.
+ *
+ * @param counts If given, resized to palette.size() and filled with the
+ *               number of @p img pixels per label (skipClass included)
+ */
+void segOverlay(cv::Mat& img, const cv::Mat& labels, const std::vector<cv::Vec3b>& palette,
+                const SegOverlayOptions& opts, std::vector<int>* counts = nullptr);
+
+} // namespace visionpipe
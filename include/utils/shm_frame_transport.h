@@ -43,6 +43,22 @@ inline uint64_t shmFrameGetSeq(const std::string& n) {
     return iox2_transport::iox2FrameGetSeq(n);
 }
 
+/// iceoryx2 loans its own publish buffers; output placement is a no-op here.
+class ShmOutputScope {
+public:
+    explicit ShmOutputScope(const std::string&) {}
+    bool armed() const { return false; }
+};
+/// No borrowed views on this backend: the "view" is a received copy.
+inline bool shmFrameReadView(const std::string& n, cv::Mat& out, uint64_t& seq) {
+    if (!iox2_transport::iox2FrameRead(n, out)) return false;
+    seq = iox2_transport::iox2FrameGetSeq(n);
+    return true;
+}
+inline bool shmFrameValidate(const std::string&, uint64_t) {
+    return true;
+}
+
 } // namespace visionpipe
 
 #else  // VISIONPIPE_IPC_USE_ICEORYX2 — default POSIX shm backend
@@ -56,6 +72,15 @@ inline uint64_t shmFrameGetSeq(const std::string& n) {
  * POSIX shm_open/mmap.  A writer process writes frames to a named region; any
  * number of reader processes can retrieve the latest frame.
  *
+ * Both copies can be removed:
+ *   - Writer: a ShmOutputScope around the item that produces the frame makes
+ *     its output cv::Mat allocate directly in the region's next buffer (the
+ *     interpreter arms one automatically for the statement preceding a
+ *     shm_write("literal")).  shmFrameWrite() then only bumps the sequence.
+ *   - Reader: shmFrameReadView() wraps the published buffer without copying;
+ *     shmFrameValidate() afterwards reports whether the writer started
+ *     overwriting it while it was in use (torn frame).
+ *
  * Typical flow inside a .vsp script:
  *
  *   # Parent process (setup)
@@ -77,6 +102,7 @@ inline uint64_t shmFrameGetSeq(const std::string& n) {
 #include <memory>
 #include <unordered_map>
 #include <mutex>
+#include <vector>
 
 namespace visionpipe {
 
@@ -87,14 +113,15 @@ namespace visionpipe {
 /**
  * @brief Header structure at the start of each shared memory frame region.
  *
- * Uses a simple sequence-number protocol:
- *   Writer:  writes pixel data → increments writeSeq (release fence)
- *   Reader:  compares readSeq vs writeSeq → memcpy if new data → stores readSeq
+ * Uses a seqlock-style sequence-number protocol:
+ *   Writer:  stores writingSeq = seq+1 → writes pixel data → writeSeq = seq+1
+ *   Reader:  loads writeSeq → reads buffer (writeSeq & 1) → checks that
+ *            writingSeq < writeSeq + 2, i.e. that buffer was not reclaimed
  */
 struct ShmFrameHeader {
     // ── Synchronisation ──
-    std::atomic<uint64_t> writeSeq;  ///< bumped by writer after each frame write
-    uint64_t _pad0;                  ///< cache-line padding
+    std::atomic<uint64_t> writeSeq;    ///< bumped by writer after each frame write
+    std::atomic<uint64_t> writingSeq;  ///< frame the writer is currently filling
 
     // ── Shutdown flag ──
     std::atomic<int32_t>  shutdown;  ///< set to 1 by parent; children check it
@@ -138,11 +165,13 @@ bool shmFrameCreate(const std::string& name, int width, int height, int type);
  * @brief Write a cv::Mat frame to the named shared-memory region.
  *
  * Performs one memcpy into the inactive buffer, then atomically bumps the
- * sequence counter so readers see the new frame.
+ * sequence counter so readers see the new frame.  The memcpy is skipped
+ * when @p frame already lives in that buffer (see ShmOutputScope).
  *
  * @param name  POSIX shm name (same as passed to shmFrameCreate)
  * @param frame Frame to publish (must match the region's dimensions/type)
- * @return true on success
+ * @return true on success; false, without writing, if the inactive buffer
+ *         still holds a placed frame that is referenced in this process
  */
 bool shmFrameWrite(const std::string& name, const cv::Mat& frame);
 
@@ -151,7 +180,7 @@ bool shmFrameWrite(const std::string& name, const cv::Mat& frame);
  *
  * If no new frame has been written since the last read, the previous frame
  * is returned.  The data is memcpy'd into @p out so the caller owns the
- * buffer.
+ * buffer; a copy that raced with the writer is detected and retried.
  *
  * @param name  POSIX shm name
  * @param[out] out    Destination Mat (reallocated if necessary)
@@ -159,6 +188,66 @@ bool shmFrameWrite(const std::string& name, const cv::Mat& frame);
  */
 bool shmFrameRead(const std::string& name, cv::Mat& out);
 
+/**
+ * @brief Zero-copy read of the latest frame.
+ *
+ * @p out wraps the region's published buffer directly.  The data stays
+ * intact until the writer starts its second frame after @p seq; call
+ * shmFrameValidate() after using it to detect that case.
+ *
+ * @param[out] seq  Sequence number of the frame wrapped by @p out
+ * @return false if nothing has been written yet
+ */
+bool shmFrameReadView(const std::string& name, cv::Mat& out, uint64_t& seq);
+
+/**
+ * @brief Check that the frame with sequence @p seq was not overwritten.
+ *
+ * @return true if no write into that frame's buffer has started since it
+ *         was published
+ */
+bool shmFrameValidate(const std::string& name, uint64_t seq);
+
+/**
+ * @brief Frames this process has copied into or out of any region.
+ *
+ * Counts each shmFrameWrite() memcpy and each shmFrameRead() attempt;
+ * placed writes and views do not copy.  For diagnostics and benchmarks.
+ */
+uint64_t shmFrameCopyCount();
+
+/**
+ * @brief Place the next matching cv::Mat allocation in a region's free buffer.
+ *
+ * While the scope is alive, the first allocation on the calling thread
+ * whose size and type match region @p name is served from the buffer the
+ * next shmFrameWrite() will publish, so that write degenerates to a
+ * sequence bump.  If that Mat is released before the scope ends (a
+ * temporary of the same size), the next matching allocation gets the
+ * buffer instead.  Other allocations and other threads are unaffected, and
+ * the allocator wrapper is only installed while a scope is armed.
+ *
+ * The scope does not arm (armed() == false) when the region is unknown or
+ * a Mat from an earlier placement still references the free buffer.
+ * A Mat placed this way is a view into shared memory.  While it is
+ * referenced, the writer will not reuse its buffer: the next scope does
+ * not arm and shmFrameWrite() of a heap frame into it fails, so a frame
+ * kept past the next write should be cloned.
+ */
+class ShmOutputScope {
+public:
+    explicit ShmOutputScope(const std::string& name);
+    ~ShmOutputScope();
+
+    ShmOutputScope(const ShmOutputScope&) = delete;
+    ShmOutputScope& operator=(const ShmOutputScope&) = delete;
+
+    bool armed() const { return _armed; }
+
+private:
+    bool _armed = false;
+};
+
 /**
  * @brief Set the shutdown flag in a named shared-memory region.
  *
@@ -0,0 +1,97 @@
+#pragma once
+
+/**
+ * @file template_matcher.h
+ * @brief Multi-template, coarse-to-fine template matching.
+ *
+ * cv::matchTemplate evaluates every template at every full-resolution
+ * position and returns a dense score map.  Locating 20+ parts in a 1080p
+ * frame that way is dominated by work whose results are thrown away.
+ *
+ * A TemplateBank holds a set of templates with their gray pyramids and
+ * statistics precomputed once.  Matching a frame:
+ *
+ *  1. builds the frame's gray pyramid once for the whole batch;
+ *  2. searches each template densely only at its coarsest usable level,
+ *     where the template is still at least `minTemplateSide` pixels;
+ *  3. refines the best coarse candidates level by level inside a small
+ *     window around the projected position;
+ *  4. returns the top-k peaks per template directly.
+ *
+ * Coarse searches of large templates use FFTEngine correlation with the
+ * template spectrum cached per template and level; the normalisation terms
+ * come from integral images of the frame pyramid, computed once per level
+ * and shared by every template in the batch.
+ */
+
+#include "utils/keyed_registry.h"
+
+#include <opencv2/core.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace visionpipe {
+
+/// One refined match.
+struct MatchPeak {
+    int      templateIndex = 0;
+    cv::Rect box;              ///< Full-resolution template placement
+    float    score = 0.f;      ///< Higher is better (1 - value for sqdiff_normed)
+};
+
+struct TemplateMatchParams {
+    int    method          = 5;     ///< cv::TM_CCOEFF_NORMED, TM_CCORR_NORMED or TM_SQDIFF_NORMED
+    int    topK            = 1;     ///< Peaks kept per template
+    double threshold       = 0.8;   ///< Minimum final score
+    int    maxLevels       = -1;    ///< Pyramid levels above full resolution (-1 = auto)
+    int    minTemplateSide = 12;    ///< Coarsest level keeps templates at least this large
+    int    fftMinArea      = 1024;  ///< Template area (at search level) from which FFT is used
+    double coarseSlack     = 0.15;  ///< Coarse candidates may score this much below threshold
+};
+
+/// Precomputed pyramid and statistics of one template (immutable once built).
+struct TemplateModel {
+    cv::Mat source;                  ///< Keeps the cache buffer alive (identity check)
+    std::vector<cv::Mat> levels;     ///< 8-bit gray pyramid, level 0 = full resolution
+    std::vector<cv::Mat> zeroMean;   ///< CV_32F template minus its mean, per level
+    std::vector<cv::Mat> raw;        ///< CV_32F template, per level
+    std::vector<double>  zeroMeanNorm;
+    std::vector<double>  rawNorm;
+
+    explicit TemplateModel(const cv::Mat& src);
+};
+
+/**
+ * @brief Set of templates matched together against each frame.
+ *
+ * Concurrent match() calls on one bank serialise on its mutex: they share
+ * the frame pyramid buffers.  Use one cache_id per independent stream.
+ */
+class TemplateBank {
+public:
+    explicit TemplateBank(std::string id) : _id(std::move(id)) {}
+
+    /// Match every template in `templates` against `frame`.  Models are
+    /// rebuilt only for templates whose cache buffer changed.
+    std::vector<MatchPeak> match(const cv::Mat& frame, const std::vector<cv::Mat>& templates,
+                                 const TemplateMatchParams& params);
+
+    size_t size() const { return _models.size(); }
+
+private:
+    void sync(const std::vector<cv::Mat>& templates);
+
+    std::string _id;
+    std::vector<std::shared_ptr<const TemplateModel>> _models;
+    std::vector<cv::Mat> _pyramid;   ///< Reused gray frame pyramid
+    std::vector<cv::Mat> _sum;       ///< Per-level integral images (FFT levels only)
+    std::vector<cv::Mat> _sqsum;
+    std::mutex _mutex;
+};
+
+/// Template banks keyed by cache_id.
+using TemplateBankRegistry = KeyedRegistry<TemplateBank>;
+
+} // namespace visionpipe
@@ -0,0 +1,119 @@
+#pragma once
+
+/**
+ * @file text_renderer.h
+ * @brief Hershey text from cached glyph atlases.
+ *
+ * cv::putText strokes every glyph of every label through the polyline
+ * rasterizer on every call.  TextRenderer rasterizes the printable ASCII
+ * glyphs of a (font, scale, thickness, line type) once, with cv::putText
+ * itself, into a single-channel coverage atlas, and afterwards draws text by
+ * alpha-blending glyph rectangles from the atlas into the image.
+ *
+ * Glyphs are placed with the same 16.16 fixed-point pen as cv::putText and
+ * snapped to the nearest pixel, so output matches it to within half a pixel
+ * per glyph horizontally and exactly vertically; blending a coverage mask
+ * in one step is equivalent to cv::putText's per-stroke blending since all
+ * strokes share one color.  Text metrics come from per-font advance tables
+ * and match cv::getTextSize exactly.
+ *
+ * Text with characters outside printable ASCII, and images other than 8-bit
+ * with 1, 3 or 4 channels, are passed to cv::putText unchanged.
+ */
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <array>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace visionpipe {
+
+class TextRenderer {
+public:
+    static TextRenderer& instance();
+
+    struct Label {
+        std::string text;
+        cv::Point   org;     ///< Bottom-left corner of the text, as for cv::putText
+        cv::Scalar  color;
+    };
+
+    /// Drop-in for cv::getTextSize.
+    cv::Size getTextSize(const std::string& text, int fontFace, double fontScale,
+                         int thickness, int* baseLine = nullptr);
+
+    /// Drop-in for cv::putText (bottomLeftOrigin is not supported).
+    void putText(cv::Mat& img, const std::string& text, cv::Point org, int fontFace,
+                 double fontScale, const cv::Scalar& color, int thickness = 1,
+                 int lineType = cv::LINE_8);
+
+    /// Draw many strings that share a font, in order, with one atlas lookup.
+    void putTextBatch(cv::Mat& img, const std::vector<Label>& labels, int fontFace,
+                      double fontScale, int thickness = 1, int lineType = cv::LINE_8);
+
+    /// Forget every atlas (e.g. after drawing at many one-off scales).
+    void clear();
+
+private:
+    TextRenderer() = default;
+
+    static constexpr int kFirstChar = 32;
+    static constexpr int kNumChars  = 95;   // ' ' .. '~'
+
+    struct Glyph {
+        cv::Rect  rect;      ///< Coverage in the atlas (may be empty, e.g. space)
+        cv::Point offset;    ///< Top-left of rect relative to the pen position
+    };
+
+    struct Atlas {
+        cv::Mat coverage;                     ///< CV_8UC1
+        std::array<Glyph, kNumChars> glyphs;
+        int64_t hscale = 0;                   ///< cvRound(fontScale * 65536), as in cv::putText
+    };
+
+    /// Glyph advances in font units, independent of scale and thickness.
+    struct FontMetrics {
+        std::array<int, kNumChars> advance{};
+        int capLine  = 0;
+        int baseLine = 0;
+    };
+
+    struct AtlasKey {
+        int fontFace;
+        int64_t hscale;
+        int thickness;
+        int lineType;
+        bool operator==(const AtlasKey& o) const {
+            return fontFace == o.fontFace && hscale == o.hscale &&
+                   thickness == o.thickness && lineType == o.lineType;
+        }
+    };
+    struct AtlasKeyHash {
+        size_t operator()(const AtlasKey& k) const {
+            size_t h = std::hash<int64_t>()(k.hscale);
+            h ^= std::hash<int>()(k.fontFace) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<int>()(k.thickness * 64 + k.lineType) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    static constexpr size_t kMaxAtlases = 64;
+
+    static bool isPrintable(const std::string& text);
+    static bool isSupported(const cv::Mat& img);
+
+    std::shared_ptr<const FontMetrics> metrics(int fontFace);
+    std::shared_ptr<const Atlas> atlas(int fontFace, double fontScale, int thickness, int lineType);
+    void draw(cv::Mat& img, const Atlas& atlas, const FontMetrics& fm,
+              const std::string& text, cv::Point org, const cv::Scalar& color);
+
+    std::shared_mutex _mutex;
+    std::unordered_map<int, std::shared_ptr<const FontMetrics>> _metrics;
+    std::unordered_map<AtlasKey, std::shared_ptr<const Atlas>, AtlasKeyHash> _atlases;
+};
+
+} // namespace visionpipe
@@ -3,12 +3,16 @@
 
 #ifdef VISIONPIPE_V4L2_NATIVE_ENABLED
 
+#include "utils/mjpeg_decoder.h"
 #include <opencv2/core/mat.hpp>
 #include <string>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <thread>
 #include <cstdint>
 
 namespace visionpipe {
@@ -30,6 +34,10 @@ struct V4L2NativeConfig {
     std::string pixelFormat = "YUYV"; // FourCC or named: "YUYV", "MJPG", "NV12", "SRGGB10", etc.
     int bufferCount = 4;
     V4L2IOMethod io_method = V4L2IOMethod::MMAP;
+    // MJPEG only
+    int decodeThreads = 0;            // 0 = decode inline in acquireFrame; N = decoder pool
+    int decodeScale = 1;              // 1, 2, 4, 8: DCT-domain reduced decode
+    bool decodeGray = false;          // Luma only (CV_8UC1), skips chroma
 };
 
 /**
@@ -181,6 +189,20 @@ private:
         std::vector<Plane> planes;
     };
 
+    /// Capture thread + decoder pool for MJPEG with decodeThreads > 0.
+    /// The thread dequeues compressed buffers, copies them out, re-queues
+    /// them at once and hands the copy to the pool; acquireFrame() only
+    /// collects decoded frames in order.
+    struct MjpegFeed {
+        std::unique_ptr<MjpegDecoderPool> pool;
+        std::thread thread;
+        std::atomic<bool> stop{false};
+        /// Held by the thread around DQBUF .. QBUF and by setControl for a
+        /// whole STREAMOFF .. STREAMON pause, so the two never interleave.
+        std::mutex ioMutex;
+        std::atomic<uint64_t> pauses{0};   ///< Bumped by every pause
+    };
+
     struct V4L2Session {
         int fd = -1;
         V4L2NativeConfig config;
@@ -199,9 +221,12 @@ private:
         // time and cached here so every subsequent setControl / getControl call
         // can skip the expensive filesystem + ioctl enumeration.
         std::vector<std::string> cachedSubDevs;
+        std::shared_ptr<MjpegFeed> mjpegFeed;
     };
 
     bool openDevice(const std::string& devicePath, V4L2Session& session);
+    void startMjpegFeed(const std::string& devicePath, V4L2Session& session);
+    void stopMjpegFeed(V4L2Session& session);
     uint32_t lookupPixelFormat(const std::string& name) const;
     uint32_t resolveControlId(int fd, const std::string& nameOrId) const;
     std::string fourccToString(uint32_t fourcc) const;
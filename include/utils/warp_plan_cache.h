@@ -0,0 +1,151 @@
+#pragma once
+
+/**
+ * @file warp_plan_cache.h
+ * @brief Process-wide cache of precomputed geometric-transform plans.
+ *
+ * warpAffine / warpPerspective / undistort regenerate their coordinate maps
+ * on every call.  For static geometry (fixed calibration, a homography that
+ * only changes on user input) that map generation is pure waste.  A WarpPlan
+ * holds fixed-point CV_16SC2 + CV_16UC1 maps built once; applying it is a
+ * single remap pass.
+ *
+ * Plans are keyed by a 64-bit FNV-1a hash of everything that determines the
+ * maps (transform kind, matrix / distortion values, sizes, interpolation,
+ * border mode).  Looking up a plan therefore costs a few dozen multiplies.
+ *
+ * Affine, perspective and remap plans use a two-sighting rule: the first
+ * time a key is seen, the lookup returns nullptr and the caller falls back
+ * to the direct OpenCV call; the plan is only built when the same key is
+ * requested again.  A transform that changes every frame (e.g. stabilisation) thus
+ * never pays the map build cost.
+ *
+ * Typical use:
+ *
+ *   auto& cache = WarpPlanCache::instance();
+ *   auto plan = cache.affine(M, src.size(), dstSize, cv::INTER_LINEAR,
+ *                            cv::BORDER_CONSTANT);
+ *   if (plan) warpPlanApply(*plan, src, dst);
+ *   else      cv::warpAffine(src, dst, M, dstSize, ...);
+ */
+
+#include <opencv2/core.hpp>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace visionpipe {
+
+/// Precomputed fixed-point remap plan (immutable once built).
+struct WarpPlan {
+    uint64_t key = 0;
+    cv::Mat  map1;           ///< CV_16SC2 integer coordinates
+    cv::Mat  map2;           ///< CV_16UC1 interpolation table indices (empty for nearest)
+    cv::Size dstSize;
+    int      interpolation = 1;   // cv::INTER_LINEAR
+    int      borderMode    = 0;   // cv::BORDER_CONSTANT
+};
+
+/// Incremental FNV-1a hasher used to build plan keys.
+class WarpKeyHasher {
+public:
+    WarpKeyHasher& add(const void* data, size_t bytes);
+    WarpKeyHasher& add(int v) { return add(&v, sizeof(v)); }
+    WarpKeyHasher& add(double v) { return add(&v, sizeof(v)); }
+    WarpKeyHasher& add(const cv::Size& s) { return add(s.width).add(s.height); }
+    /// Hashes matrix values converted to double, so CV_32F and CV_64F
+    /// matrices with equal values produce the same key.
+    WarpKeyHasher& add(const cv::Mat& m);
+    /// Hashes the raw bytes of @p m (type included); cheap enough for full-frame maps.
+    WarpKeyHasher& addContent(const cv::Mat& m);
+    uint64_t value() const { return _h; }
+
+private:
+    uint64_t _h = 1469598103934665603ULL;
+};
+
+class WarpPlanCache {
+public:
+    static WarpPlanCache& instance();
+
+    /// Plan equivalent to cv::warpAffine(src, dst, M, dstSize, interp, border).
+    std::shared_ptr<const WarpPlan> affine(const cv::Mat& M, const cv::Size& srcSize,
+                                           const cv::Size& dstSize, int interpolation,
+                                           int borderMode);
+
+    /// Plan equivalent to cv::warpPerspective(src, dst, H, dstSize, interp, border).
+    std::shared_ptr<const WarpPlan> perspective(const cv::Mat& H, const cv::Size& srcSize,
+                                                const cv::Size& dstSize, int interpolation,
+                                                int borderMode);
+
+    /// Plan equivalent to cv::undistort(src, dst, K, D, newK).  Built on the
+    /// first request: camera intrinsics are static by nature.
+    std::shared_ptr<const WarpPlan> undistort(const cv::Mat& K, const cv::Mat& D,
+                                              const cv::Mat& newK, const cv::Size& size,
+                                              int interpolation);
+
+    /// Plan wrapping user-supplied float maps.  They are converted to fixed
+    /// point once and identified by content, so a map rewritten in place or
+    /// reallocated at the same address gets a new plan.  Returns nullptr for
+    /// maps that are already CV_16SC2 (nothing to precompute).
+    ///
+    /// Hashing a full-frame map costs about as much as reading it.  When the
+    /// caller passes nonzero @p generation1 / @p generation2 (e.g. the cache
+    /// entry generations the maps came from) and the maps are the same
+    /// buffers last seen with those generations, the content key from that
+    /// sighting is reused without reading the maps; a rewrite in place then
+    /// needs a new generation (for cache entries: set() it again).
+    std::shared_ptr<const WarpPlan> remap(const cv::Mat& map1, const cv::Mat& map2,
+                                          int interpolation, int borderMode,
+                                          uint64_t generation1 = 0, uint64_t generation2 = 0);
+
+    /// Drop all plans.
+    void clear();
+
+    /// Maximum number of plans retained (least recently used are evicted).
+    void setCapacity(size_t n);
+
+    struct Stats {
+        uint64_t hits   = 0;
+        uint64_t misses = 0;
+        uint64_t builds = 0;
+        size_t   plans  = 0;
+    };
+    Stats stats() const;
+
+private:
+    WarpPlanCache() = default;
+
+    /// Returns the cached plan for key, building it via `build` when
+    /// `buildNow` is true or the key has been seen before.
+    template <typename F>
+    std::shared_ptr<const WarpPlan> lookup(uint64_t key, bool buildNow, F&& build);
+
+    void touch(uint64_t key);
+    void evictIfNeeded();
+
+    mutable std::mutex _mutex;
+    std::unordered_map<uint64_t, std::shared_ptr<const WarpPlan>> _plans;
+    std::list<uint64_t> _lru;                 ///< front = most recently used
+    std::unordered_set<uint64_t> _seenOnce;   ///< keys requested once, not yet built
+    /// Map buffer identity + generations -> content key, for remap()
+    std::unordered_map<uint64_t, uint64_t> _remapKeys;
+    size_t _capacity = 32;
+    Stats  _stats;
+};
+
+/// Apply a plan with a tile-ordered remap: the destination is split into
+/// cache-sized tiles which are processed on OpenCV's thread pool.
+/// @p borderValue fills BORDER_CONSTANT pixels; it does not affect the maps,
+/// so it is not part of the plan.
+void warpPlanApply(const WarpPlan& plan, const cv::Mat& src, cv::Mat& dst,
+                   const cv::Scalar& borderValue = cv::Scalar());
+
+/// Tile-ordered cv::remap for arbitrary map pairs (same semantics as cv::remap).
+void tiledRemap(const cv::Mat& src, cv::Mat& dst, const cv::Mat& map1, const cv::Mat& map2,
+                int interpolation, int borderMode, const cv::Scalar& borderValue = cv::Scalar());
+
+} // namespace visionpipe
@@ -0,0 +1,698 @@
+/**
+ * VisionPipe Batch Runner
+ *
+ * Decoder threads read inputs ahead into per-worker bounded queues; worker
+ * threads, each owning a Runtime with the script loaded once, run the
+ * pipeline on every queued frame and hand results to the sinks.
+ *
+ * Scripts may keep state between frames (frame cache, background models,
+ * flow, ...), so a video is pinned to one worker that has nothing else
+ * queued: its frames arrive in order, and the worker starts it with an
+ * empty frame cache and its own StateNamespace for cache_id'd state.
+ */
+
+#include "batch.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/videoio.hpp>
+
+#include "interpreter/runtime.h"
+#include "interpreter/parser.h"
+#include "utils/keyed_registry.h"
+
+namespace fs = std::filesystem;
+
+namespace visionpipe {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// ============================================================================
+// Inputs
+// ============================================================================
+
+const char* const kImageExts[] = {".png", ".jpg", ".jpeg", ".bmp", ".tif", ".tiff", ".webp",
+                                  ".pgm", ".ppm", ".pnm", ".pbm", ".exr", ".hdr", ".jp2"};
+const char* const kVideoExts[] = {".mp4", ".avi", ".mkv", ".mov", ".webm", ".m4v",
+                                  ".mpg", ".mpeg", ".wmv", ".ts"};
+
+std::string lowerExtension(const std::string& path) {
+    std::string ext = fs::path(path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext;
+}
+
+bool isVideo(const std::string& path) {
+    const std::string ext = lowerExtension(path);
+    return std::find(std::begin(kVideoExts), std::end(kVideoExts), ext) != std::end(kVideoExts);
+}
+
+bool isMedia(const std::string& path) {
+    const std::string ext = lowerExtension(path);
+    return isVideo(path) ||
+           std::find(std::begin(kImageExts), std::end(kImageExts), ext) != std::end(kImageExts);
+}
+
+std::string trim(const std::string& s) {
+    const size_t b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos) return "";
+    const size_t e = s.find_last_not_of(" \t\r\n");
+    return s.substr(b, e - b + 1);
+}
+
+// Files, directories (non-recursive), globs, and @list files of any of those.
+void expandInput(const std::string& spec, std::vector<std::string>& out) {
+    if (!spec.empty() && spec[0] == '@') {
+        std::ifstream list(spec.substr(1));
+        if (!list.is_open()) {
+            std::cerr << "[Batch] Warning: cannot open input list: " << spec.substr(1) << std::endl;
+            return;
+        }
+        std::string line;
+        while (std::getline(list, line)) {
+            line = trim(line);
+            if (line.empty() || line[0] == '#') continue;
+            expandInput(line, out);
+        }
+    } else if (spec.find_first_of("*?") != std::string::npos) {
+        std::vector<cv::String> matches;
+        cv::glob(spec, matches, false);
+        for (const auto& m : matches) {
+            if (isMedia(m)) out.push_back(m);
+        }
+    } else if (fs::is_directory(spec)) {
+        std::vector<std::string> files;
+        for (const auto& entry : fs::directory_iterator(spec)) {
+            if (entry.is_regular_file() && isMedia(entry.path().string())) {
+                files.push_back(entry.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        out.insert(out.end(), files.begin(), files.end());
+    } else {
+        out.push_back(spec);
+    }
+}
+
+// Output name for each input: its path relative to the inputs' deepest
+// common directory, without extension, so files from different folders
+// never collide and a name does not depend on which inputs a run skips.
+// Inputs differing only in extension keep it as a suffix (a_png, a_jpg).
+std::vector<std::string> outputStems(const std::vector<std::string>& paths) {
+    std::vector<fs::path> abs;
+    for (const auto& p : paths) abs.push_back(fs::absolute(p).lexically_normal());
+
+    fs::path root;
+    for (size_t i = 0; i < abs.size(); ++i) {
+        const fs::path dir = abs[i].parent_path();
+        if (i == 0) {
+            root = dir;
+            continue;
+        }
+        fs::path common;
+        for (auto a = root.begin(), b = dir.begin(); a != root.end() && b != dir.end() && *a == *b; ++a, ++b) {
+            common /= *a;
+        }
+        root = common;
+    }
+
+    std::vector<std::string> stems(paths.size());
+    std::unordered_map<std::string, int> count;
+    for (size_t i = 0; i < abs.size(); ++i) {
+        fs::path rel = abs[i].lexically_relative(root);
+        if (rel.empty()) rel = abs[i].filename();
+        stems[i] = (rel.parent_path() / rel.stem()).generic_string();
+        ++count[stems[i]];
+    }
+    for (size_t i = 0; i < abs.size(); ++i) {
+        if (count[stems[i]] > 1) {
+            std::string ext = abs[i].extension().string();
+            if (!ext.empty()) stems[i] += "_" + ext.substr(1);
+        }
+    }
+    return stems;
+}
+
+// ============================================================================
+// Work queue
+// ============================================================================
+
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : _capacity(std::max<size_t>(1, capacity)) {}
+
+    /// Blocks while full; false once closed.
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _notFull.wait(lock, [&] { return _closed || _items.size() < _capacity; });
+        if (_closed) return false;
+        _items.push_back(std::move(item));
+        _notEmpty.notify_one();
+        return true;
+    }
+
+    /// Blocks while empty; false once closed and drained.
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _notEmpty.wait(lock, [&] { return _closed || !_items.empty(); });
+        if (_items.empty()) return false;
+        item = std::move(_items.front());
+        _items.pop_front();
+        _notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _closed = true;
+        _notFull.notify_all();
+        _notEmpty.notify_all();
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _items.size();
+    }
+
+    size_t capacity() const { return _capacity; }
+
+private:
+    const size_t _capacity;
+    std::mutex _mutex;
+    std::condition_variable _notFull;
+    std::condition_variable _notEmpty;
+    std::deque<T> _items;
+    bool _closed = false;
+};
+
+// ============================================================================
+// Shared state
+// ============================================================================
+
+struct BatchFile {
+    std::string path;
+    std::string stem;                  ///< Output path under outputDir, without extension
+    size_t index = 0;
+    int worker = -1;                   ///< Worker all of its frames go to
+    bool video = false;
+    std::atomic<int> pending{1};       ///< Frames in flight, +1 while decoding
+    std::atomic<bool> failed{false};
+    std::atomic<bool> abandoned{false};  ///< Stopped before all frames were queued
+};
+
+struct BatchItem {
+    BatchFile* file = nullptr;
+    int frame = 0;
+    cv::Mat image;
+};
+
+struct BatchState {
+    const BatchOptions& opts;
+    std::string pipeline;
+    bool sinkImage = false;
+    bool sinkCsv = false;
+
+    std::vector<std::unique_ptr<BatchFile>> files;
+    std::vector<std::unique_ptr<BoundedQueue<BatchItem>>> queues;   ///< One per worker
+    std::atomic<size_t> nextFile{0};
+
+    std::mutex assignMutex;            ///< Guards the two vectors below
+    std::condition_variable workerFreed;
+    std::vector<int> filesAssigned;    ///< Per worker, files not yet released
+    std::vector<bool> videoAssigned;   ///< Per worker, a video holds it exclusively
+    std::atomic<bool> stop{false};
+    std::atomic<bool> loadFailed{false};
+
+    std::atomic<uint64_t> framesDone{0};
+    std::atomic<uint64_t> framesFailed{0};
+    std::atomic<uint64_t> filesDone{0};
+    std::atomic<uint64_t> filesFailed{0};
+    std::atomic<uint64_t> pipelineNs{0};
+    std::atomic<uint64_t> decodeNs{0};
+
+    std::mutex outMutex;               ///< Guards the files below and stderr
+    std::ofstream checkpoint;
+    std::ofstream csv;
+
+    BatchState(const BatchOptions& o, int workers, size_t queueCapacity)
+        : opts(o), filesAssigned(workers, 0), videoAssigned(workers, false) {
+        for (int i = 0; i < workers; ++i) {
+            queues.push_back(std::make_unique<BoundedQueue<BatchItem>>(queueCapacity));
+        }
+    }
+
+    size_t queued() {
+        size_t n = 0;
+        for (auto& q : queues) n += q->size();
+        return n;
+    }
+
+    void closeQueues() {
+        for (auto& q : queues) q->close();
+        std::lock_guard<std::mutex> lock(assignMutex);
+        workerFreed.notify_all();
+    }
+};
+
+std::string fileNamespace(const BatchFile& f) {
+    return "batch/" + std::to_string(f.index) + "/";
+}
+
+uint64_t elapsedNs(Clock::time_point t0) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+}
+
+std::string csvQuote(const std::string& s) {
+    std::string q = "\"";
+    for (char c : s) {
+        if (c == '"') q += '"';
+        q += c;
+    }
+    return q + "\"";
+}
+
+// Pick the worker for @p f: a video needs a worker with nothing else
+// assigned, an image the least loaded one not held by a video.  Blocks
+// until one is free; false when stopping.
+bool assignWorker(BatchState& st, BatchFile& f) {
+    std::unique_lock<std::mutex> lock(st.assignMutex);
+    int best = -1;
+    st.workerFreed.wait(lock, [&] {
+        if (st.stop.load()) return true;
+        best = -1;
+        for (int w = 0; w < static_cast<int>(st.filesAssigned.size()); ++w) {
+            if (st.videoAssigned[w] || (f.video && st.filesAssigned[w] > 0)) continue;
+            if (best < 0 || st.filesAssigned[w] < st.filesAssigned[best]) best = w;
+        }
+        return best >= 0;
+    });
+    if (best < 0) return false;
+    f.worker = best;
+    ++st.filesAssigned[best];
+    if (f.video) st.videoAssigned[best] = true;
+    return true;
+}
+
+// Drop one reference to the file; the last one frees its worker and records its outcome.
+void release(BatchState& st, BatchFile& f) {
+    if (f.pending.fetch_sub(1) != 1) return;
+    if (f.worker >= 0) {
+        std::lock_guard<std::mutex> lock(st.assignMutex);
+        --st.filesAssigned[f.worker];
+        if (f.video) st.videoAssigned[f.worker] = false;
+        st.workerFreed.notify_all();
+    }
+    if (f.video) StateNamespace::drop(fileNamespace(f));
+    if (f.abandoned.load()) return;
+    std::lock_guard<std::mutex> lock(st.outMutex);
+    if (f.failed.load()) {
+        ++st.filesFailed;
+        return;
+    }
+    ++st.filesDone;
+    if (st.checkpoint.is_open()) {
+        st.checkpoint << f.path << '\n';
+        st.checkpoint.flush();
+    }
+}
+
+// ============================================================================
+// Decoders
+// ============================================================================
+
+void decodeLoop(BatchState& st) {
+    while (!st.stop.load()) {
+        const size_t idx = st.nextFile++;
+        if (idx >= st.files.size()) break;
+        BatchFile& f = *st.files[idx];
+        if (!assignWorker(st, f)) {
+            f.abandoned = true;
+            release(st, f);
+            break;
+        }
+        BoundedQueue<BatchItem>& queue = *st.queues[f.worker];
+
+        if (f.video) {
+            cv::VideoCapture cap(f.path);
+            if (!cap.isOpened()) {
+                f.failed = true;
+                std::lock_guard<std::mutex> lock(st.outMutex);
+                std::cerr << "[Batch] Cannot open video: " << f.path << std::endl;
+            }
+            int n = 0;
+            while (cap.isOpened() && !st.stop.load()) {
+                cv::Mat frame;   // Fresh buffer per frame; the queue keeps it alive
+                auto t0 = Clock::now();
+                const bool ok = cap.read(frame);
+                st.decodeNs += elapsedNs(t0);
+                if (!ok || frame.empty()) break;
+                ++f.pending;
+                if (!queue.push({&f, n++, frame})) {
+                    --f.pending;
+                    break;
+                }
+            }
+        } else {
+            auto t0 = Clock::now();
+            cv::Mat image = cv::imread(f.path, cv::IMREAD_COLOR);
+            st.decodeNs += elapsedNs(t0);
+            if (image.empty()) {
+                f.failed = true;
+                std::lock_guard<std::mutex> lock(st.outMutex);
+                std::cerr << "[Batch] Cannot decode: " << f.path << std::endl;
+            } else {
+                ++f.pending;
+                if (!queue.push({&f, 0, image})) --f.pending;
+            }
+        }
+        if (st.stop.load()) f.abandoned = true;
+        release(st, f);
+    }
+}
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+bool writeImage(BatchState& st, const BatchItem& item, const cv::Mat& out) {
+    if (out.empty()) return true;
+    std::ostringstream name;
+    name << item.file->stem;
+    if (item.file->video) name << '_' << std::setw(6) << std::setfill('0') << item.frame;
+    name << st.opts.imageExt;
+    const std::string path = (fs::path(st.opts.outputDir) / name.str()).string();
+    try {
+        if (cv::imwrite(path, out)) return true;
+    } catch (const cv::Exception&) {
+        // Unsupported depth/channels for the extension; reported below
+    }
+    std::lock_guard<std::mutex> lock(st.outMutex);
+    std::cerr << "[Batch] Cannot write: " << path << std::endl;
+    return false;
+}
+
+void workerLoop(BatchState& st, int id) {
+    const BatchOptions& opts = st.opts;
+    std::unique_ptr<Runtime> runtime;
+    try {
+        RuntimeConfig config;
+        config.enableDisplay = false;
+        config.enableLogging = opts.verbose;
+        config.interpreterConfig.verbose = opts.verbose;
+        runtime = std::make_unique<Runtime>(config);
+        for (const auto& [key, value] : opts.params) {
+            runtime->setParam(key, value);
+        }
+        runtime->loadDefinitions(opts.scriptPath);
+    } catch (const std::exception& e) {
+        std::lock_guard<std::mutex> lock(st.outMutex);
+        std::cerr << "[Batch] Worker " << id << " failed to load script: " << e.what() << std::endl;
+        st.loadFailed = true;
+        st.stop = true;
+        return;
+    }
+
+    BoundedQueue<BatchItem>& queue = *st.queues[id];
+    const std::string workerNamespace = "batch/w" + std::to_string(id) + "/";
+    const BatchFile* current = nullptr;
+    BatchItem item;
+    while (!st.stop.load() && queue.pop(item)) {
+        // A video starts from, and leaves behind, an empty frame cache
+        if (item.file != current) {
+            if (item.file->video || (current && current->video)) {
+                runtime->interpreter().cache().clearGlobal();
+            }
+            current = item.file;
+        }
+
+        auto t0 = Clock::now();
+        cv::Mat out;
+        bool ok = true;
+        std::string error;
+        try {
+            StateNamespace ns(item.file->video ? fileNamespace(*item.file) : workerNamespace);
+            out = runtime->executePipeline(st.pipeline, {}, item.image);
+        } catch (const std::exception& e) {
+            ok = false;
+            error = e.what();
+        }
+        if (runtime->interpreter().hasError()) {
+            ok = false;
+            error = runtime->interpreter().lastError();
+            runtime->interpreter().clearError();
+        }
+        const uint64_t ns = elapsedNs(t0);
+        st.pipelineNs += ns;
+
+        if (ok && st.sinkImage) ok = writeImage(st, item, out);
+
+        if (ok) {
+            ++st.framesDone;
+        } else {
+            ++st.framesFailed;
+            item.file->failed = true;
+        }
+
+        if (st.sinkCsv || !ok) {
+            std::lock_guard<std::mutex> lock(st.outMutex);
+            if (!ok && !error.empty()) {
+                std::cerr << "[Batch] " << item.file->path;
+                if (item.file->video) std::cerr << " frame " << item.frame;
+                std::cerr << ": " << error << std::endl;
+            }
+            if (st.sinkCsv) {
+                st.csv << csvQuote(item.file->path) << ',' << item.frame << ','
+                       << (ok ? "ok" : "failed") << ',' << std::fixed << std::setprecision(3)
+                       << (ns / 1e6) << ',' << out.cols << ',' << out.rows << ','
+                       << out.channels() << '\n';
+            }
+        }
+
+        release(st, *item.file);
+        item = BatchItem{};   // Drop the frame before blocking on the queue
+    }
+}
+
+void printProgress(BatchState& st, double seconds, bool final) {
+    const uint64_t frames = st.framesDone.load() + st.framesFailed.load();
+    std::cout << (final ? "" : "\r") << "[Batch] Files: "
+              << (st.filesDone.load() + st.filesFailed.load()) << "/" << st.files.size()
+              << " | Frames: " << frames
+              << " | Failed: " << st.framesFailed.load()
+              << " | " << std::fixed << std::setprecision(1)
+              << (seconds > 0 ? frames / seconds : 0.0) << " frames/s"
+              << " | Queue: " << st.queued() << "/" << st.queues.size() * st.queues.front()->capacity()
+              << (final ? "\n" : "     ") << std::flush;
+}
+
+} // namespace
+
+// ============================================================================
+// Entry point
+// ============================================================================
+
+std::vector<std::string> expandInputs(const std::vector<std::string>& specs) {
+    std::vector<std::string> out;
+    for (const auto& spec : specs) expandInput(spec, out);
+    return out;
+}
+
+bool isVideoInput(const std::string& path) {
+    return isVideo(path);
+}
+
+int runBatch(const BatchOptions& opts, const std::atomic<bool>& running) {
+    // Validate once up front so a syntax error is reported once, not per worker.
+    auto program = parseFile(opts.scriptPath);
+
+    std::string pipeline = opts.pipelineName;
+    if (pipeline.empty()) {
+        if (program->findPipeline("main")) {
+            pipeline = "main";
+        } else if (!program->pipelines.empty()) {
+            pipeline = program->pipelines.front()->name;
+        }
+    }
+    if (pipeline.empty()) {
+        std::cerr << "Error: Script defines no pipeline to run" << std::endl;
+        return 1;
+    }
+
+    const int hw = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const int workers = opts.workers > 0 ? opts.workers : hw;
+    const int decoders = opts.decoders > 0 ? opts.decoders : std::max(1, workers / 2);
+    const int prefetch = opts.prefetch > 0 ? opts.prefetch : 2 * workers;
+
+    BatchState st(opts, workers, static_cast<size_t>(std::max(1, prefetch / workers)));
+    st.pipeline = pipeline;
+    if (opts.sinks.empty()) {
+        st.sinkImage = true;
+    }
+    for (const auto& sink : opts.sinks) {
+        if (sink == "image")     st.sinkImage = true;
+        else if (sink == "csv")  st.sinkCsv = true;
+        else if (sink != "none") {
+            std::cerr << "Error: Unknown sink '" << sink << "' (expected image, csv or none)" << std::endl;
+            return 1;
+        }
+    }
+
+    std::error_code ec;
+    fs::create_directories(opts.outputDir, ec);
+    if (ec) {
+        std::cerr << "Error: Cannot create output directory " << opts.outputDir << ": "
+                  << ec.message() << std::endl;
+        return 1;
+    }
+
+    // ---- Inputs, minus those already checkpointed -------------------------
+    std::vector<std::string> inputs;
+    for (const auto& spec : opts.inputs) expandInput(spec, inputs);
+
+    const std::string checkpointPath = opts.checkpointPath.empty()
+        ? (fs::path(opts.outputDir) / "batch.checkpoint").string()
+        : opts.checkpointPath;
+    std::unordered_set<std::string> completed;
+    if (opts.resume) {
+        std::ifstream in(checkpointPath);
+        std::string line;
+        while (std::getline(in, line)) {
+            line = trim(line);
+            if (!line.empty()) completed.insert(line);
+        }
+    }
+
+    std::vector<std::string> unique;
+    std::unordered_set<std::string> seen;
+    for (const auto& path : inputs) {
+        if (seen.insert(path).second) unique.push_back(path);
+    }
+
+    // Output names depend only on the input set, not on what --resume skips
+    const std::vector<std::string> stems = outputStems(unique);
+
+    size_t skipped = 0;
+    for (size_t i = 0; i < unique.size(); ++i) {
+        if (completed.count(unique[i])) {
+            ++skipped;
+            continue;
+        }
+        auto f = std::make_unique<BatchFile>();
+        f->path = unique[i];
+        f->video = isVideo(unique[i]);
+        f->stem = stems[i];
+        f->index = st.files.size();
+        const fs::path dir = (fs::path(opts.outputDir) / f->stem).parent_path();
+        fs::create_directories(dir, ec);
+        if (ec) {
+            std::cerr << "Error: Cannot create output directory " << dir.string() << ": "
+                      << ec.message() << std::endl;
+            return 1;
+        }
+        st.files.push_back(std::move(f));
+    }
+
+    if (!opts.quiet) {
+        std::cout << "[Batch] Script: " << opts.scriptPath << " (pipeline '" << pipeline << "')" << std::endl;
+        std::cout << "[Batch] Inputs: " << st.files.size();
+        if (skipped) std::cout << " (" << skipped << " already done)";
+        std::cout << " | Workers: " << workers << " | Decoders: " << decoders
+                  << " | Prefetch: " << prefetch << std::endl;
+    }
+    if (st.files.empty()) return 0;
+
+    st.checkpoint.open(checkpointPath, opts.resume ? std::ios::app : std::ios::trunc);
+    if (!st.checkpoint.is_open()) {
+        std::cerr << "[Batch] Warning: cannot write checkpoint " << checkpointPath << std::endl;
+    }
+    if (st.sinkCsv) {
+        const std::string csvPath = (fs::path(opts.outputDir) / "batch_results.csv").string();
+        const bool append = opts.resume && fs::exists(csvPath);
+        st.csv.open(csvPath, append ? std::ios::app : std::ios::trunc);
+        if (!append) st.csv << "input,frame,status,ms,width,height,channels\n";
+    }
+
+    // N interpreters each fanning out over OpenCV's full pool would oversubscribe.
+    const int prevCvThreads = cv::getNumThreads();
+    cv::setNumThreads(std::max(1, hw / workers));
+
+    // ---- Run --------------------------------------------------------------
+    auto start = Clock::now();
+    std::vector<std::thread> decoderThreads;
+    std::vector<std::thread> workerThreads;
+    for (int i = 0; i < decoders; ++i) decoderThreads.emplace_back(decodeLoop, std::ref(st));
+    for (int i = 0; i < workers; ++i) workerThreads.emplace_back(workerLoop, std::ref(st), i);
+
+    auto lastReport = start;
+    std::atomic<bool> decodersDone{false};
+    std::thread joiner([&] {
+        for (auto& t : decoderThreads) t.join();
+        st.closeQueues();
+        decodersDone = true;
+    });
+
+    while (!decodersDone.load() || st.queued() > 0) {
+        if (!running.load() || st.stop.load()) {
+            st.stop = true;
+            st.closeQueues();
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto now = Clock::now();
+        if (!opts.quiet && opts.reportIntervalSec > 0 &&
+            std::chrono::duration<double>(now - lastReport).count() >= opts.reportIntervalSec) {
+            lastReport = now;
+            std::lock_guard<std::mutex> lock(st.outMutex);
+            printProgress(st, std::chrono::duration<double>(now - start).count(), false);
+        }
+    }
+    joiner.join();
+    for (auto& t : workerThreads) t.join();
+    cv::setNumThreads(prevCvThreads);
+    StateNamespace::drop("batch/");
+
+    // ---- Summary ----------------------------------------------------------
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    const uint64_t frames = st.framesDone.load() + st.framesFailed.load();
+    if (!opts.quiet) {
+        printProgress(st, seconds, true);
+        std::cout << "[Batch] " << (st.stop.load() ? "Stopped" : "Completed") << " in "
+                  << std::fixed << std::setprecision(2) << seconds << "s" << std::endl;
+        if (frames > 0) {
+            std::cout << "  Pipeline: " << std::setprecision(2)
+                      << (st.pipelineNs.load() / 1e6 / frames) << " ms/frame per worker" << std::endl;
+            std::cout << "  Decode:   " << std::setprecision(2)
+                      << (st.decodeNs.load() / 1e6 / frames) << " ms/frame per decoder" << std::endl;
+        }
+        if (st.filesFailed.load() > 0) {
+            std::cout << "  Failed inputs: " << st.filesFailed.load()
+                      << " (not checkpointed; rerun with --resume to retry)" << std::endl;
+        }
+    }
+
+    if (st.loadFailed.load()) return 1;
+    return (st.filesFailed.load() > 0 || st.stop.load()) ? 1 : 0;
+}
+
+}  // namespace visionpipe
@@ -0,0 +1,57 @@
+/**
+ * VisionPipe Batch Runner
+ *
+ * Offline dataset processing: one script, many input files, N long-lived
+ * workers that each load the script (and its models) once.
+ */
+
+#ifndef VISIONPIPE_BATCH_H
+#define VISIONPIPE_BATCH_H
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace visionpipe {
+
+struct BatchOptions {
+    std::string scriptPath;
+    std::vector<std::string> inputs;        // Files, directories, globs or @list.txt
+    std::string pipelineName;               // Default: 'main', else the first pipeline
+    std::map<std::string, std::string> params;
+    int workers = 0;                        // Interpreter threads (0 = hardware concurrency)
+    int decoders = 0;                       // Prefetch decode threads (0 = workers / 2)
+    int prefetch = 0;                       // Decoded frames queued ahead (0 = 2 * workers)
+    std::vector<std::string> sinks;         // image, csv, none (default: image)
+    std::string outputDir = "batch_out";
+    std::string imageExt = ".png";
+    std::string checkpointPath;             // Default: <outputDir>/batch.checkpoint
+    bool resume = false;                    // Skip inputs already in the checkpoint
+    bool verbose = false;
+    bool quiet = false;
+    double reportIntervalSec = 5.0;
+};
+
+/**
+ * Process every input with the script's pipeline.
+ *
+ * Each input's decoded frame is passed to the pipeline as its input Mat;
+ * the pipeline's result goes to the configured sinks.  An input is appended
+ * to the checkpoint once all of its frames succeeded, so an interrupted or
+ * failed run can be resumed with `resume`.
+ *
+ * @param running Cleared (e.g. by SIGINT) to stop after the in-flight frames
+ * @return 0 when every input succeeded, non-zero otherwise
+ */
+int runBatch(const BatchOptions& opts, const std::atomic<bool>& running);
+
+/// Expand input specs (files, directories, globs, @list.txt) into file paths.
+std::vector<std::string> expandInputs(const std::vector<std::string>& specs);
+
+/// True if @p path has a video file extension.
+bool isVideoInput(const std::string& path);
+
+}  // namespace visionpipe
+
+#endif  // VISIONPIPE_BATCH_H
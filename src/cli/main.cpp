@@ -5,6 +5,7 @@
  * 
  * Usage:
  *   visionpipe run <script.vsp> [--param key=value ...] [--verbose]
+ *   visionpipe batch <script.vsp> <inputs...> [--workers N] [--output <dir>] [--resume]
  *   visionpipe docs [--output <dir>] [--format html|md]
  *   visionpipe validate <script.vsp> [--verbose]
  *   visionpipe version
@@ -25,6 +26,7 @@
 #include "interpreter/runtime.h"
 #include "interpreter/lexer.h"
 #include "interpreter/parser.h"
+#include "tune.h"
 
 // TCP client helpers for the 'params' subcommand
 #if defined(_WIN32)
@@ -97,6 +99,26 @@ struct CLIOptions {
     bool throughputMode = false;            // Debug throughput profiling
     double throughputIntervalSec = 1.0;    // Print interval for throughput table
     bool latencyMode = false;              // Latency percentile reporting (p50/p95/p99)
+    bool planMemory = false;               // Enable static memory planning
+    bool memoryPlan = false;               // Print each pipeline's static memory plan
+    // batch
+    std::vector<std::string> inputs;       // Files, directories, globs or @list.txt
+    std::vector<std::string> sinks;        // image, csv, none
+    int workers = 0;                       // 0 = hardware concurrency
+    int decoders = 0;                      // 0 = workers / 2
+    int prefetch = 0;                      // 0 = 2 * workers
+    std::string imageExt = ".png";
+    std::string checkpointPath;            // Default: <output>/batch.checkpoint
+    bool resume = false;
+    double reportIntervalSec = 5.0;
+    // tune / run --profile
+    std::string profilePath;               // run: profile to apply; tune: profile to write
+    std::string synthetic = "640x480x3";   // tune: WxH[xC] noise frames when no inputs
+    int tuneFrames = 30;
+    int tuneWarmup = 3;
+    int maxTrials = 64;
+    std::string objective = "mean";        // mean | p50 | p95
+    double tolerance = -1;                 // <0 = no output check
 };
 
 // ============================================================================
@@ -131,6 +153,8 @@ Usage:
 
 Commands:
   run <script.vsp>    Execute a VisionPipe script
+  batch <script> <in> Run a script's pipeline over many files with a worker pool
+  tune <script> [in]  Search @tunable params and built-in knobs, write a profile
   validate <script>   Validate script syntax without executing
   params <pid>        Inspect / control a running pipeline's runtime params
   docs                Generate documentation for interpreter items
@@ -151,6 +175,37 @@ Run Options:
   --throughput-interval N  Refresh interval in seconds (default: 1.0, requires --throughput)
   --latency                Enable latency percentile mode (p50/p95/p99/max per pipeline,
                            includes exec_fork child processes via shared-memory arena)
+  --plan-memory            Place intermediate frames in per-pipeline arenas (memory planning)
+  --memory-plan            Print each arena plan when built (implies --plan-memory)
+  --profile <file>         Apply settings written by 'visionpipe tune' (--param wins)
+
+Batch Options:
+  --input, -i <spec>       File, directory, glob or @list.txt (repeatable; extra
+                           positional arguments are inputs too)
+  --pipeline, -P name      Pipeline applied to each frame (default: 'main' or first)
+  --workers N              Interpreter threads, script loaded once each (default: all cores)
+  --decoders N             Prefetch decode threads (default: workers / 2)
+  --prefetch N             Decoded frames queued ahead of the workers (default: 2 x workers)
+  --sink <name>            image | csv | none (repeatable, default: image)
+  --ext <.ext>             Image sink file extension (default: .png)
+  --output, -o <dir>       Output directory for sinks and checkpoint (default: current)
+  --checkpoint <file>      Completed-input log (default: <output>/batch.checkpoint)
+  --resume                 Skip inputs already listed in the checkpoint
+  --report-interval N      Progress print interval in seconds (default: 5)
+
+Tune Options:
+  --input, -i <spec>       Recorded frames: file, directory, glob or @list.txt
+                           (repeatable; default: synthetic noise frames)
+  --synthetic WxH[xC]      Size of the synthetic frames (default: 640x480x3)
+  --pipeline, -P name      Pipeline to tune (default: 'main' or first)
+  --frames N               Timed runs per trial (default: 30)
+  --warmup N               Untimed runs before each trial (default: 3)
+  --max-trials N           Stop after N trials (default: 64)
+  --objective <name>       mean | p50 | p95 latency (default: mean)
+  --tolerance T            Reject configurations whose outputs differ from the
+                           defaults' by more than T mean abs per pixel
+  --profile <file>         Profile to write (default: <output>/<script>.profile)
+  --output, -o <dir>       Output directory for the profile (default: current)
 
 Docs Options:
   --output, -o <dir>       Output directory (default: current)
@@ -163,6 +218,10 @@ Examples:
   visionpipe run stereo.vsp
   visionpipe run stereo.vsp --param brightness=75 --param gain=1.5
   visionpipe validate mypipeline.vsp
+  visionpipe batch detect.vsp 'archive/*.jpg' --workers 8 --sink image --sink csv -o out
+  visionpipe batch detect.vsp @files.txt -o out --resume
+  visionpipe tune detect.vsp 'clips/*.mp4' --tolerance 1.0
+  visionpipe run detect.vsp --profile detect.profile
   visionpipe params 12345              # interactive REPL for PID 12345
   visionpipe params 12345 list         # list all runtime params
   visionpipe params 12345 get brightness
@@ -283,10 +342,49 @@ CLIOptions parseArgs(int argc, char* argv[]) {
             opts.throughputIntervalSec = std::stod(argv[++i]);
         } else if (arg == "--latency") {
             opts.latencyMode = true;
+        } else if (arg == "--plan-memory") {
+            opts.planMemory = true;
+        } else if (arg == "--memory-plan") {
+            opts.memoryPlan = true;
         } else if (arg == "--port" && i + 1 < argc) {
             opts.port = std::stoi(argv[++i]);
+        } else if ((arg == "--input" || arg == "-i") && i + 1 < argc) {
+            opts.inputs.push_back(argv[++i]);
+        } else if (arg == "--workers" && i + 1 < argc) {
+            opts.workers = std::stoi(argv[++i]);
+        } else if (arg == "--decoders" && i + 1 < argc) {
+            opts.decoders = std::stoi(argv[++i]);
+        } else if (arg == "--prefetch" && i + 1 < argc) {
+            opts.prefetch = std::stoi(argv[++i]);
+        } else if (arg == "--sink" && i + 1 < argc) {
+            opts.sinks.push_back(argv[++i]);
+        } else if (arg == "--ext" && i + 1 < argc) {
+            opts.imageExt = argv[++i];
+            if (opts.imageExt[0] != '.') opts.imageExt = "." + opts.imageExt;
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            opts.checkpointPath = argv[++i];
+        } else if (arg == "--resume") {
+            opts.resume = true;
+        } else if (arg == "--report-interval" && i + 1 < argc) {
+            opts.reportIntervalSec = std::stod(argv[++i]);
+        } else if (arg == "--profile" && i + 1 < argc) {
+            opts.profilePath = argv[++i];
+        } else if (arg == "--synthetic" && i + 1 < argc) {
+            opts.synthetic = argv[++i];
+        } else if (arg == "--frames" && i + 1 < argc) {
+            opts.tuneFrames = std::stoi(argv[++i]);
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            opts.tuneWarmup = std::stoi(argv[++i]);
+        } else if (arg == "--max-trials" && i + 1 < argc) {
+            opts.maxTrials = std::stoi(argv[++i]);
+        } else if (arg == "--objective" && i + 1 < argc) {
+            opts.objective = argv[++i];
+        } else if (arg == "--tolerance" && i + 1 < argc) {
+            opts.tolerance = std::stod(argv[++i]);
         } else if (arg[0] != '-' && opts.scriptPath.empty()) {
             opts.scriptPath = arg;
+        } else if (arg[0] != '-' && (opts.command == "batch" || opts.command == "tune")) {
+            opts.inputs.push_back(arg);
         } else if (arg[0] != '-') {
             std::cerr << "Warning: Ignoring extra argument: " << arg << std::endl;
         } else {
@@ -355,6 +453,24 @@ int cmdRun(const CLIOptions& opts) {
         config.interpreterConfig.throughputMode = opts.throughputMode;
         config.interpreterConfig.throughputPrintIntervalSec = opts.throughputIntervalSec;
         config.interpreterConfig.latencyMode = opts.latencyMode;
+        config.interpreterConfig.memoryPlanning = opts.planMemory || opts.memoryPlan;
+        config.interpreterConfig.memoryPlanReport = opts.memoryPlan;
+
+        // Tuned settings; explicit --param values take precedence
+        std::map<std::string, std::string> params = opts.params;
+        if (!opts.profilePath.empty()) {
+            TuneProfile profile;
+            std::string error;
+            if (!profile.load(opts.profilePath, error)) {
+                std::cerr << "Error: " << error << std::endl;
+                return 1;
+            }
+            profile.apply(config, params);
+            if (!opts.quiet) {
+                std::cout << "[VisionPipe] Profile: " << opts.profilePath
+                          << " (" << profile.settings.size() << " settings)" << std::endl;
+            }
+        }
         
         // Create runtime
         Runtime runtime(config);
@@ -363,12 +479,12 @@ int cmdRun(const CLIOptions& opts) {
         
         // Apply initial --param overrides (before run, before declare()
         // fills defaults — ParameterStore::declare only sets if not yet set)
-        for (const auto& [key, value] : opts.params) {
+        for (const auto& [key, value] : params) {
             runtime.setParam(key, value);
         }
-        if (opts.verbose && !opts.params.empty()) {
+        if (opts.verbose && !params.empty()) {
             std::cout << "[VisionPipe] Initial parameters:" << std::endl;
-            for (const auto& [key, value] : opts.params) {
+            for (const auto& [key, value] : params) {
                 std::cout << "  " << key << " = " << value << std::endl;
             }
         }
@@ -469,6 +585,116 @@ int cmdRun(const CLIOptions& opts) {
     }
 }
 
+// ============================================================================
+// Command: batch (uses batch module)
+// ============================================================================
+
+#include "batch.h"
+
+int cmdBatch(const CLIOptions& opts) {
+    if (opts.scriptPath.empty() || opts.inputs.empty()) {
+        std::cerr << "Error: batch needs a script and at least one input" << std::endl;
+        std::cerr << "Usage: visionpipe batch <script.vsp> <file|dir|glob|@list> ..." << std::endl;
+        return 1;
+    }
+
+    if (!fileExists(opts.scriptPath)) {
+        std::cerr << "Error: File not found: " << opts.scriptPath << std::endl;
+        return 1;
+    }
+
+    BatchOptions batchOpts;
+    batchOpts.scriptPath = opts.scriptPath;
+    batchOpts.inputs = opts.inputs;
+    batchOpts.pipelineName = opts.pipelineName;
+    batchOpts.params = opts.params;
+    batchOpts.workers = opts.workers;
+    batchOpts.decoders = opts.decoders;
+    batchOpts.prefetch = opts.prefetch;
+    batchOpts.sinks = opts.sinks;
+    batchOpts.outputDir = opts.outputDir;
+    batchOpts.imageExt = opts.imageExt;
+    batchOpts.checkpointPath = opts.checkpointPath;
+    batchOpts.resume = opts.resume;
+    batchOpts.verbose = opts.verbose;
+    batchOpts.quiet = opts.quiet;
+    batchOpts.reportIntervalSec = opts.reportIntervalSec;
+
+    // No runtime to stop here: workers poll g_running between frames.
+    std::signal(SIGINT, signalHandler);
+#ifndef _WIN32
+    std::signal(SIGTERM, signalHandler);
+#endif
+
+    try {
+        return runBatch(batchOpts, g_running);
+    } catch (const ParseError& e) {
+        std::cerr << "[Parse Error] " << e.what() << std::endl;
+        std::cerr << "  at " << e.location().toString() << std::endl;
+        return 1;
+    } catch (const LexerError& e) {
+        std::cerr << "[Lexer Error] " << e.what() << std::endl;
+        std::cerr << "  at " << e.location().toString() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "[Error] " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+// ============================================================================
+// Command: tune (uses tune module)
+// ============================================================================
+
+int cmdTune(const CLIOptions& opts) {
+    if (opts.scriptPath.empty()) {
+        std::cerr << "Error: No script file specified" << std::endl;
+        std::cerr << "Usage: visionpipe tune <script.vsp> [file|dir|glob|@list] ..." << std::endl;
+        return 1;
+    }
+
+    if (!fileExists(opts.scriptPath)) {
+        std::cerr << "Error: File not found: " << opts.scriptPath << std::endl;
+        return 1;
+    }
+
+    TuneOptions tuneOpts;
+    tuneOpts.scriptPath = opts.scriptPath;
+    tuneOpts.inputs = opts.inputs;
+    tuneOpts.synthetic = opts.synthetic;
+    tuneOpts.pipelineName = opts.pipelineName;
+    tuneOpts.params = opts.params;
+    tuneOpts.frames = opts.tuneFrames;
+    tuneOpts.warmup = opts.tuneWarmup;
+    tuneOpts.maxTrials = opts.maxTrials;
+    tuneOpts.objective = opts.objective;
+    tuneOpts.tolerance = opts.tolerance;
+    tuneOpts.outputDir = opts.outputDir;
+    tuneOpts.profilePath = opts.profilePath;
+    tuneOpts.verbose = opts.verbose;
+    tuneOpts.quiet = opts.quiet;
+
+    std::signal(SIGINT, signalHandler);
+#ifndef _WIN32
+    std::signal(SIGTERM, signalHandler);
+#endif
+
+    try {
+        return runTune(tuneOpts, g_running);
+    } catch (const ParseError& e) {
+        std::cerr << "[Parse Error] " << e.what() << std::endl;
+        std::cerr << "  at " << e.location().toString() << std::endl;
+        return 1;
+    } catch (const LexerError& e) {
+        std::cerr << "[Lexer Error] " << e.what() << std::endl;
+        std::cerr << "  at " << e.location().toString() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "[Error] " << e.what() << std::endl;
+        return 1;
+    }
+}
+
 // ============================================================================
 // Command: validate
 // ============================================================================
@@ -805,6 +1031,10 @@ int main(int argc, char* argv[]) {
         printVersion();
     } else if (opts.command == "run") {
         result = cmdRun(opts);
+    } else if (opts.command == "batch") {
+        result = cmdBatch(opts);
+    } else if (opts.command == "tune") {
+        result = cmdTune(opts);
     } else if (opts.command == "params") {
         // Pass remaining args starting from index 2 (after "params")
         result = cmdParams(argc, argv, 2);
@@ -0,0 +1,493 @@
+/**
+ * VisionPipe Autotuner
+ *
+ * One Runtime loads the script once; every trial applies a configuration
+ * (OpenCV threads, interpreter optimization, @tunable params), runs the
+ * pipeline over the preloaded frames and records its latency.  Knobs are
+ * explored by coordinate descent from the script's defaults, which doubles
+ * as the reference run for the optional output-similarity check.
+ */
+
+#include "tune.h"
+#include "batch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/videoio.hpp>
+
+#include "interpreter/runtime.h"
+#include "interpreter/parser.h"
+#include "interpreter/param_store.h"
+
+namespace fs = std::filesystem;
+
+namespace visionpipe {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Improvement a candidate needs over the current best to be adopted, so
+/// timing noise does not flip knobs back and forth.
+constexpr double kMinGain = 0.02;
+
+std::string trim(const std::string& s) {
+    const size_t b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos) return "";
+    const size_t e = s.find_last_not_of(" \t\r\n");
+    return s.substr(b, e - b + 1);
+}
+
+// ============================================================================
+// Knobs
+// ============================================================================
+
+struct Knob {
+    std::string key;                  ///< cv_threads, memory_plan or param.<name>
+    std::vector<std::string> values;
+};
+
+using TuneConfig = std::vector<size_t>;   ///< Chosen value index per knob
+
+/// Wire form of a literal @tunable / default value, "" if not a literal.
+std::string literalText(const Expression* expr) {
+    if (auto* lit = dynamic_cast<const LiteralExpr*>(expr)) {
+        if (auto* d = std::get_if<double>(&lit->value)) {
+            std::ostringstream os;
+            os << *d;
+            return os.str();
+        }
+        if (auto* s = std::get_if<std::string>(&lit->value)) return *s;
+        if (auto* b = std::get_if<bool>(&lit->value)) return *b ? "true" : "false";
+    }
+    if (auto* un = dynamic_cast<const UnaryExpr*>(expr)) {
+        if (un->op == TokenType::OP_MINUS) {
+            std::string inner = literalText(un->operand.get());
+            if (!inner.empty()) return "-" + inner;
+        }
+    }
+    return "";
+}
+
+std::vector<Knob> collectKnobs(const Program& program, const TuneOptions& opts, TuneConfig& defaults) {
+    std::vector<Knob> knobs;
+
+    // OpenCV threads: powers of two up to the current setting
+    Knob threads{"cv_threads", {}};
+    const int maxThreads = std::max(1, cv::getNumThreads());
+    for (int n = 1; n < maxThreads; n *= 2) threads.values.push_back(std::to_string(n));
+    threads.values.push_back(std::to_string(maxThreads));
+    knobs.push_back(threads);
+    defaults.push_back(threads.values.size() - 1);
+
+    knobs.push_back({"memory_plan", {"false", "true"}});   // Off by default
+    defaults.push_back(0);
+
+    for (const auto& decl : program.paramDecls) {
+        for (const auto& entry : decl->entries) {
+            if (entry.tunableValues.empty() || opts.params.count(entry.name)) continue;
+            Knob k{"param." + entry.name, {}};
+            for (const auto& v : entry.tunableValues) {
+                std::string text = literalText(v.get());
+                if (text.empty()) {
+                    std::cerr << "[Tune] Warning: @tunable value of '" << entry.name
+                              << "' is not a literal; ignored" << std::endl;
+                    continue;
+                }
+                if (std::find(k.values.begin(), k.values.end(), text) == k.values.end()) {
+                    k.values.push_back(text);
+                }
+            }
+            std::string def = entry.defaultValue ? literalText(entry.defaultValue->get()) : "";
+            size_t idx = 0;
+            if (!def.empty()) {
+                auto it = std::find(k.values.begin(), k.values.end(), def);
+                if (it == k.values.end()) {
+                    k.values.insert(k.values.begin(), def);
+                } else {
+                    idx = static_cast<size_t>(it - k.values.begin());
+                }
+            }
+            if (k.values.size() < 2) continue;
+            knobs.push_back(std::move(k));
+            defaults.push_back(idx);
+        }
+    }
+    return knobs;
+}
+
+std::string describe(const std::vector<Knob>& knobs, const TuneConfig& c) {
+    std::ostringstream os;
+    for (size_t k = 0; k < knobs.size(); ++k) {
+        if (k) os << ' ';
+        const std::string& key = knobs[k].key;
+        os << (key.compare(0, 6, "param.") == 0 ? key.substr(6) : key) << '=' << knobs[k].values[c[k]];
+    }
+    return os.str();
+}
+
+// ============================================================================
+// Frames
+// ============================================================================
+
+std::vector<cv::Mat> loadFrames(const TuneOptions& opts) {
+    std::vector<cv::Mat> frames;
+    const size_t limit = static_cast<size_t>(std::max(1, opts.frames));
+
+    for (const auto& path : expandInputs(opts.inputs)) {
+        if (frames.size() >= limit) break;
+        if (isVideoInput(path)) {
+            cv::VideoCapture cap(path);
+            cv::Mat frame;
+            while (frames.size() < limit && cap.read(frame) && !frame.empty()) {
+                frames.push_back(frame.clone());
+            }
+        } else {
+            cv::Mat image = cv::imread(path, cv::IMREAD_COLOR);
+            if (image.empty()) {
+                std::cerr << "[Tune] Cannot decode: " << path << std::endl;
+                continue;
+            }
+            frames.push_back(image);
+        }
+    }
+    if (!opts.inputs.empty()) return frames;
+
+    int w = 0, h = 0, c = 3;
+    char x1 = 0, x2 = 0;
+    std::istringstream is(opts.synthetic);
+    is >> w >> x1 >> h;
+    if (is >> x2) is >> c;
+    if (w <= 0 || h <= 0 || c < 1 || c > 4 || x1 != 'x' || (x2 && x2 != 'x')) {
+        std::cerr << "[Tune] Invalid --synthetic size '" << opts.synthetic
+                  << "' (expected WxH or WxHxC)" << std::endl;
+        return frames;
+    }
+    cv::RNG rng(0x5eed);
+    for (size_t i = 0; i < std::min<size_t>(limit, 4); ++i) {
+        cv::Mat m(h, w, CV_8UC(c));
+        rng.fill(m, cv::RNG::UNIFORM, 0, 256);
+        frames.push_back(m);
+    }
+    return frames;
+}
+
+// ============================================================================
+// Trials
+// ============================================================================
+
+struct Trial {
+    TuneConfig config;
+    bool ok = false;
+    std::string error;
+    double meanMs = 0, p50Ms = 0, p95Ms = 0, fps = 0;
+    double diff = 0;                  ///< Max mean abs diff to the reference outputs
+    std::vector<cv::Mat> outputs;     ///< One per input frame
+
+    double score(const std::string& objective) const {
+        if (objective == "p50") return p50Ms;
+        if (objective == "p95") return p95Ms;
+        return meanMs;
+    }
+};
+
+double meanAbsDiff(const cv::Mat& a, const cv::Mat& b) {
+    if (a.empty() && b.empty()) return 0;
+    if (a.size() != b.size() || a.type() != b.type()) return std::numeric_limits<double>::infinity();
+    return cv::norm(a, b, cv::NORM_L1) / (static_cast<double>(a.total()) * a.channels());
+}
+
+class Tuner {
+public:
+    Tuner(const TuneOptions& opts, std::string pipeline, Runtime& runtime,
+          std::vector<Knob> knobs, std::vector<cv::Mat> frames)
+        : _opts(opts), _pipeline(std::move(pipeline)), _runtime(runtime),
+          _knobs(std::move(knobs)), _frames(std::move(frames)) {}
+
+    const std::vector<Knob>& knobs() const { return _knobs; }
+    size_t trials() const { return _trials; }
+
+    Trial run(const TuneConfig& c, const Trial* reference) {
+        ++_trials;
+        Trial t;
+        t.config = c;
+        apply(c);
+
+        const int total = std::max(0, _opts.warmup) + std::max(1, _opts.frames);
+        std::vector<double> ms;
+        t.outputs.resize(_frames.size());
+        auto start = Clock::now();
+        for (int i = 0; i < total; ++i) {
+            const size_t f = static_cast<size_t>(i) % _frames.size();
+            const bool timed = i >= _opts.warmup;
+            if (timed && ms.empty()) start = Clock::now();
+
+            auto t0 = Clock::now();
+            cv::Mat out;
+            try {
+                out = _runtime.executePipeline(_pipeline, {}, _frames[f]);
+            } catch (const std::exception& e) {
+                t.error = e.what();
+            }
+            if (t.error.empty() && _runtime.interpreter().hasError()) {
+                t.error = _runtime.interpreter().lastError();
+            }
+            if (!t.error.empty()) {
+                _runtime.interpreter().clearError();
+                return t;
+            }
+            if (!timed) continue;
+            ms.push_back(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+            if (t.outputs[f].empty() && !out.empty()) t.outputs[f] = out.clone();
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::sort(ms.begin(), ms.end());
+        double sum = 0;
+        for (double v : ms) sum += v;
+        t.meanMs = sum / ms.size();
+        t.p50Ms = ms[ms.size() / 2];
+        t.p95Ms = ms[std::min(ms.size() - 1, static_cast<size_t>(ms.size() * 0.95))];
+        t.fps = seconds > 0 ? ms.size() / seconds : 0;
+        t.ok = true;
+
+        if (reference) {
+            for (size_t f = 0; f < _frames.size(); ++f) {
+                t.diff = std::max(t.diff, meanAbsDiff(t.outputs[f], reference->outputs[f]));
+            }
+            if (_opts.tolerance >= 0 && t.diff > _opts.tolerance) {
+                t.ok = false;
+                std::ostringstream os;
+                os << "output differs from reference (" << std::setprecision(3) << t.diff << ")";
+                t.error = os.str();
+            }
+        }
+        return t;
+    }
+
+private:
+    void apply(const TuneConfig& c) {
+        for (size_t k = 0; k < _knobs.size(); ++k) {
+            const std::string& key = _knobs[k].key;
+            const std::string& value = _knobs[k].values[c[k]];
+            if (key == "cv_threads") {
+                cv::setNumThreads(std::stoi(value));
+            } else if (key == "memory_plan") {
+                InterpreterConfig cfg = _runtime.interpreter().config();
+                cfg.memoryPlanning = value == "true";
+                _runtime.interpreter().setConfig(cfg);
+            } else if (key.compare(0, 6, "param.") == 0 && _runtime.paramStore()) {
+                _runtime.paramStore()->setFromString(key.substr(6), value);
+            }
+        }
+    }
+
+    const TuneOptions& _opts;
+    std::string _pipeline;
+    Runtime& _runtime;
+    std::vector<Knob> _knobs;
+    std::vector<cv::Mat> _frames;
+    size_t _trials = 0;
+};
+
+void printTrial(const std::vector<Knob>& knobs, const Trial& t, size_t n, bool best) {
+    std::cout << "[Tune] #" << std::setw(3) << n << "  " << describe(knobs, t.config) << "\n       ";
+    if (!t.error.empty()) {
+        std::cout << "rejected: " << t.error << std::endl;
+        return;
+    }
+    std::cout << std::fixed << std::setprecision(2)
+              << "mean " << t.meanMs << " ms | p50 " << t.p50Ms << " ms | p95 " << t.p95Ms
+              << " ms | " << std::setprecision(1) << t.fps << " frames/s"
+              << " | diff " << std::setprecision(3) << t.diff
+              << (best ? "  <- best" : "") << std::endl;
+}
+
+} // namespace
+
+// ============================================================================
+// Profile
+// ============================================================================
+
+bool TuneProfile::load(const std::string& path, std::string& error) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        error = "cannot open profile: " + path;
+        return false;
+    }
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
+        const size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            error = path + ":" + std::to_string(lineNo) + ": expected 'key = value'";
+            return false;
+        }
+        const std::string key = trim(line.substr(0, eq));
+        const std::string value = trim(line.substr(eq + 1));
+        if (key == "script") script = value;
+        else if (key == "pipeline") pipeline = value;
+        else settings[key] = value;
+    }
+    return true;
+}
+
+bool TuneProfile::save(const std::string& path, const std::string& comment) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) return false;
+    out << "# VisionPipe tune profile (apply with: visionpipe run <script> --profile " << path << ")\n";
+    if (!comment.empty()) out << "# " << comment << "\n";
+    out << "script = " << script << "\n";
+    out << "pipeline = " << pipeline << "\n";
+    for (const auto& [key, value] : settings) out << key << " = " << value << "\n";
+    return out.good();
+}
+
+void TuneProfile::apply(RuntimeConfig& config, std::map<std::string, std::string>& params) const {
+    for (const auto& [key, value] : settings) {
+        if (key == "cv_threads") {
+            const int n = std::atoi(value.c_str());
+            if (n > 0) cv::setNumThreads(n);
+        } else if (key == "memory_plan") {
+            config.interpreterConfig.memoryPlanning = value == "true" || value == "1";
+        } else if (key.compare(0, 6, "param.") == 0) {
+            params.emplace(key.substr(6), value);
+        } else {
+            std::cerr << "[Profile] Warning: unknown setting '" << key << "'" << std::endl;
+        }
+    }
+}
+
+// ============================================================================
+// Entry point
+// ============================================================================
+
+int runTune(const TuneOptions& opts, const std::atomic<bool>& running) {
+    auto program = parseFile(opts.scriptPath);
+
+    std::string pipeline = opts.pipelineName;
+    if (pipeline.empty()) {
+        if (program->findPipeline("main")) {
+            pipeline = "main";
+        } else if (!program->pipelines.empty()) {
+            pipeline = program->pipelines.front()->name;
+        }
+    }
+    if (pipeline.empty()) {
+        std::cerr << "Error: Script defines no pipeline to tune" << std::endl;
+        return 1;
+    }
+    if (opts.objective != "mean" && opts.objective != "p50" && opts.objective != "p95") {
+        std::cerr << "Error: Unknown objective '" << opts.objective << "' (expected mean, p50 or p95)" << std::endl;
+        return 1;
+    }
+
+    std::vector<cv::Mat> frames = loadFrames(opts);
+    if (frames.empty()) {
+        std::cerr << "Error: No input frames to tune with" << std::endl;
+        return 1;
+    }
+
+    TuneConfig defaults;
+    std::vector<Knob> knobs = collectKnobs(*program, opts, defaults);
+    const int prevCvThreads = cv::getNumThreads();
+
+    RuntimeConfig config;
+    config.enableDisplay = false;
+    config.enableLogging = opts.verbose;
+    config.interpreterConfig.verbose = opts.verbose;
+    Runtime runtime(config);
+    for (const auto& [key, value] : opts.params) runtime.setParam(key, value);
+    runtime.loadDefinitions(opts.scriptPath);
+
+    if (!opts.quiet) {
+        std::cout << "[Tune] Script: " << opts.scriptPath << " (pipeline '" << pipeline << "')" << std::endl;
+        std::cout << "[Tune] Frames: " << frames.size() << " (" << opts.warmup << " warm-up + "
+                  << opts.frames << " timed runs per trial) | Objective: " << opts.objective << " latency"
+                  << std::endl;
+        for (const auto& k : knobs) {
+            std::cout << "[Tune] Knob " << k.key << ": ";
+            for (size_t i = 0; i < k.values.size(); ++i) std::cout << (i ? ", " : "") << k.values[i];
+            std::cout << std::endl;
+        }
+    }
+
+    Tuner tuner(opts, pipeline, runtime, knobs, std::move(frames));
+
+    // ---- Reference: the script's defaults ---------------------------------
+    Trial best = tuner.run(defaults, nullptr);
+    if (!opts.quiet) printTrial(knobs, best, tuner.trials(), true);
+    if (!best.ok) {
+        cv::setNumThreads(prevCvThreads);
+        std::cerr << "Error: Pipeline fails with its default settings" << std::endl;
+        return 1;
+    }
+    const Trial reference = best;
+
+    // ---- Coordinate descent ----------------------------------------------
+    std::map<TuneConfig, double> seen{{defaults, best.score(opts.objective)}};
+    bool improved = true;
+    while (improved && running.load() && static_cast<int>(tuner.trials()) < opts.maxTrials) {
+        improved = false;
+        for (size_t k = 0; k < knobs.size(); ++k) {
+            const TuneConfig current = best.config;
+            for (size_t v = 0; v < knobs[k].values.size(); ++v) {
+                if (!running.load() || static_cast<int>(tuner.trials()) >= opts.maxTrials) break;
+                TuneConfig candidate = current;
+                candidate[k] = v;
+                if (seen.count(candidate)) continue;
+
+                Trial t = tuner.run(candidate, &reference);
+                seen[candidate] = t.ok ? t.score(opts.objective) : std::numeric_limits<double>::infinity();
+                const bool better = t.ok && t.score(opts.objective) < best.score(opts.objective) * (1.0 - kMinGain);
+                if (!opts.quiet) printTrial(knobs, t, tuner.trials(), better);
+                if (better) {
+                    best = std::move(t);
+                    improved = true;
+                }
+            }
+        }
+    }
+    cv::setNumThreads(prevCvThreads);
+
+    // ---- Profile ---------------------------------------------------------
+    TuneProfile profile;
+    profile.script = opts.scriptPath;
+    profile.pipeline = pipeline;
+    for (size_t k = 0; k < knobs.size(); ++k) profile.settings[knobs[k].key] = knobs[k].values[best.config[k]];
+
+    const std::string path = opts.profilePath.empty()
+        ? (fs::path(opts.outputDir) / (fs::path(opts.scriptPath).stem().string() + ".profile")).string()
+        : opts.profilePath;
+    std::ostringstream summary;
+    summary << std::fixed << std::setprecision(2) << opts.objective << " latency " << best.score(opts.objective)
+            << " ms (defaults: " << reference.score(opts.objective) << " ms), " << tuner.trials() << " trials";
+    if (!profile.save(path, summary.str())) {
+        std::cerr << "Error: Cannot write profile " << path << std::endl;
+        return 1;
+    }
+
+    if (!opts.quiet) {
+        std::cout << "[Tune] Best: " << describe(knobs, best.config) << std::endl;
+        std::cout << "[Tune] " << summary.str() << std::endl;
+        std::cout << "[Tune] Profile written to " << path << std::endl;
+    }
+    return 0;
+}
+
+}  // namespace visionpipe
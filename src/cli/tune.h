@@ -0,0 +1,69 @@
+/**
+ * VisionPipe Autotuner
+ *
+ * Runs one pipeline of a script over recorded or synthetic frames while
+ * exploring tunable knobs -- script params marked @tunable(...) plus built-in
+ * ones such as OpenCV's thread count -- and writes the fastest configuration
+ * to a profile that `visionpipe run --profile` applies.
+ */
+
+#ifndef VISIONPIPE_TUNE_H
+#define VISIONPIPE_TUNE_H
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace visionpipe {
+
+struct RuntimeConfig;
+
+struct TuneOptions {
+    std::string scriptPath;
+    std::vector<std::string> inputs;        // Recorded frames: files, directories, globs or @list.txt
+    std::string synthetic = "640x480x3";    // WxH[xC] noise frames when no inputs are given
+    std::string pipelineName;               // Default: 'main', else the first pipeline
+    std::map<std::string, std::string> params;  // Fixed values; these params are not explored
+    int frames = 30;                        // Timed runs per trial
+    int warmup = 3;                         // Untimed runs before each trial
+    int maxTrials = 64;
+    std::string objective = "mean";         // mean | p50 | p95 latency
+    double tolerance = -1;                  // Max mean abs diff to the reference outputs (<0 = off)
+    std::string outputDir = ".";
+    std::string profilePath;                // Default: <outputDir>/<script stem>.profile
+    bool verbose = false;
+    bool quiet = false;
+};
+
+/**
+ * Settings chosen by `tune`, stored as `key = value` lines:
+ *   cv_threads = N       OpenCV worker threads
+ *   memory_plan = bool   InterpreterConfig::memoryPlanning
+ *   param.<name> = v     Initial value of a script param
+ */
+struct TuneProfile {
+    std::string script;
+    std::string pipeline;
+    std::map<std::string, std::string> settings;
+
+    bool load(const std::string& path, std::string& error);
+    bool save(const std::string& path, const std::string& comment = "") const;
+
+    /// Apply the built-in settings; param.* entries are added to @p params
+    /// unless already set there (explicit --param wins).
+    void apply(RuntimeConfig& config, std::map<std::string, std::string>& params) const;
+};
+
+/**
+ * Explore the script's knobs by coordinate descent from its defaults and
+ * write the best configuration found to the profile.
+ *
+ * @param running Cleared (e.g. by SIGINT) to stop after the current trial
+ * @return 0 when a profile was written, non-zero otherwise
+ */
+int runTune(const TuneOptions& opts, const std::atomic<bool>& running);
+
+}  // namespace visionpipe
+
+#endif  // VISIONPIPE_TUNE_H
@@ -202,6 +202,8 @@ std::string ExecNasyncStmt::toString(int ind) const {
     std::ostringstream oss;
     if (!isInlineBlock()) {
         oss << indent(ind) << "exec_nasync " << pipelineRef->toString(0);
+        if (workers) oss << " workers=" << workers->toString(0);
+        if (strictOrder) oss << " order=strict";
     } else {
         oss << indent(ind) << "exec_nasync start\n";
         for (const auto& s : body) {
@@ -311,6 +313,14 @@ std::string ParamDeclStmt::toString(int ind) const {
         if (e.defaultValue.has_value()) {
             oss << " = " << (*e.defaultValue)->toString(0);
         }
+        if (!e.tunableValues.empty()) {
+            oss << " @tunable(";
+            for (size_t i = 0; i < e.tunableValues.size(); ++i) {
+                if (i) oss << ", ";
+                oss << e.tunableValues[i]->toString(0);
+            }
+            oss << ")";
+        }
         oss << "\n";
     }
     oss << indent(ind) << "]";
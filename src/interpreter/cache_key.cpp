@@ -0,0 +1,56 @@
+#include "interpreter/cache_key.h"
+
+#include <mutex>
+#include <stdexcept>
+
+namespace visionpipe {
+
+CacheKeyTable& CacheKeyTable::instance() {
+    static CacheKeyTable inst;
+    return inst;
+}
+
+CacheKey CacheKeyTable::intern(const std::string& id) {
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        auto it = _index.find(id);
+        if (it != _index.end()) return CacheKey{it->second};
+    }
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    auto [it, inserted] = _index.emplace(id, static_cast<uint32_t>(_names.size()));
+    if (inserted) _names.push_back(id);
+    return CacheKey{it->second};
+}
+
+CacheKey CacheKeyTable::find(const std::string& id) const {
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    auto it = _index.find(id);
+    return it != _index.end() ? CacheKey{it->second} : CacheKey{};
+}
+
+CacheKey CacheKeyTable::numeric(uint16_t key) {
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        auto it = _numeric.find(key);
+        if (it != _numeric.end()) return CacheKey{it->second};
+    }
+    CacheKey k = intern("__num_" + std::to_string(key));
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    _numeric.emplace(key, k.index);
+    return k;
+}
+
+const std::string& CacheKeyTable::name(CacheKey key) const {
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    if (key.index >= _names.size()) {
+        throw std::out_of_range("Invalid cache key");
+    }
+    return _names[key.index];
+}
+
+size_t CacheKeyTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    return _names.size();
+}
+
+} // namespace visionpipe
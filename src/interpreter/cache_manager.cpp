@@ -6,44 +6,160 @@
 
 namespace visionpipe {
 
+// ============================================================================
+// CacheSlots
+// ============================================================================
+
+namespace {
+
+uint64_t nextGeneration() {
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+} // namespace
+
+const CacheEntry* CacheSlots::findDynamic(CacheKey key) const {
+    auto it = _dynamic.find(CacheKeyTable::instance().name(key));
+    return it != _dynamic.end() ? &it->second : nullptr;
+}
+
+CacheEntry& CacheSlots::insert(CacheKey key) {
+    if (key.index >= _slot.size()) _slot.resize(key.index + 1, 0);
+    uint32_t& slot = _slot[key.index];
+    if (slot == 0) {
+        _entries.emplace_back();
+        _keys.push_back(key);
+        slot = static_cast<uint32_t>(_entries.size());
+        // Written by name before the id was interned: take that entry over
+        if (!_dynamic.empty()) {
+            auto it = _dynamic.find(CacheKeyTable::instance().name(key));
+            if (it != _dynamic.end()) {
+                _entries.back() = std::move(it->second);
+                _dynamic.erase(it);
+            }
+        }
+    }
+    CacheEntry& entry = _entries[slot - 1];
+    entry.generation = nextGeneration();
+    return entry;
+}
+
+bool CacheSlots::erase(CacheKey key) {
+    if (!_dynamic.empty()) _dynamic.erase(CacheKeyTable::instance().name(key));
+    if (key.index >= _slot.size() || _slot[key.index] == 0) return false;
+    const uint32_t pos = _slot[key.index] - 1;
+    const uint32_t last = static_cast<uint32_t>(_entries.size() - 1);
+    if (pos != last) {
+        _entries[pos] = std::move(_entries[last]);
+        _keys[pos] = _keys[last];
+        _slot[_keys[pos].index] = pos + 1;
+    }
+    _entries.pop_back();
+    _keys.pop_back();
+    _slot[key.index] = 0;
+    return true;
+}
+
+const CacheEntry* CacheSlots::find(const std::string& id) const {
+    auto it = _dynamic.find(id);
+    return it != _dynamic.end() ? &it->second : nullptr;
+}
+
+CacheEntry* CacheSlots::find(const std::string& id) {
+    auto it = _dynamic.find(id);
+    return it != _dynamic.end() ? &it->second : nullptr;
+}
+
+CacheEntry& CacheSlots::insert(const std::string& id) {
+    CacheEntry& entry = _dynamic[id];
+    entry.generation = nextGeneration();
+    return entry;
+}
+
+bool CacheSlots::erase(const std::string& id) {
+    return _dynamic.erase(id) > 0;
+}
+
+void CacheSlots::clear() {
+    for (CacheKey key : _keys) _slot[key.index] = 0;
+    _entries.clear();
+    _keys.clear();
+    _dynamic.clear();
+}
+
+namespace {
+
+// Name an entry is published under in the SHM arena
+const std::string& nameOf(CacheKey key) { return CacheKeyTable::instance().name(key); }
+const std::string& nameOf(const std::string& id) { return id; }
+
+} // namespace
+
+// ============================================================================
+// CacheManager
+// ============================================================================
+
 CacheManager::CacheManager()
     : _sharedGlobal(std::make_shared<GlobalCacheData>()) {
     // Start with one local scope
-    _localScopes.push_back({});
+    _localScopes.resize(1);
 }
 
 CacheManager::CacheManager(std::shared_ptr<GlobalCacheData> sharedGlobal)
     : _sharedGlobal(std::move(sharedGlobal)) {
     // Start with one local scope
-    _localScopes.push_back({});
+    _localScopes.resize(1);
 }
 
 // ============================================================================
 // Global cache operations
 // ============================================================================
 
-void CacheManager::setGlobal(const std::string& id, const cv::Mat& mat, const std::string& source) {
+template <typename Id>
+void CacheManager::setGlobalImpl(const Id& key, const cv::Mat& mat, const std::string& source) {
+    if (_stageGlobals) {
+        CacheEntry& entry = _staged.insert(key);
+        entry.mat      = mat;
+        entry.source   = source;
+        entry.isGlobal = true;
+        return;
+    }
+
     std::unique_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
     
-    CacheEntry entry;
+    CacheEntry& entry = _sharedGlobal->entries.insert(key);
     entry.mat = mat;
     entry.source = source;
     entry.timestamp = 0;
     entry.accessCount = 0;
     entry.isGlobal = true;
     entry.shmSeq = 0;  // Not sourced from SHM; clear so getGlobal always re-reads
-    
-    _sharedGlobal->entries[id] = std::move(entry);
 
     // In fork child processes, write the frame into the anonymous-mmap arena
     // so the parent (and its threads) can read it via zero-copy getGlobal().
     if (_isForkChild && _shmArena && !mat.empty()) {
         lock.unlock();  // don't hold lock during memcpy into arena
-        shmArenaWrite(_shmArena, id, mat);
+        shmArenaWrite(_shmArena, nameOf(key), mat);
     }
 }
 
-cv::Mat CacheManager::getGlobal(const std::string& id) const {
+void CacheManager::setGlobal(const std::string& id, const cv::Mat& mat, const std::string& source) {
+    CacheKey key = CacheKeyTable::instance().find(id);
+    if (key.valid()) setGlobalImpl(key, mat, source);
+    else             setGlobalImpl(id, mat, source);
+}
+
+void CacheManager::setGlobal(CacheKey key, const cv::Mat& mat, const std::string& source) {
+    setGlobalImpl(key, mat, source);
+}
+
+template <typename Id>
+cv::Mat CacheManager::getGlobalImpl(const Id& key) const {
+    if (_stageGlobals) {
+        if (const CacheEntry* staged = _staged.find(key)) return staged->mat;
+    }
+
     // When fork children are running, use a seq-number write-through cache:
     //
     //   1. Read the SHM slot's writeSeq (one atomic load — very cheap).
@@ -58,16 +174,16 @@ cv::Mat CacheManager::getGlobal(const std::string& id) const {
     // that reads a new frame pays one shmArenaRead + clone; every subsequent
     // caller in the same turn (same writeSeq) pays only one shared_lock read.
     if (_hasForkChildren && _shmArena) {
+        const std::string& id = nameOf(key);
         uint64_t shmSeq = shmArenaGetSeq(_shmArena, id);
         if (shmSeq > 0) {
             // Fast path: in-process cache has the current frame already.
             {
                 std::shared_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
-                auto it = _sharedGlobal->entries.find(id);
-                if (it != _sharedGlobal->entries.end() &&
-                    it->second.shmSeq == shmSeq) {
-                    const_cast<CacheEntry&>(it->second).accessCount++;
-                    return it->second.mat;  // cache hit — no SHM read
+                const CacheEntry* cached = _sharedGlobal->entries.find(key);
+                if (cached && cached->shmSeq == shmSeq) {
+                    const_cast<CacheEntry*>(cached)->accessCount++;
+                    return cached->mat;  // cache hit — no SHM read
                 }
             }
 
@@ -80,7 +196,7 @@ cv::Mat CacheManager::getGlobal(const std::string& id) const {
                 cv::Mat owned = shmMat.clone();
                 {
                     std::unique_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
-                    CacheEntry& entry    = _sharedGlobal->entries[id];
+                    CacheEntry& entry    = _sharedGlobal->entries.insert(key);
                     entry.mat            = owned;
                     entry.shmSeq         = shmSeq;
                     entry.isGlobal       = true;
@@ -102,18 +218,19 @@ cv::Mat CacheManager::getGlobal(const std::string& id) const {
     // Writers identify their entries with shmSeq=0 in the in-process map so
     // we detect them by that sentinel and return without an arena round-trip.
     if (_shmArena && !_hasForkChildren) {
+        const std::string& id = nameOf(key);
         uint64_t shmSeq = shmArenaGetSeq(_shmArena, id);
         if (shmSeq > 0) {
             // Fast path: in-process cache may already have a current copy.
             {
                 std::shared_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
-                auto it = _sharedGlobal->entries.find(id);
-                if (it != _sharedGlobal->entries.end()) {
+                const CacheEntry* cached = _sharedGlobal->entries.find(key);
+                if (cached) {
                     // shmSeq==0 on the entry marks a locally-written frame
                     // (the writer process itself); always treat it as current.
-                    if (it->second.shmSeq == 0 || it->second.shmSeq == shmSeq) {
-                        const_cast<CacheEntry&>(it->second).accessCount++;
-                        return it->second.mat;
+                    if (cached->shmSeq == 0 || cached->shmSeq == shmSeq) {
+                        const_cast<CacheEntry*>(cached)->accessCount++;
+                        return cached->mat;
                     }
                 }
             }
@@ -123,7 +240,7 @@ cv::Mat CacheManager::getGlobal(const std::string& id) const {
                 cv::Mat owned = shmMat.clone();
                 {
                     std::unique_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
-                    CacheEntry& entry = _sharedGlobal->entries[id];
+                    CacheEntry& entry = _sharedGlobal->entries.insert(key);
                     entry.mat         = owned;
                     entry.shmSeq      = shmSeq;
                     entry.isGlobal    = true;
@@ -134,42 +251,103 @@ cv::Mat CacheManager::getGlobal(const std::string& id) const {
         }
     }
 
-    // Fallback: in-process shared map (pre-fork values or direct setGlobal calls).
+    // Fallback: in-process shared store (pre-fork values or direct setGlobal calls).
     std::shared_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
-    auto it = _sharedGlobal->entries.find(id);
-    if (it != _sharedGlobal->entries.end()) {
-        const_cast<CacheEntry&>(it->second).accessCount++;
-        return it->second.mat;
+    if (const CacheEntry* cached = _sharedGlobal->entries.find(key)) {
+        const_cast<CacheEntry*>(cached)->accessCount++;
+        return cached->mat;
     }
     return cv::Mat();
 }
 
-bool CacheManager::hasGlobal(const std::string& id) const {
+cv::Mat CacheManager::getGlobal(const std::string& id) const {
+    CacheKey key = CacheKeyTable::instance().find(id);
+    return key.valid() ? getGlobalImpl(key) : getGlobalImpl(id);
+}
+
+cv::Mat CacheManager::getGlobal(CacheKey key) const {
+    return getGlobalImpl(key);
+}
+
+cv::Mat CacheManager::getGlobal(const CacheRef& ref) const {
+    return ref.key.valid() ? getGlobalImpl(ref.key) : getGlobalImpl(ref.id);
+}
+
+template <typename Id>
+bool CacheManager::hasGlobalImpl(const Id& key) const {
+    if (_stageGlobals && _staged.find(key)) return true;
     // When an SHM arena is attached, check it first — this covers fork
     // grandchildren (e.g. chessboard_loop) that have _hasForkChildren=false
     // but still need to detect frames written by a sibling fork child
     // (e.g. camera_fetch) into the shared arena.
-    if (_shmArena && shmArenaGetSeq(_shmArena, id) > 0) return true;
+    if (_shmArena && shmArenaGetSeq(_shmArena, nameOf(key)) > 0) return true;
     std::shared_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
-    return _sharedGlobal->entries.count(id) > 0;
+    return _sharedGlobal->entries.find(key) != nullptr;
+}
+
+bool CacheManager::hasGlobal(const std::string& id) const {
+    CacheKey key = CacheKeyTable::instance().find(id);
+    return key.valid() ? hasGlobalImpl(key) : hasGlobalImpl(id);
+}
+
+bool CacheManager::hasGlobal(CacheKey key) const {
+    return hasGlobalImpl(key);
 }
 
 void CacheManager::removeGlobal(const std::string& id) {
+    CacheKey key = CacheKeyTable::instance().find(id);
+    if (key.valid()) {
+        removeGlobal(key);
+        return;
+    }
     std::unique_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
     _sharedGlobal->entries.erase(id);
 }
 
+void CacheManager::removeGlobal(CacheKey key) {
+    std::unique_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
+    _sharedGlobal->entries.erase(key);
+}
+
 void CacheManager::clearGlobal() {
     std::unique_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
     _sharedGlobal->entries.clear();
 }
 
+CacheManager::StagedGlobals CacheManager::takeStagedGlobals() {
+    StagedGlobals out;
+    out.keyed.reserve(_staged.size());
+    for (size_t i = 0; i < _staged.size(); ++i) {
+        out.keyed.emplace_back(_staged.keyAt(i), std::move(_staged.entryAt(i)));
+    }
+    for (auto& [id, entry] : _staged.dynamic()) {
+        out.dynamic.emplace_back(id, std::move(entry));
+    }
+    _staged.clear();
+    return out;
+}
+
+void CacheManager::commitGlobals(StagedGlobals& staged) {
+    if (staged.keyed.empty() && staged.dynamic.empty()) return;
+    std::unique_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
+    for (auto& [key, entry] : staged.keyed) {
+        _sharedGlobal->entries.insert(key) = std::move(entry);
+    }
+    for (auto& [id, entry] : staged.dynamic) {
+        _sharedGlobal->entries.insert(id) = std::move(entry);
+    }
+}
+
 std::vector<std::string> CacheManager::getGlobalIds() const {
+    const CacheKeyTable& table = CacheKeyTable::instance();
     std::shared_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
     
     std::vector<std::string> ids;
-    ids.reserve(_sharedGlobal->entries.size());
-    for (const auto& [id, _] : _sharedGlobal->entries) {
+    ids.reserve(_sharedGlobal->entries.size() + _sharedGlobal->entries.dynamic().size());
+    for (size_t i = 0; i < _sharedGlobal->entries.size(); ++i) {
+        ids.push_back(table.name(_sharedGlobal->entries.keyAt(i)));
+    }
+    for (const auto& [id, entry] : _sharedGlobal->entries.dynamic()) {
         ids.push_back(id);
     }
     return ids;
@@ -180,24 +358,22 @@ std::vector<std::string> CacheManager::getGlobalIds() const {
 // ============================================================================
 
 size_t CacheManager::pushScope() {
-    _localScopes.push_back({});
-    return _localScopes.size() - 1;
+    if (_scopeDepth == _localScopes.size()) {
+        _localScopes.emplace_back();
+    }
+    return _scopeDepth++;
 }
 
 void CacheManager::popScope() {
-    if (_localScopes.size() > 1) {
-        _localScopes.pop_back();
-    } else {
-        _localScopes.back().clear();
+    _localScopes[_scopeDepth - 1].clear();
+    if (_scopeDepth > 1) {
+        --_scopeDepth;
     }
 }
 
-void CacheManager::setLocal(const std::string& id, const cv::Mat& mat, const std::string& source) {
-    if (_localScopes.empty()) {
-        _localScopes.push_back({});
-    }
-    
-    CacheEntry entry;
+template <typename Id>
+void CacheManager::setLocalImpl(const Id& key, const cv::Mat& mat, const std::string& source) {
+    CacheEntry& entry = _localScopes[_scopeDepth - 1].insert(key);
     // Shallow copy: local scopes are strictly per-thread, and most items return
     // a newly-allocated cv::Mat rather than modifying the buffer in-place, so
     // there is no risk of the caller mutating the stored Mat through a shared
@@ -208,40 +384,67 @@ void CacheManager::setLocal(const std::string& id, const cv::Mat& mat, const std
     entry.timestamp = 0;   // Timestamps are metadata; skip the syscall in the hot path.
     entry.accessCount = 0;
     entry.isGlobal = false;
-    
-    _localScopes.back()[id] = std::move(entry);
 }
 
-cv::Mat CacheManager::getLocal(const std::string& id) const {
+void CacheManager::setLocal(const std::string& id, const cv::Mat& mat, const std::string& source) {
+    CacheKey key = CacheKeyTable::instance().find(id);
+    if (key.valid()) setLocalImpl(key, mat, source);
+    else             setLocalImpl(id, mat, source);
+}
+
+void CacheManager::setLocal(CacheKey key, const cv::Mat& mat, const std::string& source) {
+    setLocalImpl(key, mat, source);
+}
+
+template <typename Id>
+cv::Mat CacheManager::getLocalImpl(const Id& key) const {
     // Search from innermost scope outward
-    for (auto it = _localScopes.rbegin(); it != _localScopes.rend(); ++it) {
-        auto entryIt = it->find(id);
-        if (entryIt != it->end()) {
-            const_cast<CacheEntry&>(entryIt->second).accessCount++;
-            return entryIt->second.mat;
+    for (size_t i = _scopeDepth; i-- > 0;) {
+        if (const CacheEntry* entry = _localScopes[i].find(key)) {
+            const_cast<CacheEntry*>(entry)->accessCount++;
+            return entry->mat;
         }
     }
     return cv::Mat();
 }
 
-bool CacheManager::hasLocal(const std::string& id) const {
-    for (auto it = _localScopes.rbegin(); it != _localScopes.rend(); ++it) {
-        if (it->count(id) > 0) {
+cv::Mat CacheManager::getLocal(const std::string& id) const {
+    CacheKey key = CacheKeyTable::instance().find(id);
+    return key.valid() ? getLocalImpl(key) : getLocalImpl(id);
+}
+
+cv::Mat CacheManager::getLocal(CacheKey key) const {
+    return getLocalImpl(key);
+}
+
+template <typename Id>
+bool CacheManager::hasLocalImpl(const Id& key) const {
+    for (size_t i = _scopeDepth; i-- > 0;) {
+        if (_localScopes[i].find(key)) {
             return true;
         }
     }
     return false;
 }
 
+bool CacheManager::hasLocal(const std::string& id) const {
+    CacheKey key = CacheKeyTable::instance().find(id);
+    return key.valid() ? hasLocalImpl(key) : hasLocalImpl(id);
+}
+
+bool CacheManager::hasLocal(CacheKey key) const {
+    return hasLocalImpl(key);
+}
+
 void CacheManager::clearLocalScope() {
-    if (!_localScopes.empty()) {
-        _localScopes.back().clear();
-    }
+    _localScopes[_scopeDepth - 1].clear();
 }
 
 void CacheManager::resetLocalScopes() {
-    _localScopes.clear();
-    _localScopes.push_back({});
+    for (size_t i = 0; i < _scopeDepth; ++i) {
+        _localScopes[i].clear();
+    }
+    _scopeDepth = 1;
 }
 
 // ============================================================================
@@ -256,58 +459,119 @@ void CacheManager::set(const std::string& id, const cv::Mat& mat, bool isGlobal,
     }
 }
 
+void CacheManager::set(CacheKey key, const cv::Mat& mat, bool isGlobal, const std::string& source) {
+    if (isGlobal) {
+        setGlobal(key, mat, source);
+    } else {
+        setLocal(key, mat, source);
+    }
+}
+
+void CacheManager::set(const CacheRef& ref, const cv::Mat& mat, bool isGlobal, const std::string& source) {
+    if (ref.key.valid()) {
+        set(ref.key, mat, isGlobal, source);
+    } else if (isGlobal) {
+        setGlobalImpl(ref.id, mat, source);
+    } else {
+        setLocalImpl(ref.id, mat, source);
+    }
+}
+
 cv::Mat CacheManager::get(const std::string& id) const {
+    CacheKey key = CacheKeyTable::instance().find(id);
+    return key.valid() ? get(key) : get(CacheRef{key, id});
+}
+
+cv::Mat CacheManager::get(const CacheRef& ref) const {
+    if (ref.key.valid()) return get(ref.key);
+    cv::Mat localMat = getLocalImpl(ref.id);
+    return localMat.empty() ? getGlobalImpl(ref.id) : localMat;
+}
+
+cv::Mat CacheManager::get(CacheKey key) const {
     // Check local first
-    cv::Mat localMat = getLocal(id);
+    cv::Mat localMat = getLocal(key);
     if (!localMat.empty()) {
         return localMat;
     }
     
     // Fall back to global
-    return getGlobal(id);
+    return getGlobal(key);
 }
 
 bool CacheManager::has(const std::string& id) const {
-    return hasLocal(id) || hasGlobal(id);
+    CacheKey key = CacheKeyTable::instance().find(id);
+    if (key.valid()) return has(key);
+    return hasLocalImpl(id) || hasGlobalImpl(id);
 }
 
-std::optional<CacheEntry> CacheManager::getEntry(const std::string& id) const {
+bool CacheManager::has(CacheKey key) const {
+    return hasLocal(key) || hasGlobal(key);
+}
+
+template <typename Id>
+std::optional<CacheEntry> CacheManager::getEntryImpl(const Id& key) const {
     // Check local first (no locking — local scopes are per-thread)
-    {
-        for (auto it = _localScopes.rbegin(); it != _localScopes.rend(); ++it) {
-            auto entryIt = it->find(id);
-            if (entryIt != it->end()) {
-                return entryIt->second;
-            }
+    for (size_t i = _scopeDepth; i-- > 0;) {
+        if (const CacheEntry* entry = _localScopes[i].find(key)) {
+            return *entry;
         }
     }
     
     // Check global
     {
         std::shared_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
-        auto it = _sharedGlobal->entries.find(id);
-        if (it != _sharedGlobal->entries.end()) {
-            return it->second;
+        if (const CacheEntry* entry = _sharedGlobal->entries.find(key)) {
+            return *entry;
         }
     }
     
     return std::nullopt;
 }
 
+std::optional<CacheEntry> CacheManager::getEntry(const std::string& id) const {
+    CacheKey key = CacheKeyTable::instance().find(id);
+    return key.valid() ? getEntryImpl(key) : getEntryImpl(id);
+}
+
+std::optional<CacheEntry> CacheManager::getEntry(CacheKey key) const {
+    return getEntryImpl(key);
+}
+
+template <typename Id>
+uint64_t CacheManager::generationImpl(const Id& key) const {
+    for (size_t i = _scopeDepth; i-- > 0;) {
+        if (const CacheEntry* entry = _localScopes[i].find(key)) {
+            return entry->generation;
+        }
+    }
+    if (_stageGlobals) {
+        if (const CacheEntry* staged = _staged.find(key)) return staged->generation;
+    }
+    std::shared_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
+    const CacheEntry* entry = _sharedGlobal->entries.find(key);
+    return entry ? entry->generation : 0;
+}
+
+uint64_t CacheManager::generation(const std::string& id) const {
+    CacheKey key = CacheKeyTable::instance().find(id);
+    return key.valid() ? generationImpl(key) : generationImpl(id);
+}
+
 // ============================================================================
 // Numeric key support
 // ============================================================================
 
 void CacheManager::set(uint16_t key, const cv::Mat& mat) {
-    setLocal("__num_" + std::to_string(key), mat);
+    setLocal(CacheKeyTable::instance().numeric(key), mat);
 }
 
 cv::Mat CacheManager::get(uint16_t key) const {
-    return get("__num_" + std::to_string(key));
+    return get(CacheKeyTable::instance().numeric(key));
 }
 
 bool CacheManager::has(uint16_t key) const {
-    return has("__num_" + std::to_string(key));
+    return has(CacheKeyTable::instance().numeric(key));
 }
 
 // ============================================================================
@@ -319,17 +583,25 @@ CacheManager::Stats CacheManager::getStats() const {
     
     {
         std::shared_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
-        stats.globalEntryCount = _sharedGlobal->entries.size();
-        for (const auto& [_, entry] : _sharedGlobal->entries) {
+        const CacheSlots& global = _sharedGlobal->entries;
+        stats.globalEntryCount = global.size() + global.dynamic().size();
+        for (size_t i = 0; i < global.size(); ++i) {
+            stats.totalMemoryBytes += estimateMatMemory(global.entryAt(i).mat);
+        }
+        for (const auto& [id, entry] : global.dynamic()) {
             stats.totalMemoryBytes += estimateMatMemory(entry.mat);
         }
     }
     
     {
-        stats.scopeDepth = _localScopes.size();
-        for (const auto& scope : _localScopes) {
-            stats.localEntryCount += scope.size();
-            for (const auto& [_, entry] : scope) {
+        stats.scopeDepth = _scopeDepth;
+        for (size_t s = 0; s < _scopeDepth; ++s) {
+            const CacheSlots& scope = _localScopes[s];
+            stats.localEntryCount += scope.size() + scope.dynamic().size();
+            for (size_t i = 0; i < scope.size(); ++i) {
+                stats.totalMemoryBytes += estimateMatMemory(scope.entryAt(i).mat);
+            }
+            for (const auto& [id, entry] : scope.dynamic()) {
                 stats.totalMemoryBytes += estimateMatMemory(entry.mat);
             }
         }
@@ -348,23 +620,37 @@ std::string CacheManager::debugString() const {
     oss << "  Scope depth: " << stats.scopeDepth << "\n";
     oss << "  Total memory: " << (stats.totalMemoryBytes / 1024.0 / 1024.0) << " MB\n";
     
+    const CacheKeyTable& table = CacheKeyTable::instance();
     oss << "  Global cache:\n";
     {
         std::shared_lock<std::shared_mutex> lock(_sharedGlobal->mutex);
-        for (const auto& [id, entry] : _sharedGlobal->entries) {
-            oss << "    [" << id << "] " 
+        const CacheSlots& global = _sharedGlobal->entries;
+        for (size_t i = 0; i < global.size(); ++i) {
+            const CacheEntry& entry = global.entryAt(i);
+            oss << "    [" << table.name(global.keyAt(i)) << "] " 
                 << entry.mat.cols << "x" << entry.mat.rows 
                 << " (accessed " << entry.accessCount << " times)\n";
         }
+        for (const auto& [id, entry] : global.dynamic()) {
+            oss << "    [" << id << "] "
+                << entry.mat.cols << "x" << entry.mat.rows
+                << " (accessed " << entry.accessCount << " times)\n";
+        }
     }
     
     oss << "  Local scopes:\n";
     {
 
-        for (size_t i = 0; i < _localScopes.size(); ++i) {
-            oss << "    Scope " << i << ":\n";
-            for (const auto& [id, entry] : _localScopes[i]) {
-                oss << "      [" << id << "] " 
+        for (size_t s = 0; s < _scopeDepth; ++s) {
+            oss << "    Scope " << s << ":\n";
+            const CacheSlots& scope = _localScopes[s];
+            for (size_t i = 0; i < scope.size(); ++i) {
+                const CacheEntry& entry = scope.entryAt(i);
+                oss << "      [" << table.name(scope.keyAt(i)) << "] " 
+                    << entry.mat.cols << "x" << entry.mat.rows << "\n";
+            }
+            for (const auto& [id, entry] : scope.dynamic()) {
+                oss << "      [" << id << "] "
                     << entry.mat.cols << "x" << entry.mat.rows << "\n";
             }
         }
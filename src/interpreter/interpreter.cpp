@@ -1,9 +1,12 @@
 #include "interpreter/interpreter.h"
 #include "interpreter/parser.h"
 #include "interpreter/param_store.h"
+#include "interpreter/memory_planner.h"
 #include "pipeline/pipeline.h"
 #include "pipeline/pipeline_threaded_group.h"
 #include "utils/shm_zero_copy.h"
+#include "utils/shm_frame_transport.h"
+#include "utils/frame_arena.h"
 #include <iostream>
 #include <fstream>
 #include <thread>
@@ -23,6 +26,14 @@ namespace visionpipe {
 // process resets/checks in its tight loop.
 static std::atomic<bool> s_forkChildStopped{false};
 
+// Cache ids written in the script were interned by the parser; ids built at
+// runtime (variable-named outputs) are looked up, not interned.
+static CacheRef resolveCacheRef(CacheKey parsed, const std::string& id) {
+    if (parsed.valid()) return CacheRef{parsed, {}};
+    CacheKey key = CacheKeyTable::instance().find(id);
+    return key.valid() ? CacheRef{key, {}} : CacheRef{key, id};
+}
+
 // ============================================================================
 // Constructor / Destructor
 // ============================================================================
@@ -86,6 +97,9 @@ Interpreter::~Interpreter() {
     // Stop persistent exec_nasync worker threads.
     shutdownNasyncWorkers();
 
+    // Stop map_rois worker pools.
+    shutdownRoiPools();
+
     // Stop fork children (sends SIGTERM, waits, cleans up arena).
     shutdownForkChildren();
 
@@ -539,17 +553,17 @@ void Interpreter::shutdownMultiWorkers() {
 }
 
 void Interpreter::shutdownNasyncWorkers() {
-    for (auto& [name, nw] : _nasyncWorkers) {
-        if (nw && nw->sync) {
-            {
-                std::lock_guard<std::mutex> lk(nw->sync->mtx);
-                nw->sync->shutdown = true;
-            }
-            nw->sync->cv.notify_one();
+    for (auto& [name, pool] : _nasyncPools) {
+        {
+            std::lock_guard<std::mutex> lk(pool->sync->mtx);
+            pool->sync->shutdown = true;
+        }
+        pool->sync->cv.notify_all();
+        for (auto& w : pool->workers) {
+            if (w.thread.joinable()) w.thread.join();
         }
-        if (nw && nw->thread.joinable()) nw->thread.join();
     }
-    _nasyncWorkers.clear();
+    _nasyncPools.clear();
 }
 
 void Interpreter::initMultiWorkers(const std::vector<std::string>& names,
@@ -659,6 +673,7 @@ void Interpreter::resetWorkerState(Interpreter& worker, const cv::Mat& inputMat,
     // Clear execution control flags.
     worker._context.reset();
     worker._context.currentMat = inputMat;  // caller supplies a per-worker copy
+    worker._context.frameGeneration = _context.frameGeneration;   // same frame as the parent
 
     // Reset verbose/debug flags so debug_start in frame N does not bleed into
     // frame N+1 when the same worker Interpreter is reused across frames.
@@ -827,6 +842,7 @@ void Interpreter::execExecLoop(ExecLoopStmt* stmt) {
         _context.debugDump = false;
         _debugDump         = false;
         _context.frameNotReady = false;
+        _context.nextFrame();
 
         // Check condition if present
         if (stmt->condition.has_value()) {
@@ -1199,27 +1215,101 @@ void Interpreter::execExecRtMulti(ExecRtMultiStmt* stmt) {
 }
 
 // ============================================================================
-// exec_nasync  (fire-and-forget with persistent worker threads)
+// exec_nasync  (fire-and-forget with persistent worker pools)
 //
 // Semantics:
 //   • The current Mat is shared (shallow copy) for the async thread.  Pipeline
 //     items produce new buffers so the parent's Mat is unaffected.
-//   • For named pipelines, a persistent worker thread is reused across frames.
-//     If the worker is still busy from the previous frame, the new invocation
-//     is silently skipped (preserving fire-and-forget semantics).
+//   • For named pipelines, a pool of persistent worker threads (workers=N,
+//     default 1) is reused across frames, fed by a bounded queue of N frames.
+//     When the queue is full, order=latest (default) displaces the oldest
+//     waiting frame and order=strict drops the new one.
+//   • With N > 1, global-cache writes are staged per frame and published in
+//     input order (strict) or newest-wins (latest); see publishNasync().
 //   • For inline blocks, the original detached-thread behaviour is preserved
 //     because inline blocks have no stable name to key the worker on.
 //   • The calling thread's Mat is left unchanged (bypass behaviour).
 //
 // Forms:
-//   exec_nasync pipeline_name        – run named pipeline (persistent worker)
+//   exec_nasync pipeline_name [workers=N] [order=strict|latest]
 //   exec_nasync start ... end        – run inline anonymous block (detached)
 // ============================================================================
 
+NasyncPoolStats Interpreter::NasyncPoolSync::snapshot() {
+    NasyncPoolStats st;
+    st.pipeline    = pipelineName;
+    st.workers     = workers;
+    st.strictOrder = strictOrder;
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        st.queueDepth    = queue.size();
+        st.maxQueueDepth = maxQueueDepth;
+        st.submitted     = submittedCount;
+        st.dropped       = droppedCount;
+    }
+    {
+        std::lock_guard<std::mutex> lk(publishMtx);
+        st.reorderDepth = reorder.size();
+        st.published    = publishedCount;
+        st.stale        = staleCount;
+        st.avgLatencyMs = publishedCount > 0
+            ? static_cast<double>(totalLatencyNs) / 1e6 / publishedCount : 0.0;
+        st.maxLatencyMs = static_cast<double>(maxLatencyNs) / 1e6;
+    }
+    return st;
+}
+
+std::vector<NasyncPoolStats> Interpreter::nasyncPoolStats() const {
+    std::vector<NasyncPoolStats> out;
+    out.reserve(_nasyncPools.size());
+    for (const auto& [name, pool] : _nasyncPools) {
+        out.push_back(pool->sync->snapshot());
+    }
+    return out;
+}
+
+void Interpreter::publishNasync(NasyncPoolSync& pool, const NasyncJob& job,
+                                CacheManager::StagedGlobals writes, CacheManager& cache) {
+    using clock = std::chrono::steady_clock;
+    std::lock_guard<std::mutex> lk(pool.publishMtx);
+
+    auto record = [&pool](clock::time_point submitted) {
+        uint64_t ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                clock::now() - submitted).count());
+        ++pool.publishedCount;
+        pool.totalLatencyNs += ns;
+        pool.maxLatencyNs = std::max(pool.maxLatencyNs, ns);
+    };
+
+    if (!pool.strictOrder) {
+        // Newest wins: a slow worker must not overwrite a newer frame's result.
+        if (job.seq < pool.nextPublish) {
+            ++pool.staleCount;
+            return;
+        }
+        cache.commitGlobals(writes);
+        pool.nextPublish = job.seq + 1;
+        record(job.submitted);
+        return;
+    }
+
+    // Strict: hold results until every earlier frame has been published.
+    // Sequence numbers are only issued to accepted frames, so there are no gaps.
+    pool.reorder.emplace(job.seq, NasyncPoolSync::Finished{std::move(writes), job.submitted});
+    for (auto it = pool.reorder.begin();
+         it != pool.reorder.end() && it->first == pool.nextPublish;
+         it = pool.reorder.erase(it)) {
+        cache.commitGlobals(it->second.writes);
+        record(it->second.submitted);
+        ++pool.nextPublish;
+    }
+}
+
 void Interpreter::execExecNasync(ExecNasyncStmt* stmt) {
 
     if (!stmt->isInlineBlock()) {
-        // ── Named pipeline form ── persistent worker thread ──────────────────
+        // ── Named pipeline form ── persistent worker pool ────────────────────
         std::string pname;
         std::vector<RuntimeValue> args;
 
@@ -1236,90 +1326,116 @@ void Interpreter::execExecNasync(ExecNasyncStmt* stmt) {
             return;
         }
 
-        // Shallow copy of the Mat — the async thread must not mutate it.
-        cv::Mat asyncMat = _context.currentMat;
-
-        // Find or create persistent worker for this pipeline name.
-        auto it = _nasyncWorkers.find(pname);
-        if (it == _nasyncWorkers.end()) {
-            // First invocation: create the worker.
-            auto nw   = std::make_shared<NasyncWorker>();
-            nw->sync  = std::make_shared<NasyncWorkerSync>();
-            nw->interp = std::make_unique<Interpreter>(_config);
-            nw->interp->_pipelines = _pipelines;
-            nw->interp->_registry  = _registry;
-            if (_throughputTable) nw->interp->_throughputTable = _throughputTable;
-            auto sharedGlobal = _cacheManager.getGlobalData();
-            nw->interp->_cacheManager.replaceGlobalData(sharedGlobal);
-            nw->interp->_context.cacheManager = &nw->interp->_cacheManager;
-            if (_paramStore) nw->interp->_paramStore = _paramStore;
-
-            // Propagate fork-child awareness so arena reads work.
-            nw->interp->_hasForkChildren = _hasForkChildren;
-            nw->interp->_cacheManager.setHasForkChildren(_hasForkChildren);
-            nw->interp->_cacheManager.setShmArena(_shmArena);
-
-            auto  syncPtr  = nw->sync;
-            auto* interpRaw = nw->interp.get();
-
-            nw->thread = std::thread([syncPtr, interpRaw]() {
-                while (true) {
-                    std::unique_lock<std::mutex> lk(syncPtr->mtx);
-                    syncPtr->cv.wait(lk, [&] { return syncPtr->hasWork || syncPtr->shutdown; });
-                    if (syncPtr->shutdown) break;
-                    syncPtr->hasWork = false;
-                    syncPtr->busy    = true;
-                    std::string name    = syncPtr->pipelineName;
-                    std::vector<RuntimeValue> a = syncPtr->args;
-                    cv::Mat mat         = syncPtr->inputMat;
-                    lk.unlock();
-
-                    // Reset per-frame state.
-                    interpRaw->_context.reset();
-                    interpRaw->_context.currentMat     = mat;
-                    interpRaw->_context.cacheManager   = &interpRaw->_cacheManager;
-                    interpRaw->_context.verbose         = interpRaw->_config.verbose;
-                    interpRaw->_context.debugDump       = false;
-                    interpRaw->_cacheManager.resetLocalScopes();
-                    interpRaw->_scopes.clear();
-                    interpRaw->_scopes.emplace_back();
-                    interpRaw->_recursionDepth = 0;
+        // Find or create the pool for this pipeline name.  Its size and
+        // ordering are fixed by the first invocation.
+        auto it = _nasyncPools.find(pname);
+        if (it == _nasyncPools.end()) {
+            int workers = 1;
+            if (stmt->workers) {
+                workers = std::max(1, static_cast<int>(evalExpression(stmt->workers.get()).asNumber()));
+            }
 
-                    try {
-                        interpRaw->executePipeline(name, a, mat);
-                    } catch (const std::exception& e) {
-                        std::cerr << "[exec_nasync] Error in pipeline '"
-                                  << name << "': " << e.what() << "\n";
-                    }
+            auto pool  = std::make_shared<NasyncPool>();
+            pool->sync = std::make_shared<NasyncPoolSync>();
+            auto syncPtr = pool->sync;
+            syncPtr->pipelineName = pname;
+            syncPtr->workers      = workers;
+            syncPtr->strictOrder  = stmt->strictOrder;
+            syncPtr->staged       = workers > 1;
+            syncPtr->capacity     = static_cast<size_t>(workers);
 
-                    {
-                        std::lock_guard<std::mutex> lk2(syncPtr->mtx);
-                        syncPtr->busy = false;
+            auto sharedGlobal = _cacheManager.getGlobalData();
+            pool->workers.resize(workers);
+            for (auto& w : pool->workers) {
+                w.interp = std::make_unique<Interpreter>(_config);
+                w.interp->_pipelines = _pipelines;
+                w.interp->_registry  = _registry;
+                if (_throughputTable) w.interp->_throughputTable = _throughputTable;
+                w.interp->_cacheManager.replaceGlobalData(sharedGlobal);
+                w.interp->_context.cacheManager = &w.interp->_cacheManager;
+                if (_paramStore) w.interp->_paramStore = _paramStore;
+
+                // Propagate fork-child awareness so arena reads work.
+                w.interp->_hasForkChildren = _hasForkChildren;
+                w.interp->_cacheManager.setHasForkChildren(_hasForkChildren);
+                w.interp->_cacheManager.setShmArena(_shmArena);
+
+                auto* interpRaw = w.interp.get();
+
+                w.thread = std::thread([syncPtr, interpRaw]() {
+                    while (true) {
+                        NasyncJob job;
+                        {
+                            std::unique_lock<std::mutex> lk(syncPtr->mtx);
+                            syncPtr->cv.wait(lk, [&] { return syncPtr->shutdown || !syncPtr->queue.empty(); });
+                            if (syncPtr->shutdown) break;
+                            job = std::move(syncPtr->queue.front());
+                            syncPtr->queue.pop_front();
+                        }
+
+                        // Reset per-frame state.
+                        interpRaw->_context.reset();
+                        interpRaw->_context.currentMat     = job.inputMat;
+                        interpRaw->_context.cacheManager   = &interpRaw->_cacheManager;
+                        interpRaw->_context.verbose         = interpRaw->_config.verbose;
+                        interpRaw->_context.debugDump       = false;
+                        interpRaw->_cacheManager.resetLocalScopes();
+                        interpRaw->_cacheManager.replaceGlobalData(job.global);
+                        interpRaw->_cacheManager.setStageGlobals(syncPtr->staged);
+                        if (job.paramStore) interpRaw->_paramStore = job.paramStore;
+                        interpRaw->_scopes.clear();
+                        interpRaw->_scopes.emplace_back();
+                        interpRaw->_recursionDepth = 0;
+
+                        try {
+                            interpRaw->executePipeline(syncPtr->pipelineName, job.args, job.inputMat);
+                        } catch (const std::exception& e) {
+                            std::cerr << "[exec_nasync] Error in pipeline '"
+                                      << syncPtr->pipelineName << "': " << e.what() << "\n";
+                        }
+
+                        // Publish even after an error so strict order never stalls.
+                        CacheManager::StagedGlobals writes;
+                        if (syncPtr->staged) {
+                            writes = interpRaw->_cacheManager.takeStagedGlobals();
+                            interpRaw->_cacheManager.setStageGlobals(false);
+                        }
+                        job.inputMat.release();
+                        publishNasync(*syncPtr, job, std::move(writes), interpRaw->_cacheManager);
                     }
-                }
-            });
+                });
+            }
 
-            it = _nasyncWorkers.emplace(pname, std::move(nw)).first;
+            if (_throughputTable) {
+                std::lock_guard<std::mutex> lk(_throughputTable->mutex);
+                _throughputTable->nasyncPools.push_back(syncPtr);
+            }
+            it = _nasyncPools.emplace(pname, std::move(pool)).first;
         }
 
-        // Signal the persistent worker if it is idle.
+        // Queue the frame (shallow copy — the async thread must not mutate it).
         auto& sync = *it->second->sync;
         {
             std::lock_guard<std::mutex> lk(sync.mtx);
-            if (sync.busy) {
-                // Worker is still processing previous frame — skip.
-                return;
+            if (sync.queue.size() >= sync.capacity) {
+                ++sync.droppedCount;
+                if (sync.strictOrder) {
+                    // Every worker busy and the queue full — skip this frame.
+                    return;
+                }
+                // Latest: the new frame displaces the oldest waiting one.
+                sync.queue.pop_front();
             }
-            // Refresh the shared global cache pointer (cheap swap).
-            it->second->interp->_cacheManager.replaceGlobalData(
-                _cacheManager.getGlobalData());
-            if (_paramStore)
-                it->second->interp->_paramStore = _paramStore;
-
-            sync.pipelineName = pname;
-            sync.args         = std::move(args);
-            sync.inputMat     = asyncMat;
-            sync.hasWork      = true;
+            NasyncJob job;
+            job.seq        = sync.nextSeq++;
+            job.args       = std::move(args);
+            job.inputMat   = _context.currentMat;
+            job.global     = _cacheManager.getGlobalData();
+            job.paramStore = _paramStore;
+            job.submitted  = std::chrono::steady_clock::now();
+            sync.queue.push_back(std::move(job));
+            ++sync.submittedCount;
+            sync.maxQueueDepth = std::max(sync.maxQueueDepth, sync.queue.size());
         }
         sync.cv.notify_one();
 
@@ -1368,6 +1484,267 @@ void Interpreter::execExecNasync(ExecNasyncStmt* stmt) {
     // Main thread continues immediately with the original (unchanged) Mat.
 }
 
+// ============================================================================
+// map_rois  (per-detection sub-pipeline over a worker pool)
+//
+//   map_rois(<pipeline>, "detections", max_parallel) [-> "id"]
+//
+// Each row of the detections Mat ([x, y, w, h, ...], e.g. the N x 6 output
+// of the YOLO decoders) selects a zero-copy view of the current frame; the
+// sub-pipeline runs once per view and receives (index, detection row) for
+// as many parameters as it declares.  The call returns a list aligned with
+// the detection rows holding each run's return value, or its output Mat
+// when it returns nothing; failed or empty ROIs yield void.  The current
+// Mat is left unchanged.  With a cache output, the results are stacked one
+// row per detection.
+// ============================================================================
+
+// Stack per-ROI results into one Mat, one row per detection.
+static bool stackRoiResults(const std::vector<RuntimeValue>& results, cv::Mat& out,
+                            std::string& error) {
+    out.release();
+    if (results.empty()) return true;
+
+    if (results.front().isMat()) {
+        const cv::Mat& first = results.front().asMat();
+        const size_t total = first.total() * first.channels();
+        out.create(static_cast<int>(results.size()), static_cast<int>(total), first.depth());
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (!results[i].isMat()) {
+                error = "result " + std::to_string(i) + " is not a Mat";
+                return false;
+            }
+            const cv::Mat& m = results[i].asMat();
+            if (m.depth() != first.depth() || m.total() * m.channels() != total) {
+                error = "result " + std::to_string(i) + " differs in size or type from result 0";
+                return false;
+            }
+            cv::Mat row = m.isContinuous() ? m : m.clone();
+            row.reshape(1, 1).copyTo(out.row(static_cast<int>(i)));
+        }
+        return true;
+    }
+
+    out.create(static_cast<int>(results.size()), 1, CV_64F);
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (!results[i].isNumeric()) {
+            error = "result " + std::to_string(i) + " is neither a Mat nor a number";
+            return false;
+        }
+        out.at<double>(static_cast<int>(i)) = results[i].asNumber();
+    }
+    return true;
+}
+
+Interpreter::RoiPool& Interpreter::acquireRoiPool(const std::string& pipelineName, int workers) {
+    auto it = _roiPools.find(pipelineName);
+    if (it != _roiPools.end() && static_cast<int>(it->second->workers.size()) == workers) {
+        return *it->second;
+    }
+
+    // New pipeline, or max_parallel changed: rebuild the pool.
+    if (it != _roiPools.end()) {
+        auto& old = *it->second;
+        {
+            std::lock_guard<std::mutex> lk(old.sync->mtx);
+            old.sync->shutdown = true;
+        }
+        old.sync->startCv.notify_all();
+        for (auto& w : old.workers) {
+            if (w.thread.joinable()) w.thread.join();
+        }
+        _roiPools.erase(it);
+    }
+
+    auto pool  = std::make_shared<RoiPool>();
+    pool->sync = std::make_shared<RoiPoolSync>();
+    auto syncPtr      = pool->sync;
+    auto sharedGlobal = _cacheManager.getGlobalData();
+
+    pool->workers.resize(workers);
+    for (auto& w : pool->workers) {
+        w.interp = std::make_unique<Interpreter>(_config);
+        w.interp->_pipelines = _pipelines;
+        w.interp->_registry  = _registry;
+        if (_throughputTable) w.interp->_throughputTable = _throughputTable;
+        if (_paramStore) w.interp->_paramStore = _paramStore;
+        w.interp->_cacheManager.replaceGlobalData(sharedGlobal);
+        w.interp->_context.cacheManager = &w.interp->_cacheManager;
+
+        // Propagate fork-child awareness so arena reads work.
+        w.interp->_hasForkChildren = _hasForkChildren;
+        w.interp->_cacheManager.setHasForkChildren(_hasForkChildren);
+        w.interp->_cacheManager.setShmArena(_shmArena);
+
+        auto* interpRaw = w.interp.get();
+
+        w.thread = std::thread([syncPtr, interpRaw]() {
+            uint64_t seen = 0;
+            while (true) {
+                RoiBatch* batch = nullptr;
+                {
+                    std::unique_lock<std::mutex> lk(syncPtr->mtx);
+                    syncPtr->startCv.wait(lk, [&] { return syncPtr->shutdown || syncPtr->generation != seen; });
+                    if (syncPtr->shutdown) break;
+                    seen  = syncPtr->generation;
+                    batch = syncPtr->batch;
+                }
+
+                const size_t count = batch->rois.size();
+                for (size_t i = batch->next.fetch_add(1); i < count; i = batch->next.fetch_add(1)) {
+                    const cv::Rect& roi = batch->rois[i];
+                    if (roi.empty()) continue;
+
+                    interpRaw->_context.reset();
+                    interpRaw->_cacheManager.resetLocalScopes();
+                    interpRaw->_recursionDepth = 0;
+
+                    std::vector<RuntimeValue> args;
+                    if (batch->paramCount > 0) args.emplace_back(static_cast<int64_t>(i));
+                    if (batch->paramCount > 1) args.emplace_back(batch->detections.row(static_cast<int>(i)));
+
+                    try {
+                        cv::Mat out = interpRaw->executePipeline(batch->pipelineName, args,
+                                                                 batch->frame(roi));
+                        if (interpRaw->hasError()) {
+                            batch->errors[i] = interpRaw->lastError();
+                            interpRaw->clearError();
+                        } else if (!interpRaw->_context.returnValue.isVoid()) {
+                            batch->results[i] = interpRaw->_context.returnValue;
+                        } else {
+                            batch->results[i] = RuntimeValue(out);
+                        }
+                    } catch (const std::exception& e) {
+                        batch->errors[i] = e.what();
+                        interpRaw->clearError();
+                        interpRaw->_scopes.resize(1);  // Drop scopes the throw left pushed
+                    }
+                }
+
+                std::lock_guard<std::mutex> lk(syncPtr->mtx);
+                if (--syncPtr->active == 0) syncPtr->doneCv.notify_all();
+            }
+        });
+    }
+
+    return *_roiPools.emplace(pipelineName, std::move(pool)).first->second;
+}
+
+RuntimeValue Interpreter::evalMapRois(FunctionCallExpr* expr) {
+    if (expr->arguments.size() < 2) {
+        reportError("map_rois requires a pipeline and a detections cache id", expr->location);
+        return RuntimeValue();
+    }
+
+    // Pipeline: bare name, call form (arguments ignored) or string.
+    std::string pname = resolvePipelineRef(expr->arguments[0].get(), *this).first;
+    if (pname.empty()) pname = evalExpression(expr->arguments[0].get()).asString();
+    auto pipeline = getPipeline(pname);
+    if (!pipeline) {
+        reportError("map_rois: pipeline not found: " + pname, expr->location);
+        return RuntimeValue();
+    }
+
+    // Detections: cache id (or a Mat expression).
+    RuntimeValue detArg = evalExpression(expr->arguments[1].get());
+    cv::Mat detections;
+    if (detArg.isMat()) {
+        detections = detArg.asMat();
+    } else {
+        const CacheKey parsed = expr->argKeys.size() > 1 ? expr->argKeys[1] : CacheKey{};
+        detections = _cacheManager.get(resolveCacheRef(parsed, detArg.asString()));
+    }
+    if (!detections.empty() && (detections.channels() != 1 || detections.cols < 4)) {
+        reportError("map_rois: detections must be an N x 4+ single-channel Mat [x, y, w, h, ...]",
+                    expr->location);
+        return RuntimeValue();
+    }
+
+    int maxParallel = expr->arguments.size() > 2
+                          ? static_cast<int>(evalExpression(expr->arguments[2].get()).asNumber())
+                          : static_cast<int>(std::thread::hardware_concurrency());
+    maxParallel = std::max(1, maxParallel);
+
+    const cv::Mat& frame = _context.currentMat;
+    RoiBatch batch;
+    batch.pipelineName = pname;
+    batch.paramCount   = pipeline->parameters.size();
+    batch.frame        = frame;
+    detections.convertTo(batch.detections, CV_32F);
+
+    const cv::Rect bounds(0, 0, frame.cols, frame.rows);
+    batch.rois.reserve(batch.detections.rows);
+    for (int r = 0; r < batch.detections.rows; ++r) {
+        const float* d = batch.detections.ptr<float>(r);
+        batch.rois.push_back(cv::Rect(cvRound(d[0]), cvRound(d[1]), cvRound(d[2]), cvRound(d[3])) & bounds);
+    }
+    batch.results.resize(batch.rois.size());
+    batch.errors.resize(batch.rois.size());
+
+    if (!batch.rois.empty() && !frame.empty()) {
+        // Sized by max_parallel alone, so a varying detection count reuses the
+        // pool; workers beyond the ROI count find the counter exhausted.
+        RoiPool& pool = acquireRoiPool(pname, maxParallel);
+
+        // Workers are idle here; seed them with this frame's globals.
+        for (auto& w : pool.workers) {
+            w.interp->_scopes.clear();
+            w.interp->_scopes.push_back(_scopes.empty() ? Scope{} : _scopes.front());
+            w.interp->_cacheManager.replaceGlobalData(_cacheManager.getGlobalData());
+            w.interp->_context.verbose = w.interp->_config.verbose;
+            if (_paramStore) w.interp->_paramStore = _paramStore;
+        }
+
+        std::unique_lock<std::mutex> lk(pool.sync->mtx);
+        pool.sync->batch  = &batch;
+        pool.sync->active = pool.workers.size();
+        ++pool.sync->generation;
+        pool.sync->startCv.notify_all();
+        pool.sync->doneCv.wait(lk, [&] { return pool.sync->active == 0; });
+        pool.sync->batch = nullptr;
+    }
+
+    size_t failed = 0;
+    for (size_t i = 0; i < batch.errors.size(); ++i) {
+        if (batch.errors[i].empty()) continue;
+        if (failed++ == 0) {
+            std::cerr << "[map_rois] " << pname << " failed on ROI " << i << ": "
+                      << batch.errors[i] << "\n";
+        }
+    }
+    if (failed > 1) {
+        std::cerr << "[map_rois] " << pname << " failed on " << failed << " of "
+                  << batch.rois.size() << " ROIs\n";
+    }
+
+    if (expr->cacheOutput.has_value()) {
+        cv::Mat stacked;
+        std::string error;
+        if (!stackRoiResults(batch.results, stacked, error)) {
+            reportError("map_rois: cannot cache results: " + error, expr->location);
+            return RuntimeValue();
+        }
+        _cacheManager.set(resolveCacheRef(expr->cacheOutput->cacheKey, expr->cacheOutput->cacheId),
+                          stacked, expr->cacheOutput->isGlobal);
+    }
+
+    return RuntimeValue(std::move(batch.results));
+}
+
+void Interpreter::shutdownRoiPools() {
+    for (auto& [name, pool] : _roiPools) {
+        {
+            std::lock_guard<std::mutex> lk(pool->sync->mtx);
+            pool->sync->shutdown = true;
+        }
+        pool->sync->startCv.notify_all();
+        for (auto& w : pool->workers) {
+            if (w.thread.joinable()) w.thread.join();
+        }
+    }
+    _roiPools.clear();
+}
+
 // ============================================================================
 // exec_fork  (child process via fork())
 //
@@ -1460,8 +1837,15 @@ void Interpreter::execExecFork(ExecForkStmt* stmt) {
         for (auto& w : _multiWorkers) {
             if (w.thread.joinable()) w.thread.detach();
         }
-        for (auto& [name, nw] : _nasyncWorkers) {
-            if (nw && nw->thread.joinable()) nw->thread.detach();
+        for (auto& [name, pool] : _nasyncPools) {
+            for (auto& w : pool->workers) {
+                if (w.thread.joinable()) w.thread.detach();
+            }
+        }
+        for (auto& [name, pool] : _roiPools) {
+            for (auto& w : pool->workers) {
+                if (w.thread.joinable()) w.thread.detach();
+            }
         }
         // Do NOT lock _intervalMutex here — the thread that held it in
         // the parent no longer exists in the child, so the mutex may be
@@ -1473,7 +1857,8 @@ void Interpreter::execExecFork(ExecForkStmt* stmt) {
         // Clear parent's thread-based workers (they don't exist in the child).
         _multiWorkers.clear();
         _multiWorkerTopology.clear();
-        _nasyncWorkers.clear();
+        _nasyncPools.clear();
+        _roiPools.clear();
         _intervalWorkers.clear();  // interval threads don't exist in child
         _forkChildren.clear();  // child doesn't own parent's children
 
@@ -1690,9 +2075,9 @@ void Interpreter::execUse(UseStmt* stmt) {
     cv::Mat mat;
     
     if (stmt->isGlobal) {
-        mat = _cacheManager.getGlobal(stmt->cacheId);
+        mat = _cacheManager.getGlobal(resolveCacheRef(stmt->cacheKey, stmt->cacheId));
     } else {
-        mat = _cacheManager.get(stmt->cacheId);
+        mat = _cacheManager.get(resolveCacheRef(stmt->cacheKey, stmt->cacheId));
     }
 
     // When fork children are active and the frame hasn't arrived yet,
@@ -1715,21 +2100,22 @@ void Interpreter::execUse(UseStmt* stmt) {
     // Handle optional cache output: use("a") -> "b"
     if (stmt->cacheOutput.has_value()) {
         const auto& output = stmt->cacheOutput.value();
-        _cacheManager.set(output.cacheId, mat.clone(), output.isGlobal);
+        _cacheManager.set(resolveCacheRef(output.cacheKey, output.cacheId), mat.clone(), output.isGlobal);
     }
 }
 
 void Interpreter::execCache(CacheStmt* stmt) {
     // If no value expression provided, cache the current mat
     if (!stmt->value) {
-        _cacheManager.set(stmt->cacheId, _context.currentMat.clone(), stmt->isGlobal);
+        _cacheManager.set(resolveCacheRef(stmt->cacheKey, stmt->cacheId),
+                          _context.currentMat.clone(), stmt->isGlobal);
         return;
     }
     
     RuntimeValue value = evalExpression(stmt->value.get());
     
     if (value.isMat()) {
-        _cacheManager.set(stmt->cacheId, value.asMat(), stmt->isGlobal);
+        _cacheManager.set(resolveCacheRef(stmt->cacheKey, stmt->cacheId), value.asMat(), stmt->isGlobal);
     } else {
         // Store as variable instead
         if (stmt->isGlobal) {
@@ -1752,9 +2138,10 @@ void Interpreter::execGlobalPromote(GlobalStmt* stmt) {
     }
 
     // global "cache_id"  — promote a local cache entry to the global cache store.
-    cv::Mat mat = _cacheManager.get(stmt->cacheId);
+    const CacheRef key = resolveCacheRef(stmt->cacheKey, stmt->cacheId);
+    cv::Mat mat = _cacheManager.get(key);
     if (!mat.empty()) {
-        _cacheManager.set(stmt->cacheId, mat.clone(), true);  // true = global
+        _cacheManager.set(key, mat.clone(), true);  // true = global
     } else if (_config.strictMode) {
         reportError("Cache entry not found for global promotion: " + stmt->cacheId, stmt->location);
     }
@@ -1927,12 +2314,18 @@ RuntimeValue Interpreter::evalFunctionCall(FunctionCallExpr* expr) {
         
         // Handle cache output
         if (expr->cacheOutput.has_value()) {
-            _cacheManager.set(expr->cacheOutput->cacheId, result, expr->cacheOutput->isGlobal);
+            _cacheManager.set(resolveCacheRef(expr->cacheOutput->cacheKey, expr->cacheOutput->cacheId),
+                              result, expr->cacheOutput->isGlobal);
         }
         
         return RuntimeValue(result);
     }
     
+    // map_rois needs the interpreter itself, so it is a built-in, not an item.
+    if (expr->functionName == "map_rois") {
+        return evalMapRois(expr);
+    }
+
     // Check if it's a registered item
     auto item = _registry.getItem(expr->functionName);
     if (item) {
@@ -1995,6 +2388,34 @@ RuntimeValue Interpreter::evalFunctionCall(FunctionCallExpr* expr) {
             return RuntimeValue();
         }
         
+        // Hand the parse-time keys of literal arguments to the item, lined
+        // up with the resolved positional args.  Saved and restored because
+        // items may re-enter the interpreter (e.g. pipeline-running items).
+        std::vector<CacheKey> namedArgKeys;
+        const std::vector<CacheKey>* argKeys = &expr->argKeys;
+        if (!expr->namedArguments.empty()) {
+            namedArgKeys = expr->argKeys;
+            namedArgKeys.resize(args.size());
+            const auto& paramDefs = item->params();
+            for (size_t ni = 0; ni < expr->namedArguments.size(); ++ni) {
+                for (size_t pi = 0; pi < paramDefs.size() && pi < namedArgKeys.size(); ++pi) {
+                    if (paramDefs[pi].name == expr->namedArguments[ni].first) {
+                        namedArgKeys[pi] = expr->namedArgKeys[ni];
+                        break;
+                    }
+                }
+            }
+            argKeys = &namedArgKeys;
+        }
+        struct ArgKeysGuard {
+            ExecutionContext& ctx;
+            const std::vector<CacheKey>* prev;
+            const SourceLocation* prevSite;
+            ~ArgKeysGuard() { ctx.argKeys = prev; ctx.callSite = prevSite; }
+        } argKeysGuard{_context, _context.argKeys, _context.callSite};
+        _context.argKeys = argKeys;
+        _context.callSite = &expr->location;
+
         // Execute item
         ExecutionResult result = item->execute(args, _context);
         
@@ -2010,8 +2431,8 @@ RuntimeValue Interpreter::evalFunctionCall(FunctionCallExpr* expr) {
         
         // Handle cache output
         if (expr->cacheOutput.has_value()) {
-            _cacheManager.set(expr->cacheOutput->cacheId, result.outputMat, 
-                            expr->cacheOutput->isGlobal);
+            _cacheManager.set(resolveCacheRef(expr->cacheOutput->cacheKey, expr->cacheOutput->cacheId),
+                              result.outputMat, expr->cacheOutput->isGlobal);
         }
         
         // Update context mat
@@ -2173,9 +2594,9 @@ RuntimeValue Interpreter::evalCacheAccess(CacheAccessExpr* expr) {
     cv::Mat mat;
     
     if (expr->isGlobal) {
-        mat = _cacheManager.getGlobal(expr->cacheId);
+        mat = _cacheManager.getGlobal(resolveCacheRef(expr->cacheKey, expr->cacheId));
     } else {
-        mat = _cacheManager.get(expr->cacheId);
+        mat = _cacheManager.get(resolveCacheRef(expr->cacheKey, expr->cacheId));
     }
     
     return RuntimeValue(mat);
@@ -2197,7 +2618,10 @@ RuntimeValue Interpreter::evalCacheLoad(CacheLoadExpr* expr) {
     
     // Load the cached Mat
     cv::Mat cachedMat;
-    if (expr->isGlobal) {
+    if (!expr->isDynamic) {
+        const CacheRef key = resolveCacheRef(expr->cacheKey, cacheId);
+        cachedMat = expr->isGlobal ? _cacheManager.getGlobal(key) : _cacheManager.get(key);
+    } else if (expr->isGlobal) {
         cachedMat = _cacheManager.getGlobal(cacheId);
     } else {
         cachedMat = _cacheManager.get(cacheId);
@@ -2289,6 +2713,17 @@ RuntimeValue Interpreter::evalParamRef(ParamRefExpr* expr) {
 // Pipeline execution
 // ============================================================================
 
+/// Region name if @p stmt is a plain shm_write("literal") call, else nullptr.
+static const std::string* shmWriteTarget(const Statement* stmt) {
+    if (!stmt || stmt->nodeType != ASTNodeType::EXPRESSION_STMT) return nullptr;
+    auto* call = dynamic_cast<FunctionCallExpr*>(
+        static_cast<const ExpressionStmt*>(stmt)->expression.get());
+    if (!call || call->functionName != "shm_write" || call->arguments.empty()) return nullptr;
+    auto* lit = dynamic_cast<LiteralExpr*>(call->arguments[0].get());
+    if (!lit) return nullptr;
+    return std::get_if<std::string>(&lit->value);
+}
+
 cv::Mat Interpreter::executePipelineDecl(PipelineDecl* pipeline, 
                                           const std::vector<RuntimeValue>& args,
                                           const cv::Mat& input) {
@@ -2336,9 +2771,25 @@ cv::Mat Interpreter::executePipelineDecl(PipelineDecl* pipeline,
     
     // Set input mat
     _context.currentMat = input;
+    // Held for the whole body: a nested call may replace the stored plan.
+    std::shared_ptr<const MemoryPlan> plan = memoryPlanFor(pipeline, input);
     
     // Execute pipeline body
-    for (const auto& stmt : pipeline->body) {
+    for (size_t si = 0; si < pipeline->body.size(); ++si) {
+        const auto& stmt = pipeline->body[si];
+        // A statement feeding shm_write("name") allocates its output
+        // directly in the region's free buffer, so the write is copy-free.
+        std::optional<ShmOutputScope> shmOutput;
+        if (si + 1 < pipeline->body.size()) {
+            if (const std::string* region = shmWriteTarget(pipeline->body[si + 1].get())) {
+                shmOutput.emplace(*region);
+            }
+        }
+        // Otherwise a planned intermediate goes to its slot in the arena.
+        std::optional<FrameArenaScope> arenaOutput;
+        if (plan && !shmOutput && plan->slotOf[si] >= 0) {
+            arenaOutput.emplace(plan->arena, static_cast<size_t>(plan->slotOf[si]));
+        }
         executeStatement(stmt);
         
         if (_context.shouldReturn) {
@@ -2355,8 +2806,8 @@ cv::Mat Interpreter::executePipelineDecl(PipelineDecl* pipeline,
     
     // Handle pipeline-level cache output
     if (pipeline->cacheOutput.has_value()) {
-        _cacheManager.set(pipeline->cacheOutput->cacheId, result, 
-                         pipeline->cacheOutput->isGlobal);
+        _cacheManager.set(resolveCacheRef(pipeline->cacheOutput->cacheKey, pipeline->cacheOutput->cacheId),
+                          result, pipeline->cacheOutput->isGlobal);
     }
     
     // Clean up scope
@@ -2385,6 +2836,23 @@ cv::Mat Interpreter::executePipelineDecl(PipelineDecl* pipeline,
     return result;
 }
 
+std::shared_ptr<const MemoryPlan> Interpreter::memoryPlanFor(const PipelineDecl* pipeline, const cv::Mat& input) {
+    if (!_config.memoryPlanning) return nullptr;
+    FrameShape shape = FrameShape::of(input);
+    auto& plans = _memoryPlans[pipeline];
+    auto it = std::find_if(plans.begin(), plans.end(),
+                           [&](const std::shared_ptr<MemoryPlan>& p) { return p->input == shape; });
+    if (it == plans.end()) {
+        if (plans.size() >= kMemoryPlansPerPipeline) plans.pop_back();
+        plans.insert(plans.begin(), planPipelineMemory(*pipeline, shape, _registry, _pipelines));
+        if (_config.memoryPlanReport) std::cout << plans.front()->report() << std::flush;
+    } else if (it != plans.begin()) {
+        std::rotate(plans.begin(), it, it + 1);
+    }
+    const std::shared_ptr<MemoryPlan>& plan = plans.front();
+    return plan->arena ? plan : nullptr;
+}
+
 // ============================================================================
 // Scope management
 // ============================================================================
@@ -2683,6 +3151,46 @@ void Interpreter::ThroughputTable::startPrinter(double intervalSec) {
                 }
                 std::cout << oss.str() << std::flush;
             }
+
+            // ── exec_nasync pools ─────────────────────────────────────────────
+            std::vector<std::shared_ptr<NasyncPoolSync>> pools;
+            {
+                std::lock_guard<std::mutex> lk(mutex);
+                pools = nasyncPools;
+            }
+            if (!pools.empty()) {
+                const int totalWidth = W + 8 + 8 + 8 + 10 + 10 + 8 + 10 + 10;
+                std::ostringstream oss;
+                oss << "\n[Nasync] " << std::string(totalWidth, '-') << '\n';
+                oss << "[Nasync]  "
+                    << std::left  << std::setw(W)  << "Pipeline"
+                    << std::right << std::setw(8)  << "workers"
+                    << std::right << std::setw(8)  << "order"
+                    << std::right << std::setw(8)  << "queue"
+                    << std::right << std::setw(10) << "accepted"
+                    << std::right << std::setw(10) << "dropped"
+                    << std::right << std::setw(8)  << "stale"
+                    << std::right << std::setw(10) << "avg ms"
+                    << std::right << std::setw(10) << "max ms"
+                    << '\n';
+                oss << "[Nasync]  " << std::string(totalWidth, '-') << '\n';
+                for (const auto& p : pools) {
+                    NasyncPoolStats st = p->snapshot();
+                    std::string queue = std::to_string(st.queueDepth) + "/" + std::to_string(st.maxQueueDepth);
+                    oss << "[Nasync]  "
+                        << std::left  << std::setw(W)  << st.pipeline
+                        << std::right << std::setw(8)  << st.workers
+                        << std::right << std::setw(8)  << (st.strictOrder ? "strict" : "latest")
+                        << std::right << std::setw(8)  << queue
+                        << std::right << std::setw(10) << st.submitted
+                        << std::right << std::setw(10) << st.dropped
+                        << std::right << std::setw(8)  << st.stale
+                        << std::right << std::setw(10) << std::fixed << std::setprecision(2) << st.avgLatencyMs
+                        << std::right << std::setw(10) << std::fixed << std::setprecision(2) << st.maxLatencyMs
+                        << '\n';
+                }
+                std::cout << oss.str() << std::flush;
+            }
         }
     });
 }
@@ -1,5 +1,7 @@
 #include "interpreter/item_registry.h"
 #include "interpreter/tensor_types.h"
+#include "interpreter/lexer.h"
+#include <atomic>
 #include <sstream>
 #include <algorithm>
 #include <iomanip>
@@ -262,6 +264,31 @@ std::string RuntimeValue::debugString() const {
     return oss.str();
 }
 
+// ============================================================================
+// ExecutionContext
+// ============================================================================
+
+CacheRef ExecutionContext::cacheRefArg(const std::vector<RuntimeValue>& args, size_t index,
+                                       const std::string& fallback) const {
+    if (argKeys && index < argKeys->size() && (*argKeys)[index].valid()) {
+        return CacheRef{(*argKeys)[index], {}};
+    }
+    CacheRef ref;
+    ref.id = args.size() > index ? args[index].asString() : fallback;
+    ref.key = CacheKeyTable::instance().find(ref.id);
+    if (ref.key.valid()) ref.id.clear();
+    return ref;
+}
+
+std::string ExecutionContext::callSiteId(const std::string& prefix) const {
+    return callSite ? prefix + "@" + callSite->toString() : prefix;
+}
+
+void ExecutionContext::nextFrame() {
+    static std::atomic<uint64_t> counter{0};
+    frameGeneration = counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 // ============================================================================
 // InterpreterItem
 // ============================================================================
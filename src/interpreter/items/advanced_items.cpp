@@ -1,7 +1,10 @@
 #include "interpreter/items/advanced_items.h"
 #include "interpreter/cache_manager.h"
+#include "utils/exposure_fusion.h"
+#include "utils/primitive_rasterizer.h"
 #include <iostream>
 #include <chrono>
+#include <algorithm>
 
 namespace visionpipe {
 
@@ -10,6 +13,7 @@ void registerAdvancedItems(ItemRegistry& registry) {
     registry.add<CalcOpticalFlowPyrLKItem>();
     registry.add<CalcOpticalFlowFarnebackItem>();
     registry.add<DrawOpticalFlowItem>();
+    registry.add<DenseFlowItem>();
     
     // Background Subtraction
     registry.add<BackgroundSubtractorMOG2Item>();
@@ -30,6 +34,7 @@ void registerAdvancedItems(ItemRegistry& registry) {
     // HDR
     registry.add<CreateMergeMertensItem>();
     registry.add<MergeExposuresItem>();
+    registry.add<ExposureFusionItem>();
     registry.add<TonemapItem>();
     registry.add<TonemapDragoItem>();
     registry.add<TonemapReinhardItem>();
@@ -180,6 +185,121 @@ ExecutionResult CalcOpticalFlowFarnebackItem::execute(const std::vector<RuntimeV
     return ExecutionResult::ok(flow);
 }
 
+// ============================================================================
+// DenseFlowItem
+// ============================================================================
+
+DenseFlowState::DenseFlowState(const std::string& preset) : _preset(preset) {
+    int p = cv::DISOpticalFlow::PRESET_FAST;
+    if (preset == "ultrafast") p = cv::DISOpticalFlow::PRESET_ULTRAFAST;
+    else if (preset == "medium") p = cv::DISOpticalFlow::PRESET_MEDIUM;
+    _dis = cv::DISOpticalFlow::create(p);
+}
+
+cv::Mat DenseFlowState::compute(const cv::Mat& frame, bool warmStart, int stride) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Convert into the buffer that held the frame before last; the swap
+    // below turns it into _prevGray, so steady state allocates nothing.
+    // DIS takes 8-bit gray only.  Scales are fixed (16-bit full range,
+    // float 0-1) so brightness does not shift between frames.
+    const int depth = frame.depth();
+    cv::Mat gray = depth == CV_8U ? _gray : cv::Mat();
+    if (frame.channels() == 3)      cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+    else if (frame.channels() == 4) cv::cvtColor(frame, gray, cv::COLOR_BGRA2GRAY);
+    else if (depth == CV_8U)        frame.copyTo(gray);
+    else                            gray = frame;
+    if (depth == CV_8U) {
+        _gray = gray;
+    } else {
+        const double scale = depth == CV_16U ? 1.0 / 256.0
+                           : (depth == CV_32F || depth == CV_64F) ? 255.0 : 1.0;
+        gray.convertTo(_gray, CV_8U, scale);
+    }
+
+    if (_prevGray.size() != _gray.size()) {
+        _flow.release();
+        cv::swap(_prevGray, _gray);
+        _frames = 1;
+        return cv::Mat();
+    }
+
+    const bool useInitial = warmStart && _flow.size() == _gray.size();
+    _dis->setUseInitialFlow(useInitial);
+    if (!useInitial) _flow.release();
+    _dis->calc(_prevGray, _gray, _flow);
+
+    cv::swap(_prevGray, _gray);
+    ++_frames;
+
+    // Copied out under the lock: _flow is next frame's initial estimate,
+    // refined in place by the next caller.
+    cv::Mat result;
+    if (stride == 1) {
+        result = _flow.clone();
+    } else {
+        // Average down and express vectors in output-grid pixels.
+        cv::Size outSize((_flow.cols + stride - 1) / stride, (_flow.rows + stride - 1) / stride);
+        cv::resize(_flow, result, outSize, 0, 0, cv::INTER_AREA);
+        result *= 1.0 / stride;
+    }
+    return result;
+}
+
+DenseFlowItem::DenseFlowItem() {
+    _functionName = "dense_flow";
+    _description = "Dense optical flow with a persistent DIS instance per cache_id and temporal warm start";
+    _category = "advanced";
+    _params = {
+        ParamDef::optional("preset", BaseType::STRING, "DIS preset: ultrafast, fast, medium", "fast"),
+        ParamDef::optional("cache_id", BaseType::STRING, "Flow cache ID, also keys the flow state (empty = state per call site, not cached)", ""),
+        ParamDef::optional("stride", BaseType::INT, "Output stride (1 = full resolution, 4 = quarter)", 1),
+        ParamDef::optional("warm_start", BaseType::BOOL, "Initialise from the previous flow", true)
+    };
+    _example = "dense_flow(\"fast\", \"\", 4)";
+    _returnType = "mat";
+    _tags = {"optical_flow", "dis", "dense", "motion"};
+}
+
+ExecutionResult DenseFlowItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
+    std::string preset = args.size() > 0 ? args[0].asString() : "fast";
+    std::string cacheId = args.size() > 1 ? args[1].asString() : "";
+    const bool cached = !cacheId.empty();
+    if (!cached) {
+        cacheId = ctx.callSiteId(_functionName);
+    }
+    int stride = args.size() > 2 ? std::max(1, static_cast<int>(args[2].asNumber())) : 1;
+    bool warmStart = args.size() > 3 ? args[3].asBool() : true;
+
+    if (preset != "ultrafast" && preset != "fast" && preset != "medium") {
+        return ExecutionResult::fail("dense_flow: unknown preset '" + preset + "'");
+    }
+    if (ctx.currentMat.empty()) {
+        return ExecutionResult::fail("dense_flow: empty input frame");
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto state = DenseFlowRegistry::instance().acquire(cacheId, preset);
+    cv::Mat result = state->compute(ctx.currentMat, warmStart, stride);
+    if (result.empty()) {
+        // First frame: no motion yet, but downstream items get a valid field.
+        result = cv::Mat::zeros((ctx.currentMat.rows + stride - 1) / stride,
+                                (ctx.currentMat.cols + stride - 1) / stride, CV_32FC2);
+    }
+
+    if (cached) {
+        ctx.cacheManager->set(cacheId, result);
+    }
+
+    if (ctx.verbose) {
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - t0).count();
+        std::cout << "[dense_flow] " << cacheId << ": " << ms << " ms/frame (" << preset
+                  << ", stride " << stride << ", frame " << state->frameCount() << ")" << std::endl;
+    }
+    return ExecutionResult::ok(result);
+}
+
 // ============================================================================
 // DrawOpticalFlowItem
 // ============================================================================
@@ -235,51 +355,186 @@ ExecutionResult DrawOpticalFlowItem::execute(const std::vector<RuntimeValue>& ar
             cv::cvtColor(result, result, cv::COLOR_GRAY2BGR);
         }
         
+        // All arrows are rasterized together, tile-parallel
+        step = std::max(step, 1);
+        PrimitiveBatch arrows;
+        arrows.reserve(static_cast<size_t>((flowOpt.rows + step - 1) / step) *
+                       ((flowOpt.cols + step - 1) / step) * 3);
         for (int y = 0; y < flowOpt.rows; y += step) {
+            const cv::Vec2f* flowRow = flowOpt.ptr<cv::Vec2f>(y);
             for (int x = 0; x < flowOpt.cols; x += step) {
-                cv::Vec2f flow = flowOpt.at<cv::Vec2f>(y, x);
+                const cv::Vec2f& flow = flowRow[x];
                 cv::Point2f from(x, y);
                 cv::Point2f to(x + flow[0] * scale, y + flow[1] * scale);
-                cv::arrowedLine(result, from, to, cv::Scalar(0, 255, 0), 1, cv::LINE_AA);
+                arrows.arrow(from, to, cv::Scalar(0, 255, 0));
             }
         }
+        arrows.render(result, cv::LINE_AA);
     }
     
     return ExecutionResult::ok(result);
 }
 
+// ============================================================================
+// BackgroundModel
+// ============================================================================
+
+void BackgroundModel::allocate(const cv::Size& modelSize, int type) {
+    _modelSize = modelSize;
+    _type      = type;
+    _frames    = 0;
+
+    // Strips shorter than ~32 rows cost more in per-call overhead than they
+    // gain in parallelism.
+    int n = _cfg.strips > 0 ? _cfg.strips : std::max(1, cv::getNumThreads());
+    n = std::max(1, std::min(n, modelSize.height / 32));
+
+    _strips.clear();
+    _rowRanges.clear();
+    for (int i = 0; i < n; ++i) {
+        int y0 = modelSize.height * i / n;
+        int y1 = modelSize.height * (i + 1) / n;
+        _rowRanges.emplace_back(y0, y1);
+        if (_cfg.algorithm == "knn") {
+            _strips.push_back(cv::createBackgroundSubtractorKNN(
+                _cfg.history, _cfg.threshold, _cfg.detectShadows));
+        } else {
+            _strips.push_back(cv::createBackgroundSubtractorMOG2(
+                _cfg.history, _cfg.threshold, _cfg.detectShadows));
+        }
+    }
+    _smallMask.create(modelSize, CV_8U);
+}
+
+cv::Mat BackgroundModel::apply(const cv::Mat& frame, double learningRate, int warmupFrames) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    cv::Size modelSize = frame.size();
+    if (_cfg.modelScale < 1.0) {
+        modelSize.width  = std::max(1, cvRound(frame.cols * _cfg.modelScale));
+        modelSize.height = std::max(1, cvRound(frame.rows * _cfg.modelScale));
+    }
+    if (modelSize != _modelSize || frame.type() != _type || _strips.empty()) {
+        allocate(modelSize, frame.type());
+    }
+
+    const cv::Mat* input = &frame;
+    if (modelSize != frame.size()) {
+        cv::resize(frame, _small, modelSize, 0, 0, cv::INTER_AREA);
+        input = &_small;
+    }
+
+    double rate = learningRate;
+    if (static_cast<int64_t>(_frames) < warmupFrames) {
+        double bootstrap = 1.0 / static_cast<double>(_frames + 1);
+        rate = (rate < 0) ? bootstrap : std::max(rate, bootstrap);
+    }
+
+    // Each strip writes straight into its row range of the shared mask;
+    // BackgroundSubtractor::apply() keeps a correctly sized ROI as-is.
+    cv::parallel_for_(cv::Range(0, static_cast<int>(_strips.size())), [&](const cv::Range& r) {
+        for (int i = r.start; i < r.end; ++i) {
+            cv::Mat stripMask = _smallMask.rowRange(_rowRanges[i]);
+            _strips[i]->apply(input->rowRange(_rowRanges[i]), stripMask, rate);
+        }
+    });
+    ++_frames;
+
+    if (modelSize == frame.size()) {
+        return _smallMask.clone();
+    }
+    cv::Mat mask;
+    cv::resize(_smallMask, mask, frame.size(), 0, 0, cv::INTER_NEAREST);
+    return mask;
+}
+
+cv::Mat BackgroundModel::background() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_strips.empty() || _frames == 0) return cv::Mat();
+
+    cv::Mat bg(_modelSize, _type);
+    for (size_t i = 0; i < _strips.size(); ++i) {
+        cv::Mat part;
+        _strips[i]->getBackgroundImage(part);
+        if (part.empty()) return cv::Mat();
+        part.copyTo(bg.rowRange(_rowRanges[i]));
+    }
+    return bg;
+}
+
+// Shared by the three background items: run the model, report timing.
+static ExecutionResult runBackgroundModel(const std::string& itemName, const std::string& cacheId,
+                                          BackgroundModel& model, double learningRate,
+                                          int warmupFrames, ExecutionContext& ctx) {
+    if (ctx.currentMat.empty()) {
+        return ExecutionResult::fail(itemName + ": empty input frame");
+    }
+    if (!ctx.verbose) {
+        return ExecutionResult::ok(model.apply(ctx.currentMat, learningRate, warmupFrames));
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    cv::Mat mask = model.apply(ctx.currentMat, learningRate, warmupFrames);
+    {
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - t0).count();
+        cv::Size modelSize = model.modelSize();
+        std::cout << "[" << itemName << "] " << cacheId << ": " << ms << " ms/frame"
+                  << " (model " << modelSize.width << "x" << modelSize.height
+                  << ", " << model.stripCount() << " strips, frame " << model.frameCount() << ")"
+                  << std::endl;
+    }
+    return ExecutionResult::ok(mask);
+}
+
+static BackgroundModelConfig readBackgroundConfig(const std::string& algorithm,
+                                                  const std::vector<RuntimeValue>& args,
+                                                  double defaultThreshold) {
+    BackgroundModelConfig cfg;
+    cfg.algorithm     = algorithm;
+    cfg.history       = args.size() > 0 ? static_cast<int>(args[0].asNumber()) : 500;
+    cfg.threshold     = args.size() > 1 ? args[1].asNumber() : defaultThreshold;
+    cfg.detectShadows = args.size() > 2 ? args[2].asBool() : true;
+    cfg.modelScale    = args.size() > 5 ? args[5].asNumber() : 1.0;
+    cfg.strips        = args.size() > 6 ? static_cast<int>(args[6].asNumber()) : 0;
+    cfg.modelScale    = std::max(0.0625, std::min(cfg.modelScale, 1.0));
+    cfg.strips        = std::max(0, cfg.strips);
+    return cfg;
+}
+
 // ============================================================================
 // BackgroundSubtractorMOG2Item
 // ============================================================================
 
 BackgroundSubtractorMOG2Item::BackgroundSubtractorMOG2Item() {
     _functionName = "background_subtractor_mog2";
-    _description = "Creates MOG2 background subtractor";
+    _description = "Updates a persistent MOG2 background model (kept per cache_id) and returns the foreground mask";
     _category = "advanced";
     _params = {
         ParamDef::optional("history", BaseType::INT, "History length", 500),
         ParamDef::optional("var_threshold", BaseType::FLOAT, "Variance threshold", 16.0),
         ParamDef::optional("detect_shadows", BaseType::BOOL, "Detect shadows", true),
-        ParamDef::optional("cache_id", BaseType::STRING, "Subtractor cache ID", "bg_sub")
+        ParamDef::optional("cache_id", BaseType::STRING, "Model ID (empty = one model per call site)", ""),
+        ParamDef::optional("learning_rate", BaseType::FLOAT, "Learning rate (-1 = auto)", -1.0),
+        ParamDef::optional("model_scale", BaseType::FLOAT, "Model resolution scale (1, 0.5, 0.25); mask is upsampled", 1.0),
+        ParamDef::optional("strips", BaseType::INT, "Horizontal strips updated in parallel (0 = auto)", 0),
+        ParamDef::optional("warmup_frames", BaseType::INT, "Frames learned at 1/(n+1) rate after (re)start", 0)
     };
-    _example = "background_subtractor_mog2(500, 16.0, true, \"bg_sub\")";
+    _example = "background_subtractor_mog2(500, 16.0, true, \"\", -1, 0.5)";
     _returnType = "mat";
     _tags = {"background", "subtraction", "mog2"};
 }
 
 ExecutionResult BackgroundSubtractorMOG2Item::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
-    // Note: Background subtractor state would need to be stored separately
-    // This is a simplified version that just creates the mask
-    int history = args.size() > 0 ? static_cast<int>(args[0].asNumber()) : 500;
-    double varThreshold = args.size() > 1 ? args[1].asNumber() : 16.0;
-    bool detectShadows = args.size() > 2 ? args[2].asBool() : true;
-    
-    cv::Ptr<cv::BackgroundSubtractorMOG2> bgSub = cv::createBackgroundSubtractorMOG2(history, varThreshold, detectShadows);
-    
-    cv::Mat mask;
-    bgSub->apply(ctx.currentMat, mask);
-    
-    return ExecutionResult::ok(mask);
+    BackgroundModelConfig cfg = readBackgroundConfig("mog2", args, 16.0);
+    std::string cacheId = args.size() > 3 ? args[3].asString() : "";
+    if (cacheId.empty()) {
+        cacheId = ctx.callSiteId(_functionName);
+    }
+    double learningRate = args.size() > 4 ? args[4].asNumber() : -1.0;
+    int warmupFrames = args.size() > 7 ? static_cast<int>(args[7].asNumber()) : 0;
+
+    auto model = BackgroundModelRegistry::instance().acquire(cacheId, cfg);
+    return runBackgroundModel(_functionName, cacheId, *model, learningRate, warmupFrames, ctx);
 }
 
 // ============================================================================
@@ -288,29 +543,34 @@ ExecutionResult BackgroundSubtractorMOG2Item::execute(const std::vector<RuntimeV
 
 BackgroundSubtractorKNNItem::BackgroundSubtractorKNNItem() {
     _functionName = "background_subtractor_knn";
-    _description = "Creates KNN background subtractor";
+    _description = "Updates a persistent KNN background model (kept per cache_id) and returns the foreground mask";
     _category = "advanced";
     _params = {
         ParamDef::optional("history", BaseType::INT, "History length", 500),
         ParamDef::optional("dist2_threshold", BaseType::FLOAT, "Distance threshold", 400.0),
-        ParamDef::optional("detect_shadows", BaseType::BOOL, "Detect shadows", true)
+        ParamDef::optional("detect_shadows", BaseType::BOOL, "Detect shadows", true),
+        ParamDef::optional("cache_id", BaseType::STRING, "Model ID (empty = one model per call site)", ""),
+        ParamDef::optional("learning_rate", BaseType::FLOAT, "Learning rate (-1 = auto)", -1.0),
+        ParamDef::optional("model_scale", BaseType::FLOAT, "Model resolution scale (1, 0.5, 0.25); mask is upsampled", 1.0),
+        ParamDef::optional("strips", BaseType::INT, "Horizontal strips updated in parallel (0 = auto)", 0),
+        ParamDef::optional("warmup_frames", BaseType::INT, "Frames learned at 1/(n+1) rate after (re)start", 0)
     };
-    _example = "background_subtractor_knn(500, 400.0, true)";
+    _example = "background_subtractor_knn(500, 400.0, true, \"\", -1, 0.5)";
     _returnType = "mat";
     _tags = {"background", "subtraction", "knn"};
 }
 
 ExecutionResult BackgroundSubtractorKNNItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
-    int history = args.size() > 0 ? static_cast<int>(args[0].asNumber()) : 500;
-    double dist2Threshold = args.size() > 1 ? args[1].asNumber() : 400.0;
-    bool detectShadows = args.size() > 2 ? args[2].asBool() : true;
-    
-    cv::Ptr<cv::BackgroundSubtractorKNN> bgSub = cv::createBackgroundSubtractorKNN(history, dist2Threshold, detectShadows);
-    
-    cv::Mat mask;
-    bgSub->apply(ctx.currentMat, mask);
-    
-    return ExecutionResult::ok(mask);
+    BackgroundModelConfig cfg = readBackgroundConfig("knn", args, 400.0);
+    std::string cacheId = args.size() > 3 ? args[3].asString() : "";
+    if (cacheId.empty()) {
+        cacheId = ctx.callSiteId(_functionName);
+    }
+    double learningRate = args.size() > 4 ? args[4].asNumber() : -1.0;
+    int warmupFrames = args.size() > 7 ? static_cast<int>(args[7].asNumber()) : 0;
+
+    auto model = BackgroundModelRegistry::instance().acquire(cacheId, cfg);
+    return runBackgroundModel(_functionName, cacheId, *model, learningRate, warmupFrames, ctx);
 }
 
 // ============================================================================
@@ -319,20 +579,39 @@ ExecutionResult BackgroundSubtractorKNNItem::execute(const std::vector<RuntimeVa
 
 ApplyBackgroundSubtractorItem::ApplyBackgroundSubtractorItem() {
     _functionName = "apply_background_subtractor";
-    _description = "Applies background subtractor to current frame";
+    _description = "Applies an existing background model (created by background_subtractor_mog2/knn) to the current frame";
     _category = "advanced";
     _params = {
         ParamDef::required("subtractor_cache", BaseType::STRING, "Subtractor cache ID"),
-        ParamDef::optional("learning_rate", BaseType::FLOAT, "Learning rate (-1 = auto)", -1.0)
+        ParamDef::optional("learning_rate", BaseType::FLOAT, "Learning rate (-1 = auto, 0 = frozen model)", -1.0),
+        ParamDef::optional("background_cache", BaseType::STRING, "Cache ID to store the background estimate (empty = skip)", "")
     };
-    _example = "apply_background_subtractor(\"bg_sub\", -1)";
+    _example = "# Learn in one pipeline, reuse the same model (frozen) in another\n"
+               "background_subtractor_mog2(500, 16.0, true, \"lobby_bg\")\n"
+               "apply_background_subtractor(\"lobby_bg\", 0)";
     _returnType = "mat";
     _tags = {"background", "subtraction"};
 }
 
 ExecutionResult ApplyBackgroundSubtractorItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
-    // Simplified - would need proper state management
-    return ExecutionResult::ok(ctx.currentMat);
+    std::string cacheId = args[0].asString();
+    double learningRate = args.size() > 1 ? args[1].asNumber() : -1.0;
+    std::string backgroundCache = args.size() > 2 ? args[2].asString() : "";
+
+    auto model = BackgroundModelRegistry::instance().find(cacheId);
+    if (!model) {
+        return ExecutionResult::fail("Background subtractor not found: " + cacheId +
+                                     " (create it with background_subtractor_mog2/knn first)");
+    }
+
+    ExecutionResult result = runBackgroundModel(_functionName, cacheId, *model, learningRate, 0, ctx);
+    if (result.success && !backgroundCache.empty()) {
+        cv::Mat bg = model->background();
+        if (!bg.empty()) {
+            ctx.cacheManager->set(backgroundCache, bg);
+        }
+    }
+    return result;
 }
 
 // ============================================================================
@@ -544,7 +823,8 @@ MergeExposuresItem::MergeExposuresItem() {
     _description = "Merges multiple exposures using Mertens fusion";
     _category = "advanced";
     _params = {
-        ParamDef::required("images_cache", BaseType::STRING, "Comma-separated image cache IDs")
+        ParamDef::required("images_cache", BaseType::STRING, "Comma-separated image cache IDs"),
+        ParamDef::optional("cache_id", BaseType::STRING, "Fuse with the fixed-point engine kept under this ID (\"\" = cv::MergeMertens)", "")
     };
     _example = "merge_exposures(\"exp1,exp2,exp3\")";
     _returnType = "mat";
@@ -566,6 +846,21 @@ ExecutionResult MergeExposuresItem::execute(const std::vector<RuntimeValue>& arg
         }
     }
     
+    std::string engineId = args.size() > 1 ? args[1].asString() : "";
+    if (!engineId.empty()) {
+        ExposureFusionConfig cfg;
+        cfg.exposures = static_cast<int>(images.size());
+        auto engine = ExposureFusionRegistry::instance().acquire(engineId, cfg);
+        for (size_t i = 0; i < images.size(); ++i) {
+            engine->update(images[i], static_cast<int>(i));
+        }
+        cv::Mat fused = engine->fuse();
+        if (fused.empty()) {
+            return ExecutionResult::fail("merge_exposures: exposures differ in size or type");
+        }
+        return ExecutionResult::ok(fused);
+    }
+    
     cv::Ptr<cv::MergeMertens> merge = cv::createMergeMertens();
     cv::Mat fusion;
     merge->process(images, fusion);
@@ -575,6 +870,61 @@ ExecutionResult MergeExposuresItem::execute(const std::vector<RuntimeValue>& arg
     return ExecutionResult::ok(fusion);
 }
 
+// ============================================================================
+// ExposureFusionItem
+// ============================================================================
+
+ExposureFusionItem::ExposureFusionItem() {
+    _functionName = "exposure_fusion";
+    _description = "Streaming fixed-point exposure fusion of an interleaved exposure stream";
+    _category = "advanced";
+    _params = {
+        ParamDef::optional("exposures", BaseType::INT, "Exposures in the bracket", 3),
+        ParamDef::optional("exposure_index", BaseType::INT, "Slot of the current frame (-1 = round robin)", -1),
+        ParamDef::optional("cache_id", BaseType::STRING, "Fusion engine ID", "exposure_fusion"),
+        ParamDef::optional("weight_scale", BaseType::INT, "Weight map downscale: 1, 2, 4, 8", 4),
+        ParamDef::optional("contrast_weight", BaseType::FLOAT, "Contrast weight", 1.0),
+        ParamDef::optional("saturation_weight", BaseType::FLOAT, "Saturation weight", 1.0),
+        ParamDef::optional("exposure_weight", BaseType::FLOAT, "Well-exposedness weight", 1.0)
+    };
+    _example = "exposure_fusion(2, -1, \"hdr_cam\")";
+    _returnType = "mat";
+    _tags = {"hdr", "fusion", "exposure", "mertens", "streaming"};
+}
+
+ExecutionResult ExposureFusionItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
+    ExposureFusionConfig cfg;
+    cfg.exposures = args.size() > 0 ? std::max(1, static_cast<int>(args[0].asNumber())) : 3;
+    int exposureIndex = args.size() > 1 ? static_cast<int>(args[1].asNumber()) : -1;
+    std::string cacheId = args.size() > 2 ? args[2].asString() : "exposure_fusion";
+    int weightScale = args.size() > 3 ? std::max(1, static_cast<int>(args[3].asNumber())) : 4;
+    cfg.contrast = args.size() > 4 ? args[4].asNumber() : 1.0;
+    cfg.saturation = args.size() > 5 ? args[5].asNumber() : 1.0;
+    cfg.exposedness = args.size() > 6 ? args[6].asNumber() : 1.0;
+
+    cfg.weightLevel = 0;
+    while ((2 << cfg.weightLevel) <= weightScale) ++cfg.weightLevel;
+
+    if (ctx.currentMat.empty()) {
+        return ExecutionResult::fail("exposure_fusion: empty input frame");
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto engine = ExposureFusionRegistry::instance().acquire(cacheId, cfg);
+    engine->update(ctx.currentMat, exposureIndex);
+    cv::Mat fused = engine->fuse();
+
+    if (ctx.verbose) {
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - t0).count();
+        std::cout << "[exposure_fusion] " << cacheId << ": " << ms << " ms/frame ("
+                  << cfg.exposures << " exposures, " << engine->levels() << " levels, frame "
+                  << engine->frameCount() << (fused.empty() ? ", filling bracket" : "") << ")"
+                  << std::endl;
+    }
+    return ExecutionResult::ok(fused.empty() ? ctx.currentMat : fused);
+}
+
 // ============================================================================
 // TonemapItem
 // ============================================================================
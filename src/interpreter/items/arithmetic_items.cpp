@@ -1,6 +1,8 @@
 #include "interpreter/items/arithmetic_items.h"
 #include "interpreter/items/feature_items.h"
 #include "interpreter/cache_manager.h"
+#include "utils/fft_engine.h"
+#include "utils/integral_image_service.h"
 #include <iostream>
 #include <cmath>
 
@@ -20,6 +22,9 @@ void registerArithmeticItems(ItemRegistry& registry) {
     registry.add<DFTItem>();
     registry.add<IDFTItem>();
     registry.add<MulSpectrumsItem>();
+    registry.add<FFTConvolveItem>();
+    registry.add<FFTFilterItem>();
+    registry.add<PhaseCorrelateItem>();
     registry.add<DCTItem>();
     registry.add<IDCTItem>();
     registry.add<MagnitudeItem>();
@@ -30,6 +35,7 @@ void registerArithmeticItems(ItemRegistry& registry) {
     registry.add<NormalizeItem>();
     registry.add<ReduceItem>();
     registry.add<SumItem>();
+    registry.add<WindowStatsItem>();
     registry.add<CountNonZeroItem>();
     
     // Math operations
@@ -306,8 +312,12 @@ ExecutionResult DFTItem::execute(const std::vector<RuntimeValue>& args, Executio
     if (flagsStr.find("complex_output") != std::string::npos) flags |= cv::DFT_COMPLEX_OUTPUT;
     if (flagsStr.find("real_output") != std::string::npos) flags |= cv::DFT_REAL_OUTPUT;
     
-    cv::Mat floatMat;
-    ctx.currentMat.convertTo(floatMat, CV_32F);
+    // CV_32F input is transformed directly; convertTo would copy it anyway.
+    // Anything else (CV_64F included) is converted so the output stays CV_32F.
+    cv::Mat floatMat = ctx.currentMat;
+    if (floatMat.depth() != CV_32F) {
+        ctx.currentMat.convertTo(floatMat, CV_32F);
+    }
     
     cv::Mat result;
     cv::dft(floatMat, result, flags, nonzeroRows);
@@ -383,6 +393,207 @@ ExecutionResult MulSpectrumsItem::execute(const std::vector<RuntimeValue>& args,
     return ExecutionResult::ok(result);
 }
 
+// ============================================================================
+// FFTConvolveItem
+// ============================================================================
+
+static int parseFFTBorder(const std::string& border) {
+    if (border == "replicate") return cv::BORDER_REPLICATE;
+    if (border == "reflect") return cv::BORDER_REFLECT;
+    if (border == "wrap") return cv::BORDER_WRAP;
+    if (border == "constant") return cv::BORDER_CONSTANT;
+    return cv::BORDER_REFLECT_101;
+}
+
+FFTConvolveItem::FFTConvolveItem() {
+    _functionName = "fft_convolve";
+    _description = "Large-kernel filtering via padded FFT with a cached kernel spectrum";
+    _category = "arithmetic";
+    _params = {
+        ParamDef::required("kernel_cache", BaseType::STRING, "Cache ID of single-channel kernel"),
+        ParamDef::optional("anchor_x", BaseType::INT, "Kernel anchor x (-1 = center)", -1),
+        ParamDef::optional("anchor_y", BaseType::INT, "Kernel anchor y (-1 = center)", -1),
+        ParamDef::optional("border", BaseType::STRING, "Border: replicate, reflect, reflect_101, wrap, constant", "reflect_101"),
+        ParamDef::optional("mode", BaseType::STRING, "correlation (filter2d) or convolution", "correlation"),
+        ParamDef::optional("ddepth", BaseType::INT, "Output depth (-1 = same)", -1),
+        ParamDef::optional("generation", BaseType::INT, "Bump to rebuild the cached spectrum", 0)
+    };
+    _example = "fft_convolve(\"psf\", -1, -1, \"reflect_101\", \"convolution\")";
+    _returnType = "mat";
+    _tags = {"dft", "fft", "convolution", "filter"};
+}
+
+ExecutionResult FFTConvolveItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
+    std::string kernelCache = args[0].asString();
+    int anchorX = args.size() > 1 ? static_cast<int>(args[1].asNumber()) : -1;
+    int anchorY = args.size() > 2 ? static_cast<int>(args[2].asNumber()) : -1;
+    int border = parseFFTBorder(args.size() > 3 ? args[3].asString() : "reflect_101");
+    bool convolution = args.size() > 4 && args[4].asString() == "convolution";
+    int ddepth = args.size() > 5 ? static_cast<int>(args[5].asNumber()) : -1;
+    int generation = args.size() > 6 ? static_cast<int>(args[6].asNumber()) : 0;
+    
+    cv::Mat kernel = ctx.cacheManager->get(kernelCache);
+    if (kernel.empty()) {
+        return ExecutionResult::fail("Kernel not found: " + kernelCache);
+    }
+    if (kernel.channels() != 1) {
+        return ExecutionResult::fail("fft_convolve: kernel must be single-channel");
+    }
+    
+    cv::Mat result;
+    if (kernel.total() < 121) {
+        // Spatial filtering wins below ~11x11; keep the item usable for any size.
+        cv::Mat k = kernel;
+        cv::Point anchor(anchorX < 0 ? kernel.cols / 2 : anchorX,
+                         anchorY < 0 ? kernel.rows / 2 : anchorY);
+        if (convolution) {
+            cv::flip(kernel, k, -1);
+            anchor = cv::Point(kernel.cols - 1 - anchor.x, kernel.rows - 1 - anchor.y);
+        }
+        if (border == cv::BORDER_WRAP) {
+            // filter2D rejects BORDER_WRAP: extend periodically, filter, crop
+            cv::Mat ext;
+            cv::copyMakeBorder(ctx.currentMat, ext, anchor.y, k.rows - 1 - anchor.y,
+                               anchor.x, k.cols - 1 - anchor.x, cv::BORDER_WRAP);
+            cv::Mat filtered;
+            cv::filter2D(ext, filtered, ddepth, k, anchor, 0, cv::BORDER_CONSTANT);
+            result = filtered(cv::Rect(anchor.x, anchor.y, ctx.currentMat.cols, ctx.currentMat.rows)).clone();
+        } else {
+            cv::filter2D(ctx.currentMat, result, ddepth, k, anchor, 0, border);
+        }
+        return ExecutionResult::ok(result);
+    }
+    
+    int64 t0 = ctx.verbose ? cv::getTickCount() : 0;
+    FFTEngine& fft = FFTEngine::instance();
+    fft.convolve(ctx.currentMat, result, kernel, kernelCache, cv::Point(anchorX, anchorY),
+                 border, ddepth, convolution, generation);
+    
+    if (ctx.verbose) {
+        double ms = (cv::getTickCount() - t0) * 1000.0 / cv::getTickFrequency();
+        cv::Size pad = FFTEngine::optimalSize(cv::Size(ctx.currentMat.cols + kernel.cols - 1,
+                                                       ctx.currentMat.rows + kernel.rows - 1));
+        auto st = fft.stats();
+        std::cout << "[fft_convolve] " << kernel.cols << "x" << kernel.rows << " kernel, padded "
+                  << pad.width << "x" << pad.height << ", " << ms << " ms (spectra built "
+                  << st.builds << ", reused " << st.hits << ")" << std::endl;
+    }
+    return ExecutionResult::ok(result);
+}
+
+// ============================================================================
+// FFTFilterItem
+// ============================================================================
+
+FFTFilterItem::FFTFilterItem() {
+    _functionName = "fft_filter";
+    _description = "Frequency-domain low/high/band filter with a cached transfer function";
+    _category = "arithmetic";
+    _params = {
+        ParamDef::optional("type", BaseType::STRING, "lowpass, highpass, bandpass, bandstop", "lowpass"),
+        ParamDef::optional("cutoff", BaseType::FLOAT, "Cutoff as fraction of Nyquist (band low edge)", 0.1),
+        ParamDef::optional("cutoff_high", BaseType::FLOAT, "Band high edge as fraction of Nyquist", 0.3),
+        ParamDef::optional("shape", BaseType::STRING, "gaussian, butterworth, ideal", "gaussian"),
+        ParamDef::optional("order", BaseType::INT, "Butterworth order", 2),
+        ParamDef::optional("response_cache", BaseType::STRING, "Cache ID of centered custom response (overrides type)", ""),
+        ParamDef::optional("cache_id", BaseType::STRING, "Spectrum slot (one per filter in a pipeline)", "fft_filter"),
+        ParamDef::optional("ddepth", BaseType::INT, "Output depth (-1 = same)", -1)
+    };
+    _example = "fft_filter(\"highpass\", 0.05, 0.3, \"butterworth\", 2)";
+    _returnType = "mat";
+    _tags = {"dft", "fft", "filter", "frequency"};
+}
+
+ExecutionResult FFTFilterItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
+    std::string type = args.size() > 0 ? args[0].asString() : "lowpass";
+    std::string shape = args.size() > 3 ? args[3].asString() : "gaussian";
+    std::string responseCache = args.size() > 5 ? args[5].asString() : "";
+    
+    FrequencyResponse response;
+    response.cutoff = args.size() > 1 ? args[1].asNumber() : 0.1;
+    response.cutoffHigh = args.size() > 2 ? args[2].asNumber() : 0.3;
+    response.order = args.size() > 4 ? static_cast<int>(args[4].asNumber()) : 2;
+    response.id = args.size() > 6 ? args[6].asString() : "fft_filter";
+    int ddepth = args.size() > 7 ? static_cast<int>(args[7].asNumber()) : -1;
+    
+    if (!responseCache.empty()) {
+        response.kind = FrequencyResponse::Kind::CUSTOM;
+        response.custom = ctx.cacheManager->get(responseCache);
+        if (response.custom.empty()) {
+            return ExecutionResult::fail("Response not found: " + responseCache);
+        }
+    } else if (type == "lowpass") {
+        response.kind = FrequencyResponse::Kind::LOWPASS;
+    } else if (type == "highpass") {
+        response.kind = FrequencyResponse::Kind::HIGHPASS;
+    } else if (type == "bandpass") {
+        response.kind = FrequencyResponse::Kind::BANDPASS;
+    } else if (type == "bandstop") {
+        response.kind = FrequencyResponse::Kind::BANDSTOP;
+    } else {
+        return ExecutionResult::fail("fft_filter: unknown type '" + type + "'");
+    }
+    
+    if (shape == "butterworth") response.shape = FrequencyResponse::Shape::BUTTERWORTH;
+    else if (shape == "ideal") response.shape = FrequencyResponse::Shape::IDEAL;
+    else response.shape = FrequencyResponse::Shape::GAUSSIAN;
+    
+    cv::Mat result;
+    FFTEngine::instance().filter(ctx.currentMat, result, response, ddepth);
+    return ExecutionResult::ok(result);
+}
+
+// ============================================================================
+// PhaseCorrelateItem
+// ============================================================================
+
+PhaseCorrelateItem::PhaseCorrelateItem() {
+    _functionName = "phase_correlate";
+    _description = "Global shift estimate by phase correlation with a cached reference spectrum";
+    _category = "arithmetic";
+    _params = {
+        ParamDef::required("reference_cache", BaseType::STRING, "Reference frame cache ID (or tracking slot)"),
+        ParamDef::optional("track", BaseType::BOOL, "Correlate against the previous frame", false),
+        ParamDef::optional("window", BaseType::BOOL, "Apply Hann window", true),
+        ParamDef::optional("generation", BaseType::INT, "Bump to rebuild the cached reference spectrum", 0)
+    };
+    _example = "phase_correlate(\"prev\", true)";
+    _returnType = "array[float, float, float]";
+    _tags = {"dft", "fft", "phase", "registration", "shift"};
+}
+
+ExecutionResult PhaseCorrelateItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
+    std::string refCache = args[0].asString();
+    bool track = args.size() > 1 ? args[1].asBool() : false;
+    bool window = args.size() > 2 ? args[2].asBool() : true;
+    int generation = args.size() > 3 ? static_cast<int>(args[3].asNumber()) : 0;
+    
+    cv::Mat reference;
+    if (!track) {
+        reference = ctx.cacheManager->get(refCache);
+        if (reference.empty()) {
+            return ExecutionResult::fail("Reference not found: " + refCache);
+        }
+        if (reference.size() != ctx.currentMat.size()) {
+            return ExecutionResult::fail("phase_correlate: reference size differs from frame");
+        }
+    }
+    
+    PhaseShift ps = FFTEngine::instance().phaseCorrelate(ctx.currentMat, refCache, reference,
+                                                         window, track, generation);
+    
+    if (ctx.verbose) {
+        std::cout << "[phase_correlate] dx=" << ps.shift.x << " dy=" << ps.shift.y
+                  << " response=" << ps.response << (ps.valid ? "" : " (no reference yet)") << std::endl;
+    }
+    
+    std::vector<RuntimeValue> result;
+    result.emplace_back(ps.shift.x);
+    result.emplace_back(ps.shift.y);
+    result.emplace_back(ps.response);
+    return ExecutionResult::okWithMat(ctx.currentMat, RuntimeValue(std::move(result)));
+}
+
 // ============================================================================
 // DCTItem
 // ============================================================================
@@ -670,6 +881,50 @@ ExecutionResult SumItem::execute(const std::vector<RuntimeValue>& args, Executio
     return ExecutionResult::ok(ctx.currentMat);
 }
 
+// ============================================================================
+// WindowStatsItem
+// ============================================================================
+
+WindowStatsItem::WindowStatsItem() {
+    _functionName = "window_stats";
+    _description = "O(1) mean and variance of a window from the frame's integral images";
+    _category = "arithmetic";
+    _params = {
+        ParamDef::required("x", BaseType::INT, "Window left"),
+        ParamDef::required("y", BaseType::INT, "Window top"),
+        ParamDef::required("width", BaseType::INT, "Window width"),
+        ParamDef::required("height", BaseType::INT, "Window height"),
+        ParamDef::optional("channel", BaseType::INT, "Channel index", 0)
+    };
+    _example = "stats = window_stats(100, 80, 32, 32)";
+    _returnType = "array[float, float]";
+    _tags = {"integral", "mean", "variance", "window", "statistics"};
+}
+
+ExecutionResult WindowStatsItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
+    cv::Rect window(static_cast<int>(args[0].asNumber()), static_cast<int>(args[1].asNumber()),
+                    static_cast<int>(args[2].asNumber()), static_cast<int>(args[3].asNumber()));
+    int channel = args.size() > 4 ? static_cast<int>(args[4].asNumber()) : 0;
+
+    if (ctx.currentMat.empty()) {
+        return ExecutionResult::fail("window_stats: empty input");
+    }
+    if (channel < 0 || channel >= ctx.currentMat.channels()) {
+        return ExecutionResult::fail("window_stats: channel out of range");
+    }
+
+    auto ii = IntegralImageService::instance().acquire(
+        ctx.currentMat, ctx.frameGeneration, IntegralImage::SUM | IntegralImage::SQSUM);
+    if (!ii) {
+        return ExecutionResult::fail("window_stats: unsupported input");
+    }
+    std::vector<RuntimeValue> result = {
+        RuntimeValue(ii->windowMean(window, channel)),
+        RuntimeValue(ii->windowVariance(window, channel))
+    };
+    return ExecutionResult::okWithMat(ctx.currentMat, RuntimeValue(std::move(result)));
+}
+
 // ============================================================================
 // CountNonZeroItem
 // ============================================================================
@@ -128,6 +128,32 @@ ExecutionResult ColorConvertItem::execute(const std::vector<RuntimeValue>& args,
     }
 }
 
+std::optional<FrameShape> ColorConvertItem::inferOutputShape(const std::vector<RuntimeValue>& args,
+                                                             const FrameShape& input) const {
+    if (args.empty() || !args[0].isString()) return std::nullopt;
+    std::string code = args[0].asString();
+    std::transform(code.begin(), code.end(), code.begin(), ::tolower);
+
+    // Codes are "<src>2<dst>"; the destination follows the last '2'
+    size_t sep = code.rfind('2');
+    if (sep == std::string::npos || sep == 0) return std::nullopt;
+    std::string src = code.substr(0, sep);
+    std::string dst = code.substr(sep + 1);
+    if (dst.size() > 5 && dst.compare(dst.size() - 5, 5, "_full") == 0) dst.resize(dst.size() - 5);
+
+    int channels = 0;
+    if (dst == "gray") channels = 1;
+    else if (dst == "bgra" || dst == "rgba") channels = 4;
+    else if (dst == "bgr" || dst == "rgb" || dst == "lbgr" || dst == "lrgb" || dst == "xyz" ||
+             dst == "ycrcb" || dst == "hsv" || dst == "hls" || dst == "lab" || dst == "luv" ||
+             dst == "yuv") channels = 3;
+    if (channels == 0) return std::nullopt;
+
+    // Semi-planar 4:2:0 input stacks the chroma plane under the luma plane
+    int rows = (src == "nv12" || src == "nv21") ? input.rows * 2 / 3 : input.rows;
+    return FrameShape{rows, input.cols, CV_MAKETYPE(CV_MAT_DEPTH(input.type), channels)};
+}
+
 // ============================================================================
 // ExtractChannelItem
 // ============================================================================
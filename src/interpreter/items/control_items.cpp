@@ -78,8 +78,7 @@ CacheItem::CacheItem() {
 }
 
 ExecutionResult CacheItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
-    std::string cacheId = args[0].asString();
-    ctx.cacheManager->set(cacheId, ctx.currentMat.clone());
+    ctx.cacheManager->set(ctx.cacheRefArg(args, 0), ctx.currentMat.clone());
     return ExecutionResult::ok(ctx.currentMat);
 }
 
@@ -100,8 +99,7 @@ GlobalCacheItem::GlobalCacheItem() {
 }
 
 ExecutionResult GlobalCacheItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
-    std::string cacheId = args[0].asString();
-    ctx.cacheManager->set(cacheId, ctx.currentMat.clone(), true);  // true = global
+    ctx.cacheManager->set(ctx.cacheRefArg(args, 0), ctx.currentMat.clone(), true);  // true = global
     return ExecutionResult::ok(ctx.currentMat);
 }
 
@@ -169,12 +167,12 @@ PromoteToGlobalItem::PromoteToGlobalItem() {
 }
 
 ExecutionResult PromoteToGlobalItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
-    std::string cacheId = args[0].asString();
-    cv::Mat mat = ctx.cacheManager->get(cacheId);
+    CacheRef key = ctx.cacheRefArg(args, 0);
+    cv::Mat mat = ctx.cacheManager->get(key);
     if (mat.empty()) {
-        return ExecutionResult::fail("Cache not found: " + cacheId);
+        return ExecutionResult::fail("Cache not found: " + args[0].asString());
     }
-    ctx.cacheManager->set(cacheId, mat.clone(), true);  // Promote to global
+    ctx.cacheManager->set(key, mat.clone(), true);  // Promote to global
     return ExecutionResult::ok(ctx.currentMat);
 }
 
@@ -195,10 +193,9 @@ LoadCacheItem::LoadCacheItem() {
 }
 
 ExecutionResult LoadCacheItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
-    std::string cacheId = args[0].asString();
-    cv::Mat cached = ctx.cacheManager->get(cacheId);
+    cv::Mat cached = ctx.cacheManager->get(ctx.cacheRefArg(args, 0));
     if (cached.empty()) {
-        return ExecutionResult::fail("Cache not found: " + cacheId);
+        return ExecutionResult::fail("Cache not found: " + args[0].asString());
     }
     return ExecutionResult::ok(cached.clone());
 }
@@ -275,15 +272,12 @@ CopyCacheItem::CopyCacheItem() {
 }
 
 ExecutionResult CopyCacheItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
-    std::string src = args[0].asString();
-    std::string dst = args[1].asString();
-    
-    cv::Mat cached = ctx.cacheManager->get(src);
+    cv::Mat cached = ctx.cacheManager->get(ctx.cacheRefArg(args, 0));
     if (cached.empty()) {
-        return ExecutionResult::fail("Source cache not found: " + src);
+        return ExecutionResult::fail("Source cache not found: " + args[0].asString());
     }
     
-    ctx.cacheManager->set(dst, cached.clone());
+    ctx.cacheManager->set(ctx.cacheRefArg(args, 1), cached.clone());
     return ExecutionResult::ok(ctx.currentMat);
 }
 
@@ -305,18 +299,18 @@ SwapCacheItem::SwapCacheItem() {
 }
 
 ExecutionResult SwapCacheItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
-    std::string id1 = args[0].asString();
-    std::string id2 = args[1].asString();
+    CacheRef key1 = ctx.cacheRefArg(args, 0);
+    CacheRef key2 = ctx.cacheRefArg(args, 1);
     
-    cv::Mat mat1 = ctx.cacheManager->get(id1);
-    cv::Mat mat2 = ctx.cacheManager->get(id2);
+    cv::Mat mat1 = ctx.cacheManager->get(key1);
+    cv::Mat mat2 = ctx.cacheManager->get(key2);
     
-    if (mat1.empty()) return ExecutionResult::fail("Cache not found: " + id1);
-    if (mat2.empty()) return ExecutionResult::fail("Cache not found: " + id2);
+    if (mat1.empty()) return ExecutionResult::fail("Cache not found: " + args[0].asString());
+    if (mat2.empty()) return ExecutionResult::fail("Cache not found: " + args[1].asString());
     
     cv::Mat temp = mat1.clone();
-    ctx.cacheManager->set(id1, mat2.clone());
-    ctx.cacheManager->set(id2, temp);
+    ctx.cacheManager->set(key1, mat2.clone());
+    ctx.cacheManager->set(key2, temp);
     
     return ExecutionResult::ok(ctx.currentMat);
 }
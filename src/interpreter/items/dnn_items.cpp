@@ -1,8 +1,12 @@
 #include "interpreter/items/dnn_items.h"
 #include "interpreter/ml/preprocessing.h"
 #include "interpreter/cache_manager.h"
+#include "utils/text_renderer.h"
+#include "utils/seg_overlay.h"
 #include <iostream>
 #include <sstream>
+#include <algorithm>
+#include <iterator>
 
 namespace visionpipe {
 
@@ -26,6 +30,8 @@ void registerDNNItems(ItemRegistry& registry) {
     registry.add<UnloadModelItem>();
     registry.add<ListModelsItem>();
     registry.add<ModelInfoItem>();
+    registry.add<ModelCascadeItem>();
+    registry.add<CascadeStatsItem>();
     
     // Inference
     registry.add<ModelInferItem>();
@@ -38,6 +44,8 @@ void registerDNNItems(ItemRegistry& registry) {
     
     // Detection post-processing
     registry.add<DecodeYoloItem>();
+    registry.add<DecodeYoloSegItem>();
+    registry.add<DecodeYoloPoseItem>();
     registry.add<NMSBoxesItem>();
     
     // Tensor operations
@@ -48,6 +56,7 @@ void registerDNNItems(ItemRegistry& registry) {
     // Drawing
     registry.add<DrawDetectionsItem>();
     registry.add<DrawClassificationItem>();
+    registry.add<SegOverlayItem>();
     
     // Tensor output conversions (for raw DNN output access)
     registry.add<ModelOutputVectorItem>();
@@ -211,6 +220,130 @@ ExecutionResult ModelInfoItem::execute(const std::vector<RuntimeValue>& args, Ex
     return ExecutionResult::ok(RuntimeValue(ss.str()));
 }
 
+// ============================================================================
+// ModelCascadeItem
+// ============================================================================
+
+ModelCascadeItem::ModelCascadeItem() {
+    _functionName = "model_cascade";
+    _description = "Define a cascade of loaded models; each stage's gate decides whether the next stage runs";
+    _category = "dnn";
+    _params = {
+        ParamDef::required("id", BaseType::STRING, "Cascade identifier, used with model_infer"),
+        ParamDef::required("stages", BaseType::ARRAY, "Model ids, cheapest first"),
+        ParamDef::optional("gates", BaseType::ANY,
+            "Gate spec for every transition, or an array with one per stage transition, "
+            "e.g. \"score:0.3,0.7; classes:0,2; boxes:1,5\" (empty = always escalate)", ""),
+        ParamDef::optional("task", BaseType::ANY, "classify or detect, for every stage or as an array per stage", "classify"),
+        ParamDef::optional("roi", BaseType::BOOL, "Run the last stage on each gated box of the detect stage before it; "
+            "the result is then one output per box (\"roi_<i>\") plus a \"rois\" [N x 4] matrix, "
+            "or the detect result when no box passes", false),
+        ParamDef::optional("conf", BaseType::FLOAT, "Detection confidence threshold for detect stages", 0.25),
+        ParamDef::optional("version", BaseType::STRING, "YOLO version of detect stages", "v8"),
+        ParamDef::optional("roi_padding", BaseType::INT, "Pixels added around each ROI", 0)
+    };
+    _example = "model_cascade(\"fast_then_slow\", [\"mobilenet\", \"resnet\"], \"score:0.3,0.7\")";
+    _returnType = "void";
+    _tags = {"model", "cascade", "dnn", "gating"};
+}
+
+ExecutionResult ModelCascadeItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
+    if (args.size() < 2 || !args[1].isArray()) {
+        return ExecutionResult::fail("model_cascade requires id and an array of stage model ids");
+    }
+    
+    std::string id = args[0].asString();
+    const auto& stageIds = args[1].asArray();
+    
+    // Per-stage string: a scalar applies to every stage
+    auto perStage = [&](size_t argIndex, size_t stage, const std::string& def) -> std::string {
+        if (args.size() <= argIndex) return def;
+        if (args[argIndex].isArray()) {
+            const auto& arr = args[argIndex].asArray();
+            return stage < arr.size() ? arr[stage].asString() : def;
+        }
+        return args[argIndex].asString();
+    };
+    
+    ml::CascadeConfig config;
+    config.roi = args.size() > 4 ? args[4].asBool() : false;
+    float conf = args.size() > 5 ? static_cast<float>(args[5].asNumber()) : 0.25f;
+    std::string version = args.size() > 6 ? args[6].asString() : "v8";
+    config.roiPadding = args.size() > 7 ? static_cast<int>(args[7].asNumber()) : 0;
+    
+    for (size_t i = 0; i < stageIds.size(); ++i) {
+        ml::CascadeStage stage;
+        stage.modelId = stageIds[i].asString();
+        stage.task = perStage(3, i, "classify");
+        stage.yoloVersion = version;
+        stage.confThreshold = conf;
+        
+        std::string error;
+        if (!ml::CascadeGate::parse(perStage(2, i, ""), stage.gate, error)) {
+            return ExecutionResult::fail("model_cascade: stage " + std::to_string(i) + ": " + error);
+        }
+        config.stages.push_back(stage);
+    }
+    
+    std::string error;
+    if (!ml::ModelRegistry::instance().defineCascade(id, config, error)) {
+        return ExecutionResult::fail("model_cascade: " + error);
+    }
+    
+    if (ctx.verbose) {
+        std::cout << "[model_cascade] " << id << ": " << config.stages.size() << " stages"
+                  << (config.roi ? ", last stage on ROIs" : "") << std::endl;
+    }
+    
+    return ExecutionResult::ok();
+}
+
+// ============================================================================
+// CascadeStatsItem
+// ============================================================================
+
+CascadeStatsItem::CascadeStatsItem() {
+    _functionName = "cascade_stats";
+    _description = "Report per-stage hit rates (fraction of runs that escalated) and average cost of a cascade";
+    _category = "dnn";
+    _params = {
+        ParamDef::required("id", BaseType::STRING, "Cascade identifier")
+    };
+    _example = "cascade_stats(\"fast_then_slow\")";
+    _returnType = "string";
+    _tags = {"model", "cascade", "stats", "dnn"};
+}
+
+ExecutionResult CascadeStatsItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
+    if (args.empty()) {
+        return ExecutionResult::fail("cascade_stats requires cascade id");
+    }
+    
+    std::string id = args[0].asString();
+    auto stats = ml::ModelRegistry::instance().getCascadeStats(id);
+    if (!stats) {
+        return ExecutionResult::fail("Cascade not found: " + id);
+    }
+    
+    std::stringstream ss;
+    ss << "Cascade: " << id << "\n"
+       << "  Frames: " << stats->frames << "\n"
+       << "  Avg time: " << stats->averageTimeMs() << " ms";
+    for (size_t i = 0; i < stats->stages.size(); ++i) {
+        const auto& stage = stats->stages[i];
+        ss << "\n  Stage " << i << " (" << stage.modelId << "): "
+           << stage.runs << " runs, ";
+        if (i + 1 < stats->stages.size()) {
+            ss << stage.hitRate() * 100.0 << "% escalated, ";
+        }
+        ss << stage.averageTimeMs() << " ms avg";
+    }
+    
+    std::cout << ss.str() << std::endl;
+    
+    return ExecutionResult::ok(RuntimeValue(ss.str()));
+}
+
 // ============================================================================
 // ModelInferItem
 // ============================================================================
@@ -220,7 +353,8 @@ ModelInferItem::ModelInferItem() {
     _description = "Run inference on the current frame using a loaded model";
     _category = "dnn";
     _params = {
-        ParamDef::required("id", BaseType::STRING, "Model identifier")
+        ParamDef::required("id", BaseType::STRING, "Model identifier"),
+        ParamDef::optional("cache_id", BaseType::STRING, "Cache every output i as <cache_id>_<i> (empty = off)", "")
     };
     _example = "model_infer(\"yolo\") -> \"output\"";
     _returnType = "mat";
@@ -247,6 +381,14 @@ ExecutionResult ModelInferItem::execute(const std::vector<RuntimeValue>& args, E
                   << result.inferenceTimeMs << " ms" << std::endl;
     }
     
+    // Multi-output models (e.g. segmentation prototypes) without a second inference
+    std::string cacheId = args.size() > 1 ? args[1].asString() : "";
+    if (!cacheId.empty() && ctx.cacheManager) {
+        for (size_t i = 0; i < result.outputs.size(); ++i) {
+            ctx.cacheManager->set(cacheId + "_" + std::to_string(i), result.outputs[i]);
+        }
+    }
+    
     // Return primary output
     cv::Mat output = result.getPrimaryOutput();
     
@@ -279,10 +421,8 @@ ExecutionResult ModelOutputItem::execute(const std::vector<RuntimeValue>& args,
     std::string layerName = args[1].asString();
     
     auto& registry = ml::ModelRegistry::instance();
-    auto model = registry.getModel(id);
-    
-    if (!model) {
-        return ExecutionResult::fail("Model not found: " + id);
+    if (!registry.exists(id)) {
+        return ExecutionResult::fail("Model or cascade not found: " + id);
     }
     
     // Note: This requires running inference first
@@ -419,6 +559,21 @@ ExecutionResult NormalizeMeanStdItem::execute(const std::vector<RuntimeValue>& a
 // DecodeYoloItem
 // ============================================================================
 
+// Format: each row = [x, y, w, h, classId, confidence]
+static cv::Mat detectionsToMat(const std::vector<ml::Detection>& detections) {
+    cv::Mat detMat(static_cast<int>(detections.size()), 6, CV_32F);
+    for (size_t i = 0; i < detections.size(); ++i) {
+        const auto& det = detections[i];
+        detMat.at<float>(static_cast<int>(i), 0) = static_cast<float>(det.box.x);
+        detMat.at<float>(static_cast<int>(i), 1) = static_cast<float>(det.box.y);
+        detMat.at<float>(static_cast<int>(i), 2) = static_cast<float>(det.box.width);
+        detMat.at<float>(static_cast<int>(i), 3) = static_cast<float>(det.box.height);
+        detMat.at<float>(static_cast<int>(i), 4) = static_cast<float>(det.classId);
+        detMat.at<float>(static_cast<int>(i), 5) = det.confidence;
+    }
+    return detMat;
+}
+
 DecodeYoloItem::DecodeYoloItem() {
     _functionName = "decode_yolo";
     _description = "Decode YOLO model output to detections";
@@ -454,19 +609,137 @@ ExecutionResult DecodeYoloItem::execute(const std::vector<RuntimeValue>& args, E
     }
     
     // Store detections in a Mat format for caching
-    // Format: each row = [x, y, w, h, classId, confidence]
-    cv::Mat detMat(static_cast<int>(detections.size()), 6, CV_32F);
-    for (size_t i = 0; i < detections.size(); ++i) {
+    return ExecutionResult::ok(detectionsToMat(detections));
+}
+
+// ============================================================================
+// DecodeYoloSegItem
+// ============================================================================
+
+DecodeYoloSegItem::DecodeYoloSegItem() {
+    _functionName = "decode_yolo_seg";
+    _description = "Decode YOLO segmentation output to detections and per-instance masks";
+    _category = "dnn";
+    _params = {
+        ParamDef::required("protos", BaseType::STRING, "Cache ID of the mask prototype output [1, 32, 160, 160]"),
+        ParamDef::optional("conf_thresh", BaseType::FLOAT, "Confidence threshold", 0.25),
+        ParamDef::optional("iou_thresh", BaseType::FLOAT, "IoU threshold for NMS", 0.45),
+        ParamDef::optional("mask_thresh", BaseType::FLOAT, "Mask probability threshold", 0.5),
+        ParamDef::optional("orig_width", BaseType::INT, "Original image width", 640),
+        ParamDef::optional("orig_height", BaseType::INT, "Original image height", 640),
+        ParamDef::optional("input_size", BaseType::INT, "Model input size", 640),
+        ParamDef::optional("cache_id", BaseType::STRING, "Instance map is cached as <cache_id>_masks", "seg")
+    };
+    _example = "decode_yolo_seg(\"out_1\", 0.25) -> \"detections\"";
+    _returnType = "mat";
+    _tags = {"postprocess", "yolo", "segmentation", "mask", "dnn"};
+}
+
+ExecutionResult DecodeYoloSegItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
+    if (args.empty()) {
+        return ExecutionResult::fail("decode_yolo_seg requires the prototype cache id");
+    }
+    std::string protosId = args[0].asString();
+    float confThresh = args.size() > 1 ? static_cast<float>(args[1].asNumber()) : 0.25f;
+    float iouThresh = args.size() > 2 ? static_cast<float>(args[2].asNumber()) : 0.45f;
+    float maskThresh = args.size() > 3 ? static_cast<float>(args[3].asNumber()) : 0.5f;
+    int origWidth = args.size() > 4 ? static_cast<int>(args[4].asNumber()) : 640;
+    int origHeight = args.size() > 5 ? static_cast<int>(args[5].asNumber()) : 640;
+    int inputSize = args.size() > 6 ? static_cast<int>(args[6].asNumber()) : 640;
+    std::string cacheId = args.size() > 7 ? args[7].asString() : "seg";
+    
+    if (!ctx.cacheManager) {
+        return ExecutionResult::fail("Cache manager not available");
+    }
+    cv::Mat protos = ctx.cacheManager->get(protosId);
+    if (protos.empty() || protos.dims != 4) {
+        return ExecutionResult::fail("Mask prototypes not found or not 4D: " + protosId);
+    }
+    
+    cv::Size imageSize(origWidth, origHeight);
+    auto detections = ml::Postprocessing::decodeYoloSeg(
+        ctx.currentMat, protos, imageSize, cv::Size(inputSize, inputSize),
+        confThresh, iouThresh, maskThresh
+    );
+    
+    // One instance map instead of N full-frame masks.  Detections come in
+    // NMS order, best first; painting from the back leaves each overlap to
+    // the higher-confidence instance.
+    cv::Mat instances = cv::Mat::zeros(imageSize, CV_16UC1);
+    const cv::Rect bounds(0, 0, imageSize.width, imageSize.height);
+    for (size_t i = detections.size(); i-- > 0;) {
         const auto& det = detections[i];
-        detMat.at<float>(static_cast<int>(i), 0) = static_cast<float>(det.box.x);
-        detMat.at<float>(static_cast<int>(i), 1) = static_cast<float>(det.box.y);
-        detMat.at<float>(static_cast<int>(i), 2) = static_cast<float>(det.box.width);
-        detMat.at<float>(static_cast<int>(i), 3) = static_cast<float>(det.box.height);
-        detMat.at<float>(static_cast<int>(i), 4) = static_cast<float>(det.classId);
-        detMat.at<float>(static_cast<int>(i), 5) = det.confidence;
+        const cv::Rect box = det.box & bounds;
+        if (det.mask.empty() || box != det.box) {
+            continue;
+        }
+        instances(box).setTo(cv::Scalar(static_cast<double>(i + 1)), det.mask);
     }
+    ctx.cacheManager->set(cacheId + "_masks", instances);
     
-    return ExecutionResult::ok(detMat);
+    if (ctx.verbose) {
+        std::cout << "[decode_yolo_seg] Detected " << detections.size() << " instances" << std::endl;
+    }
+    
+    return ExecutionResult::ok(detectionsToMat(detections));
+}
+
+// ============================================================================
+// DecodeYoloPoseItem
+// ============================================================================
+
+DecodeYoloPoseItem::DecodeYoloPoseItem() {
+    _functionName = "decode_yolo_pose";
+    _description = "Decode YOLO pose output to detections and keypoints";
+    _category = "dnn";
+    _params = {
+        ParamDef::optional("conf_thresh", BaseType::FLOAT, "Confidence threshold", 0.25),
+        ParamDef::optional("iou_thresh", BaseType::FLOAT, "IoU threshold for NMS", 0.45),
+        ParamDef::optional("orig_width", BaseType::INT, "Original image width", 640),
+        ParamDef::optional("orig_height", BaseType::INT, "Original image height", 640),
+        ParamDef::optional("input_size", BaseType::INT, "Model input size", 640),
+        ParamDef::optional("num_classes", BaseType::INT, "Class scores before the keypoints", 1),
+        ParamDef::optional("cache_id", BaseType::STRING, "Keypoints are cached as <cache_id>_keypoints", "pose")
+    };
+    _example = "decode_yolo_pose(0.25) -> \"detections\"";
+    _returnType = "mat";
+    _tags = {"postprocess", "yolo", "pose", "keypoints", "dnn"};
+}
+
+ExecutionResult DecodeYoloPoseItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
+    float confThresh = args.size() > 0 ? static_cast<float>(args[0].asNumber()) : 0.25f;
+    float iouThresh = args.size() > 1 ? static_cast<float>(args[1].asNumber()) : 0.45f;
+    int origWidth = args.size() > 2 ? static_cast<int>(args[2].asNumber()) : 640;
+    int origHeight = args.size() > 3 ? static_cast<int>(args[3].asNumber()) : 640;
+    int inputSize = args.size() > 4 ? static_cast<int>(args[4].asNumber()) : 640;
+    int numClasses = args.size() > 5 ? static_cast<int>(args[5].asNumber()) : 1;
+    std::string cacheId = args.size() > 6 ? args[6].asString() : "pose";
+    
+    auto detections = ml::Postprocessing::decodeYoloPose(
+        ctx.currentMat, cv::Size(origWidth, origHeight), cv::Size(inputSize, inputSize),
+        confThresh, iouThresh, numClasses
+    );
+    
+    // Format: each row = [x0, y0, conf0, x1, y1, conf1, ...]
+    const int numKeypoints = detections.empty() ? 0 : static_cast<int>(detections[0].keypoints.size());
+    cv::Mat keypoints(static_cast<int>(detections.size()), numKeypoints * 3, CV_32F);
+    for (size_t i = 0; i < detections.size(); ++i) {
+        float* row = keypoints.ptr<float>(static_cast<int>(i));
+        for (int k = 0; k < numKeypoints; ++k) {
+            row[3 * k] = detections[i].keypoints[k].x;
+            row[3 * k + 1] = detections[i].keypoints[k].y;
+            row[3 * k + 2] = detections[i].keypointConfidences[k];
+        }
+    }
+    if (ctx.cacheManager) {
+        ctx.cacheManager->set(cacheId + "_keypoints", keypoints);
+    }
+    
+    if (ctx.verbose) {
+        std::cout << "[decode_yolo_pose] Detected " << detections.size() << " poses" << std::endl;
+    }
+    
+    return ExecutionResult::ok(detectionsToMat(detections));
 }
 
 // ============================================================================
@@ -645,6 +918,7 @@ ExecutionResult DrawDetectionsItem::execute(const std::vector<RuntimeValue>& arg
     }
     
     cv::Mat result = ctx.currentMat.clone();
+    TextRenderer& renderer = TextRenderer::instance();
     
     for (int i = 0; i < detMat.rows; ++i) {
         int x = static_cast<int>(detMat.at<float>(i, 0));
@@ -676,14 +950,14 @@ ExecutionResult DrawDetectionsItem::execute(const std::vector<RuntimeValue>& arg
         
         // Draw label background
         int baseline = 0;
-        cv::Size textSize = cv::getTextSize(label, cv::FONT_HERSHEY_SIMPLEX, 0.5, 1, &baseline);
+        cv::Size textSize = renderer.getTextSize(label, cv::FONT_HERSHEY_SIMPLEX, 0.5, 1, &baseline);
         cv::rectangle(result, 
             cv::Point(x, y - textSize.height - 4),
             cv::Point(x + textSize.width + 4, y),
             color, cv::FILLED);
         
         // Draw label text
-        cv::putText(result, label, cv::Point(x + 2, y - 2), 
+        renderer.putText(result, label, cv::Point(x + 2, y - 2), 
             cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(255, 255, 255), 1);
     }
     
@@ -769,6 +1043,106 @@ ExecutionResult DrawClassificationItem::execute(const std::vector<RuntimeValue>&
     return ExecutionResult::ok(result);
 }
 
+// ============================================================================
+// SegOverlayItem
+// ============================================================================
+
+SegOverlayItem::SegOverlayItem() {
+    _functionName = "seg_overlay";
+    _description = "Argmax, colorize and blend a semantic segmentation output onto the frame";
+    _category = "dnn";
+    _params = {
+        ParamDef::required("scores", BaseType::STRING, "Cache ID of the [1, C, H, W] class score tensor"),
+        ParamDef::optional("alpha", BaseType::FLOAT, "Overlay opacity", 0.5),
+        ParamDef::optional("upsample", BaseType::STRING, "Label upsampling: nearest, edge", "nearest"),
+        ParamDef::optional("thresholds", BaseType::ANY, "Minimum score, one for all classes or an array per class (\"\" = none)", ""),
+        ParamDef::optional("background", BaseType::INT, "Class left unblended (-1 = none)", 0),
+        ParamDef::optional("palette", BaseType::ANY, "Array of [b, g, r] per class (\"voc\" = generated)", "voc"),
+        ParamDef::optional("cache_id", BaseType::STRING, "Cache prefix for _labels and _counts", "seg")
+    };
+    _example = "seg_overlay(\"out_0\", 0.5, \"edge\")";
+    _returnType = "mat";
+    _tags = {"segmentation", "overlay", "visualization", "dnn"};
+}
+
+ExecutionResult SegOverlayItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
+    if (args.empty()) {
+        return ExecutionResult::fail("seg_overlay requires the score tensor cache id");
+    }
+    std::string scoresId = args[0].asString();
+    double alpha = args.size() > 1 ? args[1].asNumber() : 0.5;
+    std::string upsample = args.size() > 2 ? args[2].asString() : "nearest";
+    int background = args.size() > 4 ? static_cast<int>(args[4].asNumber()) : 0;
+    std::string cacheId = args.size() > 6 ? args[6].asString() : "seg";
+    
+    std::vector<float> thresholds;
+    if (args.size() > 3) {
+        if (args[3].isArray()) {
+            for (const auto& v : args[3].asArray()) {
+                thresholds.push_back(static_cast<float>(v.asNumber()));
+            }
+        } else if (args[3].isNumeric()) {
+            thresholds.push_back(static_cast<float>(args[3].asNumber()));
+        }
+    }
+    
+    if (!ctx.cacheManager) {
+        return ExecutionResult::fail("Cache manager not available");
+    }
+    cv::Mat scores = ctx.cacheManager->get(scoresId);
+    if (scores.empty()) {
+        return ExecutionResult::fail("Score tensor not found: " + scoresId);
+    }
+    
+    cv::Mat labels;
+    int numClasses = segArgmax(scores, thresholds, labels);
+    if (numClasses == 0) {
+        return ExecutionResult::fail("seg_overlay expects a CV_32F [1, C, H, W] tensor with C < 255");
+    }
+    
+    std::vector<cv::Vec3b> palette;
+    if (args.size() > 5 && args[5].isArray()) {
+        for (const auto& c : args[5].asArray()) {
+            if (!c.isArray() || c.asArray().size() < 3) {
+                return ExecutionResult::fail("seg_overlay palette entries must be [b, g, r]");
+            }
+            const auto& bgr = c.asArray();
+            palette.emplace_back(cv::saturate_cast<uchar>(bgr[0].asNumber()),
+                                 cv::saturate_cast<uchar>(bgr[1].asNumber()),
+                                 cv::saturate_cast<uchar>(bgr[2].asNumber()));
+        }
+    }
+    if (static_cast<int>(palette.size()) < numClasses) {
+        std::vector<cv::Vec3b> generated = segPalette(numClasses);
+        std::copy(generated.begin() + palette.size(), generated.end(), std::back_inserter(palette));
+    }
+    
+    cv::Mat result;
+    if (ctx.currentMat.channels() == 1) {
+        cv::cvtColor(ctx.currentMat, result, cv::COLOR_GRAY2BGR);
+    } else {
+        result = ctx.currentMat.clone();
+    }
+    
+    SegOverlayOptions opts;
+    opts.alpha = alpha;
+    opts.edgeAware = upsample == "edge";
+    opts.skipClass = background;
+    std::vector<int> counts;
+    segOverlay(result, labels, palette, opts, &counts);
+    
+    counts.resize(numClasses);
+    ctx.cacheManager->set(cacheId + "_labels", labels);
+    ctx.cacheManager->set(cacheId + "_counts", cv::Mat(counts, true));
+    
+    if (ctx.verbose) {
+        std::cout << "[seg_overlay] " << numClasses << " classes at " << labels.cols << "x" << labels.rows
+                  << " -> " << result.cols << "x" << result.rows << std::endl;
+    }
+    
+    return ExecutionResult::ok(result);
+}
+
 // ============================================================================
 // ModelOutputVectorItem - Get DNN output as Vector type
 // ============================================================================
@@ -794,9 +1168,8 @@ ExecutionResult ModelOutputVectorItem::execute(const std::vector<RuntimeValue>&
     std::string id = args[0].asString();
     
     auto& registry = ml::ModelRegistry::instance();
-    auto model = registry.getModel(id);
-    if (!model) {
-        return ExecutionResult::fail("Model not found: " + id);
+    if (!registry.exists(id)) {
+        return ExecutionResult::fail("Model or cascade not found: " + id);
     }
     
     // Run inference if needed
@@ -862,9 +1235,8 @@ ExecutionResult ModelOutputMatrixItem::execute(const std::vector<RuntimeValue>&
     std::string id = args[0].asString();
     
     auto& registry = ml::ModelRegistry::instance();
-    auto model = registry.getModel(id);
-    if (!model) {
-        return ExecutionResult::fail("Model not found: " + id);
+    if (!registry.exists(id)) {
+        return ExecutionResult::fail("Model or cascade not found: " + id);
     }
     
     // Run inference if needed
@@ -937,9 +1309,8 @@ ExecutionResult ModelGetOutputsItem::execute(const std::vector<RuntimeValue>& ar
     std::string id = args[0].asString();
     
     auto& registry = ml::ModelRegistry::instance();
-    auto model = registry.getModel(id);
-    if (!model) {
-        return ExecutionResult::fail("Model not found: " + id);
+    if (!registry.exists(id)) {
+        return ExecutionResult::fail("Model or cascade not found: " + id);
     }
     
     // Run inference
@@ -1,5 +1,6 @@
 #include "interpreter/items/draw_items.h"
 #include "interpreter/cache_manager.h"
+#include "utils/text_renderer.h"
 #include <iostream>
 
 namespace visionpipe {
@@ -434,7 +435,7 @@ ExecutionResult PutTextItem::execute(const std::vector<RuntimeValue>& args, Exec
         cv::cvtColor(result, result, cv::COLOR_GRAY2BGR);
     }
     
-    cv::putText(result, text, cv::Point(x, y), font, scale, parseColor(colorStr), thickness, cv::LINE_AA);
+    TextRenderer::instance().putText(result, text, cv::Point(x, y), font, scale, parseColor(colorStr), thickness, cv::LINE_AA);
     
     return ExecutionResult::ok(result);
 }
@@ -471,7 +472,7 @@ ExecutionResult GetTextSizeItem::execute(const std::vector<RuntimeValue>& args,
     else if (fontStr == "complex") font = cv::FONT_HERSHEY_COMPLEX;
     
     int baseline;
-    cv::Size size = cv::getTextSize(text, font, scale, thickness, &baseline);
+    cv::Size size = TextRenderer::instance().getTextSize(text, font, scale, thickness, &baseline);
     
     ctx.cacheManager->set(prefix + "_width", cv::Mat(1, 1, CV_32S, cv::Scalar(size.width)));
     ctx.cacheManager->set(prefix + "_height", cv::Mat(1, 1, CV_32S, cv::Scalar(size.height)));
@@ -573,11 +574,12 @@ ExecutionResult DrawLabeledRectItem::execute(const std::vector<RuntimeValue>& ar
     
     // Draw label background
     int baseline;
-    cv::Size textSize = cv::getTextSize(label, cv::FONT_HERSHEY_SIMPLEX, fontScale, 1, &baseline);
+    TextRenderer& renderer = TextRenderer::instance();
+    cv::Size textSize = renderer.getTextSize(label, cv::FONT_HERSHEY_SIMPLEX, fontScale, 1, &baseline);
     cv::rectangle(result, cv::Point(x, y - textSize.height - 5), cv::Point(x + textSize.width + 4, y), color, -1);
     
     // Draw label text
-    cv::putText(result, label, cv::Point(x + 2, y - 3), cv::FONT_HERSHEY_SIMPLEX, fontScale, cv::Scalar(255, 255, 255), 1, cv::LINE_AA);
+    renderer.putText(result, label, cv::Point(x + 2, y - 3), cv::FONT_HERSHEY_SIMPLEX, fontScale, cv::Scalar(255, 255, 255), 1, cv::LINE_AA);
     
     return ExecutionResult::ok(result);
 }
@@ -1,5 +1,7 @@
 #include "interpreter/items/edge_items.h"
 #include "interpreter/cache_manager.h"
+#include "utils/hough_engine.h"
+#include <algorithm>
 #include <iostream>
 
 namespace visionpipe {
@@ -30,6 +32,23 @@ void registerEdgeItems(ItemRegistry& registry) {
     registry.add<HoughCirclesItem>();
 }
 
+/// Canny with the 3x3 Sobel pass hoisted out so its derivatives can be
+/// published for hough_lines' orientation-gated voting.  Other apertures
+/// go through cv::Canny unchanged.
+static void cannyShared(const cv::Mat& gray, cv::Mat& edges, double t1, double t2,
+                        int apertureSize, bool L2gradient) {
+    if (apertureSize != 3 || gray.depth() != CV_8U) {
+        cv::Canny(gray, edges, t1, t2, apertureSize, L2gradient);
+        return;
+    }
+    cv::Mat dx, dy;
+    // Same derivatives cv::Canny computes internally for aperture 3.
+    cv::Sobel(gray, dx, CV_16S, 1, 0, 3, 1, 0, cv::BORDER_REPLICATE);
+    cv::Sobel(gray, dy, CV_16S, 0, 1, 3, 1, 0, cv::BORDER_REPLICATE);
+    cv::Canny(dx, dy, edges, t1, t2, L2gradient);
+    GradientStore::instance().publish(edges, dx, dy);
+}
+
 // ============================================================================
 // CannyItem
 // ============================================================================
@@ -61,7 +80,7 @@ ExecutionResult CannyItem::execute(const std::vector<RuntimeValue>& args, Execut
     }
     
     cv::Mat result;
-    cv::Canny(input, result, thresh1, thresh2, apertureSize, L2gradient);
+    cannyShared(input, result, thresh1, thresh2, apertureSize, L2gradient);
     
     return ExecutionResult::ok(result);
 }
@@ -106,7 +125,7 @@ ExecutionResult AutoCannyItem::execute(const std::vector<RuntimeValue>& args, Ex
     double upper = std::min(255.0, (1.0 + sigma) * median);
     
     cv::Mat result;
-    cv::Canny(gray, result, lower, upper);
+    cannyShared(gray, result, lower, upper, 3, false);
     
     return ExecutionResult::ok(result);
 }
@@ -905,6 +924,17 @@ ExecutionResult IsContourConvexItem::execute(const std::vector<RuntimeValue>& ar
     return ExecutionResult::ok(ctx.currentMat);
 }
 
+/// roi_x, roi_y, roi_w, roi_h starting at args[first]; zero extents run to
+/// the frame edge.  Clipped to the frame; an empty result means the full frame.
+static cv::Rect parseHoughRoi(const std::vector<RuntimeValue>& args, size_t first, const cv::Size& size) {
+    auto at = [&](size_t i) { return args.size() > first + i ? static_cast<int>(args[first + i].asNumber()) : 0; };
+    cv::Rect roi(at(0), at(1), at(2), at(3));
+    if (roi.width <= 0) roi.width = size.width - roi.x;
+    if (roi.height <= 0) roi.height = size.height - roi.y;
+    roi &= cv::Rect(0, 0, size.width, size.height);
+    return roi.empty() ? cv::Rect(0, 0, size.width, size.height) : roi;
+}
+
 // ============================================================================
 // HoughLinesItem
 // ============================================================================
@@ -918,9 +948,22 @@ HoughLinesItem::HoughLinesItem() {
         ParamDef::optional("theta", BaseType::FLOAT, "Angle resolution (degrees)", 1.0),
         ParamDef::optional("threshold", BaseType::INT, "Accumulator threshold", 100),
         ParamDef::optional("color", BaseType::STRING, "Line color", "red"),
-        ParamDef::optional("thickness", BaseType::INT, "Line thickness", 2)
+        ParamDef::optional("thickness", BaseType::INT, "Line thickness", 2),
+        ParamDef::optional("angle_window", BaseType::FLOAT,
+                           "Vote only within +/- this many degrees of each edge pixel's gradient "
+                           "(needs a canny edge map; 0 = all angles)", 0.0),
+        ParamDef::optional("min_angle", BaseType::FLOAT, "Searched theta range start (degrees)", 0.0),
+        ParamDef::optional("max_angle", BaseType::FLOAT, "Searched theta range end (degrees)", 180.0),
+        ParamDef::optional("roi_x", BaseType::INT, "ROI left (pixels)", 0),
+        ParamDef::optional("roi_y", BaseType::INT, "ROI top (pixels)", 0),
+        ParamDef::optional("roi_w", BaseType::INT, "ROI width (0 = to frame edge)", 0),
+        ParamDef::optional("roi_h", BaseType::INT, "ROI height (0 = to frame edge)", 0),
+        ParamDef::optional("max_lines", BaseType::INT, "Keep the N strongest lines (0 = all)", 0),
+        ParamDef::optional("output_cache", BaseType::STRING,
+                           "Cache ID for the N x 3 [rho, theta, votes] lines (empty = none)", ""),
+        ParamDef::optional("cache_id", BaseType::STRING, "Accumulator state ID", "hough_lines")
     };
-    _example = "hough_lines(1, 1, 100, \"red\", 2)";
+    _example = "canny(50, 150) | hough_lines(1, 1, 100, \"red\", 2, 10, 80, 100)";
     _returnType = "mat";
     _tags = {"hough", "lines", "detection"};
 }
@@ -941,8 +984,44 @@ ExecutionResult HoughLinesItem::execute(const std::vector<RuntimeValue>& args, E
         cv::cvtColor(input, input, cv::COLOR_BGR2GRAY);
     }
     
-    std::vector<cv::Vec2f> lines;
-    cv::HoughLines(input, lines, rho, theta, threshold);
+    HoughLineConfig cfg;
+    cfg.rho = rho;
+    cfg.thetaStep = theta;
+    cfg.angleWindow = args.size() > 5 ? args[5].asNumber() * CV_PI / 180.0 : 0.0;
+    cfg.minTheta = args.size() > 6 ? args[6].asNumber() * CV_PI / 180.0 : 0.0;
+    cfg.maxTheta = args.size() > 7 ? args[7].asNumber() * CV_PI / 180.0 : CV_PI;
+    cv::Rect roi(args.size() > 8 ? static_cast<int>(args[8].asNumber()) : 0,
+                 args.size() > 9 ? static_cast<int>(args[9].asNumber()) : 0,
+                 args.size() > 10 ? static_cast<int>(args[10].asNumber()) : 0,
+                 args.size() > 11 ? static_cast<int>(args[11].asNumber()) : 0);
+    int maxLines = args.size() > 12 ? static_cast<int>(args[12].asNumber()) : 0;
+    std::string outputCache = args.size() > 13 ? args[13].asString() : "";
+    std::string cacheId = args.size() > 14 ? args[14].asString() : "hough_lines";
+    
+    cfg.minTheta = std::clamp(cfg.minTheta, 0.0, CV_PI);
+    cfg.maxTheta = std::clamp(cfg.maxTheta, cfg.minTheta, CV_PI);
+    if (roi.width <= 0) roi.width = input.cols - roi.x;
+    if (roi.height <= 0) roi.height = input.rows - roi.y;
+    if (input.depth() != CV_8U) {
+        input.convertTo(input, CV_8U);
+    }
+    
+    // Derivatives are only known for a canny edge map passed straight through.
+    cv::Mat dx, dy;
+    GradientStore::instance().lookup(input, dx, dy);
+    
+    auto engine = HoughEngineRegistry::instance().acquire(cacheId);
+    std::vector<HoughLine> lines = engine->detectLines(input, dx, dy, cfg, roi, threshold, maxLines);
+    
+    if (!outputCache.empty()) {
+        cv::Mat table(static_cast<int>(lines.size()), 3, CV_32F);
+        for (int i = 0; i < table.rows; ++i) {
+            table.at<float>(i, 0) = lines[i].rho;
+            table.at<float>(i, 1) = lines[i].theta;
+            table.at<float>(i, 2) = static_cast<float>(lines[i].votes);
+        }
+        ctx.cacheManager->set(outputCache, table);
+    }
     
     cv::Mat result = ctx.currentMat.clone();
     if (result.channels() == 1) {
@@ -950,7 +1029,7 @@ ExecutionResult HoughLinesItem::execute(const std::vector<RuntimeValue>& args, E
     }
     
     for (const auto& line : lines) {
-        float r = line[0], t = line[1];
+        float r = line.rho, t = line.theta;
         double a = std::cos(t), b = std::sin(t);
         double x0 = a * r, y0 = b * r;
         cv::Point pt1(cvRound(x0 + 1000 * (-b)), cvRound(y0 + 1000 * (a)));
@@ -976,7 +1055,11 @@ HoughLinesPItem::HoughLinesPItem() {
         ParamDef::optional("min_line_length", BaseType::FLOAT, "Minimum line length", 50.0),
         ParamDef::optional("max_line_gap", BaseType::FLOAT, "Maximum gap between segments", 10.0),
         ParamDef::optional("color", BaseType::STRING, "Line color", "red"),
-        ParamDef::optional("thickness", BaseType::INT, "Line thickness", 2)
+        ParamDef::optional("thickness", BaseType::INT, "Line thickness", 2),
+        ParamDef::optional("roi_x", BaseType::INT, "ROI left (pixels)", 0),
+        ParamDef::optional("roi_y", BaseType::INT, "ROI top (pixels)", 0),
+        ParamDef::optional("roi_w", BaseType::INT, "ROI width (0 = to frame edge)", 0),
+        ParamDef::optional("roi_h", BaseType::INT, "ROI height (0 = to frame edge)", 0)
     };
     _example = "hough_lines_p(1, 1, 50, 50, 10, \"red\", 2)";
     _returnType = "mat";
@@ -1001,8 +1084,13 @@ ExecutionResult HoughLinesPItem::execute(const std::vector<RuntimeValue>& args,
         cv::cvtColor(input, input, cv::COLOR_BGR2GRAY);
     }
     
+    cv::Rect roi = parseHoughRoi(args, 7, input.size());
+    
     std::vector<cv::Vec4i> lines;
-    cv::HoughLinesP(input, lines, rho, theta, threshold, minLineLength, maxLineGap);
+    cv::HoughLinesP(input(roi), lines, rho, theta, threshold, minLineLength, maxLineGap);
+    for (auto& l : lines) {
+        l += cv::Vec4i(roi.x, roi.y, roi.x, roi.y);
+    }
     
     cv::Mat result = ctx.currentMat.clone();
     if (result.channels() == 1) {
@@ -1032,9 +1120,13 @@ HoughCirclesItem::HoughCirclesItem() {
         ParamDef::optional("min_radius", BaseType::INT, "Minimum radius", 0),
         ParamDef::optional("max_radius", BaseType::INT, "Maximum radius", 0),
         ParamDef::optional("color", BaseType::STRING, "Circle color", "green"),
-        ParamDef::optional("thickness", BaseType::INT, "Line thickness", 2)
+        ParamDef::optional("thickness", BaseType::INT, "Line thickness", 2),
+        ParamDef::optional("roi_x", BaseType::INT, "ROI left (pixels)", 0),
+        ParamDef::optional("roi_y", BaseType::INT, "ROI top (pixels)", 0),
+        ParamDef::optional("roi_w", BaseType::INT, "ROI width (0 = to frame edge)", 0),
+        ParamDef::optional("roi_h", BaseType::INT, "ROI height (0 = to frame edge)", 0)
     };
-    _example = "hough_circles(1, 20, 100, 30, 10, 100, \"green\", 2)";
+    _example = "hough_circles(1, 20, 100, 30, 10, 100, \"green\", 2, 320, 0, 640, 480)";
     _returnType = "mat";
     _tags = {"hough", "circles", "detection"};
 }
@@ -1058,8 +1150,14 @@ ExecutionResult HoughCirclesItem::execute(const std::vector<RuntimeValue>& args,
         cv::cvtColor(input, input, cv::COLOR_BGR2GRAY);
     }
     
+    cv::Rect roi = parseHoughRoi(args, 8, input.size());
+    
     std::vector<cv::Vec3f> circles;
-    cv::HoughCircles(input, circles, cv::HOUGH_GRADIENT, dp, minDist, param1, param2, minRadius, maxRadius);
+    cv::HoughCircles(input(roi), circles, cv::HOUGH_GRADIENT, dp, minDist, param1, param2, minRadius, maxRadius);
+    for (auto& c : circles) {
+        c[0] += static_cast<float>(roi.x);
+        c[1] += static_cast<float>(roi.y);
+    }
     
     cv::Mat result = ctx.currentMat.clone();
     if (result.channels() == 1) {
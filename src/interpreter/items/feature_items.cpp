@@ -1,6 +1,10 @@
 #include "interpreter/items/feature_items.h"
 #include "interpreter/cache_manager.h"
+#include "utils/template_matcher.h"
+#include "utils/primitive_rasterizer.h"
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
 namespace visionpipe {
 
@@ -24,9 +28,48 @@ void registerFeatureItems(ItemRegistry& registry) {
     registry.add<FindHomographyItem>();
     registry.add<PerspectiveTransformPointsItem>();
     registry.add<MatchTemplateItem>();
+    registry.add<MatchTemplatesItem>();
     registry.add<MinMaxLocItem>();
 }
 
+// ============================================================================
+// Keypoint drawing
+// ============================================================================
+
+/**
+ * @brief cv::drawKeypoints on PrimitiveBatch: every keypoint circle (and
+ * orientation line when @p rich) goes through one parallel rasterization
+ * pass instead of a cv::circle call each.
+ */
+static cv::Mat drawKeypointsBatched(const cv::Mat& image, const std::vector<cv::KeyPoint>& keypoints,
+                                    const cv::Scalar& color, bool rich = false) {
+    cv::Mat result;
+    if (image.channels() == 1) {
+        cv::cvtColor(image, result, cv::COLOR_GRAY2BGR);
+    } else if (image.channels() == 4) {
+        cv::cvtColor(image, result, cv::COLOR_BGRA2BGR);
+    } else {
+        result = image.clone();
+    }
+
+    PrimitiveBatch batch;
+    batch.reserve(keypoints.size() * (rich ? 2 : 1));
+    for (const cv::KeyPoint& kp : keypoints) {
+        if (!rich) {
+            batch.circle(kp.pt, 3.0f, color);
+            continue;
+        }
+        const float radius = kp.size * 0.5f;
+        batch.circle(kp.pt, radius, color);
+        if (kp.angle != -1) {
+            const float a = kp.angle * static_cast<float>(CV_PI / 180.0);
+            batch.line(kp.pt, kp.pt + cv::Point2f(std::cos(a), std::sin(a)) * radius, color);
+        }
+    }
+    batch.render(result, cv::LINE_AA);
+    return result;
+}
+
 // ============================================================================
 // GoodFeaturesToTrackItem
 // ============================================================================
@@ -246,8 +289,7 @@ ExecutionResult SimpleBlobDetectorItem::execute(const std::vector<RuntimeValue>&
     std::vector<cv::KeyPoint> keypoints;
     detector->detect(ctx.currentMat, keypoints);
     
-    cv::Mat result;
-    cv::drawKeypoints(ctx.currentMat, keypoints, result, cv::Scalar(0, 0, 255), cv::DrawMatchesFlags::DRAW_RICH_KEYPOINTS);
+    cv::Mat result = drawKeypointsBatched(ctx.currentMat, keypoints, cv::Scalar(0, 0, 255), true);
     
     return ExecutionResult::ok(result);
 }
@@ -287,8 +329,7 @@ ExecutionResult ORBItem::execute(const std::vector<RuntimeValue>& args, Executio
     
     ctx.cacheManager->set(cacheId + "_descriptors", descriptors);
     
-    cv::Mat result;
-    cv::drawKeypoints(ctx.currentMat, keypoints, result, cv::Scalar(0, 255, 0));
+    cv::Mat result = drawKeypointsBatched(ctx.currentMat, keypoints, cv::Scalar(0, 255, 0));
     
     return ExecutionResult::ok(result);
 }
@@ -330,8 +371,7 @@ ExecutionResult SIFTItem::execute(const std::vector<RuntimeValue>& args, Executi
     
     ctx.cacheManager->set(cacheId + "_descriptors", descriptors);
     
-    cv::Mat result;
-    cv::drawKeypoints(ctx.currentMat, keypoints, result, cv::Scalar(0, 255, 0));
+    cv::Mat result = drawKeypointsBatched(ctx.currentMat, keypoints, cv::Scalar(0, 255, 0));
     
     return ExecutionResult::ok(result);
 }
@@ -369,8 +409,7 @@ ExecutionResult AKAZEItem::execute(const std::vector<RuntimeValue>& args, Execut
     
     ctx.cacheManager->set(cacheId + "_descriptors", descriptors);
     
-    cv::Mat result;
-    cv::drawKeypoints(ctx.currentMat, keypoints, result, cv::Scalar(0, 255, 0));
+    cv::Mat result = drawKeypointsBatched(ctx.currentMat, keypoints, cv::Scalar(0, 255, 0));
     
     return ExecutionResult::ok(result);
 }
@@ -408,8 +447,7 @@ ExecutionResult BRISKItem::execute(const std::vector<RuntimeValue>& args, Execut
     
     ctx.cacheManager->set(cacheId + "_descriptors", descriptors);
     
-    cv::Mat result;
-    cv::drawKeypoints(ctx.currentMat, keypoints, result, cv::Scalar(0, 255, 0));
+    cv::Mat result = drawKeypointsBatched(ctx.currentMat, keypoints, cv::Scalar(0, 255, 0));
     
     return ExecutionResult::ok(result);
 }
@@ -446,8 +484,7 @@ ExecutionResult FASTItem::execute(const std::vector<RuntimeValue>& args, Executi
     std::vector<cv::KeyPoint> keypoints;
     detector->detect(ctx.currentMat, keypoints);
     
-    cv::Mat result;
-    cv::drawKeypoints(ctx.currentMat, keypoints, result, cv::Scalar(0, 255, 0));
+    cv::Mat result = drawKeypointsBatched(ctx.currentMat, keypoints, cv::Scalar(0, 255, 0));
     
     return ExecutionResult::ok(result);
 }
@@ -485,8 +522,7 @@ ExecutionResult AGASTItem::execute(const std::vector<RuntimeValue>& args, Execut
     std::vector<cv::KeyPoint> keypoints;
     detector->detect(ctx.currentMat, keypoints);
     
-    cv::Mat result;
-    cv::drawKeypoints(ctx.currentMat, keypoints, result, cv::Scalar(0, 255, 0));
+    cv::Mat result = drawKeypointsBatched(ctx.currentMat, keypoints, cv::Scalar(0, 255, 0));
     
     return ExecutionResult::ok(result);
 }
@@ -528,8 +564,7 @@ ExecutionResult KAZEItem::execute(const std::vector<RuntimeValue>& args, Executi
     
     ctx.cacheManager->set(cacheId + "_descriptors", descriptors);
     
-    cv::Mat result;
-    cv::drawKeypoints(ctx.currentMat, keypoints, result, cv::Scalar(0, 255, 0));
+    cv::Mat result = drawKeypointsBatched(ctx.currentMat, keypoints, cv::Scalar(0, 255, 0));
     
     return ExecutionResult::ok(result);
 }
@@ -818,6 +853,85 @@ ExecutionResult MatchTemplateItem::execute(const std::vector<RuntimeValue>& args
     return ExecutionResult::ok(result);
 }
 
+// ============================================================================
+// MatchTemplatesItem
+// ============================================================================
+
+MatchTemplatesItem::MatchTemplatesItem() {
+    _functionName = "match_templates";
+    _description = "Coarse-to-fine matching of a template batch, returning top-k peaks";
+    _category = "feature";
+    _params = {
+        ParamDef::required("templates", BaseType::ARRAY, "Array of template cache IDs"),
+        ParamDef::optional("method", BaseType::STRING,
+            "Method: ccoeff_normed, ccorr_normed, sqdiff_normed", "ccoeff_normed"),
+        ParamDef::optional("top_k", BaseType::INT, "Peaks kept per template", 1),
+        ParamDef::optional("threshold", BaseType::FLOAT, "Minimum match score", 0.8),
+        ParamDef::optional("levels", BaseType::INT, "Pyramid levels (-1 = auto)", -1),
+        ParamDef::optional("output_cache", BaseType::STRING, "Cache ID for detections", "matches"),
+        ParamDef::optional("cache_id", BaseType::STRING, "Template bank ID", "match_templates")
+    };
+    _example = "match_templates([\"part_a\", \"part_b\"], \"ccoeff_normed\", 3, 0.85)";
+    _returnType = "mat";
+    _tags = {"template", "matching", "detection", "pyramid", "batch"};
+}
+
+ExecutionResult MatchTemplatesItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
+    std::vector<std::string> ids;
+    if (args[0].isArray()) {
+        for (const auto& v : args[0].asArray()) ids.push_back(v.asString());
+    } else {
+        ids.push_back(args[0].asString());
+    }
+    std::string method = args.size() > 1 ? args[1].asString() : "ccoeff_normed";
+    
+    TemplateMatchParams params;
+    params.topK = args.size() > 2 ? std::max(1, static_cast<int>(args[2].asNumber())) : 1;
+    params.threshold = args.size() > 3 ? args[3].asNumber() : 0.8;
+    params.maxLevels = args.size() > 4 ? static_cast<int>(args[4].asNumber()) : -1;
+    std::string outputCache = args.size() > 5 ? args[5].asString() : "matches";
+    std::string cacheId = args.size() > 6 ? args[6].asString() : "match_templates";
+    
+    if (method == "ccoeff_normed") params.method = cv::TM_CCOEFF_NORMED;
+    else if (method == "ccorr_normed") params.method = cv::TM_CCORR_NORMED;
+    else if (method == "sqdiff_normed") params.method = cv::TM_SQDIFF_NORMED;
+    else return ExecutionResult::fail("match_templates: unsupported method '" + method + "'");
+    
+    std::vector<cv::Mat> templates;
+    templates.reserve(ids.size());
+    for (const auto& id : ids) {
+        cv::Mat t = ctx.cacheManager->get(id);
+        if (t.empty()) {
+            return ExecutionResult::fail("Template not found in cache: " + id);
+        }
+        templates.push_back(t);
+    }
+    
+    int64 t0 = ctx.verbose ? cv::getTickCount() : 0;
+    auto bank = TemplateBankRegistry::instance().acquire(cacheId);
+    std::vector<MatchPeak> peaks = bank->match(ctx.currentMat, templates, params);
+    
+    cv::Mat detMat(static_cast<int>(peaks.size()), 6, CV_32F);
+    for (size_t i = 0; i < peaks.size(); ++i) {
+        float* row = detMat.ptr<float>(static_cast<int>(i));
+        row[0] = static_cast<float>(peaks[i].box.x);
+        row[1] = static_cast<float>(peaks[i].box.y);
+        row[2] = static_cast<float>(peaks[i].box.width);
+        row[3] = static_cast<float>(peaks[i].box.height);
+        row[4] = static_cast<float>(peaks[i].templateIndex);
+        row[5] = peaks[i].score;
+    }
+    ctx.cacheManager->set(outputCache, detMat);
+    
+    if (ctx.verbose) {
+        double ms = (cv::getTickCount() - t0) * 1000.0 / cv::getTickFrequency();
+        std::cout << "[match_templates] " << templates.size() << " templates, "
+                  << peaks.size() << " peaks in " << ms << " ms" << std::endl;
+    }
+    
+    return ExecutionResult::ok(ctx.currentMat);
+}
+
 // ============================================================================
 // MinMaxLocItem
 // ============================================================================
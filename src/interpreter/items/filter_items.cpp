@@ -1,4 +1,5 @@
 #include "interpreter/items/filter_items.h"
+#include "utils/integral_image_service.h"
 #include <iostream>
 
 namespace visionpipe {
@@ -61,6 +62,11 @@ ExecutionResult GaussianBlurItem::execute(const std::vector<RuntimeValue>& args,
     return ExecutionResult::ok(result);
 }
 
+std::optional<FrameShape> GaussianBlurItem::inferOutputShape(const std::vector<RuntimeValue>& /*args*/,
+                                                             const FrameShape& input) const {
+    return input;
+}
+
 // ============================================================================
 // MedianBlurItem
 // ============================================================================
@@ -87,6 +93,11 @@ ExecutionResult MedianBlurItem::execute(const std::vector<RuntimeValue>& args, E
     return ExecutionResult::ok(result);
 }
 
+std::optional<FrameShape> MedianBlurItem::inferOutputShape(const std::vector<RuntimeValue>& /*args*/,
+                                                           const FrameShape& input) const {
+    return input;
+}
+
 // ============================================================================
 // BilateralFilterItem
 // ============================================================================
@@ -153,8 +164,17 @@ ExecutionResult BoxFilterItem::execute(const std::vector<RuntimeValue>& args, Ex
     int anchorY = args.size() > 4 ? static_cast<int>(args[4].asNumber()) : -1;
     
     cv::Mat result;
-    cv::boxFilter(ctx.currentMat, result, ddepth, cv::Size(ksize, ksize), 
-                  cv::Point(anchorX, anchorY), normalize);
+    cv::Size kernel(ksize, ksize);
+    cv::Point anchor(anchorX, anchorY);
+    auto& integrals = IntegralImageService::instance();
+    if (ksize > 0 && integrals.shouldRoute(ctx.currentMat, ctx.frameGeneration, cv::BORDER_DEFAULT)) {
+        // Another box-statistics item already read this frame: share its sums.
+        auto ii = integrals.acquire(ctx.currentMat, ctx.frameGeneration, IntegralImage::SUM,
+                                    IntegralImageService::marginFor(kernel, anchor), cv::BORDER_DEFAULT);
+        ii->boxFilter(result, kernel, anchor, normalize, ddepth);
+    } else {
+        cv::boxFilter(ctx.currentMat, result, ddepth, kernel, anchor, normalize);
+    }
     
     return ExecutionResult::ok(result);
 }
@@ -179,11 +199,25 @@ ExecutionResult BlurItem::execute(const std::vector<RuntimeValue>& args, Executi
     int ksize = args.size() > 0 ? static_cast<int>(args[0].asNumber()) : 5;
     
     cv::Mat result;
-    cv::blur(ctx.currentMat, result, cv::Size(ksize, ksize));
+    cv::Size kernel(ksize, ksize);
+    auto& integrals = IntegralImageService::instance();
+    if (ksize > 0 && integrals.shouldRoute(ctx.currentMat, ctx.frameGeneration, cv::BORDER_DEFAULT)) {
+        auto ii = integrals.acquire(ctx.currentMat, ctx.frameGeneration, IntegralImage::SUM,
+                                    IntegralImageService::marginFor(kernel, cv::Point(-1, -1)),
+                                    cv::BORDER_DEFAULT);
+        ii->boxFilter(result, kernel, cv::Point(-1, -1), true, -1);
+    } else {
+        cv::blur(ctx.currentMat, result, kernel);
+    }
     
     return ExecutionResult::ok(result);
 }
 
+std::optional<FrameShape> BlurItem::inferOutputShape(const std::vector<RuntimeValue>& /*args*/,
+                                                     const FrameShape& input) const {
+    return input;
+}
+
 // ============================================================================
 // StackBlurItem
 // ============================================================================
@@ -1,5 +1,6 @@
 #include "interpreter/items/gui_enhanced_items.h"
 #include "interpreter/cache_manager.h"
+#include "utils/text_renderer.h"
 #include <opencv2/highgui.hpp>
 #include <iostream>
 #include <sstream>
@@ -733,7 +734,8 @@ ExecutionResult ImshowWithVarsItem::execute(const std::vector<RuntimeValue>& arg
         }
     }
     
-    // Draw variable values
+    // Draw variable values: all shadows first, then the text on top
+    std::vector<TextRenderer::Label> shadows, texts;
     int y = 20;
     for (const auto& varName : vars) {
         std::string text = varName + ": ";
@@ -754,11 +756,12 @@ ExecutionResult ImshowWithVarsItem::execute(const std::vector<RuntimeValue>& arg
             text += "<undefined>";
         }
         
-        // Draw with shadow for visibility
-        cv::putText(display, text, cv::Point(11, y + 1), cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(0, 0, 0), 2);
-        cv::putText(display, text, cv::Point(10, y), cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(0, 255, 0), 1);
+        shadows.push_back({text, cv::Point(11, y + 1), cv::Scalar(0, 0, 0)});
+        texts.push_back({std::move(text), cv::Point(10, y), cv::Scalar(0, 255, 0)});
         y += 20;
     }
+    TextRenderer::instance().putTextBatch(display, shadows, cv::FONT_HERSHEY_SIMPLEX, 0.5, 2);
+    TextRenderer::instance().putTextBatch(display, texts, cv::FONT_HERSHEY_SIMPLEX, 0.5, 1);
     
     cv::imshow(window, display);
     
@@ -1,5 +1,9 @@
 #include "interpreter/items/morphology_items.h"
 #include "interpreter/cache_manager.h"
+#include "utils/run_length_blobs.h"
+#include "utils/integral_image_service.h"
+#include "utils/binary_thinning.h"
+#include "utils/packed_mask.h"
 #include <iostream>
 
 namespace visionpipe {
@@ -18,6 +22,7 @@ void registerMorphologyItems(ItemRegistry& registry) {
     registry.add<RemoveSmallObjectsItem>();
     registry.add<ConnectedComponentsItem>();
     registry.add<ConnectedComponentsWithStatsItem>();
+    registry.add<BlobAnalyzeItem>();
     registry.add<DistanceTransformItem>();
 }
 
@@ -59,6 +64,11 @@ ExecutionResult ThresholdItem::execute(const std::vector<RuntimeValue>& args, Ex
     return ExecutionResult::ok(result);
 }
 
+std::optional<FrameShape> ThresholdItem::inferOutputShape(const std::vector<RuntimeValue>& /*args*/,
+                                                          const FrameShape& input) const {
+    return input;
+}
+
 // ============================================================================
 // AdaptiveThresholdItem
 // ============================================================================
@@ -100,7 +110,35 @@ ExecutionResult AdaptiveThresholdItem::execute(const std::vector<RuntimeValue>&
     }
     
     cv::Mat result;
-    cv::adaptiveThreshold(input, result, maxval, method, type, blockSize, C);
+    const int border = cv::BORDER_REPLICATE | cv::BORDER_ISOLATED;   // as cv::adaptiveThreshold
+    auto& integrals = IntegralImageService::instance();
+    if (method == cv::ADAPTIVE_THRESH_MEAN_C && input.type() == CV_8UC1 && blockSize > 1 &&
+        integrals.shouldRoute(input, ctx.frameGeneration, border)) {
+        // Same mean and lookup as cv::adaptiveThreshold, with the local mean
+        // taken from integral images shared with other box-statistics items.
+        cv::Size kernel(blockSize, blockSize);
+        auto ii = integrals.acquire(input, ctx.frameGeneration, IntegralImage::SUM,
+                                    IntegralImageService::marginFor(kernel, cv::Point(-1, -1)), border);
+        cv::Mat mean;
+        ii->boxFilter(mean, kernel, cv::Point(-1, -1), true, CV_8U);
+
+        const uchar imaxval = cv::saturate_cast<uchar>(maxval);
+        const int idelta = type == cv::THRESH_BINARY ? cvCeil(C) : cvFloor(C);
+        uchar tab[768];
+        for (int i = 0; i < 768; ++i) {
+            const bool above = i - 255 > -idelta;
+            tab[i] = (type == cv::THRESH_BINARY ? above : !above) ? imaxval : 0;
+        }
+        result.create(input.size(), CV_8UC1);
+        for (int y = 0; y < input.rows; ++y) {
+            const uchar* s = input.ptr<uchar>(y);
+            const uchar* m = mean.ptr<uchar>(y);
+            uchar* d = result.ptr<uchar>(y);
+            for (int x = 0; x < input.cols; ++x) d[x] = tab[s[x] - m[x] + 255];
+        }
+    } else {
+        cv::adaptiveThreshold(input, result, maxval, method, type, blockSize, C);
+    }
     
     return ExecutionResult::ok(result);
 }
@@ -167,10 +205,11 @@ ExecutionResult ErodeItem::execute(const std::vector<RuntimeValue>& args, Execut
     if (shape == "cross") morphShape = cv::MORPH_CROSS;
     else if (shape == "ellipse") morphShape = cv::MORPH_ELLIPSE;
     
-    cv::Mat kernel = cv::getStructuringElement(morphShape, cv::Size(ksize, ksize));
-    
     cv::Mat result;
-    cv::erode(ctx.currentMat, result, kernel, cv::Point(-1,-1), iterations);
+    if (!packedMorphology(ctx.currentMat, cv::MORPH_ERODE, ksize, morphShape, iterations, result)) {
+        cv::Mat kernel = cv::getStructuringElement(morphShape, cv::Size(ksize, ksize));
+        cv::erode(ctx.currentMat, result, kernel, cv::Point(-1,-1), iterations);
+    }
     
     return ExecutionResult::ok(result);
 }
@@ -202,10 +241,11 @@ ExecutionResult DilateItem::execute(const std::vector<RuntimeValue>& args, Execu
     if (shape == "cross") morphShape = cv::MORPH_CROSS;
     else if (shape == "ellipse") morphShape = cv::MORPH_ELLIPSE;
     
-    cv::Mat kernel = cv::getStructuringElement(morphShape, cv::Size(ksize, ksize));
-    
     cv::Mat result;
-    cv::dilate(ctx.currentMat, result, kernel, cv::Point(-1,-1), iterations);
+    if (!packedMorphology(ctx.currentMat, cv::MORPH_DILATE, ksize, morphShape, iterations, result)) {
+        cv::Mat kernel = cv::getStructuringElement(morphShape, cv::Size(ksize, ksize));
+        cv::dilate(ctx.currentMat, result, kernel, cv::Point(-1,-1), iterations);
+    }
     
     return ExecutionResult::ok(result);
 }
@@ -247,10 +287,11 @@ ExecutionResult MorphologyExItem::execute(const std::vector<RuntimeValue>& args,
     if (shape == "cross") morphShape = cv::MORPH_CROSS;
     else if (shape == "ellipse") morphShape = cv::MORPH_ELLIPSE;
     
-    cv::Mat kernel = cv::getStructuringElement(morphShape, cv::Size(ksize, ksize));
-    
     cv::Mat result;
-    cv::morphologyEx(ctx.currentMat, result, morphOp, kernel, cv::Point(-1,-1), iterations);
+    if (!packedMorphology(ctx.currentMat, morphOp, ksize, morphShape, iterations, result)) {
+        cv::Mat kernel = cv::getStructuringElement(morphShape, cv::Size(ksize, ksize));
+        cv::morphologyEx(ctx.currentMat, result, morphOp, kernel, cv::Point(-1,-1), iterations);
+    }
     
     return ExecutionResult::ok(result);
 }
@@ -294,7 +335,7 @@ ExecutionResult GetStructuringElementItem::execute(const std::vector<RuntimeValu
 
 SkeletonizeItem::SkeletonizeItem() {
     _functionName = "skeletonize";
-    _description = "Extracts skeleton of binary image";
+    _description = "Extracts skeleton of binary image (Zhang-Suen thinning)";
     _category = "morphology";
     _params = {};
     _example = "skeletonize()";
@@ -303,28 +344,17 @@ SkeletonizeItem::SkeletonizeItem() {
 }
 
 ExecutionResult SkeletonizeItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
-    cv::Mat img = ctx.currentMat.clone();
+    cv::Mat img = ctx.currentMat;
     if (img.channels() > 1) {
         cv::cvtColor(img, img, cv::COLOR_BGR2GRAY);
     }
-    
-    cv::Mat skel = cv::Mat::zeros(img.size(), CV_8UC1);
-    cv::Mat element = cv::getStructuringElement(cv::MORPH_CROSS, cv::Size(3, 3));
-    cv::Mat temp;
-    
-    bool done = false;
-    while (!done) {
-        cv::morphologyEx(img, temp, cv::MORPH_OPEN, element);
-        cv::bitwise_not(temp, temp);
-        cv::bitwise_and(img, temp, temp);
-        cv::bitwise_or(skel, temp, skel);
-        cv::erode(img, img, element);
-        
-        double maxVal;
-        cv::minMaxLoc(img, nullptr, &maxVal);
-        done = (maxVal == 0);
+    if (img.depth() != CV_8U) {
+        img.convertTo(img, CV_8U);
     }
     
+    cv::Mat skel;
+    thinBinary(img, skel, ThinningMethod::ZhangSuen);
+    
     return ExecutionResult::ok(skel);
 }
 
@@ -334,7 +364,7 @@ ExecutionResult SkeletonizeItem::execute(const std::vector<RuntimeValue>& args,
 
 ThinningItem::ThinningItem() {
     _functionName = "thinning";
-    _description = "Applies morphological thinning using ximgproc";
+    _description = "Applies Zhang-Suen or Guo-Hall thinning";
     _category = "morphology";
     _params = {
         ParamDef::optional("type", BaseType::STRING, "Type: zhangsuen, guohall", "zhangsuen")
@@ -345,8 +375,29 @@ ThinningItem::ThinningItem() {
 }
 
 ExecutionResult ThinningItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
-    // Use skeletonize as fallback - ximgproc::thinning requires contrib
-    return SkeletonizeItem().execute(args, ctx);
+    std::string type = args.size() > 0 ? args[0].asString() : "zhangsuen";
+    
+    ThinningMethod method;
+    if (type == "zhangsuen" || type == "zhang_suen") {
+        method = ThinningMethod::ZhangSuen;
+    } else if (type == "guohall" || type == "guo_hall") {
+        method = ThinningMethod::GuoHall;
+    } else {
+        return ExecutionResult::fail("Unknown thinning type: " + type);
+    }
+    
+    cv::Mat img = ctx.currentMat;
+    if (img.channels() > 1) {
+        cv::cvtColor(img, img, cv::COLOR_BGR2GRAY);
+    }
+    if (img.depth() != CV_8U) {
+        img.convertTo(img, CV_8U);
+    }
+    
+    cv::Mat result;
+    thinBinary(img, result, method);
+    
+    return ExecutionResult::ok(result);
 }
 
 // ============================================================================
@@ -410,14 +461,25 @@ ExecutionResult RemoveSmallObjectsItem::execute(const std::vector<RuntimeValue>&
     cv::Mat labels, stats, centroids;
     int numLabels = cv::connectedComponentsWithStats(input, labels, stats, centroids);
     
-    cv::Mat result = cv::Mat::zeros(input.size(), CV_8UC1);
+    // One pass over the labels through a keep table, not one per component
+    std::vector<uchar> keep(numLabels, 0);
     for (int i = 1; i < numLabels; i++) {
-        int area = stats.at<int>(i, cv::CC_STAT_AREA);
-        if (area >= minSize) {
-            result.setTo(255, labels == i);
+        if (stats.at<int>(i, cv::CC_STAT_AREA) >= minSize) {
+            keep[i] = 255;
         }
     }
     
+    cv::Mat result(input.size(), CV_8UC1);
+    cv::parallel_for_(cv::Range(0, labels.rows), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; ++y) {
+            const int* l = labels.ptr<int>(y);
+            uchar* d = result.ptr<uchar>(y);
+            for (int x = 0; x < labels.cols; ++x) {
+                d[x] = keep[l[x]];
+            }
+        }
+    });
+    
     return ExecutionResult::ok(result);
 }
 
@@ -495,6 +557,98 @@ ExecutionResult ConnectedComponentsWithStatsItem::execute(const std::vector<Runt
     return ExecutionResult::ok(result);
 }
 
+// ============================================================================
+// BlobAnalyzeItem
+// ============================================================================
+
+BlobAnalyzeItem::BlobAnalyzeItem() {
+    _functionName = "blob_analyze";
+    _description = "Thresholds, labels and filters blobs on run-length segments (no label image)";
+    _category = "morphology";
+    _params = {
+        ParamDef::optional("threshold", BaseType::FLOAT, "Foreground is value > threshold", 127.0),
+        ParamDef::optional("invert", BaseType::BOOL, "Foreground is value <= threshold", false),
+        ParamDef::optional("min_area", BaseType::INT, "Minimum blob area (0 = none)", 0),
+        ParamDef::optional("max_area", BaseType::INT, "Maximum blob area (0 = none)", 0),
+        ParamDef::optional("connectivity", BaseType::INT, "Connectivity: 4 or 8", 8),
+        ParamDef::optional("cache_prefix", BaseType::STRING, "Cache prefix for blob tables", "blobs"),
+        ParamDef::optional("min_aspect", BaseType::FLOAT, "Minimum bbox width/height (0 = none)", 0.0),
+        ParamDef::optional("max_aspect", BaseType::FLOAT, "Maximum bbox width/height (0 = none)", 0.0),
+        ParamDef::optional("min_extent", BaseType::FLOAT, "Minimum area / bbox area (0 = none)", 0.0),
+        ParamDef::optional("max_blobs", BaseType::INT, "Keep the N largest blobs (0 = all)", 0)
+    };
+    _example = "blob_analyze(127, false, 50, 5000, 8, \"blobs\")";
+    _returnType = "int";
+    _tags = {"blob", "connected", "components", "stats", "rle"};
+}
+
+ExecutionResult BlobAnalyzeItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
+    BlobAnalysisParams params;
+    params.threshold = args.size() > 0 ? args[0].asNumber() : 127.0;
+    params.invert = args.size() > 1 ? args[1].asBool() : false;
+    params.filter.minArea = args.size() > 2 ? static_cast<int64_t>(args[2].asNumber()) : 0;
+    params.filter.maxArea = args.size() > 3 ? static_cast<int64_t>(args[3].asNumber()) : 0;
+    params.connectivity = args.size() > 4 ? static_cast<int>(args[4].asNumber()) : 8;
+    std::string prefix = args.size() > 5 ? args[5].asString() : "blobs";
+    params.filter.minAspect = args.size() > 6 ? args[6].asNumber() : 0.0;
+    params.filter.maxAspect = args.size() > 7 ? args[7].asNumber() : 0.0;
+    params.filter.minExtent = args.size() > 8 ? args[8].asNumber() : 0.0;
+    params.filter.maxBlobs = args.size() > 9 ? static_cast<int>(args[9].asNumber()) : 0;
+
+    if (ctx.currentMat.empty()) {
+        return ExecutionResult::fail("blob_analyze: empty input");
+    }
+
+    int64 t0 = cv::getTickCount();
+    BlobAnalysisResult res = analyzeBlobs(ctx.currentMat, params);
+
+    const int n = static_cast<int>(res.blobs.size());
+    cv::Mat stats(n, 5, CV_32S);
+    cv::Mat centroids(n, 2, CV_64F);
+    cv::Mat moments(n, 4, CV_64F);
+    cv::Mat detections(n, 6, CV_32F);
+    for (int i = 0; i < n; ++i) {
+        const BlobStats& b = res.blobs[i];
+        int* s = stats.ptr<int>(i);
+        s[cv::CC_STAT_LEFT] = b.bbox.x;
+        s[cv::CC_STAT_TOP] = b.bbox.y;
+        s[cv::CC_STAT_WIDTH] = b.bbox.width;
+        s[cv::CC_STAT_HEIGHT] = b.bbox.height;
+        s[cv::CC_STAT_AREA] = static_cast<int>(b.area);
+
+        centroids.at<double>(i, 0) = b.centroid.x;
+        centroids.at<double>(i, 1) = b.centroid.y;
+
+        double* m = moments.ptr<double>(i);
+        m[0] = b.mu20;
+        m[1] = b.mu02;
+        m[2] = b.mu11;
+        m[3] = b.orientation() * 180.0 / CV_PI;
+
+        float* d = detections.ptr<float>(i);
+        d[0] = static_cast<float>(b.bbox.x);
+        d[1] = static_cast<float>(b.bbox.y);
+        d[2] = static_cast<float>(b.bbox.width);
+        d[3] = static_cast<float>(b.bbox.height);
+        d[4] = 0.0f;   // class id
+        d[5] = 1.0f;   // confidence: every kept blob is certain
+    }
+
+    ctx.cacheManager->set(prefix + "_stats", stats);
+    ctx.cacheManager->set(prefix + "_centroids", centroids);
+    ctx.cacheManager->set(prefix + "_moments", moments);
+    ctx.cacheManager->set(prefix + "_detections", detections);
+
+    if (ctx.verbose) {
+        double ms = (cv::getTickCount() - t0) * 1000.0 / cv::getTickFrequency();
+        std::cout << "[blob_analyze] " << prefix << ": " << n << "/" << res.components
+                  << " blobs, " << res.runs << " runs, " << res.strips << " strips, "
+                  << ms << " ms" << std::endl;
+    }
+
+    return ExecutionResult::okWithMat(ctx.currentMat, RuntimeValue(static_cast<int64_t>(n)));
+}
+
 // ============================================================================
 // DistanceTransformItem
 // ============================================================================
@@ -37,6 +37,12 @@ Iox2FrameCache& iox2TurnCache() {
 } // anonymous namespace
 #endif // VISIONPIPE_IPC_USE_ICEORYX2
 
+namespace {
+/// Sequence of the last zero-copy shm_read per region on this thread,
+/// checked by shm_validate once the frame has been used.
+thread_local std::unordered_map<std::string, uint64_t> t_viewSeq;
+} // anonymous namespace
+
 // ============================================================================
 // ShmCreateItem
 // ============================================================================
@@ -118,7 +124,10 @@ ShmReadItem::ShmReadItem() {
                     "another process (e.g. an exec_fork capture pipeline).";
     _category = "video_io";
     _params = {
-        ParamDef::required("name", BaseType::STRING, "Shared-memory region name")
+        ParamDef::required("name", BaseType::STRING, "Shared-memory region name"),
+        ParamDef::optional("zero_copy", BaseType::BOOL,
+                           "Wrap the shared buffer instead of copying it; valid until the "
+                           "writer publishes two more frames (check with shm_validate)", false)
     };
     _example    = "shm_read(\"left_cam\")";
     _returnType = "mat";
@@ -128,6 +137,21 @@ ShmReadItem::ShmReadItem() {
 ExecutionResult ShmReadItem::execute(const std::vector<RuntimeValue>& args,
                                       ExecutionContext& ctx) {
     std::string name = args[0].asString();
+    bool zeroCopy = args.size() > 1 ? args[1].asBool() : false;
+
+#ifndef VISIONPIPE_IPC_USE_ICEORYX2
+    if (zeroCopy) {
+        cv::Mat view;
+        uint64_t seq = 0;
+        if (!shmFrameReadView(name, view, seq)) {
+            return ExecutionResult::ok(ctx.currentMat);
+        }
+        t_viewSeq[name] = seq;
+        return ExecutionResult::ok(view);
+    }
+#else
+    (void)zeroCopy;
+#endif
 
 #ifdef VISIONPIPE_IPC_USE_ICEORYX2
     // Per-turn dedup: if the reader-side seq for this channel hasn't changed
@@ -163,6 +187,33 @@ ExecutionResult ShmReadItem::execute(const std::vector<RuntimeValue>& args,
     return ExecutionResult::ok(frame);
 }
 
+// ============================================================================
+// ShmValidateItem
+// ============================================================================
+
+ShmValidateItem::ShmValidateItem() {
+    _functionName = "shm_validate";
+    _description  = "Check that the frame returned by the last zero-copy shm_read "
+                    "of a region on this thread was not overwritten while in use.  "
+                    "Returns false for a torn frame.";
+    _category = "video_io";
+    _params = {
+        ParamDef::required("name", BaseType::STRING, "Shared-memory region name")
+    };
+    _example    = "shm_validate(\"left_cam\")";
+    _returnType = "bool";
+    _tags       = {"shm", "shared_memory", "ipc", "zero_copy", "multiprocess"};
+}
+
+ExecutionResult ShmValidateItem::execute(const std::vector<RuntimeValue>& args,
+                                          ExecutionContext& ctx) {
+    std::string name = args[0].asString();
+    auto it = t_viewSeq.find(name);
+    // Copying reads are validated internally; nothing to check for them.
+    bool intact = it == t_viewSeq.end() || shmFrameValidate(name, it->second);
+    return ExecutionResult::okWithMat(ctx.currentMat, RuntimeValue(intact));
+}
+
 // ============================================================================
 // Registration
 // ============================================================================
@@ -171,6 +222,7 @@ void registerShmItems(ItemRegistry& registry) {
     registry.add(std::make_shared<ShmCreateItem>());
     registry.add(std::make_shared<ShmWriteItem>());
     registry.add(std::make_shared<ShmReadItem>());
+    registry.add(std::make_shared<ShmValidateItem>());
 }
 
 } // namespace visionpipe
@@ -1,5 +1,6 @@
 #include "interpreter/items/stereo_items.h"
 #include "interpreter/cache_manager.h"
+#include "utils/warp_plan_cache.h"
 #include <iostream>
 #include <cstdio>
 #include <cstdlib>
@@ -619,12 +620,13 @@ ExecutionResult InitUndistortRectifyMapItem::execute(const std::vector<RuntimeVa
 
 UndistortItem::UndistortItem() {
     _functionName = "undistort";
-    _description = "Undistorts image using camera parameters";
+    _description = "Undistorts image using camera parameters (maps are built once per calibration and cached)";
     _category = "stereo";
     _params = {
         ParamDef::required("cam_matrix", BaseType::STRING, "Camera matrix cache"),
         ParamDef::required("dist_coeffs", BaseType::STRING, "Distortion coeffs cache"),
-        ParamDef::optional("new_cam_matrix", BaseType::STRING, "New camera matrix cache", "")
+        ParamDef::optional("new_cam_matrix", BaseType::STRING, "New camera matrix cache", ""),
+        ParamDef::optional("interpolation", BaseType::STRING, "Interpolation: nearest, linear, cubic", "linear")
     };
     _example = "undistort(\"K\", \"D\")";
     _returnType = "mat";
@@ -635,6 +637,7 @@ ExecutionResult UndistortItem::execute(const std::vector<RuntimeValue>& args, Ex
     std::string camMatCache = args[0].asString();
     std::string distCache = args[1].asString();
     std::string newCamCache = args.size() > 2 ? args[2].asString() : "";
+    std::string method = args.size() > 3 ? args[3].asString() : "linear";
     
     cv::Mat camMatOpt = ctx.cacheManager->get(camMatCache);
     cv::Mat distOpt = ctx.cacheManager->get(distCache);
@@ -643,6 +646,10 @@ ExecutionResult UndistortItem::execute(const std::vector<RuntimeValue>& args, Ex
         return ExecutionResult::fail("Camera matrix or distortion coeffs not found");
     }
     
+    int interp = cv::INTER_LINEAR;
+    if (method == "nearest") interp = cv::INTER_NEAREST;
+    else if (method == "cubic") interp = cv::INTER_CUBIC;
+    
     cv::Mat newCamMatrix;
     if (!newCamCache.empty()) {
         cv::Mat newCamOpt = ctx.cacheManager->get(newCamCache);
@@ -651,8 +658,12 @@ ExecutionResult UndistortItem::execute(const std::vector<RuntimeValue>& args, Ex
         }
     }
     
+    // One remap pass per frame: the CV_16SC2 maps are keyed by the hash of
+    // (K, D, newK, size, interpolation) and shared by every undistort call.
+    auto plan = WarpPlanCache::instance().undistort(camMatOpt, distOpt, newCamMatrix,
+                                                    ctx.currentMat.size(), interp);
     cv::Mat result;
-    cv::undistort(ctx.currentMat, result, camMatOpt, distOpt, newCamMatrix);
+    warpPlanApply(*plan, ctx.currentMat, result);
     
     return ExecutionResult::ok(result);
 }
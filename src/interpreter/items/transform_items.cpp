@@ -1,9 +1,26 @@
 #include "interpreter/items/transform_items.h"
 #include "interpreter/cache_manager.h"
+#include "utils/warp_plan_cache.h"
+#include <chrono>
 #include <iostream>
 
 namespace visionpipe {
 
+static int parseWarpInterpolation(const std::string& method) {
+    if (method == "nearest") return cv::INTER_NEAREST;
+    if (method == "cubic") return cv::INTER_CUBIC;
+    if (method == "lanczos") return cv::INTER_LANCZOS4;
+    return cv::INTER_LINEAR;
+}
+
+static int parseWarpBorder(const std::string& border) {
+    if (border == "replicate") return cv::BORDER_REPLICATE;
+    if (border == "reflect") return cv::BORDER_REFLECT;
+    if (border == "reflect_101") return cv::BORDER_REFLECT_101;
+    if (border == "wrap") return cv::BORDER_WRAP;
+    return cv::BORDER_CONSTANT;
+}
+
 void registerTransformItems(ItemRegistry& registry) {
     registry.add<ResizeItem>();
     registry.add<RotateItem>();
@@ -20,6 +37,7 @@ void registerTransformItems(ItemRegistry& registry) {
     registry.add<InvertAffineTransformItem>();
     registry.add<RemapItem>();
     registry.add<ConvertMapsItem>();
+    registry.add<FisheyeViewsItem>();
     registry.add<PyrDownItem>();
     registry.add<PyrUpItem>();
     registry.add<BuildPyramidItem>();
@@ -72,6 +90,22 @@ ExecutionResult ResizeItem::execute(const std::vector<RuntimeValue>& args, Execu
     return ExecutionResult::ok(result);
 }
 
+std::optional<FrameShape> ResizeItem::inferOutputShape(const std::vector<RuntimeValue>& args,
+                                                       const FrameShape& input) const {
+    if (args.size() < 2) return std::nullopt;
+    int width = static_cast<int>(args[0].asNumber());
+    int height = static_cast<int>(args[1].asNumber());
+    if (width <= 0 || height <= 0) {
+        // Same rule as cv::resize: an empty dsize is computed from fx/fy
+        double fx = args.size() > 3 ? args[3].asNumber() : 0.0;
+        double fy = args.size() > 4 ? args[4].asNumber() : 0.0;
+        if (fx <= 0 || fy <= 0) return std::nullopt;
+        width = cv::saturate_cast<int>(input.cols * fx);
+        height = cv::saturate_cast<int>(input.rows * fy);
+    }
+    return FrameShape{height, width, input.type};
+}
+
 // ============================================================================
 // RotateItem
 // ============================================================================
@@ -151,6 +185,13 @@ ExecutionResult Rotate90Item::execute(const std::vector<RuntimeValue>& args, Exe
     return ExecutionResult::ok(result);
 }
 
+std::optional<FrameShape> Rotate90Item::inferOutputShape(const std::vector<RuntimeValue>& args,
+                                                         const FrameShape& input) const {
+    if (args.empty()) return std::nullopt;
+    if (args[0].asString() == "180") return input;
+    return FrameShape{input.cols, input.rows, input.type};
+}
+
 // ============================================================================
 // FlipItem
 // ============================================================================
@@ -181,6 +222,11 @@ ExecutionResult FlipItem::execute(const std::vector<RuntimeValue>& args, Executi
     return ExecutionResult::ok(result);
 }
 
+std::optional<FrameShape> FlipItem::inferOutputShape(const std::vector<RuntimeValue>& /*args*/,
+                                                     const FrameShape& input) const {
+    return input;
+}
+
 // ============================================================================
 // TransposeItem
 // ============================================================================
@@ -288,14 +334,16 @@ ExecutionResult CopyMakeBorderItem::execute(const std::vector<RuntimeValue>& arg
 
 WarpAffineItem::WarpAffineItem() {
     _functionName = "warp_affine";
-    _description = "Applies affine transformation";
+    _description = "Applies affine transformation (static matrices reuse a cached fixed-point warp plan)";
     _category = "transform";
     _params = {
         ParamDef::required("matrix", BaseType::STRING, "Cache ID of 2x3 transformation matrix"),
         ParamDef::optional("width", BaseType::INT, "Output width (default: same as input)", -1),
         ParamDef::optional("height", BaseType::INT, "Output height (default: same as input)", -1),
-        ParamDef::optional("interpolation", BaseType::STRING, "Interpolation method", "linear"),
-        ParamDef::optional("border_mode", BaseType::STRING, "Border mode", "constant")
+        ParamDef::optional("interpolation", BaseType::STRING, "Interpolation method: nearest, linear, cubic, lanczos", "linear"),
+        ParamDef::optional("border_mode", BaseType::STRING, "Border mode", "constant"),
+        ParamDef::optional("use_plan", BaseType::BOOL, "Reuse a cached remap plan when the matrix repeats", true),
+        ParamDef::optional("border_value", BaseType::FLOAT, "Border value for constant mode", 0.0)
     };
     _example = "warp_affine(\"transform_matrix\")";
     _returnType = "mat";
@@ -316,22 +364,21 @@ ExecutionResult WarpAffineItem::execute(const std::vector<RuntimeValue>& args, E
     if (width < 0) width = ctx.currentMat.cols;
     if (height < 0) height = ctx.currentMat.rows;
     
-    int interp = cv::INTER_LINEAR;
-    if (args.size() > 3) {
-        std::string method = args[3].asString();
-        if (method == "nearest") interp = cv::INTER_NEAREST;
-        else if (method == "cubic") interp = cv::INTER_CUBIC;
-    }
-    
-    int borderMode = cv::BORDER_CONSTANT;
-    if (args.size() > 4) {
-        std::string border = args[4].asString();
-        if (border == "replicate") borderMode = cv::BORDER_REPLICATE;
-        else if (border == "reflect") borderMode = cv::BORDER_REFLECT;
-    }
+    int interp = args.size() > 3 ? parseWarpInterpolation(args[3].asString()) : cv::INTER_LINEAR;
+    int borderMode = args.size() > 4 ? parseWarpBorder(args[4].asString()) : cv::BORDER_CONSTANT;
+    bool usePlan = args.size() > 5 ? args[5].asBool() : true;
+    cv::Scalar borderValue = cv::Scalar::all(args.size() > 6 ? args[6].asNumber() : 0);
     
     cv::Mat result;
-    cv::warpAffine(ctx.currentMat, result, matrix, cv::Size(width, height), interp, borderMode);
+    cv::Size dstSize(width, height);
+    auto plan = usePlan
+        ? WarpPlanCache::instance().affine(matrix, ctx.currentMat.size(), dstSize, interp, borderMode)
+        : nullptr;
+    if (plan) {
+        warpPlanApply(*plan, ctx.currentMat, result, borderValue);
+    } else {
+        cv::warpAffine(ctx.currentMat, result, matrix, dstSize, interp, borderMode, borderValue);
+    }
     
     return ExecutionResult::ok(result);
 }
@@ -342,14 +389,16 @@ ExecutionResult WarpAffineItem::execute(const std::vector<RuntimeValue>& args, E
 
 WarpPerspectiveItem::WarpPerspectiveItem() {
     _functionName = "warp_perspective";
-    _description = "Applies perspective transformation";
+    _description = "Applies perspective transformation (static matrices reuse a cached fixed-point warp plan)";
     _category = "transform";
     _params = {
         ParamDef::required("matrix", BaseType::STRING, "Cache ID of 3x3 transformation matrix"),
         ParamDef::optional("width", BaseType::INT, "Output width", -1),
         ParamDef::optional("height", BaseType::INT, "Output height", -1),
-        ParamDef::optional("interpolation", BaseType::STRING, "Interpolation method", "linear"),
-        ParamDef::optional("border_mode", BaseType::STRING, "Border mode", "constant")
+        ParamDef::optional("interpolation", BaseType::STRING, "Interpolation method: nearest, linear, cubic, lanczos", "linear"),
+        ParamDef::optional("border_mode", BaseType::STRING, "Border mode", "constant"),
+        ParamDef::optional("use_plan", BaseType::BOOL, "Reuse a cached remap plan when the matrix repeats", true),
+        ParamDef::optional("border_value", BaseType::FLOAT, "Border value for constant mode", 0.0)
     };
     _example = "warp_perspective(\"homography\")";
     _returnType = "mat";
@@ -370,11 +419,21 @@ ExecutionResult WarpPerspectiveItem::execute(const std::vector<RuntimeValue>& ar
     if (width < 0) width = ctx.currentMat.cols;
     if (height < 0) height = ctx.currentMat.rows;
     
-    int interp = cv::INTER_LINEAR;
-    int borderMode = cv::BORDER_CONSTANT;
+    int interp = args.size() > 3 ? parseWarpInterpolation(args[3].asString()) : cv::INTER_LINEAR;
+    int borderMode = args.size() > 4 ? parseWarpBorder(args[4].asString()) : cv::BORDER_CONSTANT;
+    bool usePlan = args.size() > 5 ? args[5].asBool() : true;
+    cv::Scalar borderValue = cv::Scalar::all(args.size() > 6 ? args[6].asNumber() : 0);
     
     cv::Mat result;
-    cv::warpPerspective(ctx.currentMat, result, matrix, cv::Size(width, height), interp, borderMode);
+    cv::Size dstSize(width, height);
+    auto plan = usePlan
+        ? WarpPlanCache::instance().perspective(matrix, ctx.currentMat.size(), dstSize, interp, borderMode)
+        : nullptr;
+    if (plan) {
+        warpPlanApply(*plan, ctx.currentMat, result, borderValue);
+    } else {
+        cv::warpPerspective(ctx.currentMat, result, matrix, dstSize, interp, borderMode, borderValue);
+    }
     
     return ExecutionResult::ok(result);
 }
@@ -535,13 +594,14 @@ ExecutionResult InvertAffineTransformItem::execute(const std::vector<RuntimeValu
 
 RemapItem::RemapItem() {
     _functionName = "remap";
-    _description = "Applies generic geometric transformation using lookup maps";
+    _description = "Applies generic geometric transformation using lookup maps (float maps are converted to fixed point once and cached)";
     _category = "transform";
     _params = {
         ParamDef::required("map1", BaseType::STRING, "Cache ID of first map (x coordinates)"),
         ParamDef::required("map2", BaseType::STRING, "Cache ID of second map (y coordinates)"),
-        ParamDef::optional("interpolation", BaseType::STRING, "Interpolation method", "linear"),
-        ParamDef::optional("border_mode", BaseType::STRING, "Border mode", "constant")
+        ParamDef::optional("interpolation", BaseType::STRING, "Interpolation method: nearest, linear, cubic, lanczos", "linear"),
+        ParamDef::optional("border_mode", BaseType::STRING, "Border mode", "constant"),
+        ParamDef::optional("border_value", BaseType::FLOAT, "Border value for constant mode", 0.0)
     };
     _example = "remap(\"map_x\", \"map_y\")";
     _returnType = "mat";
@@ -555,15 +615,25 @@ ExecutionResult RemapItem::execute(const std::vector<RuntimeValue>& args, Execut
     cv::Mat map1 = ctx.cacheManager->get(map1Id);
     cv::Mat map2 = ctx.cacheManager->get(map2Id);
     
-    if (map1.empty() || map2.empty()) {
+    // A CV_32FC2 / CV_16SC2 map1 is self-sufficient; map2 is optional then.
+    if (map1.empty() || (map2.empty() && map1.channels() != 2)) {
         return ExecutionResult::fail("Remap maps not found");
     }
     
-    int interp = cv::INTER_LINEAR;
-    int borderMode = cv::BORDER_CONSTANT;
+    int interp = args.size() > 2 ? parseWarpInterpolation(args[2].asString()) : cv::INTER_LINEAR;
+    int borderMode = args.size() > 3 ? parseWarpBorder(args[3].asString()) : cv::BORDER_CONSTANT;
+    cv::Scalar borderValue = cv::Scalar::all(args.size() > 4 ? args[4].asNumber() : 0);
     
     cv::Mat result;
-    cv::remap(ctx.currentMat, result, map1, map2, interp, borderMode);
+    // Entry generations let the plan cache skip hashing unchanged maps.
+    auto plan = WarpPlanCache::instance().remap(map1, map2, interp, borderMode,
+                                                ctx.cacheManager->generation(map1Id),
+                                                ctx.cacheManager->generation(map2Id));
+    if (plan) {
+        warpPlanApply(*plan, ctx.currentMat, result, borderValue);
+    } else {
+        tiledRemap(ctx.currentMat, result, map1, map2, interp, borderMode, borderValue);
+    }
     
     return ExecutionResult::ok(result);
 }
@@ -574,23 +644,153 @@ ExecutionResult RemapItem::execute(const std::vector<RuntimeValue>& args, Execut
 
 ConvertMapsItem::ConvertMapsItem() {
     _functionName = "convert_maps";
-    _description = "Converts floating-point maps to fixed-point for faster remapping";
+    _description = "Converts floating-point maps to fixed-point (CV_16SC2 + CV_16UC1) for faster remapping";
     _category = "transform";
     _params = {
         ParamDef::required("map1", BaseType::STRING, "Cache ID of first input map"),
         ParamDef::required("map2", BaseType::STRING, "Cache ID of second input map"),
-        ParamDef::optional("dstmap1type", BaseType::INT, "Type of first output map", 0)
+        ParamDef::optional("dstmap1type", BaseType::INT, "Type of first output map (0 = CV_16SC2)", 0),
+        ParamDef::optional("output_prefix", BaseType::STRING, "Output cache prefix (<prefix>1, <prefix>2); empty = overwrite inputs", ""),
+        ParamDef::optional("nearest", BaseType::BOOL, "Maps are only used with nearest interpolation (skips the table map)", false)
     };
-    _example = "convert_maps(\"map1\", \"map2\")";
+    _example = "convert_maps(\"map1\", \"map2\") | convert_maps(\"map_x\", \"map_y\", 0, \"fixed_map\")";
     _returnType = "mat";
     _tags = {"remap", "convert", "optimize"};
 }
 
 ExecutionResult ConvertMapsItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
-    // Placeholder
+    std::string map1Id = args[0].asString();
+    std::string map2Id = args[1].asString();
+    int dstType = args.size() > 2 ? static_cast<int>(args[2].asNumber()) : 0;
+    std::string prefix = args.size() > 3 ? args[3].asString() : "";
+    bool nearest = args.size() > 4 ? args[4].asBool() : false;
+    
+    cv::Mat map1 = ctx.cacheManager->get(map1Id);
+    cv::Mat map2 = ctx.cacheManager->get(map2Id);
+    if (map1.empty()) {
+        return ExecutionResult::fail("convert_maps: map not found: " + map1Id);
+    }
+    
+    if (dstType == 0) dstType = CV_16SC2;
+    if (dstType != CV_16SC2 && dstType != CV_32FC1 && dstType != CV_32FC2) {
+        return ExecutionResult::fail("convert_maps: dstmap1type must be CV_16SC2, CV_32FC1 or CV_32FC2");
+    }
+    
+    cv::Mat out1, out2;
+    try {
+        cv::convertMaps(map1, map2, out1, out2, dstType, nearest);
+    } catch (const cv::Exception& e) {
+        return ExecutionResult::fail(std::string("convert_maps: ") + e.what());
+    }
+    
+    ctx.cacheManager->set(prefix.empty() ? map1Id : prefix + "1", out1);
+    ctx.cacheManager->set(prefix.empty() ? map2Id : prefix + "2", out2);
+    
     return ExecutionResult::ok(ctx.currentMat);
 }
 
+// ============================================================================
+// FisheyeViewsItem
+// ============================================================================
+
+FisheyeViewsItem::FisheyeViewsItem() {
+    _functionName = "fisheye_views";
+    _description = "Dewarps a fisheye frame into several PTZ / equirectangular views in one tiled pass. "
+                   "Fixed-point maps are built once per view and only rebuilt for views whose parameters change";
+    _category = "transform";
+    _params = {
+        ParamDef::required("views", BaseType::STRING,
+            "View list separated by ';': ptz:pan,tilt,fov,WxH or equirect:WxH[,lon_span[,lat_span[,pan]]] (degrees)"),
+        ParamDef::optional("model", BaseType::STRING, "Lens model: equidistant, equisolid, fisheye", "equidistant"),
+        ParamDef::optional("fov", BaseType::FLOAT, "Field of view of the image circle (degrees)", 180.0),
+        ParamDef::optional("cache_id", BaseType::STRING, "Views are cached as <cache_id>_0, <cache_id>_1, ...", "fisheye"),
+        ParamDef::optional("mount", BaseType::STRING, "Camera mount: wall (pan = yaw) or ceiling (pan = azimuth)", "wall"),
+        ParamDef::optional("center_x", BaseType::FLOAT, "Image circle center X (-1 = frame center)", -1.0),
+        ParamDef::optional("center_y", BaseType::FLOAT, "Image circle center Y (-1 = frame center)", -1.0),
+        ParamDef::optional("radius", BaseType::FLOAT, "Image circle radius (-1 = inscribed)", -1.0),
+        ParamDef::optional("camera_matrix", BaseType::STRING, "fisheye model: cache ID of K", ""),
+        ParamDef::optional("dist_coeffs", BaseType::STRING, "fisheye model: cache ID of D (k1..k4)", ""),
+        ParamDef::optional("interpolation", BaseType::STRING, "Interpolation method: nearest, linear, cubic, lanczos", "linear")
+    };
+    _example = "fisheye_views(\"ptz:-45,20,70,640x480; ptz:45,20,70,640x480; equirect:1280x400\", \"equidistant\", 190)";
+    _returnType = "mat";
+    _tags = {"fisheye", "dewarp", "ptz", "equirectangular", "remap", "transform"};
+}
+
+ExecutionResult FisheyeViewsItem::execute(const std::vector<RuntimeValue>& args, ExecutionContext& ctx) {
+    if (ctx.currentMat.empty()) {
+        return ExecutionResult::fail("fisheye_views: empty input frame");
+    }
+    std::string spec = args[0].asString();
+    std::string modelStr = args.size() > 1 ? args[1].asString() : "equidistant";
+    double fov = args.size() > 2 ? args[2].asNumber() : 180.0;
+    std::string cacheId = args.size() > 3 ? args[3].asString() : "fisheye";
+    std::string mountStr = args.size() > 4 ? args[4].asString() : "wall";
+    double cx = args.size() > 5 ? args[5].asNumber() : -1.0;
+    double cy = args.size() > 6 ? args[6].asNumber() : -1.0;
+    double radius = args.size() > 7 ? args[7].asNumber() : -1.0;
+    std::string kId = args.size() > 8 ? args[8].asString() : "";
+    std::string dId = args.size() > 9 ? args[9].asString() : "";
+    int interp = args.size() > 10 ? parseWarpInterpolation(args[10].asString()) : cv::INTER_LINEAR;
+
+    std::vector<FisheyeView> views;
+    std::string error;
+    if (!parseFisheyeViews(spec, views, error)) {
+        return ExecutionResult::fail("fisheye_views: " + error);
+    }
+    if (fov <= 0 || fov > 360) {
+        return ExecutionResult::fail("fisheye_views: fov must be in (0, 360]");
+    }
+
+    const cv::Size srcSize = ctx.currentMat.size();
+    FisheyeLens lens;
+    lens.fovDeg = fov;
+    lens.mount = mountStr == "ceiling" ? FisheyeLens::Mount::CEILING : FisheyeLens::Mount::WALL;
+    lens.center = cv::Point2d(cx >= 0 ? cx : 0.5 * (srcSize.width - 1), cy >= 0 ? cy : 0.5 * (srcSize.height - 1));
+    lens.radius = radius > 0 ? radius : 0.5 * std::min(srcSize.width, srcSize.height);
+    if (modelStr == "equisolid") {
+        lens.model = FisheyeLens::Model::EQUISOLID;
+    } else if (modelStr == "fisheye") {
+        lens.model = FisheyeLens::Model::KANNALA_BRANDT;
+        cv::Mat K = ctx.cacheManager->get(kId);
+        cv::Mat D = ctx.cacheManager->get(dId);
+        if (K.total() != 9 || D.total() < 4) {
+            return ExecutionResult::fail("fisheye_views: fisheye model needs camera_matrix (3x3) and dist_coeffs (4) in cache");
+        }
+        K.convertTo(K, CV_64F);
+        D.convertTo(D, CV_64F);
+        lens.K = cv::Matx33d(K.ptr<double>());
+        lens.D = cv::Vec4d(D.ptr<double>());
+    } else if (modelStr != "equidistant") {
+        return ExecutionResult::fail("fisheye_views: unknown model '" + modelStr + "'");
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto set = FisheyeViewsRegistry::instance().acquire(cacheId);
+    std::vector<cv::Mat> outputs;
+    size_t rebuilt = 0;
+    FisheyeViewSet::Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(set->mutex());
+        rebuilt = set->configure(lens, srcSize, views, interp);
+        set->render(ctx.currentMat, outputs);
+        if (ctx.verbose) stats = set->stats();
+    }
+
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        ctx.cacheManager->set(cacheId + "_" + std::to_string(i), outputs[i]);
+    }
+
+    if (ctx.verbose) {
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - t0).count();
+        std::cout << "[fisheye_views] " << cacheId << ": " << stats.views << " view(s), "
+                  << stats.tiles << " tiles, " << rebuilt << " rebuilt, maps "
+                  << stats.mapBytes / 1024 << " KB, " << ms << " ms" << std::endl;
+    }
+    return ExecutionResult::ok(outputs.front());
+}
+
 // ============================================================================
 // PyrDownItem
 // ============================================================================
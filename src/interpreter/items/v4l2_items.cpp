@@ -56,10 +56,18 @@ V4L2SetupItem::V4L2SetupItem() {
             "Bind this camera to a named device manager instance. "
             "Cameras on different managers have independent mutexes, "
             "eliminating cross-device lock contention and enabling "
-            "true parallel capture throughput.", "")
+            "true parallel capture throughput.", ""),
+        ParamDef::optional("decode_threads", BaseType::INT,
+            "MJPEG only: decode on a pool of N threads while capture keeps dequeuing; "
+            "frames are still delivered in order. 0 decodes inline.", 0),
+        ParamDef::optional("decode_scale", BaseType::INT,
+            "MJPEG only: reduced decode in the DCT domain, 1, 2, 4 or 8 (1/N size)", 1),
+        ParamDef::optional("decode_gray", BaseType::BOOL,
+            "MJPEG only: decode luma only (single channel), skipping chroma", false)
     };
     _example = "v4l2_setup(\"/dev/video0\", 1920, 1080, \"SRGGB10\", 30)\n"
-               "v4l2_setup(\"/dev/video3\", 1640, 1232, \"SRGGB8\", 30, 4, \"/dev/v4l-subdev28\")";
+               "v4l2_setup(\"/dev/video3\", 1640, 1232, \"SRGGB8\", 30, 4, \"/dev/v4l-subdev28\")\n"
+               "v4l2_setup(\"/dev/video0\", 1920, 1080, \"MJPG\", 60, 4, \"\", \"\", 3, 2)";
     _returnType = "mat";
     _tags = {"v4l2", "camera", "setup", "configuration"};
 }
@@ -77,6 +85,9 @@ ExecutionResult V4L2SetupItem::execute(const std::vector<RuntimeValue>& args, Ex
     int bufferCount = args.size() > 5 ? static_cast<int>(args[5].asNumber()) : 4;
     std::string subdev = args.size() > 6 ? args[6].asString() : "";
     std::string managerId = args.size() > 7 ? args[7].asString() : "";
+    int decodeThreads = args.size() > 8 ? static_cast<int>(args[8].asNumber()) : 0;
+    int decodeScale = args.size() > 9 ? static_cast<int>(args[9].asNumber()) : 1;
+    bool decodeGray = args.size() > 10 ? args[10].asBool() : false;
 
     // Optional: bind this source to a named device manager
     if (!managerId.empty()) {
@@ -90,6 +101,9 @@ ExecutionResult V4L2SetupItem::execute(const std::vector<RuntimeValue>& args, Ex
                   << " fps=" << fps
                   << " buffers=" << bufferCount;
         if (!subdev.empty()) std::cout << " subdev=" << subdev;
+        if (decodeThreads > 0) std::cout << " decode_threads=" << decodeThreads;
+        if (decodeScale > 1) std::cout << " decode_scale=" << decodeScale;
+        if (decodeGray) std::cout << " decode_gray";
         std::cout << std::endl;
     }
 
@@ -99,6 +113,9 @@ ExecutionResult V4L2SetupItem::execute(const std::vector<RuntimeValue>& args, Ex
     config.pixelFormat = pixelFormat;
     config.fps = fps;
     config.bufferCount = bufferCount;
+    config.decodeThreads = decodeThreads;
+    config.decodeScale = decodeScale;
+    config.decodeGray = decodeGray;
 
     // Open and configure through CameraDeviceManager delegation
     if (!CameraDeviceManager::forSource(sourceId).setV4L2NativeConfig(sourceId, config)) {
@@ -0,0 +1,224 @@
+#include "interpreter/memory_planner.h"
+#include "interpreter/ast.h"
+#include "utils/frame_arena.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+
+namespace visionpipe {
+
+namespace {
+
+constexpr size_t kAlignment = 64;
+
+size_t alignUp(size_t n) { return (n + kAlignment - 1) & ~(kAlignment - 1); }
+
+std::string formatBytes(size_t bytes) {
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(1);
+    if (bytes >= 1024 * 1024) os << bytes / (1024.0 * 1024.0) << " MB";
+    else if (bytes >= 1024) os << bytes / 1024.0 << " KB";
+    else os << bytes << " B";
+    return os.str();
+}
+
+std::string formatShape(const FrameShape& s) {
+    return std::to_string(s.cols) + "x" + std::to_string(s.rows) + " " + cv::typeToString(s.type);
+}
+
+/// Value of a literal argument (or negated numeric literal), else nullopt.
+std::optional<RuntimeValue> staticValue(const Expression* expr) {
+    if (!expr) return std::nullopt;
+    if (auto* lit = dynamic_cast<const LiteralExpr*>(expr)) {
+        if (auto* d = std::get_if<double>(&lit->value)) return RuntimeValue(*d);
+        if (auto* s = std::get_if<std::string>(&lit->value)) return RuntimeValue(*s);
+        if (auto* b = std::get_if<bool>(&lit->value)) return RuntimeValue(*b);
+        return std::nullopt;
+    }
+    if (auto* un = dynamic_cast<const UnaryExpr*>(expr)) {
+        if (un->op != TokenType::OP_MINUS) return std::nullopt;
+        auto inner = staticValue(un->operand.get());
+        if (!inner || !inner->isNumeric()) return std::nullopt;
+        return RuntimeValue(-inner->asNumber());
+    }
+    return std::nullopt;
+}
+
+/// Arguments of @p call as the interpreter would resolve them, if all are literals.
+std::optional<std::vector<RuntimeValue>> staticArgs(const FunctionCallExpr& call,
+                                                    const InterpreterItem& item) {
+    std::vector<RuntimeValue> args;
+    for (const auto& arg : call.arguments) {
+        auto v = staticValue(arg.get());
+        if (!v) return std::nullopt;
+        args.push_back(std::move(*v));
+    }
+    if (call.namedArguments.empty()) return args;
+
+    // Same resolution as Interpreter::evalFunctionCall
+    const auto& paramDefs = item.params();
+    for (size_t i = args.size(); i < paramDefs.size(); ++i) {
+        args.push_back(paramDefs[i].defaultValue.value_or(RuntimeValue()));
+    }
+    for (const auto& [paramName, valExpr] : call.namedArguments) {
+        auto v = staticValue(valExpr.get());
+        if (!v) return std::nullopt;
+        size_t pi = 0;
+        while (pi < paramDefs.size() && paramDefs[pi].name != paramName) ++pi;
+        if (pi == paramDefs.size()) return std::nullopt;
+        args[pi] = std::move(*v);
+    }
+    return args;
+}
+
+const FunctionCallExpr* itemCall(const Statement* stmt) {
+    if (!stmt || stmt->nodeType != ASTNodeType::EXPRESSION_STMT) return nullptr;
+    return dynamic_cast<const FunctionCallExpr*>(
+        static_cast<const ExpressionStmt*>(stmt)->expression.get());
+}
+
+bool isShmWrite(const Statement* stmt) {
+    const FunctionCallExpr* call = itemCall(stmt);
+    return call && call->functionName == "shm_write";
+}
+
+} // namespace
+
+// ============================================================================
+// Planning
+// ============================================================================
+
+std::shared_ptr<MemoryPlan> planPipelineMemory(
+    const PipelineDecl& pipeline, const FrameShape& input, const ItemRegistry& registry,
+    const std::unordered_map<std::string, std::shared_ptr<PipelineDecl>>& pipelines) {
+    auto plan = std::make_shared<MemoryPlan>();
+    plan->pipeline = pipeline.name;
+    plan->input = input;
+    plan->slotOf.assign(pipeline.body.size(), -1);
+
+    // ---- Shape chain and frame lifetimes ---------------------------------
+    // A planned frame lives from its producer to the next statement known
+    // to replace it.  A frame that is cached, read by something the planner
+    // cannot see through, or returned is dropped from the plan.
+    std::vector<MemoryPlan::Buffer> candidates;
+    std::optional<MemoryPlan::Buffer> pending;
+    FrameShape shape = input;
+
+    for (size_t si = 0; si < pipeline.body.size(); ++si) {
+        const Statement* stmt = pipeline.body[si].get();
+
+        const FunctionCallExpr* call = itemCall(stmt);
+        std::shared_ptr<InterpreterItem> item;
+        if (call && call->functionName != "map_rois" && !pipelines.count(call->functionName)) {
+            item = registry.getItem(call->functionName);
+        }
+        if (!item) {
+            pending.reset();
+            shape = FrameShape{};
+            continue;
+        }
+
+        std::optional<FrameShape> out;
+        if (shape.valid()) {
+            if (auto args = staticArgs(*call, *item)) out = item->inferOutputShape(*args, shape);
+        }
+        if (!out || !out->valid()) {
+            // Pass-through items (display, logging) leave the frame alone
+            if (item->modifiesMat() || call->cacheOutput) {
+                pending.reset();
+                shape = FrameShape{};
+            }
+            continue;
+        }
+
+        ++plan->inferred;
+        if (pending) {
+            pending->lastUse = si;
+            candidates.push_back(*pending);
+            pending.reset();
+        }
+        shape = *out;
+        const bool nextIsShm = si + 1 < pipeline.body.size() && isShmWrite(pipeline.body[si + 1].get());
+        if (!call->cacheOutput && !nextIsShm) {
+            MemoryPlan::Buffer b;
+            b.statement = si;
+            b.item = call->functionName;
+            b.shape = shape;
+            b.firstUse = si;
+            pending = b;
+        }
+    }
+
+    // ---- Offsets: greedy by size over lifetime conflicts -----------------
+    std::vector<size_t> order(candidates.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return candidates[a].shape.bytes() > candidates[b].shape.bytes();
+    });
+
+    std::vector<size_t> placed;
+    for (size_t idx : order) {
+        MemoryPlan::Buffer& b = candidates[idx];
+        const size_t bytes = b.shape.bytes();
+
+        std::vector<const MemoryPlan::Buffer*> conflicts;
+        for (size_t p : placed) {
+            const MemoryPlan::Buffer& o = candidates[p];
+            if (b.firstUse <= o.lastUse && o.firstUse <= b.lastUse) conflicts.push_back(&o);
+        }
+        std::sort(conflicts.begin(), conflicts.end(),
+                  [](const MemoryPlan::Buffer* l, const MemoryPlan::Buffer* r) { return l->offset < r->offset; });
+
+        size_t offset = 0;
+        for (const MemoryPlan::Buffer* o : conflicts) {
+            if (offset + bytes <= o->offset) break;
+            offset = std::max(offset, alignUp(o->offset + o->shape.bytes()));
+        }
+        b.offset = offset;
+        placed.push_back(idx);
+
+        plan->arenaBytes = std::max(plan->arenaBytes, offset + bytes);
+        plan->naiveBytes += alignUp(bytes);
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const MemoryPlan::Buffer& l, const MemoryPlan::Buffer& r) { return l.statement < r.statement; });
+    plan->buffers = std::move(candidates);
+    if (plan->buffers.empty()) return plan;
+
+    std::vector<FrameArena::Slot> slots;
+    for (size_t i = 0; i < plan->buffers.size(); ++i) {
+        const MemoryPlan::Buffer& b = plan->buffers[i];
+        plan->slotOf[b.statement] = static_cast<int>(i);
+        slots.push_back({b.offset, b.shape.rows, b.shape.cols, b.shape.type});
+    }
+    plan->arena = std::make_shared<FrameArena>(std::move(slots), plan->arenaBytes);
+    return plan;
+}
+
+// ============================================================================
+// Report
+// ============================================================================
+
+std::string MemoryPlan::report() const {
+    std::ostringstream os;
+    os << "[memory-plan] pipeline '" << pipeline << "' (input " << formatShape(input) << "): "
+       << inferred << "/" << slotOf.size() << " statements inferred, "
+       << buffers.size() << " planned buffer(s)\n";
+    if (buffers.empty()) return os.str();
+
+    const double saved = naiveBytes ? 100.0 * (1.0 - static_cast<double>(arenaBytes) / naiveBytes) : 0.0;
+    os << "  arena " << formatBytes(arenaBytes) << " (naive " << formatBytes(naiveBytes)
+       << ", " << std::fixed << std::setprecision(0) << saved << "% reused)\n";
+    for (const Buffer& b : buffers) {
+        os << "  stmt " << std::setw(3) << b.statement << "  " << std::left << std::setw(16) << b.item
+           << std::right << " " << std::setw(18) << formatShape(b.shape)
+           << "  live [" << b.firstUse << ", " << b.lastUse << "]"
+           << "  @" << b.offset << " +" << formatBytes(b.shape.bytes()) << "\n";
+    }
+    return os.str();
+}
+
+} // namespace visionpipe
@@ -3,12 +3,169 @@
 #ifdef VISIONPIPE_WITH_ONNXRUNTIME
 #include "interpreter/ml/onnx_runtime_backend.h"
 #endif
+#include "interpreter/ml/postprocessing.h"
 #include <iostream>
 #include <chrono>
+#include <algorithm>
+#include <sstream>
 
 namespace visionpipe {
 namespace ml {
 
+namespace {
+
+std::string trimCopy(const std::string& s) {
+    size_t b = s.find_first_not_of(" \t");
+    size_t e = s.find_last_not_of(" \t");
+    return b == std::string::npos ? std::string() : s.substr(b, e - b + 1);
+}
+
+bool parseNumberList(const std::string& text, std::vector<double>& out) {
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        item = trimCopy(item);
+        if (item.empty()) return false;
+        try {
+            size_t used = 0;
+            out.push_back(std::stod(item, &used));
+            if (used != item.size()) return false;
+        } catch (...) {
+            return false;
+        }
+    }
+    return !out.empty();
+}
+
+/**
+ * @brief What a stage's output says, as far as gating is concerned
+ */
+struct StageReading {
+    float topScore = 0.0f;
+    int topClass = -1;
+    std::vector<Detection> boxes;     // detect only
+};
+
+StageReading readStage(const CascadeStage& stage, const InferenceResult& result,
+                       cv::Size imageSize, cv::Size inputSize) {
+    StageReading reading;
+    cv::Mat output = result.getPrimaryOutput();
+    if (output.empty()) {
+        return reading;
+    }
+    
+    if (stage.task == "detect") {
+        reading.boxes = Postprocessing::decodeYolo(output, imageSize, inputSize,
+                                                   stage.confThreshold, stage.yoloVersion);
+        for (const auto& det : reading.boxes) {
+            if (det.confidence > reading.topScore) {
+                reading.topScore = det.confidence;
+                reading.topClass = det.classId;
+            }
+        }
+    } else {
+        cv::Mat flat = output.reshape(1, 1);
+        if (flat.type() != CV_32F) {
+            flat.convertTo(flat, CV_32F);
+        }
+        double maxVal = 0;
+        cv::Point maxLoc;
+        cv::minMaxLoc(flat, nullptr, &maxVal, nullptr, &maxLoc);
+        reading.topScore = static_cast<float>(maxVal);
+        reading.topClass = maxLoc.x;
+    }
+    return reading;
+}
+
+bool inScoreBand(const CascadeGate& gate, float score) {
+    return score >= gate.scoreLow && score < gate.scoreHigh;
+}
+
+bool inClassSet(const CascadeGate& gate, int classId) {
+    return std::find(gate.classes.begin(), gate.classes.end(), classId) != gate.classes.end();
+}
+
+bool gateFires(const CascadeGate& gate, const StageReading& reading, bool detect) {
+    if (gate.empty()) {
+        return true;
+    }
+    if (gate.useScoreBand && inScoreBand(gate, reading.topScore)) {
+        return true;
+    }
+    if (!gate.classes.empty()) {
+        if (detect) {
+            for (const auto& det : reading.boxes) {
+                if (inClassSet(gate, det.classId)) return true;
+            }
+        } else if (inClassSet(gate, reading.topClass)) {
+            return true;
+        }
+    }
+    if (gate.hasBoxRule()) {
+        const int n = static_cast<int>(reading.boxes.size());
+        if ((gate.minBoxes < 0 || n >= gate.minBoxes) && (gate.maxBoxes < 0 || n <= gate.maxBoxes)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Boxes handed to an ROI stage: those matching the class set, else the score band, else all.
+bool boxGated(const CascadeGate& gate, const Detection& det) {
+    if (!gate.classes.empty()) {
+        return inClassSet(gate, det.classId);
+    }
+    if (gate.useScoreBand) {
+        return inScoreBand(gate, det.confidence);
+    }
+    return true;
+}
+
+} // namespace
+
+bool CascadeGate::parse(const std::string& spec, CascadeGate& gate, std::string& error) {
+    gate = CascadeGate();
+    std::stringstream ss(spec);
+    std::string rule;
+    while (std::getline(ss, rule, ';')) {
+        rule = trimCopy(rule);
+        if (rule.empty()) continue;
+        
+        size_t colon = rule.find(':');
+        std::string key = trimCopy(rule.substr(0, colon));
+        std::vector<double> values;
+        if (colon == std::string::npos || !parseNumberList(rule.substr(colon + 1), values)) {
+            error = "Malformed gate rule: '" + rule + "'";
+            return false;
+        }
+        
+        if (key == "score") {
+            if (values.size() != 2 || values[0] > values[1]) {
+                error = "Gate 'score' expects low,high";
+                return false;
+            }
+            gate.useScoreBand = true;
+            gate.scoreLow = static_cast<float>(values[0]);
+            gate.scoreHigh = static_cast<float>(values[1]);
+        } else if (key == "classes") {
+            for (double v : values) {
+                gate.classes.push_back(static_cast<int>(v));
+            }
+        } else if (key == "boxes") {
+            if (values.size() > 2) {
+                error = "Gate 'boxes' expects min[,max]";
+                return false;
+            }
+            gate.minBoxes = static_cast<int>(values[0]);
+            gate.maxBoxes = values.size() > 1 ? static_cast<int>(values[1]) : -1;
+        } else {
+            error = "Unknown gate rule '" + key + "' (expected score, classes or boxes)";
+            return false;
+        }
+    }
+    return true;
+}
+
 // Static verbose flag definition
 bool ModelRegistry::s_verbose = false;
 
@@ -41,6 +198,10 @@ bool ModelRegistry::loadModel(const std::string& id, const std::string& path,
         std::cerr << "[ModelRegistry] Model '" << id << "' already loaded. Unload first." << std::endl;
         return false;
     }
+    if (_cascades.find(id) != _cascades.end()) {
+        std::cerr << "[ModelRegistry] '" << id << "' is a cascade. Unload it first." << std::endl;
+        return false;
+    }
     
     // Create model using appropriate backend
     std::string backend = config.backend;
@@ -83,6 +244,13 @@ bool ModelRegistry::loadModel(const std::string& id, const std::string& path,
 bool ModelRegistry::unloadModel(const std::string& id) {
     std::lock_guard<std::mutex> lock(_mutex);
     
+    if (_cascades.erase(id) > 0) {
+        if (s_verbose) {
+            std::cout << "[ModelRegistry] Removed cascade '" << id << "'" << std::endl;
+        }
+        return true;
+    }
+    
     auto it = _models.find(id);
     if (it == _models.end()) {
         return false;
@@ -112,6 +280,11 @@ bool ModelRegistry::hasModel(const std::string& id) const {
     return _models.find(id) != _models.end();
 }
 
+bool ModelRegistry::exists(const std::string& id) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _models.find(id) != _models.end() || _cascades.find(id) != _cascades.end();
+}
+
 std::optional<ModelInfo> ModelRegistry::getModelInfo(const std::string& id) const {
     std::lock_guard<std::mutex> lock(_mutex);
     
@@ -148,18 +321,29 @@ void ModelRegistry::clear() {
     std::lock_guard<std::mutex> lock(_mutex);
     _models.clear();
     _modelInfo.clear();
+    _cascades.clear();
 }
 
 InferenceResult ModelRegistry::runInference(const std::string& id, const cv::Mat& input) {
     std::shared_ptr<MLModel> model;
+    CascadeConfig cascade;
     
     {
         std::lock_guard<std::mutex> lock(_mutex);
         auto it = _models.find(id);
-        if (it == _models.end()) {
-            return InferenceResult::fail("Model not found: " + id);
+        if (it != _models.end()) {
+            model = it->second;
+        } else {
+            auto c = _cascades.find(id);
+            if (c == _cascades.end()) {
+                return InferenceResult::fail("Model not found: " + id);
+            }
+            cascade = c->second.config;
         }
-        model = it->second;
+    }
+    
+    if (!model) {
+        return runCascade(id, cascade, input);
     }
     
     // Run inference outside lock
@@ -182,6 +366,182 @@ InferenceResult ModelRegistry::runInference(const std::string& id, const cv::Mat
     return result;
 }
 
+// ============================================================================
+// Cascades
+// ============================================================================
+
+bool ModelRegistry::defineCascade(const std::string& id, const CascadeConfig& config, std::string& error) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    
+    if (_models.find(id) != _models.end()) {
+        error = "'" + id + "' is already a model id";
+        return false;
+    }
+    if (config.stages.empty()) {
+        error = "A cascade needs at least one stage";
+        return false;
+    }
+    for (const auto& stage : config.stages) {
+        // Stages must be plain models, which also rules out cycles
+        if (_models.find(stage.modelId) == _models.end()) {
+            error = "Stage model not loaded: " + stage.modelId;
+            return false;
+        }
+        if (stage.task != "classify" && stage.task != "detect") {
+            error = "Unknown stage task '" + stage.task + "' (expected classify or detect)";
+            return false;
+        }
+    }
+    if (config.roi && (config.stages.size() < 2 || config.stages[config.stages.size() - 2].task != "detect")) {
+        error = "ROI cascades need a detect stage before the last stage";
+        return false;
+    }
+    
+    Cascade cascade;
+    cascade.config = config;
+    for (const auto& stage : config.stages) {
+        CascadeStats::Stage s;
+        s.modelId = stage.modelId;
+        cascade.stats.stages.push_back(s);
+    }
+    _cascades[id] = std::move(cascade);
+    
+    if (s_verbose) {
+        std::cout << "[ModelRegistry] Defined cascade '" << id << "' with "
+                  << config.stages.size() << " stages" << std::endl;
+    }
+    return true;
+}
+
+bool ModelRegistry::hasCascade(const std::string& id) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _cascades.find(id) != _cascades.end();
+}
+
+std::optional<CascadeStats> ModelRegistry::getCascadeStats(const std::string& id) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    
+    auto it = _cascades.find(id);
+    if (it != _cascades.end()) {
+        return it->second.stats;
+    }
+    return std::nullopt;
+}
+
+std::vector<std::string> ModelRegistry::listCascades() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    
+    std::vector<std::string> ids;
+    ids.reserve(_cascades.size());
+    for (const auto& pair : _cascades) {
+        ids.push_back(pair.first);
+    }
+    return ids;
+}
+
+InferenceResult ModelRegistry::runCascade(const std::string& id, const CascadeConfig& config,
+                                          const cv::Mat& input) {
+    auto start = std::chrono::high_resolution_clock::now();
+    
+    const size_t last = config.stages.size() - 1;
+    std::vector<CascadeStats::Stage> tally(config.stages.size());
+    std::vector<cv::Rect> rois;
+    InferenceResult result;
+    
+    for (size_t k = 0; k <= last; ++k) {
+        const CascadeStage& stage = config.stages[k];
+        
+        if (config.roi && k == last) {
+            // Heavy stage on the gated boxes only
+            const cv::Rect bounds(0, 0, input.cols, input.rows);
+            InferenceResult combined;
+            cv::Mat roiMat(0, 4, CV_32F);
+            for (const cv::Rect& box : rois) {
+                cv::Rect r(box.x - config.roiPadding, box.y - config.roiPadding,
+                           box.width + 2 * config.roiPadding, box.height + 2 * config.roiPadding);
+                r &= bounds;
+                if (r.empty()) {
+                    continue;
+                }
+                InferenceResult sub = runInference(stage.modelId, input(r));
+                tally[k].runs++;
+                tally[k].totalTimeMs += sub.inferenceTimeMs;
+                if (!sub.success) {
+                    combined = sub;
+                    break;
+                }
+                combined.outputNames.push_back("roi_" + std::to_string(combined.outputs.size()));
+                combined.outputs.push_back(sub.getPrimaryOutput());
+                cv::Mat row = (cv::Mat_<float>(1, 4) << static_cast<float>(r.x), static_cast<float>(r.y),
+                               static_cast<float>(r.width), static_cast<float>(r.height));
+                roiMat.push_back(row);
+            }
+            if (combined.success && roiMat.rows == 0) {
+                // No box passed the gate (or all clipped away): the detect
+                // stage's result stands, as when its gate does not fire.
+                break;
+            }
+            if (combined.success) {
+                combined.outputs.push_back(roiMat);
+                combined.outputNames.push_back("rois");
+            }
+            result = combined;
+            break;
+        }
+        
+        result = runInference(stage.modelId, input);
+        tally[k].runs++;
+        tally[k].totalTimeMs += result.inferenceTimeMs;
+        if (!result.success || k == last) {
+            break;
+        }
+        
+        cv::Size inputSize = input.size();
+        if (auto model = getModel(stage.modelId)) {
+            cv::Size s = model->getInputSize();
+            if (s.width > 0 && s.height > 0) {
+                inputSize = s;
+            }
+        }
+        const bool detect = stage.task == "detect";
+        StageReading reading = readStage(stage, result, input.size(), inputSize);
+        if (!gateFires(stage.gate, reading, detect)) {
+            break;
+        }
+        tally[k].escalations++;
+        
+        if (config.roi && k + 1 == last) {
+            rois.clear();
+            for (const auto& det : reading.boxes) {
+                if (boxGated(stage.gate, det)) {
+                    rois.push_back(det.box);
+                }
+            }
+        }
+    }
+    
+    auto end = std::chrono::high_resolution_clock::now();
+    result.inferenceTimeMs = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _cascades.find(id);
+        // Skip if the cascade was redefined while this frame ran
+        if (it != _cascades.end() && it->second.stats.stages.size() == tally.size()) {
+            CascadeStats& stats = it->second.stats;
+            stats.frames++;
+            stats.totalTimeMs += result.inferenceTimeMs;
+            for (size_t k = 0; k < tally.size(); ++k) {
+                stats.stages[k].runs += tally[k].runs;
+                stats.stages[k].escalations += tally[k].escalations;
+                stats.stages[k].totalTimeMs += tally[k].totalTimeMs;
+            }
+        }
+    }
+    
+    return result;
+}
+
 void ModelRegistry::registerBackend(const std::string& backend, ModelFactory factory) {
     std::lock_guard<std::mutex> lock(_mutex);
     _backends[backend] = factory;
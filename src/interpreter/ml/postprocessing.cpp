@@ -7,6 +7,123 @@
 namespace visionpipe {
 namespace ml {
 
+namespace {
+
+/**
+ * @brief Strided view of a YOLO head, [channels x anchors] or [anchors x channels]
+ *
+ * v8-style heads are channel-major; exports with a transpose are not.  The
+ * view reads either in place instead of transposing the whole tensor.
+ */
+struct HeadView {
+    const float* data = nullptr;
+    int anchors = 0;
+    int channels = 0;
+    size_t anchorStep = 0;
+    size_t channelStep = 0;
+
+    float at(int anchor, int channel) const {
+        return data[anchor * anchorStep + channel * channelStep];
+    }
+};
+
+bool viewHead(const cv::Mat& output, HeadView& view) {
+    if (output.type() != CV_32F || !output.isContinuous()) return false;
+    int rows = 0, cols = 0;
+    if (output.dims == 3) {
+        rows = output.size[1];
+        cols = output.size[2];
+    } else if (output.dims == 2) {
+        rows = output.rows;
+        cols = output.cols;
+    } else {
+        return false;
+    }
+    view.data = output.ptr<float>();
+    if (rows < cols) {
+        view.channels = rows;
+        view.anchors = cols;
+        view.channelStep = static_cast<size_t>(cols);
+        view.anchorStep = 1;
+    } else {
+        view.anchors = rows;
+        view.channels = cols;
+        view.anchorStep = static_cast<size_t>(cols);
+        view.channelStep = 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Best class per anchor, thresholded, boxes scaled to the image
+ *
+ * Boxes are converted exactly as decodeYolov8 does.  @p inputBoxes keeps
+ * the unclamped box in model input coordinates for mask cropping.
+ */
+void collectCandidates(const HeadView& v, int numClasses, float confThreshold,
+                       cv::Size imageSize, cv::Size inputSize,
+                       std::vector<cv::Rect>& boxes, std::vector<float>& scores,
+                       std::vector<int>& classIds, std::vector<int>& anchors,
+                       std::vector<cv::Rect2f>* inputBoxes = nullptr) {
+    std::vector<float> best(v.anchors, 0.0f);
+    std::vector<int> bestClass(v.anchors, 0);
+    if (v.anchorStep == 1) {
+        // Channel-major: one contiguous pass per class row
+        for (int c = 0; c < numClasses; ++c) {
+            const float* row = v.data + (4 + c) * v.channelStep;
+            for (int a = 0; a < v.anchors; ++a) {
+                if (row[a] > best[a]) {
+                    best[a] = row[a];
+                    bestClass[a] = c;
+                }
+            }
+        }
+    } else {
+        for (int a = 0; a < v.anchors; ++a) {
+            const float* row = v.data + a * v.anchorStep + 4;
+            for (int c = 0; c < numClasses; ++c) {
+                if (row[c] > best[a]) {
+                    best[a] = row[c];
+                    bestClass[a] = c;
+                }
+            }
+        }
+    }
+
+    float scaleX = static_cast<float>(imageSize.width) / inputSize.width;
+    float scaleY = static_cast<float>(imageSize.height) / inputSize.height;
+
+    for (int a = 0; a < v.anchors; ++a) {
+        if (best[a] < confThreshold) {
+            continue;
+        }
+        float cx = v.at(a, 0);
+        float cy = v.at(a, 1);
+        float w = v.at(a, 2);
+        float h = v.at(a, 3);
+
+        int x = static_cast<int>((cx - w / 2) * scaleX);
+        int y = static_cast<int>((cy - h / 2) * scaleY);
+        int boxW = static_cast<int>(w * scaleX);
+        int boxH = static_cast<int>(h * scaleY);
+
+        x = std::max(0, x);
+        y = std::max(0, y);
+        boxW = std::min(boxW, imageSize.width - x);
+        boxH = std::min(boxH, imageSize.height - y);
+
+        boxes.push_back(cv::Rect(x, y, boxW, boxH));
+        scores.push_back(best[a]);
+        classIds.push_back(bestClass[a]);
+        anchors.push_back(a);
+        if (inputBoxes) {
+            inputBoxes->push_back(cv::Rect2f(cx - w / 2, cy - h / 2, w, h));
+        }
+    }
+}
+
+} // namespace
+
 std::vector<int> Postprocessing::nms(const std::vector<cv::Rect>& boxes,
                                       const std::vector<float>& scores,
                                       float scoreThreshold,
@@ -222,6 +339,165 @@ std::vector<Detection> Postprocessing::decodeYolov5(const cv::Mat& output,
     return detections;
 }
 
+std::vector<Detection> Postprocessing::decodeYoloSeg(const cv::Mat& output,
+                                                      const cv::Mat& protos,
+                                                      cv::Size imageSize,
+                                                      cv::Size inputSize,
+                                                      float confThreshold,
+                                                      float nmsThreshold,
+                                                      float maskThreshold) {
+    std::vector<Detection> detections;
+    
+    // Prototypes: [1, maskDim, maskH, maskW]
+    if (protos.dims != 4 || protos.type() != CV_32F || !protos.isContinuous()) {
+        return detections;
+    }
+    const int maskDim = protos.size[1];
+    const int maskH = protos.size[2];
+    const int maskW = protos.size[3];
+    
+    HeadView head;
+    if (!viewHead(output, head)) {
+        return detections;
+    }
+    const int numClasses = head.channels - 4 - maskDim;
+    if (numClasses <= 0 || maskH <= 0 || maskW <= 0) {
+        return detections;
+    }
+    
+    std::vector<cv::Rect> boxes;
+    std::vector<float> scores;
+    std::vector<int> classIds;
+    std::vector<int> anchors;
+    std::vector<cv::Rect2f> inputBoxes;
+    collectCandidates(head, numClasses, confThreshold, imageSize, inputSize,
+                      boxes, scores, classIds, anchors, &inputBoxes);
+    
+    std::vector<int> indices = nms(boxes, scores, confThreshold, nmsThreshold);
+    
+    detections.resize(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        const int idx = indices[i];
+        detections[i].classId = classIds[idx];
+        detections[i].confidence = scores[idx];
+        detections[i].box = boxes[idx];
+    }
+    
+    // Input pixels -> prototype pixels, and prototype pixels -> image pixels
+    const float toProtoX = static_cast<float>(maskW) / inputSize.width;
+    const float toProtoY = static_cast<float>(maskH) / inputSize.height;
+    const double toImageX = static_cast<double>(imageSize.width) / maskW;
+    const double toImageY = static_cast<double>(imageSize.height) / maskH;
+    // sigmoid(logit) > t  <=>  logit > log(t / (1 - t))
+    const float t = std::min(std::max(maskThreshold, 1e-6f), 1.0f - 1e-6f);
+    const double logitThreshold = std::log(t / (1.0f - t));
+    const float* protoData = protos.ptr<float>();
+    const size_t plane = static_cast<size_t>(maskH) * maskW;
+    
+    cv::parallel_for_(cv::Range(0, static_cast<int>(indices.size())), [&](const cv::Range& range) {
+        std::vector<float> coefs(maskDim);
+        for (int i = range.start; i < range.end; ++i) {
+            Detection& det = detections[i];
+            const int idx = indices[i];
+            det.mask = cv::Mat::zeros(std::max(det.box.height, 0), std::max(det.box.width, 0), CV_8UC1);
+            if (det.mask.empty()) {
+                continue;
+            }
+            
+            // Box at prototype resolution
+            const cv::Rect2f& ib = inputBoxes[idx];
+            const int px0 = std::max(0, static_cast<int>(std::floor(ib.x * toProtoX)));
+            const int py0 = std::max(0, static_cast<int>(std::floor(ib.y * toProtoY)));
+            const int px1 = std::min(maskW, static_cast<int>(std::ceil((ib.x + ib.width) * toProtoX)));
+            const int py1 = std::min(maskH, static_cast<int>(std::ceil((ib.y + ib.height) * toProtoY)));
+            if (px1 <= px0 || py1 <= py0) {
+                continue;
+            }
+            
+            // Mask logits inside the box: sum_k coef_k * proto_k
+            for (int k = 0; k < maskDim; ++k) {
+                coefs[k] = head.at(anchors[idx], 4 + numClasses + k);
+            }
+            cv::Mat logits = cv::Mat::zeros(py1 - py0, px1 - px0, CV_32F);
+            for (int k = 0; k < maskDim; ++k) {
+                const float c = coefs[k];
+                const float* proto = protoData + k * plane;
+                for (int y = 0; y < logits.rows; ++y) {
+                    const float* src = proto + static_cast<size_t>(py0 + y) * maskW + px0;
+                    float* dst = logits.ptr<float>(y);
+                    for (int x = 0; x < logits.cols; ++x) {
+                        dst[x] += c * src[x];
+                    }
+                }
+            }
+            
+            // Upsample the crop only, then keep the part under the box
+            const cv::Rect upRect(cvRound(px0 * toImageX), cvRound(py0 * toImageY),
+                                  std::max(1, cvRound(logits.cols * toImageX)),
+                                  std::max(1, cvRound(logits.rows * toImageY)));
+            const cv::Rect overlap = upRect & det.box;
+            if (overlap.empty()) {
+                continue;
+            }
+            cv::Mat up;
+            cv::resize(logits, up, upRect.size(), 0, 0, cv::INTER_LINEAR);
+            cv::Mat maskRoi = det.mask(overlap - det.box.tl());
+            cv::compare(up(overlap - upRect.tl()), logitThreshold, maskRoi, cv::CMP_GT);
+        }
+    });
+    
+    return detections;
+}
+
+std::vector<Detection> Postprocessing::decodeYoloPose(const cv::Mat& output,
+                                                       cv::Size imageSize,
+                                                       cv::Size inputSize,
+                                                       float confThreshold,
+                                                       float nmsThreshold,
+                                                       int numClasses) {
+    std::vector<Detection> detections;
+    
+    HeadView head;
+    if (!viewHead(output, head) || numClasses <= 0) {
+        return detections;
+    }
+    // Keypoints follow the class scores as (x, y, visibility) triplets
+    const int numKeypoints = (head.channels - 4 - numClasses) / 3;
+    if (numKeypoints <= 0 || 4 + numClasses + numKeypoints * 3 != head.channels) {
+        return detections;
+    }
+    
+    std::vector<cv::Rect> boxes;
+    std::vector<float> scores;
+    std::vector<int> classIds;
+    std::vector<int> anchors;
+    collectCandidates(head, numClasses, confThreshold, imageSize, inputSize,
+                      boxes, scores, classIds, anchors);
+    
+    std::vector<int> indices = nms(boxes, scores, confThreshold, nmsThreshold);
+    
+    float scaleX = static_cast<float>(imageSize.width) / inputSize.width;
+    float scaleY = static_cast<float>(imageSize.height) / inputSize.height;
+    
+    for (int idx : indices) {
+        Detection det;
+        det.classId = classIds[idx];
+        det.confidence = scores[idx];
+        det.box = boxes[idx];
+        det.keypoints.reserve(numKeypoints);
+        det.keypointConfidences.reserve(numKeypoints);
+        const int base = 4 + numClasses;
+        for (int k = 0; k < numKeypoints; ++k) {
+            det.keypoints.emplace_back(head.at(anchors[idx], base + 3 * k) * scaleX,
+                                       head.at(anchors[idx], base + 3 * k + 1) * scaleY);
+            det.keypointConfidences.push_back(head.at(anchors[idx], base + 3 * k + 2));
+        }
+        detections.push_back(std::move(det));
+    }
+    
+    return detections;
+}
+
 cv::Mat Postprocessing::softmax(const cv::Mat& input, int axis) {
     cv::Mat output = input.clone();
     
@@ -364,6 +364,7 @@ std::optional<CacheOutput> Parser::cacheOutputSpec() {
     if (check(TokenType::STRING_LITERAL)) {
         Token cacheIdToken = advance();
         output.cacheId = cacheIdToken.asString();
+        output.cacheKey = CacheKeyTable::instance().intern(output.cacheId);
     } else if (check(TokenType::IDENTIFIER)) {
         Token cacheIdToken = advance();
         output.cacheId = cacheIdToken.asString();
@@ -424,6 +425,7 @@ std::shared_ptr<Statement> Parser::globalPromoteStatement() {
         Token cacheIdToken = consume(TokenType::STRING_LITERAL,
                                      "Expected cache id string or variable name after 'global'");
         stmt->cacheId = cacheIdToken.asString();
+        stmt->cacheKey = CacheKeyTable::instance().intern(stmt->cacheId);
     }
 
     return stmt;
@@ -563,8 +565,27 @@ std::shared_ptr<Statement> Parser::execNasyncStatement() {
         }
         consume(TokenType::KW_END, "Expected 'end' after exec_nasync block");
     } else {
-        // Named pipeline form: exec_nasync <pipeline_ref>
+        // Named pipeline form: exec_nasync <pipeline_ref> [workers=N] [order=strict|latest]
         stmt->pipelineRef = expression();
+
+        while (check(TokenType::IDENTIFIER) && peek(1).type == TokenType::OP_ASSIGN &&
+               (current().raw == "workers" || current().raw == "order")) {
+            std::string key = advance().raw;
+            advance();  // consume '='
+            if (key == "workers") {
+                stmt->workers = expression();
+            } else {
+                if (!check(TokenType::IDENTIFIER) && !check(TokenType::STRING_LITERAL)) {
+                    throw error("Expected 'strict' or 'latest' after 'order='");
+                }
+                std::string mode = advance().asString();
+                if (mode == "strict") {
+                    stmt->strictOrder = true;
+                } else if (mode != "latest") {
+                    throw error("exec_nasync order must be 'strict' or 'latest', got '" + mode + "'");
+                }
+            }
+        }
     }
 
     return stmt;
@@ -608,6 +629,7 @@ std::shared_ptr<Statement> Parser::useStatement() {
     
     Token cacheIdToken = consume(TokenType::STRING_LITERAL, "Expected cache id string");
     stmt->cacheId = cacheIdToken.asString();
+    stmt->cacheKey = CacheKeyTable::instance().intern(stmt->cacheId);
     
     consume(TokenType::RPAREN, "Expected ')' after cache id");
     
@@ -623,6 +645,7 @@ std::shared_ptr<Statement> Parser::useStatement() {
         if (check(TokenType::STRING_LITERAL)) {
             Token outputToken = advance();
             output.cacheId = outputToken.asString();
+            output.cacheKey = CacheKeyTable::instance().intern(output.cacheId);
         } else if (check(TokenType::IDENTIFIER)) {
             Token outputToken = advance();
             output.cacheId = outputToken.asString();
@@ -651,6 +674,7 @@ std::shared_ptr<Statement> Parser::cacheStatement() {
     
     Token cacheIdToken = consume(TokenType::STRING_LITERAL, "Expected cache id string");
     stmt->cacheId = cacheIdToken.asString();
+    stmt->cacheKey = CacheKeyTable::instance().intern(stmt->cacheId);
     
     // Optional second parameter: cache("id") or cache("id", expression)
     if (match(TokenType::OP_COMMA)) {
@@ -887,6 +911,7 @@ std::shared_ptr<Expression> Parser::postfix() {
             if (check(TokenType::STRING_LITERAL)) {
                 Token cacheIdToken = advance();
                 output.cacheId = cacheIdToken.asString();
+                output.cacheKey = CacheKeyTable::instance().intern(output.cacheId);
             } else if (check(TokenType::IDENTIFIER)) {
                 Token cacheIdToken = advance();
                 output.cacheId = cacheIdToken.asString();
@@ -905,6 +930,7 @@ std::shared_ptr<Expression> Parser::postfix() {
             auto loadExpr = std::make_shared<CacheLoadExpr>();
             loadExpr->location = expr->location;
             loadExpr->cacheId = std::get<std::string>(literal->value);
+            loadExpr->cacheKey = CacheKeyTable::instance().intern(loadExpr->cacheId);
             loadExpr->isDynamic = false;
             
             // Check for global modifier
@@ -1039,6 +1065,20 @@ std::shared_ptr<Expression> Parser::functionCall(const std::string& name, Source
     }
     
     consume(TokenType::RPAREN, "Expected ')' after arguments");
+
+    // Intern string literal arguments: most are cache ids (or registry
+    // cache_ids), which items can then address by key without hashing.
+    auto literalKey = [](const std::shared_ptr<Expression>& arg) {
+        auto* lit = dynamic_cast<const LiteralExpr*>(arg.get());
+        if (lit && std::holds_alternative<std::string>(lit->value)) {
+            return CacheKeyTable::instance().intern(std::get<std::string>(lit->value));
+        }
+        return CacheKey{};
+    };
+    call->argKeys.reserve(call->arguments.size());
+    for (const auto& arg : call->arguments) call->argKeys.push_back(literalKey(arg));
+    call->namedArgKeys.reserve(call->namedArguments.size());
+    for (const auto& [_, arg] : call->namedArguments) call->namedArgKeys.push_back(literalKey(arg));
     
     return call;
 }
@@ -1146,6 +1186,18 @@ std::shared_ptr<Statement> Parser::paramDeclStatement() {
             entry.defaultValue = expression();
         }
 
+        // Optional @tunable(v1, v2, ...) — candidate values for `visionpipe tune`
+        if (check(TokenType::OP_AT) && current().asString() == "tunable") {
+            advance();
+            consume(TokenType::LPAREN, "Expected '(' after @tunable");
+            if (!check(TokenType::RPAREN)) {
+                do {
+                    entry.tunableValues.push_back(expression());
+                } while (match(TokenType::OP_COMMA));
+            }
+            consume(TokenType::RPAREN, "Expected ')' after @tunable values");
+        }
+
         stmt->entries.push_back(std::move(entry));
 
         if (!match(TokenType::OP_COMMA)) break;
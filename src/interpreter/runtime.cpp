@@ -156,9 +156,29 @@ void Runtime::load(const std::string& filename) {
     _interpreter.execute(program);
 }
 
+void Runtime::loadDefinitions(const std::string& filename) {
+    size_t lastSlash = filename.find_last_of("/\\");
+    if (lastSlash != std::string::npos) {
+        auto cfg = _config.interpreterConfig;
+        cfg.workingDirectory = filename.substr(0, lastSlash);
+        _interpreter.setConfig(cfg);
+    }
+
+    // Shallow copy: pipelines and globals are shared, exec_* statements dropped.
+    auto program = std::make_shared<Program>(*parseFile(filename));
+    program->topLevelStatements.clear();
+
+    if (!program->paramDecls.empty()) {
+        ensureParamStore();
+    }
+
+    _interpreter.execute(program);
+}
+
 cv::Mat Runtime::executePipeline(const std::string& name,
                                   const std::vector<RuntimeValue>& args,
                                   const cv::Mat& input) {
+    _interpreter.beginFrame();
     return _interpreter.executePipeline(name, args, input);
 }
 
@@ -0,0 +1,178 @@
+#include "utils/binary_thinning.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace visionpipe {
+
+namespace {
+
+using DeletionLut = std::array<uchar, 256>;
+
+/// Neighbour bits clockwise from north: bit 0 = P2 (N), P3 (NE), P4 (E), ..., bit 7 = P9 (NW).
+inline int neighbourhood(const uchar* p, int step) {
+    return  p[-step]       | (p[-step + 1] << 1) | (p[1] << 2)  | (p[step + 1] << 3) |
+           (p[step] << 4)  | (p[step - 1] << 5)  | (p[-1] << 6) | (p[-step - 1] << 7);
+}
+
+std::array<DeletionLut, 2> buildLuts(ThinningMethod method) {
+    std::array<DeletionLut, 2> luts{};
+    for (int sub = 0; sub < 2; ++sub) {
+        for (int code = 0; code < 256; ++code) {
+            int p[10] = {0};
+            for (int k = 0; k < 8; ++k) p[k + 2] = (code >> k) & 1;
+
+            bool del;
+            if (method == ThinningMethod::ZhangSuen) {
+                int a = 0, b = 0;
+                for (int k = 2; k <= 9; ++k) {
+                    b += p[k];
+                    a += p[k] == 0 && p[k == 9 ? 2 : k + 1] == 1;
+                }
+                const int m1 = sub == 0 ? p[2] * p[4] * p[6] : p[2] * p[4] * p[8];
+                const int m2 = sub == 0 ? p[4] * p[6] * p[8] : p[2] * p[6] * p[8];
+                del = a == 1 && b >= 2 && b <= 6 && m1 == 0 && m2 == 0;
+            } else {
+                const int c = ((1 - p[2]) & (p[3] | p[4])) + ((1 - p[4]) & (p[5] | p[6])) +
+                              ((1 - p[6]) & (p[7] | p[8])) + ((1 - p[8]) & (p[9] | p[2]));
+                const int n1 = (p[9] | p[2]) + (p[3] | p[4]) + (p[5] | p[6]) + (p[7] | p[8]);
+                const int n2 = (p[2] | p[3]) + (p[4] | p[5]) + (p[6] | p[7]) + (p[8] | p[9]);
+                const int n = std::min(n1, n2);
+                const int m = sub == 0 ? ((p[6] | p[7] | (1 - p[9])) & p[8]) : ((p[2] | p[3] | (1 - p[5])) & p[4]);
+                del = c == 1 && n >= 2 && n <= 3 && m == 0;
+            }
+            luts[sub][code] = del;
+        }
+    }
+    return luts;
+}
+
+struct Strip {
+    int row0, row1;                 ///< Rows of the padded buffer, [row0, row1)
+    std::vector<int> fresh;         ///< Not tested since their neighbourhood changed
+    std::vector<int> stale;         ///< Tested once since; due for the other table
+    std::vector<int> kept;          ///< Fresh pixels that survived this subiteration
+    std::vector<int> deleted;
+    std::vector<int> haloTop;       ///< Deletions on row0, seen by the strip above
+    std::vector<int> haloBottom;    ///< Deletions on row1 - 1, seen by the strip below
+};
+
+} // namespace
+
+// ============================================================================
+// Thinning
+// ============================================================================
+
+void thinBinary(const cv::Mat& src, cv::Mat& dst, ThinningMethod method) {
+    CV_Assert(src.type() == CV_8UC1);
+    if (src.empty()) {
+        dst.release();
+        return;
+    }
+
+    static const std::array<DeletionLut, 2> zhangSuen = buildLuts(ThinningMethod::ZhangSuen);
+    static const std::array<DeletionLut, 2> guoHall = buildLuts(ThinningMethod::GuoHall);
+    const auto& luts = method == ThinningMethod::GuoHall ? guoHall : zhangSuen;
+
+    // 0/1 image with a one-pixel background border, so neighbourhoods need no bounds checks
+    const int H = src.rows, W = src.cols;
+    const int step = W + 2;
+    cv::Mat work = cv::Mat::zeros(H + 2, step, CV_8UC1);
+    cv::Mat inner = work(cv::Rect(1, 1, W, H));
+    cv::compare(src, 0, inner, cv::CMP_NE);
+    cv::bitwise_and(inner, cv::Scalar(1), inner);
+    uchar* img = work.ptr<uchar>();
+
+    // Subiteration stamp of each pixel's last frontier entry, for deduplication
+    std::vector<unsigned> mark(work.total(), 0);
+
+    const int nStrips = std::max(1, std::min(H, cv::getNumThreads() * 4));
+    std::vector<Strip> strips(nStrips);
+    for (int s = 0; s < nStrips; ++s) {
+        strips[s].row0 = 1 + H * s / nStrips;
+        strips[s].row1 = 1 + H * (s + 1) / nStrips;
+    }
+
+    // The only full scan: foreground touching background
+    cv::parallel_for_(cv::Range(0, nStrips), [&](const cv::Range& range) {
+        for (int s = range.start; s < range.end; ++s) {
+            Strip& st = strips[s];
+            for (int y = st.row0; y < st.row1; ++y) {
+                for (int i = y * step + 1, end = i + W; i < end; ++i) {
+                    if (img[i] && neighbourhood(img + i, step) != 255) st.fresh.push_back(i);
+                }
+            }
+        }
+    });
+
+    const int offsets[8] = {-step - 1, -step, -step + 1, -1, 1, step - 1, step, step + 1};
+    unsigned gen = 0;
+
+    for (int sub = 0; ; sub ^= 1) {
+        bool pending = false;
+        for (const Strip& st : strips) pending |= !st.fresh.empty() || !st.stale.empty();
+        if (!pending) break;
+
+        const DeletionLut& lut = luts[sub];
+        ++gen;
+
+        // Decide every deletion against the unmodified image
+        cv::parallel_for_(cv::Range(0, nStrips), [&](const cv::Range& range) {
+            for (int s = range.start; s < range.end; ++s) {
+                Strip& st = strips[s];
+                st.kept.clear();
+                st.deleted.clear();
+                st.haloTop.clear();
+                st.haloBottom.clear();
+
+                auto test = [&](int i, bool fresh) {
+                    if (lut[neighbourhood(img + i, step)]) {
+                        st.deleted.push_back(i);
+                        const int y = i / step;
+                        if (y == st.row0) st.haloTop.push_back(i);
+                        if (y == st.row1 - 1) st.haloBottom.push_back(i);
+                    } else if (fresh) {
+                        st.kept.push_back(i);
+                    }
+                };
+                for (int i : st.fresh) test(i, true);
+                for (int i : st.stale) test(i, false);
+            }
+        });
+
+        // Each strip deletes its own pixels, then takes the foreground around
+        // its own and its neighbours' boundary deletions as the next frontier
+        cv::parallel_for_(cv::Range(0, nStrips), [&](const cv::Range& range) {
+            for (int s = range.start; s < range.end; ++s) {
+                Strip& st = strips[s];
+                for (int i : st.deleted) img[i] = 0;
+
+                const int lo = st.row0 * step, hi = st.row1 * step;
+                st.fresh.clear();
+                auto gather = [&](const std::vector<int>& deleted) {
+                    for (int i : deleted) {
+                        for (int off : offsets) {
+                            const int q = i + off;
+                            if (q < lo || q >= hi || !img[q] || mark[q] == gen) continue;
+                            mark[q] = gen;
+                            st.fresh.push_back(q);
+                        }
+                    }
+                };
+                gather(st.deleted);
+                if (s > 0) gather(strips[s - 1].haloBottom);
+                if (s + 1 < nStrips) gather(strips[s + 1].haloTop);
+
+                st.stale.clear();
+                for (int i : st.kept) {
+                    if (mark[i] != gen) st.stale.push_back(i);
+                }
+            }
+        });
+    }
+
+    cv::compare(inner, 0, dst, cv::CMP_NE);
+}
+
+} // namespace visionpipe
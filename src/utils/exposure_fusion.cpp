@@ -0,0 +1,189 @@
+#include "utils/exposure_fusion.h"
+
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace visionpipe {
+
+namespace {
+
+constexpr int kPixelShift  = 3;    ///< Laplacian pyramids hold pixel << 3 (Q3)
+constexpr int kWeightShift = 14;   ///< Normalised weights are Q14 (1.0 = 16384)
+constexpr int kMaxLevels   = 10;
+
+inline float weightPow(float v, double e) {
+    if (e == 0.0) return 1.0f;
+    if (e == 1.0) return v;
+    return static_cast<float>(std::pow(v, e));
+}
+
+/// Raw Mertens weight of a Q3 Gaussian level: contrast x saturation x
+/// well-exposedness, each raised to its exponent (see cv::MergeMertens).
+void mertensWeight(const cv::Mat& gaussQ3, cv::Mat& weight, const ExposureFusionConfig& cfg) {
+    cv::Mat f;
+    gaussQ3.convertTo(f, CV_32F, 1.0 / (255.0 * (1 << kPixelShift)));
+    const int cn = f.channels();
+
+    cv::Mat gray;
+    if (cn == 3) cv::cvtColor(f, gray, cv::COLOR_BGR2GRAY);
+    else         gray = f;
+    cv::Mat contrast;
+    cv::Laplacian(gray, contrast, CV_32F);
+
+    weight.create(f.size(), CV_32F);
+    cv::parallel_for_(cv::Range(0, f.rows), [&](const cv::Range& r) {
+        for (int y = r.start; y < r.end; ++y) {
+            const float* p = f.ptr<float>(y);
+            const float* c = contrast.ptr<float>(y);
+            float* w = weight.ptr<float>(y);
+            for (int x = 0; x < f.cols; ++x) {
+                const float* px = p + x * cn;
+                float sat = 1.0f;
+                float well = 1.0f;
+                if (cn == 3) {
+                    float m = (px[0] + px[1] + px[2]) / 3.0f;
+                    float d0 = px[0] - m, d1 = px[1] - m, d2 = px[2] - m;
+                    sat = std::sqrt((d0 * d0 + d1 * d1 + d2 * d2) / 3.0f);
+                }
+                for (int ch = 0; ch < cn; ++ch) {
+                    float d = px[ch] - 0.5f;
+                    well *= std::exp(-d * d / 0.08f);   // sigma = 0.2
+                }
+                w[x] = weightPow(std::abs(c[x]), cfg.contrast) *
+                       weightPow(sat, cfg.saturation) *
+                       weightPow(well, cfg.exposedness) + 1e-12f;
+            }
+        }
+    });
+}
+
+/// out = sum_k lap_k * w_k >> 14, per pixel, all channels sharing the weight.
+void blendLevel(const std::vector<const cv::Mat*>& laps, const std::vector<const cv::Mat*>& weights,
+                cv::Mat& out) {
+    const cv::Mat& ref = *laps[0];
+    out.create(ref.size(), ref.type());
+    const int cn = ref.channels();
+    const size_t K = laps.size();
+    cv::parallel_for_(cv::Range(0, ref.rows), [&](const cv::Range& r) {
+        std::vector<const short*> lp(K), wp(K);
+        for (int y = r.start; y < r.end; ++y) {
+            for (size_t k = 0; k < K; ++k) {
+                lp[k] = laps[k]->ptr<short>(y);
+                wp[k] = weights[k]->ptr<short>(y);
+            }
+            short* o = out.ptr<short>(y);
+            for (int x = 0; x < ref.cols; ++x) {
+                for (int ch = 0; ch < cn; ++ch) {
+                    int acc = 0;
+                    for (size_t k = 0; k < K; ++k) acc += lp[k][x * cn + ch] * wp[k][x];
+                    o[x * cn + ch] = cv::saturate_cast<short>((acc + (1 << (kWeightShift - 1))) >> kWeightShift);
+                }
+            }
+        }
+    });
+}
+
+} // namespace
+
+// ============================================================================
+// ExposureFusion
+// ============================================================================
+
+ExposureFusion::ExposureFusion(const ExposureFusionConfig& cfg) : _cfg(cfg.clamped()) {}
+
+void ExposureFusion::reset(const cv::Size& size, int type) {
+    _size = size;
+    _type = type;
+    _levels = 1;
+    while (_levels < kMaxLevels && (std::min(size.width, size.height) >> _levels) >= 8) ++_levels;
+    _weightLevel = std::clamp(_cfg.weightLevel, 0, _levels - 1);
+    _next = 0;
+
+    _slots.assign(_cfg.exposures, Slot());
+    for (Slot& s : _slots) s.lap.resize(_levels);
+    _weights.assign(_cfg.exposures, std::vector<cv::Mat>(_levels));
+    _gauss.resize(_levels);
+    _blend.resize(_levels);
+}
+
+void ExposureFusion::update(const cv::Mat& frame, int slot) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    cv::Mat input = frame;
+    if (input.channels() == 4) cv::cvtColor(input, input, cv::COLOR_BGRA2BGR);
+    if (input.depth() != CV_8U) input.convertTo(input, CV_8U);
+    if (input.size() != _size || input.type() != _type) reset(input.size(), input.type());
+
+    const int idx = slot < 0 ? _next : slot % _cfg.exposures;
+    _next = (idx + 1) % _cfg.exposures;
+    Slot& s = _slots[idx];
+
+    // Gaussian pyramid in Q3; the weight level is read from it directly.
+    input.convertTo(_gauss[0], CV_16S, 1 << kPixelShift);
+    for (int l = 1; l < _levels; ++l) cv::pyrDown(_gauss[l - 1], _gauss[l]);
+    mertensWeight(_gauss[_weightLevel], s.weight, _cfg);
+
+    for (int l = 0; l + 1 < _levels; ++l) {
+        cv::pyrUp(_gauss[l + 1], _expanded, _gauss[l].size());
+        cv::subtract(_gauss[l], _expanded, s.lap[l]);
+    }
+    // Top level is the residual Gaussian; swapping hands the slot's old
+    // buffer back to the scratch pyramid instead of copying.
+    cv::swap(s.lap[_levels - 1], _gauss[_levels - 1]);
+
+    s.valid = true;
+    ++_frames;
+}
+
+bool ExposureFusion::ready() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_slots.empty()) return false;
+    return std::all_of(_slots.begin(), _slots.end(), [](const Slot& s) { return s.valid; });
+}
+
+cv::Mat ExposureFusion::fuse() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_slots.empty() ||
+        !std::all_of(_slots.begin(), _slots.end(), [](const Slot& s) { return s.valid; })) {
+        return cv::Mat();
+    }
+
+    // Normalise at the reduced weight resolution, then expand each slot's
+    // weights into a Q14 Gaussian pyramid matching the Laplacian levels.
+    _weightSum = cv::Mat::zeros(_slots[0].weight.size(), CV_32F);
+    for (const Slot& s : _slots) _weightSum += s.weight;
+
+    const int K = static_cast<int>(_slots.size());
+    cv::parallel_for_(cv::Range(0, K), [&](const cv::Range& r) {
+        for (int k = r.start; k < r.end; ++k) {
+            auto& wp = _weights[k];
+            cv::divide(_slots[k].weight, _weightSum, wp[_weightLevel], 1 << kWeightShift, CV_16S);
+            for (int l = _weightLevel + 1; l < _levels; ++l) cv::pyrDown(wp[l - 1], wp[l]);
+            for (int l = _weightLevel - 1; l >= 0; --l) {
+                cv::pyrUp(wp[l + 1], wp[l], _slots[k].lap[l].size());
+            }
+        }
+    });
+
+    std::vector<const cv::Mat*> laps(K), weights(K);
+    for (int l = 0; l < _levels; ++l) {
+        for (int k = 0; k < K; ++k) {
+            laps[k] = &_slots[k].lap[l];
+            weights[k] = &_weights[k][l];
+        }
+        blendLevel(laps, weights, _blend[l]);
+    }
+
+    // Collapse in place: each level accumulates the expanded coarser one.
+    for (int l = _levels - 2; l >= 0; --l) {
+        cv::pyrUp(_blend[l + 1], _expanded, _blend[l].size());
+        cv::add(_blend[l], _expanded, _blend[l]);
+    }
+
+    cv::Mat out;
+    _blend[0].convertTo(out, CV_8U, 1.0 / (1 << kPixelShift));
+    return out;
+}
+
+} // namespace visionpipe
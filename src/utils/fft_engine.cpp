@@ -0,0 +1,406 @@
+#include "utils/fft_engine.h"
+#include "utils/warp_plan_cache.h"
+
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+namespace visionpipe {
+
+namespace {
+
+/// Per-thread scratch buffers.  Channels are filtered on OpenCV's thread
+/// pool, so each worker keeps its own set; after the first frame of a given
+/// size no call allocates scratch memory.
+struct FFTWorkspace {
+    cv::Mat plane;      ///< Input channel converted to CV_32F
+    cv::Mat padded;     ///< Border-extended, zero-padded transform input
+    cv::Mat spectrum;   ///< Forward transform (CCS or complex)
+    cv::Mat cross;      ///< Normalised cross-power spectrum (phase correlation)
+    cv::Mat spatial;    ///< Inverse transform
+    cv::Mat window;     ///< Hann window for the last phase-correlation size
+};
+
+FFTWorkspace& workspace() {
+    thread_local FFTWorkspace ws;
+    return ws;
+}
+
+uint64_t identityStamp(WarpKeyHasher h, const cv::Mat& m) {
+    auto p = reinterpret_cast<uintptr_t>(m.data);
+    return h.add(&p, sizeof(p)).add(m.size()).add(m.type()).value();
+}
+
+/// View `plane` as CV_32F, converting into `scratch` only when necessary.
+const cv::Mat& asFloat(const cv::Mat& plane, cv::Mat& scratch) {
+    if (plane.depth() == CV_32F) return plane;
+    plane.convertTo(scratch, CV_32F);
+    return scratch;
+}
+
+/// Zero everything in `padded` outside the top-left `used` rectangle.
+void zeroTail(cv::Mat& padded, const cv::Size& used) {
+    if (used.width < padded.cols)
+        padded(cv::Rect(used.width, 0, padded.cols - used.width, padded.rows)).setTo(0);
+    if (used.height < padded.rows)
+        padded(cv::Rect(0, used.height, used.width, padded.rows - used.height)).setTo(0);
+}
+
+/// Run `fn(plane, out, depth)` on every channel, in parallel for colour input.
+template <typename Fn>
+void forEachChannel(const cv::Mat& src, cv::Mat& dst, int ddepth, Fn&& fn) {
+    const int depth = ddepth < 0 ? src.depth() : ddepth;
+    if (src.channels() == 1) {
+        cv::Mat out;
+        fn(src, out, depth);
+        dst = out;
+        return;
+    }
+    std::vector<cv::Mat> planes;
+    cv::split(src, planes);
+    std::vector<cv::Mat> outs(planes.size());
+    cv::parallel_for_(cv::Range(0, static_cast<int>(planes.size())), [&](const cv::Range& r) {
+        for (int c = r.start; c < r.end; ++c) fn(planes[c], outs[c], depth);
+    });
+    cv::merge(outs, dst);
+}
+
+/// Real gain map laid out like a CCS-packed spectrum of size P, so that an
+/// element-wise multiply scales every frequency bin by g(fu, fv).  fu and fv
+/// are signed frequencies normalised to Nyquist.
+cv::Mat buildCcsGain(const cv::Size& P, const std::function<float(double, double)>& g) {
+    const int N = P.width;
+    const int M = P.height;
+    cv::Mat gain(P, CV_32F);
+    auto fu = [N](int u) { return 2.0 * u / N; };
+    auto fv = [M](int v) { return 2.0 * v / M; };
+
+    // Interior columns hold (Re, Im) pairs for u = 1 .. ceil(N/2)-1 over all rows.
+    cv::parallel_for_(cv::Range(0, M), [&](const cv::Range& r) {
+        for (int y = r.start; y < r.end; ++y) {
+            const int v = y <= M / 2 ? y : y - M;
+            float* row = gain.ptr<float>(y);
+            for (int u = 1; 2 * u < N; ++u) {
+                row[2 * u - 1] = row[2 * u] = g(fu(u), fv(v));
+            }
+        }
+    });
+
+    // Column 0 (u = 0) and, for even N, column N-1 (u = N/2) are packed
+    // vertically: Re(v=0), then (Re, Im) pairs, then Re(M/2) for even M.
+    auto packColumn = [&](int col, int u) {
+        gain.at<float>(0, col) = g(fu(u), 0.0);
+        for (int y = 1; y < M; ++y) gain.at<float>(y, col) = g(fu(u), fv((y + 1) / 2));
+    };
+    packColumn(0, 0);
+    if (N % 2 == 0 && N > 1) packColumn(N - 1, N / 2);
+    return gain;
+}
+
+double lowpass(FrequencyResponse::Shape shape, double d, double c, int order) {
+    c = std::max(c, 1e-6);
+    switch (shape) {
+        case FrequencyResponse::Shape::IDEAL:
+            return d <= c ? 1.0 : 0.0;
+        case FrequencyResponse::Shape::BUTTERWORTH:
+            return 1.0 / (1.0 + std::pow(d / c, 2.0 * std::max(order, 1)));
+        case FrequencyResponse::Shape::GAUSSIAN:
+        default:
+            return std::exp(-(d * d) / (2.0 * c * c));
+    }
+}
+
+std::function<float(double, double)> responseFunction(const FrequencyResponse& r) {
+    using Kind = FrequencyResponse::Kind;
+    if (r.kind == Kind::CUSTOM) {
+        cv::Mat samples;
+        r.custom.convertTo(samples, CV_32F);
+        if (samples.channels() > 1) cv::extractChannel(samples, samples, 0);
+        return [samples](double fu, double fv) {
+            // Centred response: DC at (cols/2, rows/2), Nyquist at the edges.
+            const int cx = samples.cols / 2;
+            const int cy = samples.rows / 2;
+            int x = cx + static_cast<int>(std::lround(fu * samples.cols / 2.0));
+            int y = cy + static_cast<int>(std::lround(fv * samples.rows / 2.0));
+            x = std::clamp(x, 0, samples.cols - 1);
+            y = std::clamp(y, 0, samples.rows - 1);
+            return samples.at<float>(y, x);
+        };
+    }
+    return [r](double fu, double fv) {
+        const double d = std::sqrt(fu * fu + fv * fv);
+        double lo = lowpass(r.shape, d, r.cutoff, r.order);
+        double v;
+        switch (r.kind) {
+            case Kind::HIGHPASS: v = 1.0 - lo; break;
+            case Kind::BANDPASS: v = std::max(0.0, lowpass(r.shape, d, r.cutoffHigh, r.order) - lo); break;
+            case Kind::BANDSTOP: v = 1.0 - std::max(0.0, lowpass(r.shape, d, r.cutoffHigh, r.order) - lo); break;
+            case Kind::LOWPASS:
+            default: v = lo; break;
+        }
+        return static_cast<float>(v);
+    };
+}
+
+/// Single-plane correlation with a CCS kernel spectrum (see FFTEngine::convolve).
+void convolvePlane(const cv::Mat& plane, cv::Mat& out, int depth, const FrequencyPlan& k,
+                   const cv::Size& ksize, const cv::Point& anchor, int borderType) {
+    FFTWorkspace& ws = workspace();
+    const cv::Size P = k.padSize;
+    const cv::Size ext(plane.cols + ksize.width - 1, plane.rows + ksize.height - 1);
+
+    ws.padded.create(P, CV_32F);
+    cv::Mat extRoi = ws.padded(cv::Rect(cv::Point(), ext));
+    cv::copyMakeBorder(asFloat(plane, ws.plane), extRoi,
+                       anchor.y, ksize.height - 1 - anchor.y,
+                       anchor.x, ksize.width - 1 - anchor.x,
+                       borderType | cv::BORDER_ISOLATED);
+    zeroTail(ws.padded, ext);
+
+    // Circular correlation equals linear correlation on the first
+    // rows x cols outputs because the padding absorbs the kernel support.
+    cv::dft(ws.padded, ws.spectrum, 0, ext.height);
+    cv::mulSpectrums(ws.spectrum, k.spectrum, ws.spectrum, 0, true);
+    cv::idft(ws.spectrum, ws.spatial, cv::DFT_SCALE | cv::DFT_REAL_OUTPUT, plane.rows);
+    ws.spatial(cv::Rect(0, 0, plane.cols, plane.rows)).convertTo(out, depth);
+}
+
+/// Single-plane transfer-function filter; `gain` is centred on the frame.
+void filterPlane(const cv::Mat& plane, cv::Mat& out, int depth, const FrequencyPlan& gain) {
+    FFTWorkspace& ws = workspace();
+    const cv::Size P = gain.padSize;
+    const int left = (P.width - plane.cols) / 2;
+    const int top  = (P.height - plane.rows) / 2;
+
+    // Mirrored padding keeps the periodic extension smooth, which avoids
+    // the ringing zero padding would cause at the frame edges.
+    cv::copyMakeBorder(asFloat(plane, ws.plane), ws.padded,
+                       top, P.height - plane.rows - top,
+                       left, P.width - plane.cols - left,
+                       cv::BORDER_REFLECT_101 | cv::BORDER_ISOLATED);
+    cv::dft(ws.padded, ws.spectrum);
+    cv::multiply(ws.spectrum, gain.spectrum, ws.spectrum);
+    cv::idft(ws.spectrum, ws.spatial, cv::DFT_SCALE | cv::DFT_REAL_OUTPUT);
+    ws.spatial(cv::Rect(left, top, plane.cols, plane.rows)).convertTo(out, depth);
+}
+
+/// Gray, optionally Hann-windowed frame in the top-left of a zeroed P buffer.
+void preparePhasePlane(const cv::Mat& frame, cv::Mat& padded, cv::Mat& window,
+                       bool useWindow, const cv::Size& P) {
+    cv::Mat gray;
+    if (frame.channels() == 3)      cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+    else if (frame.channels() == 4) cv::cvtColor(frame, gray, cv::COLOR_BGRA2GRAY);
+    else                            gray = frame;
+
+    padded.create(P, CV_32F);
+    cv::Mat roi = padded(cv::Rect(cv::Point(), gray.size()));
+    gray.convertTo(roi, CV_32F);
+    if (useWindow && gray.cols > 1 && gray.rows > 1) {
+        if (window.size() != gray.size()) cv::createHanningWindow(window, gray.size(), CV_32F);
+        cv::multiply(roi, window, roi);
+    }
+    zeroTail(padded, gray.size());
+}
+
+} // namespace
+
+// ============================================================================
+// FFTEngine
+// ============================================================================
+
+FFTEngine& FFTEngine::instance() {
+    static FFTEngine inst;
+    return inst;
+}
+
+cv::Size FFTEngine::optimalSize(const cv::Size& minSize) {
+    return cv::Size(cv::getOptimalDFTSize(std::max(minSize.width, 1)),
+                    cv::getOptimalDFTSize(std::max(minSize.height, 1)));
+}
+
+template <typename F>
+std::shared_ptr<const FrequencyPlan> FFTEngine::acquire(const std::string& id, uint64_t stamp, F&& build) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _plans.find(id);
+        if (it != _plans.end() && it->second->stamp == stamp) {
+            ++_stats.hits;
+            return it->second;
+        }
+    }
+
+    // Build outside the lock: a spectrum is a full-size forward transform.
+    std::shared_ptr<const FrequencyPlan> plan = build();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++_stats.builds;
+    _plans[id] = plan;
+    return plan;
+}
+
+bool FFTEngine::convolve(const cv::Mat& src, cv::Mat& dst, const cv::Mat& kernel,
+                         const std::string& kernelId, cv::Point anchor, int borderType,
+                         int ddepth, bool convolution, int generation) {
+    if (src.empty() || kernel.empty() || kernel.channels() != 1) return false;
+
+    const cv::Size ks = kernel.size();
+    anchor.x = anchor.x < 0 ? ks.width / 2 : std::min(anchor.x, ks.width - 1);
+    anchor.y = anchor.y < 0 ? ks.height / 2 : std::min(anchor.y, ks.height - 1);
+    // A true convolution is a correlation with the flipped kernel, whose
+    // anchor mirrors accordingly.
+    if (convolution) anchor = cv::Point(ks.width - 1 - anchor.x, ks.height - 1 - anchor.y);
+
+    const cv::Size P = optimalSize(cv::Size(src.cols + ks.width - 1, src.rows + ks.height - 1));
+    uint64_t stamp = identityStamp(WarpKeyHasher().add(P).add(int(convolution)).add(generation), kernel);
+
+    auto plan = acquire("conv:" + kernelId, stamp, [&] {
+        auto p = std::make_shared<FrequencyPlan>();
+        p->stamp = stamp;
+        p->padSize = P;
+        p->source = kernel;
+        cv::Mat k32;
+        kernel.convertTo(k32, CV_32F);
+        if (convolution) cv::flip(k32, k32, -1);
+        cv::Mat placed = cv::Mat::zeros(P, CV_32F);
+        k32.copyTo(placed(cv::Rect(cv::Point(), ks)));
+        cv::dft(placed, p->spectrum, 0, ks.height);
+        return p;
+    });
+
+    forEachChannel(src, dst, ddepth, [&](const cv::Mat& plane, cv::Mat& out, int depth) {
+        convolvePlane(plane, out, depth, *plan, ks, anchor, borderType);
+    });
+    return true;
+}
+
+void FFTEngine::filter(const cv::Mat& src, cv::Mat& dst, const FrequencyResponse& response, int ddepth) {
+    if (src.empty()) {
+        dst = cv::Mat();
+        return;
+    }
+
+    // Mirror margin of 1/8 of the short side (8..64 px) before rounding up.
+    const int margin = std::clamp(std::min(src.cols, src.rows) / 8, 8, 64);
+    const cv::Size P = optimalSize(cv::Size(src.cols + 2 * margin, src.rows + 2 * margin));
+
+    WarpKeyHasher h;
+    h.add(int(response.kind)).add(int(response.shape)).add(response.cutoff)
+     .add(response.cutoffHigh).add(response.order).add(P).add(response.generation);
+    uint64_t stamp = response.kind == FrequencyResponse::Kind::CUSTOM
+                         ? identityStamp(h, response.custom) : h.value();
+
+    auto plan = acquire("filter:" + response.id, stamp, [&] {
+        auto p = std::make_shared<FrequencyPlan>();
+        p->stamp = stamp;
+        p->padSize = P;
+        p->source = response.custom;
+        p->spectrum = buildCcsGain(P, responseFunction(response));
+        return p;
+    });
+
+    forEachChannel(src, dst, ddepth, [&](const cv::Mat& plane, cv::Mat& out, int depth) {
+        filterPlane(plane, out, depth, *plan);
+    });
+}
+
+PhaseShift FFTEngine::phaseCorrelate(const cv::Mat& frame, const std::string& refId,
+                                     const cv::Mat& reference, bool window, bool track,
+                                     int generation) {
+    PhaseShift result;
+    if (frame.empty()) return result;
+
+    FFTWorkspace& ws = workspace();
+    const cv::Size S = frame.size();
+    const cv::Size P = optimalSize(S);
+
+    preparePhasePlane(frame, ws.padded, ws.window, window, P);
+    cv::dft(ws.padded, ws.spectrum, cv::DFT_COMPLEX_OUTPUT, S.height);
+    cv::Mat current = ws.spectrum;
+
+    std::shared_ptr<const FrequencyPlan> ref;
+    if (track) {
+        uint64_t stamp = WarpKeyHasher().add(S).add(P).add(int(window)).value();
+        auto next = std::make_shared<FrequencyPlan>();
+        next->stamp = stamp;
+        next->padSize = P;
+        next->spectrum = current;   // hand the buffer over; the next frame transforms into a fresh one
+        ws.spectrum = cv::Mat();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& slot = _plans["track:" + refId];
+        if (slot && slot->stamp == stamp) ref = slot;
+        slot = next;
+        if (!ref) return result;
+        ++_stats.hits;
+    } else {
+        if (reference.empty() || reference.size() != S) return result;
+        uint64_t stamp = identityStamp(WarpKeyHasher().add(P).add(int(window)).add(generation), reference);
+        ref = acquire("phase:" + refId, stamp, [&] {
+            auto p = std::make_shared<FrequencyPlan>();
+            p->stamp = stamp;
+            p->padSize = P;
+            p->source = reference;
+            cv::Mat padded, win;
+            preparePhasePlane(reference, padded, win, window, P);
+            cv::dft(padded, p->spectrum, cv::DFT_COMPLEX_OUTPUT, S.height);
+            return p;
+        });
+    }
+
+    // Normalised cross-power spectrum: only the phase difference remains,
+    // so its inverse is (ideally) a unit impulse at the translation.
+    cv::mulSpectrums(current, ref->spectrum, ws.cross, 0, true);
+    cv::parallel_for_(cv::Range(0, ws.cross.rows), [&](const cv::Range& r) {
+        for (int y = r.start; y < r.end; ++y) {
+            auto* p = ws.cross.ptr<cv::Vec2f>(y);
+            for (int x = 0; x < ws.cross.cols; ++x) {
+                float m = std::sqrt(p[x][0] * p[x][0] + p[x][1] * p[x][1]);
+                p[x] = m > 1e-7f ? p[x] / m : cv::Vec2f(0.f, 0.f);
+            }
+        }
+    });
+    cv::idft(ws.cross, ws.spatial, cv::DFT_SCALE | cv::DFT_REAL_OUTPUT);
+
+    // Sub-pixel peak: weighted centroid of the positive 5x5 neighbourhood,
+    // wrapping around the periodic borders.
+    cv::Point peak;
+    cv::minMaxLoc(ws.spatial, nullptr, nullptr, nullptr, &peak);
+    double sx = 0.0, sy = 0.0, sw = 0.0;
+    for (int dy = -2; dy <= 2; ++dy) {
+        const int y = (peak.y + dy + P.height) % P.height;
+        const float* row = ws.spatial.ptr<float>(y);
+        for (int dx = -2; dx <= 2; ++dx) {
+            const float v = row[(peak.x + dx + P.width) % P.width];
+            if (v <= 0.f) continue;
+            sx += v * (peak.x + dx);
+            sy += v * (peak.y + dy);
+            sw += v;
+        }
+    }
+    if (sw <= 0.0) return result;
+
+    double cx = sx / sw;
+    double cy = sy / sw;
+    if (cx > P.width / 2.0)  cx -= P.width;
+    if (cy > P.height / 2.0) cy -= P.height;
+    result.shift = cv::Point2d(cx, cy);
+    result.response = std::min(sw, 1.0);
+    result.valid = true;
+    return result;
+}
+
+void FFTEngine::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _plans.clear();
+}
+
+FFTEngine::Stats FFTEngine::stats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Stats s = _stats;
+    s.plans = _plans.size();
+    return s;
+}
+
+} // namespace visionpipe
@@ -0,0 +1,364 @@
+#include "utils/fisheye_views.h"
+
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <sstream>
+
+namespace visionpipe {
+
+namespace {
+
+// Destination tiles of 64 x 32 px: small enough that the source ROI of a
+// tile stays compact even where the dewarp stretches most.
+constexpr int kTileCols = 64;
+constexpr int kTileRows = 32;
+// Tiles are scheduled by source band of this many rows
+constexpr int kSourceBand = 32;
+// Coordinate for pixels outside the lens; far outside any tile ROI
+constexpr float kOutside = -4096.f;
+
+constexpr double kDegToRad = CV_PI / 180.0;
+
+/// Rotation taking a virtual camera's rays into the fisheye camera frame.
+cv::Matx33d viewRotation(const FisheyeLens& lens, double panDeg, double tiltDeg) {
+    const double p = panDeg * kDegToRad, t = tiltDeg * kDegToRad;
+    const double cp = std::cos(p), sp = std::sin(p), ct = std::cos(t), st = std::sin(t);
+    if (lens.mount == FisheyeLens::Mount::CEILING) {
+        // Rz(pan) * Ry(tilt): tilt away from the optical axis, then azimuth
+        const cv::Matx33d rz(cp, -sp, 0, sp, cp, 0, 0, 0, 1);
+        const cv::Matx33d ry(ct, 0, st, 0, 1, 0, -st, 0, ct);
+        return rz * ry;
+    }
+    // Ry(pan) * Rx(tilt): yaw right, pitch up (image y points down)
+    const cv::Matx33d ry(cp, 0, sp, 0, 1, 0, -sp, 0, cp);
+    const cv::Matx33d rx(1, 0, 0, 0, ct, -st, 0, st, ct);
+    return ry * rx;
+}
+
+/// Fisheye image position of a ray, or false outside the lens.
+class LensProjector {
+public:
+    LensProjector(const FisheyeLens& lens, const cv::Size& srcSize)
+        : _lens(lens), _srcSize(srcSize) {
+        _halfFov = 0.5 * lens.fovDeg * kDegToRad;
+        if (lens.model == FisheyeLens::Model::EQUISOLID) {
+            _f = lens.radius / (2.0 * std::sin(0.5 * _halfFov));
+        } else {
+            _f = lens.radius / _halfFov;
+        }
+    }
+
+    bool project(double x, double y, double z, float& u, float& v) const {
+        const double hyp = std::sqrt(x * x + y * y);
+        const double theta = std::atan2(hyp, z);
+        if (theta > _halfFov) return false;
+        const double cphi = hyp > 1e-12 ? x / hyp : 0.0;
+        const double sphi = hyp > 1e-12 ? y / hyp : 0.0;
+
+        double px, py;
+        switch (_lens.model) {
+            case FisheyeLens::Model::KANNALA_BRANDT: {
+                const double t2 = theta * theta;
+                const cv::Vec4d& k = _lens.D;
+                const double td = theta * (1 + t2 * (k[0] + t2 * (k[1] + t2 * (k[2] + t2 * k[3]))));
+                px = _lens.K(0, 0) * td * cphi + _lens.K(0, 2);
+                py = _lens.K(1, 1) * td * sphi + _lens.K(1, 2);
+                break;
+            }
+            case FisheyeLens::Model::EQUISOLID: {
+                const double r = 2.0 * _f * std::sin(0.5 * theta);
+                px = _lens.center.x + r * cphi;
+                py = _lens.center.y + r * sphi;
+                break;
+            }
+            default: {
+                const double r = _f * theta;
+                px = _lens.center.x + r * cphi;
+                py = _lens.center.y + r * sphi;
+                break;
+            }
+        }
+        if (px < -1 || py < -1 || px > _srcSize.width || py > _srcSize.height) return false;
+        u = static_cast<float>(px);
+        v = static_cast<float>(py);
+        return true;
+    }
+
+private:
+    const FisheyeLens& _lens;
+    cv::Size _srcSize;
+    double _halfFov = 0;
+    double _f = 0;
+};
+
+/// Absolute source coordinates (CV_32FC2) of every pixel of @p view.
+cv::Mat buildCoordMap(const FisheyeLens& lens, const cv::Size& srcSize, const FisheyeView& view) {
+    const LensProjector proj(lens, srcSize);
+    const cv::Size size = view.size;
+    cv::Mat xy(size, CV_32FC2);
+
+    const bool ceiling = lens.mount == FisheyeLens::Mount::CEILING;
+    const cv::Matx33d R = viewRotation(lens, view.pan, view.tilt);
+    const double fv = 0.5 * size.width / std::tan(0.5 * std::min(view.fovDeg, 179.0) * kDegToRad);
+    double lonSpan = view.lonSpanDeg, latSpan = view.latSpanDeg;
+    if (lonSpan <= 0) lonSpan = ceiling ? 360.0 : std::min(lens.fovDeg, 360.0);
+    if (latSpan <= 0) latSpan = ceiling ? 0.5 * lens.fovDeg : std::min(lens.fovDeg, 180.0);
+    lonSpan *= kDegToRad;
+    latSpan *= kDegToRad;
+    const double pan = view.pan * kDegToRad;
+    const double rim = 0.5 * lens.fovDeg * kDegToRad;
+
+    cv::parallel_for_(cv::Range(0, size.height), [&](const cv::Range& r) {
+        for (int v = r.start; v < r.end; ++v) {
+            auto* row = xy.ptr<cv::Vec2f>(v);
+            for (int u = 0; u < size.width; ++u) {
+                cv::Vec3d ray;
+                if (view.kind == FisheyeView::Kind::PERSPECTIVE) {
+                    ray = R * cv::Vec3d(u - 0.5 * (size.width - 1), v - 0.5 * (size.height - 1), fv);
+                } else if (ceiling) {
+                    const double lon = pan + lonSpan * (u + 0.5) / size.width;
+                    const double theta = std::max(0.0, rim - latSpan * (v + 0.5) / size.height);
+                    ray = cv::Vec3d(std::sin(theta) * std::cos(lon), std::sin(theta) * std::sin(lon),
+                                    std::cos(theta));
+                } else {
+                    const double lon = pan + lonSpan * ((u + 0.5) / size.width - 0.5);
+                    const double lat = latSpan * (0.5 - (v + 0.5) / size.height);
+                    ray = cv::Vec3d(std::cos(lat) * std::sin(lon), -std::sin(lat),
+                                    std::cos(lat) * std::cos(lon));
+                }
+                float px, py;
+                if (proj.project(ray[0], ray[1], ray[2], px, py)) row[u] = cv::Vec2f(px, py);
+                else row[u] = cv::Vec2f(kOutside, kOutside);
+            }
+        }
+    });
+    return xy;
+}
+
+bool parseSize(const std::string& s, cv::Size& size) {
+    int w = 0, h = 0;
+    char x = 0;
+    std::istringstream is(s);
+    if (!(is >> w >> x >> h) || (x != 'x' && x != 'X') || w <= 0 || h <= 0) return false;
+    size = cv::Size(w, h);
+    return true;
+}
+
+std::string trim(const std::string& s) {
+    const size_t b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos) return "";
+    return s.substr(b, s.find_last_not_of(" \t\r\n") - b + 1);
+}
+
+} // namespace
+
+// ============================================================================
+// Lens / view comparison and parsing
+// ============================================================================
+
+bool FisheyeLens::operator==(const FisheyeLens& o) const {
+    return model == o.model && mount == o.mount && fovDeg == o.fovDeg && center == o.center &&
+           radius == o.radius && K == o.K && D == o.D;
+}
+
+bool FisheyeView::operator==(const FisheyeView& o) const {
+    return kind == o.kind && size == o.size && pan == o.pan && tilt == o.tilt &&
+           fovDeg == o.fovDeg && lonSpanDeg == o.lonSpanDeg && latSpanDeg == o.latSpanDeg;
+}
+
+bool parseFisheyeViews(const std::string& spec, std::vector<FisheyeView>& views, std::string& error) {
+    views.clear();
+    std::istringstream all(spec);
+    std::string entry;
+    while (std::getline(all, entry, ';')) {
+        entry = trim(entry);
+        if (entry.empty()) continue;
+
+        const size_t colon = entry.find(':');
+        const std::string kind = trim(entry.substr(0, colon));
+        std::vector<std::string> fields;
+        if (colon != std::string::npos) {
+            std::istringstream fs(entry.substr(colon + 1));
+            std::string f;
+            while (std::getline(fs, f, ',')) fields.push_back(trim(f));
+        }
+
+        FisheyeView view;
+        try {
+            if (kind == "ptz") {
+                if (fields.size() != 4 || !parseSize(fields[3], view.size)) {
+                    error = "expected ptz:pan,tilt,fov,WxH in '" + entry + "'";
+                    return false;
+                }
+                view.kind = FisheyeView::Kind::PERSPECTIVE;
+                view.pan = std::stod(fields[0]);
+                view.tilt = std::stod(fields[1]);
+                view.fovDeg = std::stod(fields[2]);
+                if (view.fovDeg <= 0 || view.fovDeg >= 180) {
+                    error = "ptz field of view must be in (0, 180) in '" + entry + "'";
+                    return false;
+                }
+            } else if (kind == "equirect") {
+                if (fields.empty() || fields.size() > 4 || !parseSize(fields[0], view.size)) {
+                    error = "expected equirect:WxH[,lon[,lat[,pan]]] in '" + entry + "'";
+                    return false;
+                }
+                view.kind = FisheyeView::Kind::EQUIRECT;
+                if (fields.size() > 1) view.lonSpanDeg = std::stod(fields[1]);
+                if (fields.size() > 2) view.latSpanDeg = std::stod(fields[2]);
+                if (fields.size() > 3) view.pan = std::stod(fields[3]);
+            } else {
+                error = "unknown view kind '" + kind + "' (ptz, equirect)";
+                return false;
+            }
+        } catch (const std::exception&) {
+            error = "invalid number in '" + entry + "'";
+            return false;
+        }
+        views.push_back(view);
+    }
+    if (views.empty()) {
+        error = "no views given";
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// FisheyeViewSet
+// ============================================================================
+
+void FisheyeViewSet::buildPlan(Plan& plan) const {
+    const cv::Mat xy = buildCoordMap(_lens, _srcSize, plan.view);
+    const cv::Size size = plan.view.size;
+    const bool nearest = _interpolation == cv::INTER_NEAREST;
+    // Extra source pixels the interpolation kernel reads around floor(x)
+    const int before = (_interpolation == cv::INTER_CUBIC) ? 1 : (_interpolation == cv::INTER_LANCZOS4 ? 3 : 0);
+    const int after  = (_interpolation == cv::INTER_CUBIC) ? 2 : (_interpolation == cv::INTER_LANCZOS4 ? 4 : 1);
+
+    const int tilesX = (size.width + kTileCols - 1) / kTileCols;
+    const int tilesY = (size.height + kTileRows - 1) / kTileRows;
+    plan.tiles.assign(static_cast<size_t>(tilesX) * tilesY, Tile{});
+
+    cv::parallel_for_(cv::Range(0, tilesX * tilesY), [&](const cv::Range& r) {
+        for (int t = r.start; t < r.end; ++t) {
+            Tile& tile = plan.tiles[t];
+            const int tx = t % tilesX, ty = t / tilesX;
+            tile.dst = cv::Rect(tx * kTileCols, ty * kTileRows,
+                                std::min(kTileCols, size.width - tx * kTileCols),
+                                std::min(kTileRows, size.height - ty * kTileRows));
+            const cv::Mat coords = xy(tile.dst);
+
+            // Bounding box of the source pixels this tile reads
+            int x0 = INT_MAX, y0 = INT_MAX, x1 = INT_MIN, y1 = INT_MIN;
+            for (int y = 0; y < coords.rows; ++y) {
+                const auto* row = coords.ptr<cv::Vec2f>(y);
+                for (int x = 0; x < coords.cols; ++x) {
+                    if (row[x][0] == kOutside) continue;
+                    const int fx = cvFloor(row[x][0]), fy = cvFloor(row[x][1]);
+                    x0 = std::min(x0, fx - before); x1 = std::max(x1, fx + after);
+                    y0 = std::min(y0, fy - before); y1 = std::max(y1, fy + after);
+                }
+            }
+            if (x0 > x1) continue;  // entirely outside the lens
+
+            tile.src = cv::Rect(cv::Point(x0, y0), cv::Point(x1 + 1, y1 + 1)) &
+                       cv::Rect(0, 0, _srcSize.width, _srcSize.height);
+            if (tile.src.empty()) continue;
+
+            cv::Mat local(coords.size(), CV_32FC2);
+            const cv::Vec2f origin(static_cast<float>(tile.src.x), static_cast<float>(tile.src.y));
+            for (int y = 0; y < coords.rows; ++y) {
+                const auto* in = coords.ptr<cv::Vec2f>(y);
+                auto* out = local.ptr<cv::Vec2f>(y);
+                for (int x = 0; x < coords.cols; ++x) {
+                    out[x] = in[x][0] == kOutside ? in[x] : in[x] - origin;
+                }
+            }
+            cv::convertMaps(local, cv::noArray(), tile.map1, tile.map2, CV_16SC2, nearest);
+        }
+    });
+}
+
+void FisheyeViewSet::buildSchedule() {
+    _schedule.clear();
+    for (size_t p = 0; p < _plans.size(); ++p) {
+        for (size_t t = 0; t < _plans[p].tiles.size(); ++t) {
+            _schedule.emplace_back(static_cast<int>(p), static_cast<int>(t));
+        }
+    }
+    // Tiles outside the lens first (they only fill), then by source band and
+    // column, so tiles of different views reading the same rows run together.
+    auto key = [&](const std::pair<int, int>& e) {
+        const cv::Rect& s = _plans[e.first].tiles[e.second].src;
+        if (s.empty()) return std::make_pair(-1, 0);
+        return std::make_pair((s.y + s.height / 2) / kSourceBand, s.x + s.width / 2);
+    };
+    std::stable_sort(_schedule.begin(), _schedule.end(),
+                     [&](const std::pair<int, int>& a, const std::pair<int, int>& b) { return key(a) < key(b); });
+}
+
+size_t FisheyeViewSet::configure(const FisheyeLens& lens, const cv::Size& srcSize,
+                                 const std::vector<FisheyeView>& views, int interpolation) {
+    const bool all = lens != _lens || srcSize != _srcSize || interpolation != _interpolation;
+    _lens = lens;
+    _srcSize = srcSize;
+    _interpolation = interpolation;
+
+    bool changed = _plans.size() != views.size();
+    if (_plans.size() > views.size()) _plans.resize(views.size());
+
+    size_t rebuilt = 0;
+    for (size_t i = 0; i < views.size(); ++i) {
+        if (i == _plans.size()) _plans.emplace_back();
+        else if (!all && _plans[i].view == views[i]) continue;
+        _plans[i].view = views[i];
+        buildPlan(_plans[i]);
+        ++rebuilt;
+    }
+    if (changed || rebuilt) buildSchedule();
+    _lastRebuilt = rebuilt;
+    return rebuilt;
+}
+
+void FisheyeViewSet::render(const cv::Mat& src, std::vector<cv::Mat>& dst,
+                            const cv::Scalar& borderValue) const {
+    CV_Assert(src.size() == _srcSize);
+    dst.resize(_plans.size());
+    for (size_t p = 0; p < _plans.size(); ++p) {
+        // Outputs must not alias the source (e.g. a view reused as input)
+        if (dst[p].data && dst[p].data == src.data) dst[p] = cv::Mat();
+        dst[p].create(_plans[p].view.size, src.type());
+    }
+
+    cv::parallel_for_(cv::Range(0, static_cast<int>(_schedule.size())), [&](const cv::Range& r) {
+        for (int i = r.start; i < r.end; ++i) {
+            const Tile& tile = _plans[_schedule[i].first].tiles[_schedule[i].second];
+            cv::Mat out = dst[_schedule[i].first](tile.dst);
+            if (tile.src.empty()) {
+                out.setTo(borderValue);
+                continue;
+            }
+            // Nested parallel_for_ inside remap runs serially
+            cv::remap(src(tile.src), out, tile.map1, tile.map2, _interpolation,
+                      cv::BORDER_CONSTANT, borderValue);
+        }
+    });
+}
+
+FisheyeViewSet::Stats FisheyeViewSet::stats() const {
+    Stats s;
+    s.views = _plans.size();
+    s.rebuilt = _lastRebuilt;
+    for (const Plan& p : _plans) {
+        s.tiles += p.tiles.size();
+        for (const Tile& t : p.tiles) {
+            s.mapBytes += t.map1.total() * t.map1.elemSize() + t.map2.total() * t.map2.elemSize();
+        }
+    }
+    return s;
+}
+
+} // namespace visionpipe
@@ -0,0 +1,146 @@
+#include "utils/frame_arena.h"
+#include "utils/default_allocator_hook.h"
+
+namespace visionpipe {
+
+// ============================================================================
+// FrameArena
+// ============================================================================
+
+FrameArena::FrameArena(std::vector<Slot> slots, size_t bytes)
+    : _slots(std::move(slots)),
+      _overlaps(_slots.size()),
+      _live(new std::atomic<int>[_slots.size()]),
+      _bytes(bytes) {
+    for (size_t i = 0; i < _slots.size(); ++i) {
+        _live[i].store(0, std::memory_order_relaxed);
+        const size_t begin = _slots[i].offset;
+        const size_t end   = begin + _slots[i].bytes();
+        for (size_t j = 0; j < _slots.size(); ++j) {
+            if (j == i) continue;
+            const size_t b = _slots[j].offset;
+            const size_t e = b + _slots[j].bytes();
+            if (begin < e && b < end) _overlaps[i].push_back(j);
+        }
+    }
+    if (_bytes > 0) _data = static_cast<uint8_t*>(cv::fastMalloc(_bytes));
+}
+
+FrameArena::~FrameArena() {
+    if (_data) cv::fastFree(_data);
+}
+
+bool FrameArena::available(size_t slot) const {
+    if (slot >= _slots.size() || _live[slot].load(std::memory_order_acquire) > 0) return false;
+    for (size_t j : _overlaps[slot]) {
+        if (_live[j].load(std::memory_order_acquire) > 0) return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Output placement (FrameArenaScope)
+// ============================================================================
+
+namespace {
+
+/// Armed by FrameArenaScope; consumed by the first matching allocation.
+struct ArenaOutputHint {
+    bool   active = false;
+    size_t slot   = 0;
+    int    rows   = 0;
+    int    cols   = 0;
+    int    type   = -1;
+    std::shared_ptr<FrameArena> arena;
+};
+
+thread_local ArenaOutputHint t_arenaHint;
+
+/// UMatData::userdata of a Mat placed in an arena.
+struct ArenaPlacement {
+    std::shared_ptr<FrameArena> arena;
+    size_t slot;
+};
+
+/**
+ * Default-allocator wrapper.  Serves the allocation armed on the calling
+ * thread from the arena and forwards everything else untouched.  Installed
+ * only while a FrameArenaScope is armed.
+ */
+class FrameArenaAllocator : public cv::MatAllocator {
+public:
+    FrameArenaAllocator() : hook(this) {}
+
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data0, size_t* step,
+                           cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const override {
+        ArenaOutputHint& h = t_arenaHint;
+        if (!h.active || data0 || dims != 2 || sizes[0] != h.rows || sizes[1] != h.cols ||
+            type != h.type) {
+            return hook.fallback()->allocate(dims, sizes, type, data0, step, flags, usageFlags);
+        }
+        h.active = false;
+
+        const size_t esz = CV_ELEM_SIZE(type);
+        step[1] = esz;
+        step[0] = esz * static_cast<size_t>(sizes[1]);
+
+        auto* u = new cv::UMatData(this);
+        u->data = u->origdata = h.arena->slotData(h.slot);
+        u->size = step[0] * static_cast<size_t>(sizes[0]);
+        h.arena->retain(h.slot);
+        h.arena->countPlacement();
+        u->userdata = new ArenaPlacement{h.arena, h.slot};
+        return u;
+    }
+
+    bool allocate(cv::UMatData* u, cv::AccessFlag, cv::UMatUsageFlags) const override {
+        return u != nullptr;
+    }
+
+    void deallocate(cv::UMatData* u) const override {
+        if (!u) return;
+        auto* p = static_cast<ArenaPlacement*>(u->userdata);
+        if (p) {
+            p->arena->release(p->slot);
+            delete p;
+        }
+        delete u;
+    }
+
+    mutable DefaultAllocatorHook hook;
+};
+
+FrameArenaAllocator& arenaAllocator() {
+    static FrameArenaAllocator allocator;
+    return allocator;
+}
+
+} // namespace
+
+FrameArenaScope::FrameArenaScope(const std::shared_ptr<FrameArena>& arena, size_t slot) {
+    ArenaOutputHint& h = t_arenaHint;
+    if (h.active || !arena) return;   // an enclosing scope owns this thread's hint
+    if (!arena->available(slot)) {
+        arena->countFallback();
+        return;
+    }
+
+    arenaAllocator().hook.acquire();
+    const FrameArena::Slot& s = arena->slots()[slot];
+    h.active = true;
+    h.slot   = slot;
+    h.rows   = s.rows;
+    h.cols   = s.cols;
+    h.type   = s.type;
+    h.arena  = arena;
+    _armed   = true;
+}
+
+FrameArenaScope::~FrameArenaScope() {
+    if (!_armed) return;
+    t_arenaHint.active = false;
+    t_arenaHint.arena.reset();
+    arenaAllocator().hook.release();
+}
+
+} // namespace visionpipe
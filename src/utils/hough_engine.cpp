@@ -0,0 +1,170 @@
+#include "utils/hough_engine.h"
+
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace visionpipe {
+
+// ============================================================================
+// GradientStore
+// ============================================================================
+
+GradientStore& GradientStore::instance() {
+    static GradientStore inst;
+    return inst;
+}
+
+void GradientStore::publish(const cv::Mat& edges, const cv::Mat& dx, const cv::Mat& dy) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.erase(std::remove_if(_entries.begin(), _entries.end(),
+                                  [&](const Entry& e) { return e.edges.data == edges.data; }),
+                   _entries.end());
+    _entries.push_front({edges, dx, dy});
+    while (_entries.size() > kCapacity) _entries.pop_back();
+}
+
+bool GradientStore::lookup(const cv::Mat& edges, cv::Mat& dx, cv::Mat& dy) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const Entry& e : _entries) {
+        if (e.edges.data == edges.data && e.edges.size() == edges.size() &&
+            e.edges.step[0] == edges.step[0]) {
+            dx = e.dx;
+            dy = e.dy;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================================
+// HoughEngine
+// ============================================================================
+
+void HoughEngine::prepare(const HoughLineConfig& cfg, const cv::Size& size) {
+    if (_prepared && cfg == _cfg && size == _size) return;
+    _cfg = cfg;
+    _size = size;
+    _prepared = true;
+
+    // Bin layout as in cv::HoughLines, so results are directly comparable.
+    _numAngle = cvFloor((cfg.maxTheta - cfg.minTheta) / cfg.thetaStep) + 1;
+    if (_numAngle > 1 && std::fabs(CV_PI - (_numAngle - 1) * cfg.thetaStep) < cfg.thetaStep / 2) {
+        --_numAngle;
+    }
+    _numRho = cvRound(((size.width + size.height) * 2 + 1) / cfg.rho);
+
+    _cos.resize(_numAngle);
+    _sin.resize(_numAngle);
+    for (int n = 0; n < _numAngle; ++n) {
+        const double ang = cfg.minTheta + n * cfg.thetaStep;
+        _cos[n] = static_cast<float>(std::cos(ang) / cfg.rho);
+        _sin[n] = static_cast<float>(std::sin(ang) / cfg.rho);
+    }
+    _partials.clear();
+}
+
+std::vector<HoughLine> HoughEngine::detectLines(const cv::Mat& edges, const cv::Mat& dx, const cv::Mat& dy,
+                                                const HoughLineConfig& cfg, cv::Rect roi,
+                                                int threshold, int maxLines) {
+    CV_Assert(edges.type() == CV_8UC1);
+    std::lock_guard<std::mutex> lock(_mutex);
+    prepare(cfg, edges.size());
+
+    std::vector<HoughLine> lines;
+    roi &= cv::Rect(0, 0, edges.cols, edges.rows);
+    if (roi.empty() || _numAngle <= 0) return lines;
+
+    const bool gated = cfg.angleWindow > 0 && dx.type() == CV_16SC1 && dy.type() == CV_16SC1 &&
+                       dx.size() == edges.size() && dy.size() == edges.size();
+
+    // ---- Edge points (and orientations) inside the ROI -------------------
+    _points.clear();
+    _orientation.clear();
+    for (int y = roi.y; y < roi.y + roi.height; ++y) {
+        const uchar* e = edges.ptr<uchar>(y);
+        const short* gx = gated ? dx.ptr<short>(y) : nullptr;
+        const short* gy = gated ? dy.ptr<short>(y) : nullptr;
+        for (int x = roi.x; x < roi.x + roi.width; ++x) {
+            if (!e[x]) continue;
+            _points.emplace_back(x, y);
+            if (gated) {
+                // The gradient is the line normal, i.e. the Hough theta (mod pi).
+                float a = cv::fastAtan2(gy[x], gx[x]) * static_cast<float>(CV_PI / 180.0);
+                if (a >= CV_PI) a -= static_cast<float>(CV_PI);
+                _orientation.push_back(a);
+            }
+        }
+    }
+    if (_points.empty()) return lines;
+
+    // ---- Vote: one accumulator per chunk of points -----------------------
+    constexpr int kMaxChunks = 8;
+    const int chunks = std::clamp(static_cast<int>(_points.size() / 4096), 1,
+                                  std::min(kMaxChunks, std::max(1, cv::getNumThreads())));
+    _partials.resize(chunks);
+    const int stride = _numRho + 2;
+    const int half = (_numRho - 1) / 2;
+    const int window = gated ? static_cast<int>(std::ceil(cfg.angleWindow / cfg.thetaStep)) : 0;
+    const size_t total = _points.size();
+
+    cv::parallel_for_(cv::Range(0, chunks), [&](const cv::Range& r) {
+        for (int k = r.start; k < r.end; ++k) {
+            cv::Mat& acc = _partials[k];
+            acc.create(_numAngle + 2, stride, CV_32SC1);
+            acc.setTo(0);
+            int* a = acc.ptr<int>();
+            const size_t begin = total * k / chunks;
+            const size_t end = total * (k + 1) / chunks;
+            for (size_t i = begin; i < end; ++i) {
+                const float x = static_cast<float>(_points[i].x);
+                const float y = static_cast<float>(_points[i].y);
+                if (!gated) {
+                    for (int n = 0; n < _numAngle; ++n) {
+                        const int rr = cvRound(x * _cos[n] + y * _sin[n]) + half;
+                        ++a[(n + 1) * stride + rr + 1];
+                    }
+                    continue;
+                }
+                for (int j = -window; j <= window; ++j) {
+                    double th = _orientation[i] + j * cfg.thetaStep;
+                    if (th < 0) th += CV_PI;
+                    else if (th >= CV_PI) th -= CV_PI;
+                    const int n = cvRound((th - cfg.minTheta) / cfg.thetaStep);
+                    if (n < 0 || n >= _numAngle) continue;
+                    const int rr = cvRound(x * _cos[n] + y * _sin[n]) + half;
+                    ++a[(n + 1) * stride + rr + 1];
+                }
+            }
+        }
+    });
+
+    const cv::Mat* accPtr = &_partials[0];
+    if (chunks > 1) {
+        cv::add(_partials[0], _partials[1], _acc);
+        for (int k = 2; k < chunks; ++k) cv::add(_acc, _partials[k], _acc);
+        accPtr = &_acc;
+    }
+    const cv::Mat& acc = *accPtr;
+
+    // ---- Local maxima above threshold (cv::HoughLines rule) --------------
+    for (int n = 0; n < _numAngle; ++n) {
+        const int* prev = acc.ptr<int>(n);
+        const int* row  = acc.ptr<int>(n + 1);
+        const int* next = acc.ptr<int>(n + 2);
+        for (int rr = 0; rr < _numRho; ++rr) {
+            const int b = rr + 1;
+            const int v = row[b];
+            if (v > threshold && v > row[b - 1] && v >= row[b + 1] && v > prev[b] && v >= next[b]) {
+                lines.push_back({static_cast<float>((rr - half) * cfg.rho),
+                                 static_cast<float>(cfg.minTheta + n * cfg.thetaStep), v});
+            }
+        }
+    }
+    std::stable_sort(lines.begin(), lines.end(),
+                     [](const HoughLine& l, const HoughLine& r) { return l.votes > r.votes; });
+    if (maxLines > 0 && static_cast<int>(lines.size()) > maxLines) lines.resize(maxLines);
+    return lines;
+}
+
+} // namespace visionpipe
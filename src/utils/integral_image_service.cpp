@@ -0,0 +1,274 @@
+#include "utils/integral_image_service.h"
+
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <climits>
+
+namespace visionpipe {
+
+namespace {
+
+/// cv::integral split into row strips: each strip is integrated on its own,
+/// then shifted by the running total of the strips above it.
+void parallelIntegral(const cv::Mat& src, cv::Mat& sum, cv::Mat* sqsum, int sdepth) {
+    const int strips = std::clamp(cv::getNumThreads(), 1, std::max(1, src.rows / 64));
+    if (strips == 1) {
+        if (sqsum) cv::integral(src, sum, *sqsum, sdepth, CV_64F);
+        else       cv::integral(src, sum, sdepth);
+        return;
+    }
+
+    const int cn = src.channels();
+    std::vector<int> bounds(strips + 1);
+    for (int k = 0; k <= strips; ++k) bounds[k] = src.rows * k / strips;
+
+    std::vector<cv::Mat> partSum(strips), partSq(strips);
+    cv::parallel_for_(cv::Range(0, strips), [&](const cv::Range& r) {
+        for (int k = r.start; k < r.end; ++k) {
+            cv::Mat band = src.rowRange(bounds[k], bounds[k + 1]);
+            if (sqsum) cv::integral(band, partSum[k], partSq[k], sdepth, CV_64F);
+            else       cv::integral(band, partSum[k], sdepth);
+        }
+    });
+
+    // Carry row for strip k = bottom row of the integral over strips < k.
+    std::vector<cv::Mat> carrySum(strips), carrySq(strips);
+    carrySum[0] = cv::Mat::zeros(1, src.cols + 1, CV_MAKETYPE(sdepth, cn));
+    if (sqsum) carrySq[0] = cv::Mat::zeros(1, src.cols + 1, CV_MAKETYPE(CV_64F, cn));
+    for (int k = 1; k < strips; ++k) {
+        cv::add(carrySum[k - 1], partSum[k - 1].row(partSum[k - 1].rows - 1), carrySum[k]);
+        if (sqsum) cv::add(carrySq[k - 1], partSq[k - 1].row(partSq[k - 1].rows - 1), carrySq[k]);
+    }
+
+    sum.create(src.rows + 1, src.cols + 1, CV_MAKETYPE(sdepth, cn));
+    sum.row(0).setTo(0);
+    if (sqsum) {
+        sqsum->create(src.rows + 1, src.cols + 1, CV_MAKETYPE(CV_64F, cn));
+        sqsum->row(0).setTo(0);
+    }
+    cv::parallel_for_(cv::Range(0, strips), [&](const cv::Range& r) {
+        for (int k = r.start; k < r.end; ++k) {
+            for (int i = 1; i < partSum[k].rows; ++i) {
+                cv::Mat dst = sum.row(bounds[k] + i);
+                cv::add(partSum[k].row(i), carrySum[k], dst);
+                if (sqsum) {
+                    cv::Mat dsq = sqsum->row(bounds[k] + i);
+                    cv::add(partSq[k].row(i), carrySq[k], dsq);
+                }
+            }
+        }
+    });
+}
+
+template <typename S, typename D>
+void boxFromIntegral(const cv::Mat& sum, cv::Mat& dst, const cv::Size& k, const cv::Point& a,
+                     int margin, double scale) {
+    const int cn = dst.channels();
+    cv::parallel_for_(cv::Range(0, dst.rows), [&](const cv::Range& r) {
+        for (int y = r.start; y < r.end; ++y) {
+            const S* top = sum.ptr<S>(y - a.y + margin);
+            const S* bot = sum.ptr<S>(y - a.y + margin + k.height);
+            D* out = dst.ptr<D>(y);
+            for (int x = 0; x < dst.cols; ++x) {
+                const int l  = (x - a.x + margin) * cn;
+                const int rt = l + k.width * cn;
+                for (int c = 0; c < cn; ++c) {
+                    const double s = static_cast<double>(bot[rt + c] - bot[l + c] - top[rt + c] + top[l + c]);
+                    out[x * cn + c] = cv::saturate_cast<D>(s * scale);
+                }
+            }
+        }
+    });
+}
+
+template <typename S>
+void boxDispatch(const cv::Mat& sum, cv::Mat& dst, const cv::Size& k, const cv::Point& a,
+                 int margin, double scale) {
+    switch (dst.depth()) {
+        case CV_8U:  boxFromIntegral<S, uchar>(sum, dst, k, a, margin, scale); break;
+        case CV_16U: boxFromIntegral<S, ushort>(sum, dst, k, a, margin, scale); break;
+        case CV_16S: boxFromIntegral<S, short>(sum, dst, k, a, margin, scale); break;
+        case CV_32F: boxFromIntegral<S, float>(sum, dst, k, a, margin, scale); break;
+        case CV_64F: boxFromIntegral<S, double>(sum, dst, k, a, margin, scale); break;
+        default:
+            CV_Error(cv::Error::StsUnsupportedFormat, "IntegralImage::boxFilter: unsupported output depth");
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// IntegralImage
+// ============================================================================
+
+double IntegralImage::planeSum(const cv::Mat& plane, const cv::Rect& window, int ch) const {
+    cv::Rect w = window & cv::Rect(0, 0, _source.cols, _source.rows);
+    if (w.empty() || plane.empty()) return 0.0;
+    const int cn = plane.channels();
+    const int x0 = (w.x + _margin) * cn + ch;
+    const int x1 = (w.x + w.width + _margin) * cn + ch;
+    const int y0 = w.y + _margin;
+    const int y1 = w.y + w.height + _margin;
+    if (plane.depth() == CV_32S) {
+        const int* t = plane.ptr<int>(y0);
+        const int* b = plane.ptr<int>(y1);
+        return static_cast<double>(b[x1] - b[x0] - t[x1] + t[x0]);
+    }
+    const double* t = plane.ptr<double>(y0);
+    const double* b = plane.ptr<double>(y1);
+    return b[x1] - b[x0] - t[x1] + t[x0];
+}
+
+double IntegralImage::windowSum(const cv::Rect& window, int ch) const {
+    return planeSum(_sum, window, ch);
+}
+
+double IntegralImage::windowSqSum(const cv::Rect& window, int ch) const {
+    return planeSum(_sqsum, window, ch);
+}
+
+double IntegralImage::windowMean(const cv::Rect& window, int ch) const {
+    const double n = (window & cv::Rect(0, 0, _source.cols, _source.rows)).area();
+    return n > 0 ? windowSum(window, ch) / n : 0.0;
+}
+
+double IntegralImage::windowVariance(const cv::Rect& window, int ch) const {
+    const double n = (window & cv::Rect(0, 0, _source.cols, _source.rows)).area();
+    if (n <= 0) return 0.0;
+    const double mean = windowSum(window, ch) / n;
+    return std::max(0.0, windowSqSum(window, ch) / n - mean * mean);
+}
+
+void IntegralImage::boxFilter(cv::Mat& dst, const cv::Size& ksize, cv::Point anchor,
+                              bool normalize, int ddepth) const {
+    CV_Assert(!_sum.empty() && _margin >= IntegralImageService::marginFor(ksize, anchor));
+    if (anchor.x < 0) anchor.x = ksize.width / 2;
+    if (anchor.y < 0) anchor.y = ksize.height / 2;
+    const int depth = ddepth < 0 ? _source.depth() : ddepth;
+    dst.create(_source.size(), CV_MAKETYPE(depth, _source.channels()));
+    const double scale = normalize ? 1.0 / ksize.area() : 1.0;
+    if (_sum.depth() == CV_32S) boxDispatch<int>(_sum, dst, ksize, anchor, _margin, scale);
+    else                        boxDispatch<double>(_sum, dst, ksize, anchor, _margin, scale);
+}
+
+// ============================================================================
+// IntegralImageService
+// ============================================================================
+
+IntegralImageService& IntegralImageService::instance() {
+    static IntegralImageService inst;
+    return inst;
+}
+
+int IntegralImageService::marginFor(const cv::Size& ksize, cv::Point anchor) {
+    const int ax = anchor.x < 0 ? ksize.width / 2 : anchor.x;
+    const int ay = anchor.y < 0 ? ksize.height / 2 : anchor.y;
+    return std::max({ax, ksize.width - 1 - ax, ay, ksize.height - 1 - ay, 0});
+}
+
+IntegralImageService::Slot* IntegralImageService::find(const cv::Mat& frame, uint64_t generation,
+                                                       int border) {
+    for (Slot& s : _slots) {
+        if (s.data == frame.data && s.generation == generation && s.size == frame.size() &&
+            s.type == frame.type() && s.step == frame.step[0] && s.border == border) {
+            s.lastUse.store(++_clock, std::memory_order_relaxed);
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+IntegralImageService::Slot& IntegralImageService::insert(const cv::Mat& frame, uint64_t generation,
+                                                         int border) {
+    if (Slot* s = find(frame, generation, border)) return *s;
+    if (_slots.size() >= kCapacity) {
+        auto oldest = std::min_element(_slots.begin(), _slots.end(), [](const Slot& a, const Slot& b) {
+            return a.lastUse.load(std::memory_order_relaxed) < b.lastUse.load(std::memory_order_relaxed);
+        });
+        _slots.erase(oldest);
+    }
+    Slot& s = _slots.emplace_back();
+    s.data = frame.data;
+    s.size = frame.size();
+    s.type = frame.type();
+    s.step = frame.step[0];
+    s.generation = generation;
+    s.border = border;
+    s.source = frame;
+    s.lastUse.store(++_clock, std::memory_order_relaxed);
+    return s;
+}
+
+bool IntegralImageService::shouldRoute(const cv::Mat& frame, uint64_t generation, int border) {
+    if (generation == 0 || frame.empty() || frame.dims != 2 || std::min(frame.rows, frame.cols) < 2) {
+        return false;
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        if (Slot* s = find(frame, generation, border)) {
+            const int seen = s->consumers.fetch_add(1, std::memory_order_relaxed);
+            return s->image != nullptr || seen > 0;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    Slot& s = insert(frame, generation, border);
+    const int seen = s.consumers.fetch_add(1, std::memory_order_relaxed);
+    return s.image != nullptr || seen > 0;
+}
+
+std::shared_ptr<const IntegralImage> IntegralImageService::acquire(const cv::Mat& frame, uint64_t generation,
+                                                                   int planes, int margin, int border) {
+    if (frame.empty() || frame.dims != 2) return nullptr;
+    planes |= IntegralImage::SUM;
+    // Round the padding up so neighbouring kernel sizes share one entry.
+    if (margin > 0) margin = (margin + 7) & ~7;
+
+    std::shared_ptr<const IntegralImage> previous;
+    if (generation != 0) {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        if (Slot* s = find(frame, generation, border)) {
+            if (s->image && (s->image->_planes & planes) == planes && s->image->_margin >= margin) {
+                return s->image;
+            }
+            previous = s->image;
+        }
+    }
+    // Entries only grow: a rebuild keeps everything the previous one served.
+    if (previous) {
+        planes |= previous->_planes;
+        margin = std::max(margin, previous->_margin);
+    }
+
+    auto img = std::make_shared<IntegralImage>();
+    img->_source = frame;
+    img->_border = border;
+    img->_margin = margin;
+    img->_planes = planes;
+
+    cv::Mat padded = frame;
+    if (margin > 0) cv::copyMakeBorder(frame, padded, margin, margin, margin, margin, border);
+    const bool narrow = frame.depth() == CV_8U &&
+                        static_cast<double>(padded.total()) * 255.0 < static_cast<double>(INT_MAX);
+    const int sdepth = narrow ? CV_32S : CV_64F;
+
+    if (planes & IntegralImage::TILTED) {
+        img->_planes |= IntegralImage::SQSUM;
+        cv::integral(padded, img->_sum, img->_sqsum, img->_tilted, sdepth, CV_64F);
+    } else {
+        parallelIntegral(padded, img->_sum, (planes & IntegralImage::SQSUM) ? &img->_sqsum : nullptr,
+                         sdepth);
+    }
+
+    if (generation != 0) {
+        std::unique_lock<std::shared_mutex> lock(_mutex);
+        insert(frame, generation, border).image = img;
+    }
+    return img;
+}
+
+void IntegralImageService::clear() {
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    _slots.clear();
+}
+
+} // namespace visionpipe
@@ -0,0 +1,135 @@
+#include "utils/mjpeg_decoder.h"
+
+#include <opencv2/imgcodecs.hpp>
+#include <algorithm>
+#include <chrono>
+
+namespace visionpipe {
+
+// ============================================================================
+// Decode
+// ============================================================================
+
+int mjpegDecodeScale(int scale) {
+    if (scale >= 8) return 8;
+    if (scale >= 4) return 4;
+    if (scale >= 2) return 2;
+    return 1;
+}
+
+cv::Mat decodeMjpeg(const uint8_t* data, size_t size, const MjpegDecodeOptions& opts) {
+    if (!data || size == 0) return cv::Mat();
+
+    // The IMREAD_REDUCED_* flags set libjpeg's scale_denom, so the reduction
+    // happens in the IDCT rather than as a resize after a full decode.
+    int flags;
+    switch (mjpegDecodeScale(opts.scale)) {
+        case 2:  flags = opts.gray ? cv::IMREAD_REDUCED_GRAYSCALE_2 : cv::IMREAD_REDUCED_COLOR_2; break;
+        case 4:  flags = opts.gray ? cv::IMREAD_REDUCED_GRAYSCALE_4 : cv::IMREAD_REDUCED_COLOR_4; break;
+        case 8:  flags = opts.gray ? cv::IMREAD_REDUCED_GRAYSCALE_8 : cv::IMREAD_REDUCED_COLOR_8; break;
+        default: flags = opts.gray ? cv::IMREAD_GRAYSCALE : cv::IMREAD_COLOR; break;
+    }
+
+    // Wrap, don't copy: imdecode reads straight from the capture buffer
+    cv::Mat encoded(1, static_cast<int>(size), CV_8UC1, const_cast<uint8_t*>(data));
+    try {
+        return cv::imdecode(encoded, flags);
+    } catch (const cv::Exception&) {
+        return cv::Mat();
+    }
+}
+
+// ============================================================================
+// MjpegDecoderPool
+// ============================================================================
+
+MjpegDecoderPool::MjpegDecoderPool(int threads, MjpegDecodeOptions opts, size_t capacity)
+    : _opts(opts) {
+    const int n = std::max(1, threads);
+    _opts.scale = mjpegDecodeScale(_opts.scale);
+    _capacity = capacity > 0 ? capacity : static_cast<size_t>(n) * 2;
+    _threads.reserve(n);
+    for (int i = 0; i < n; ++i) _threads.emplace_back(&MjpegDecoderPool::worker, this);
+}
+
+MjpegDecoderPool::~MjpegDecoderPool() {
+    close();
+    {
+        // Nobody will collect what is still queued
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.clear();
+    }
+    for (auto& t : _threads) {
+        if (t.joinable()) t.join();
+    }
+}
+
+bool MjpegDecoderPool::submit(std::vector<uint8_t> jpeg, uint64_t* seq) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _spaceFree.wait(lock, [&] { return _closed || _nextSubmit - _nextOut < _capacity; });
+    if (_closed) return false;
+
+    const uint64_t s = _nextSubmit++;
+    _jobs.push_back({s, std::move(jpeg)});
+    if (seq) *seq = s;
+    lock.unlock();
+    _jobReady.notify_one();
+    return true;
+}
+
+bool MjpegDecoderPool::next(cv::Mat& frame, int timeoutMs, uint64_t* seq) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto ready = [&] {
+        return _done.count(_nextOut) || (_closed && _nextOut == _nextSubmit);
+    };
+    if (timeoutMs < 0) {
+        _frameReady.wait(lock, ready);
+    } else if (!_frameReady.wait_for(lock, std::chrono::milliseconds(timeoutMs), ready)) {
+        return false;
+    }
+
+    auto it = _done.find(_nextOut);
+    if (it == _done.end()) return false;  // closed and drained
+
+    frame = std::move(it->second);
+    if (seq) *seq = _nextOut;
+    _done.erase(it);
+    ++_nextOut;
+    lock.unlock();
+    _spaceFree.notify_one();
+    return true;
+}
+
+void MjpegDecoderPool::close() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _closed = true;
+    }
+    _jobReady.notify_all();
+    _frameReady.notify_all();
+    _spaceFree.notify_all();
+}
+
+void MjpegDecoderPool::worker() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _jobReady.wait(lock, [&] { return _closed || !_jobs.empty(); });
+            if (_jobs.empty()) return;  // closed and nothing left
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+
+        cv::Mat frame = decodeMjpeg(job.data.data(), job.data.size(), _opts);
+        (frame.empty() ? _failed : _decoded).fetch_add(1, std::memory_order_relaxed);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _done.emplace(job.seq, std::move(frame));
+        }
+        _frameReady.notify_all();
+    }
+}
+
+} // namespace visionpipe
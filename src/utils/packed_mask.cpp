@@ -0,0 +1,224 @@
+#include "utils/packed_mask.h"
+
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <atomic>
+
+namespace visionpipe {
+
+// ============================================================================
+// Pack / unpack
+// ============================================================================
+
+bool PackedMask::pack(const cv::Mat& src, PackedMask& dst) {
+    if (src.type() != CV_8UC1 || src.dims != 2) return false;
+
+    dst._rows = src.rows;
+    dst._cols = src.cols;
+    dst._stride = (src.cols + 63) / 64;
+    dst._on = 255;
+    dst._words.assign(static_cast<size_t>(dst._rows) * dst._stride, 0);
+    if (src.empty()) return true;
+
+    // Per-row foreground value (0 = none), reconciled below
+    std::vector<int> rowOn(src.rows, 0);
+    std::atomic<bool> failed(false);
+    cv::parallel_for_(cv::Range(0, src.rows), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end && !failed.load(std::memory_order_relaxed); ++y) {
+            const uchar* p = src.ptr<uchar>(y);
+            uchar m = 0;
+            for (int x = 0; x < src.cols; ++x) m = std::max(m, p[x]);
+            int bad = 0;
+            for (int x = 0; x < src.cols; ++x) bad |= (p[x] != 0) & (p[x] != m);
+            if (bad) {
+                failed = true;
+                return;
+            }
+            rowOn[y] = m;
+
+            uint64_t* w = dst._words.data() + static_cast<size_t>(y) * dst._stride;
+            for (int x0 = 0, i = 0; x0 < src.cols; x0 += 64, ++i) {
+                const int n = std::min(64, src.cols - x0);
+                uint64_t bits = 0;
+                for (int j = 0; j < n; ++j) bits |= static_cast<uint64_t>(p[x0 + j] != 0) << j;
+                w[i] = bits;
+            }
+        }
+    });
+
+    if (failed) return false;
+
+    int on = 0;
+    for (int v : rowOn) {
+        if (v && on && v != on) return false;
+        if (v) on = v;
+    }
+    if (on) dst._on = static_cast<uchar>(on);
+    return true;
+}
+
+void PackedMask::unpack(cv::Mat& dst) const {
+    dst.create(_rows, _cols, CV_8UC1);
+    cv::parallel_for_(cv::Range(0, _rows), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; ++y) {
+            const uint64_t* w = _words.data() + static_cast<size_t>(y) * _stride;
+            uchar* d = dst.ptr<uchar>(y);
+            for (int x0 = 0, i = 0; x0 < _cols; x0 += 64, ++i) {
+                const int n = std::min(64, _cols - x0);
+                const uint64_t bits = w[i];
+                for (int j = 0; j < n; ++j) {
+                    d[x0 + j] = static_cast<uchar>(-static_cast<int>((bits >> j) & 1) & _on);
+                }
+            }
+        }
+    });
+}
+
+// ============================================================================
+// Bitwise
+// ============================================================================
+
+uint64_t PackedMask::tailMask() const {
+    const int r = _cols % 64;
+    return r ? (uint64_t(1) << r) - 1 : ~uint64_t(0);
+}
+
+void PackedMask::andNot(const PackedMask& other) {
+    CV_Assert(other._rows == _rows && other._cols == _cols);
+    const uint64_t* b = other._words.data();
+    uint64_t* a = _words.data();
+    for (size_t i = 0, n = _words.size(); i < n; ++i) a[i] &= ~b[i];
+}
+
+// ============================================================================
+// Morphology
+// ============================================================================
+
+void PackedMask::erode(Shape shape, int iterations) {
+    for (int i = 0; i < iterations; ++i) morph(shape, true);
+}
+
+void PackedMask::dilate(Shape shape, int iterations) {
+    for (int i = 0; i < iterations; ++i) morph(shape, false);
+}
+
+void PackedMask::morph(Shape shape, bool erodeOp) {
+    if (_words.empty()) return;
+
+    // Pixels outside the image: foreground for erosion, background for dilation
+    const uint64_t outside = erodeOp ? ~uint64_t(0) : 0;
+    const uint64_t tail = tailMask();
+    const uint64_t tailFill = erodeOp ? ~tail : 0;
+    const int S = _stride;
+
+    // Row with bits past the last column set to the outside value
+    auto word = [&](const uint64_t* row, int i) {
+        return i == S - 1 ? row[i] | tailFill : row[i];
+    };
+
+    // Horizontal pass: each bit combined with its left and right neighbours
+    std::vector<uint64_t> h(_words.size());
+    cv::parallel_for_(cv::Range(0, _rows), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; ++y) {
+            const uint64_t* row = _words.data() + static_cast<size_t>(y) * S;
+            uint64_t* out = h.data() + static_cast<size_t>(y) * S;
+            uint64_t prev = outside;
+            uint64_t cur = word(row, 0);
+            for (int i = 0; i < S; ++i) {
+                const uint64_t next = i + 1 < S ? word(row, i + 1) : outside;
+                const uint64_t left = (cur << 1) | (prev >> 63);    // pixel x - 1 at bit x
+                const uint64_t right = (cur >> 1) | (next << 63);   // pixel x + 1 at bit x
+                out[i] = erodeOp ? cur & left & right : cur | left | right;
+                prev = cur;
+                cur = next;
+            }
+        }
+    });
+
+    // Vertical pass: RECT combines the horizontal results of three rows,
+    // CROSS the centre row's horizontal result with the raw rows above and below
+    std::vector<uint64_t> result(_words.size());
+    const std::vector<uint64_t>& vsrc = shape == RECT ? h : _words;
+    cv::parallel_for_(cv::Range(0, _rows), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; ++y) {
+            const uint64_t* c = h.data() + static_cast<size_t>(y) * S;
+            const uint64_t* up = y > 0 ? vsrc.data() + static_cast<size_t>(y - 1) * S : nullptr;
+            const uint64_t* dn = y + 1 < _rows ? vsrc.data() + static_cast<size_t>(y + 1) * S : nullptr;
+            uint64_t* out = result.data() + static_cast<size_t>(y) * S;
+            for (int i = 0; i < S; ++i) {
+                const uint64_t u = up ? (shape == RECT ? up[i] : word(up, i)) : outside;
+                const uint64_t d = dn ? (shape == RECT ? dn[i] : word(dn, i)) : outside;
+                out[i] = erodeOp ? c[i] & u & d : c[i] | u | d;
+            }
+            out[S - 1] &= tail;
+        }
+    });
+
+    _words.swap(result);
+}
+
+// ============================================================================
+// Morphology operations
+// ============================================================================
+
+bool packedMorphology(const cv::Mat& input, int op, int ksize, int morphShape,
+                      int iterations, cv::Mat& result) {
+    if (ksize != 3 || (morphShape != cv::MORPH_RECT && morphShape != cv::MORPH_CROSS) ||
+        op == cv::MORPH_HITMISS || input.type() != CV_8UC1) {
+        return false;
+    }
+    const bool compound = op != cv::MORPH_ERODE && op != cv::MORPH_DILATE;
+    if (!compound && iterations < 2) {
+        return false;
+    }
+
+    PackedMask mask;
+    if (!PackedMask::pack(input, mask)) {
+        return false;
+    }
+    const auto shape = morphShape == cv::MORPH_CROSS ? PackedMask::CROSS : PackedMask::RECT;
+
+    switch (op) {
+        case cv::MORPH_ERODE:
+            mask.erode(shape, iterations);
+            break;
+        case cv::MORPH_DILATE:
+            mask.dilate(shape, iterations);
+            break;
+        case cv::MORPH_OPEN:
+        case cv::MORPH_TOPHAT: {
+            PackedMask src = mask;
+            mask.erode(shape, iterations);
+            mask.dilate(shape, iterations);
+            if (op == cv::MORPH_TOPHAT) {
+                src.andNot(mask);
+                mask = src;
+            }
+            break;
+        }
+        case cv::MORPH_CLOSE:
+        case cv::MORPH_BLACKHAT: {
+            PackedMask src = mask;
+            mask.dilate(shape, iterations);
+            mask.erode(shape, iterations);
+            if (op == cv::MORPH_BLACKHAT) {
+                mask.andNot(src);
+            }
+            break;
+        }
+        case cv::MORPH_GRADIENT: {
+            PackedMask eroded = mask;
+            eroded.erode(shape, iterations);
+            mask.dilate(shape, iterations);
+            mask.andNot(eroded);
+            break;
+        }
+        default:
+            return false;
+    }
+
+    mask.unpack(result);
+    return true;
+}
+
+} // namespace visionpipe
@@ -0,0 +1,411 @@
+#include "utils/primitive_rasterizer.h"
+
+#include <opencv2/core/hal/intrin.hpp>
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace visionpipe {
+
+namespace {
+
+constexpr int kTile = 64;
+
+#if CV_SIMD
+inline cv::v_uint8 blendLanes(const cv::v_uint8& d, const cv::v_uint8& a, const cv::v_uint16& c) {
+    const cv::v_uint16 k255 = cv::vx_setall_u16(255);
+    const cv::v_uint16 k128 = cv::vx_setall_u16(128);
+    cv::v_uint16 d0, d1, a0, a1;
+    cv::v_expand(d, d0, d1);
+    cv::v_expand(a, a0, a1);
+    // d * (255 - a) + c * a + 128 <= 65153, so 16-bit lanes do not overflow
+    cv::v_uint16 x0 = cv::v_add_wrap(cv::v_add_wrap(cv::v_mul_wrap(d0, cv::v_sub_wrap(k255, a0)),
+                                                    cv::v_mul_wrap(c, a0)), k128);
+    cv::v_uint16 x1 = cv::v_add_wrap(cv::v_add_wrap(cv::v_mul_wrap(d1, cv::v_sub_wrap(k255, a1)),
+                                                    cv::v_mul_wrap(c, a1)), k128);
+    x0 = cv::v_shr<8>(cv::v_add_wrap(x0, cv::v_shr<8>(x0)));
+    x1 = cv::v_shr<8>(cv::v_add_wrap(x1, cv::v_shr<8>(x1)));
+    return cv::v_pack(x0, x1);
+}
+#endif
+
+inline float clamp01(float v) {
+    return std::min(std::max(v, 0.0f), 1.0f);
+}
+
+/// Coverage 0..1 to an alpha byte.
+inline uchar toAlpha(float cov) {
+    return static_cast<uchar>(static_cast<int>(cov * 255.0f + 0.5f));
+}
+
+} // namespace
+
+void blendCoverageRow(uchar* dst, const uchar* a, int n, int cn, const uchar* color) {
+    int i = 0;
+#if CV_SIMD
+    const int VL = cv::v_uint8::nlanes;
+    if (cn == 3) {
+        const cv::v_uint16 c0 = cv::vx_setall_u16(color[0]);
+        const cv::v_uint16 c1 = cv::vx_setall_u16(color[1]);
+        const cv::v_uint16 c2 = cv::vx_setall_u16(color[2]);
+        for (; i <= n - VL; i += VL) {
+            cv::v_uint8 al = cv::vx_load(a + i);
+            cv::v_uint8 b, g, r;
+            cv::v_load_deinterleave(dst + 3 * i, b, g, r);
+            cv::v_store_interleave(dst + 3 * i, blendLanes(b, al, c0), blendLanes(g, al, c1),
+                                   blendLanes(r, al, c2));
+        }
+    } else if (cn == 1) {
+        const cv::v_uint16 c0 = cv::vx_setall_u16(color[0]);
+        for (; i <= n - VL; i += VL) {
+            cv::v_store(dst + i, blendLanes(cv::vx_load(dst + i), cv::vx_load(a + i), c0));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        const unsigned al = a[i];
+        if (al == 0) continue;
+        uchar* d = dst + i * cn;
+        if (al == 255) {
+            for (int k = 0; k < cn; ++k) d[k] = color[k];
+        } else {
+            for (int k = 0; k < cn; ++k) {
+                d[k] = static_cast<uchar>(div255(d[k] * (255 - al) + color[k] * al));
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Submission
+// ============================================================================
+//
+// Coordinates follow OpenCV: integer positions are pixel centers, so pixel
+// (x, y) covers [x - 0.5, x + 0.5] x [y - 0.5, y + 0.5].  BOX corners are
+// stored as area bounds in that convention.
+
+void PrimitiveBatch::push(Kind kind, const cv::Scalar& color, float x0, float y0, float x1, float y1,
+                          float halfWidth) {
+    Prim p;
+    p.kind = kind;
+    for (int k = 0; k < 4; ++k) p.color[k] = cv::saturate_cast<uchar>(color[k]);
+    p.x0 = x0; p.y0 = y0; p.x1 = x1; p.y1 = y1;
+    p.halfWidth = halfWidth;
+    _prims.push_back(p);
+}
+
+void PrimitiveBatch::line(cv::Point2f a, cv::Point2f b, const cv::Scalar& color, int thickness) {
+    push(LINE, color, a.x, a.y, b.x, b.y, std::max(thickness, 1) * 0.5f);
+}
+
+void PrimitiveBatch::arrow(cv::Point2f a, cv::Point2f b, const cv::Scalar& color, int thickness,
+                           double tipLength) {
+    // Same construction as cv::arrowedLine: two strokes at +-45 degrees
+    const double tipSize = std::hypot(a.x - b.x, a.y - b.y) * tipLength;
+    const double angle = std::atan2(a.y - b.y, a.x - b.x);
+    line(a, b, color, thickness);
+    for (double side : {CV_PI / 4, -CV_PI / 4}) {
+        const cv::Point2f p(static_cast<float>(b.x + tipSize * std::cos(angle + side)),
+                            static_cast<float>(b.y + tipSize * std::sin(angle + side)));
+        line(p, b, color, thickness);
+    }
+}
+
+void PrimitiveBatch::rect(const cv::Rect2f& r, const cv::Scalar& color, int thickness) {
+    // Like cv::rectangle(img, rect, ...): edges run through the centers of
+    // the first and last pixel rows / columns of r
+    const float l = r.x, t = r.y;
+    const float rr = r.x + r.width - 1, b = r.y + r.height - 1;
+    if (thickness < 0) {
+        push(BOX, color, l - 0.5f, t - 0.5f, rr + 0.5f, b + 0.5f, 0);
+        return;
+    }
+    // Outline as four non-overlapping boxes, so corners are blended once;
+    // a stroke at least as wide as the hole covers it
+    const float h = std::max(thickness, 1) * 0.5f;
+    if (b - t <= 2 * h || rr - l <= 2 * h) {
+        push(BOX, color, l - h, t - h, rr + h, b + h, 0);
+        return;
+    }
+    push(BOX, color, l - h, t - h, rr + h, t + h, 0);
+    push(BOX, color, l - h, b - h, rr + h, b + h, 0);
+    push(BOX, color, l - h, t + h, l + h, b - h, 0);
+    push(BOX, color, rr - h, t + h, rr + h, b - h, 0);
+}
+
+void PrimitiveBatch::circle(cv::Point2f center, float radius, const cv::Scalar& color, int thickness) {
+    if (thickness < 0) push(DISC, color, center.x, center.y, radius, 0, 0);
+    else push(RING, color, center.x, center.y, radius, 0, std::max(thickness, 1) * 0.5f);
+}
+
+void PrimitiveBatch::point(cv::Point2f p, const cv::Scalar& color, int size) {
+    const float h = std::max(size, 1) * 0.5f;
+    push(BOX, color, p.x - h, p.y - h, p.x + h, p.y + h, 0);
+}
+
+// ============================================================================
+// Rasterization
+// ============================================================================
+
+struct PrimitiveBatch::Prepared {
+    Kind  kind;
+    uchar color[4];
+    float x0, y0, x1, y1;
+    float reach;       ///< Distance from the shape at which coverage reaches 0
+    float dx, dy;      ///< LINE: direction
+    float invLen2;     ///< LINE: 1 / |d|^2 (0 for a degenerate segment)
+    float nx, ny;      ///< LINE: unit normal
+    cv::Rect bounds;   ///< Clipped to the image
+};
+
+void PrimitiveBatch::rasterize(cv::Mat& img, const Prepared& s, const cv::Rect& clip, uchar* alpha, bool aa) {
+    const int cn = img.channels();
+    const float reach = s.reach;
+
+    for (int y = clip.y; y < clip.y + clip.height; ++y) {
+        const float fy = static_cast<float>(y);
+        int xa = clip.x, xb = clip.x + clip.width;
+        int holeA = xb, holeB = xb;    // RING: [holeA, holeB) has zero coverage
+
+        // Narrow the row to the pixels the shape can reach
+        switch (s.kind) {
+        case LINE:
+            if (std::abs(s.nx) > 1e-6f) {
+                const float off = s.ny * (fy - s.y0);
+                const float ea = s.x0 + (-reach - off) / s.nx;
+                const float eb = s.x0 + (reach - off) / s.nx;
+                // Clamp in float first: near-horizontal lines give huge spans
+                xa = static_cast<int>(std::max(static_cast<float>(xa), std::floor(std::min(ea, eb))));
+                xb = static_cast<int>(std::min(static_cast<float>(xb), std::ceil(std::max(ea, eb)) + 1));
+            } else if (s.invLen2 > 0 && std::abs(fy - s.y0) > reach) {
+                continue;
+            }
+            break;
+        case RING:
+        case DISC: {
+            const float ddy = fy - s.y0;
+            const float outer = s.x1 + reach;
+            if (std::abs(ddy) > outer) continue;
+            const float ox = std::sqrt(outer * outer - ddy * ddy);
+            xa = std::max(xa, static_cast<int>(std::floor(s.x0 - ox)));
+            xb = std::min(xb, static_cast<int>(std::ceil(s.x0 + ox)) + 1);
+            const float inner = s.x1 - reach;
+            if (s.kind == RING && inner > 0 && std::abs(ddy) < inner) {
+                const float ix = std::sqrt(inner * inner - ddy * ddy);
+                holeA = std::max(xa, static_cast<int>(std::floor(s.x0 - ix)) + 1);
+                holeB = std::min(xb, static_cast<int>(std::ceil(s.x0 + ix)));
+                if (holeA >= holeB) holeA = holeB = xb;
+            }
+            break;
+        }
+        case BOX:
+            break;
+        }
+        if (xa >= xb) continue;
+
+        // Coverage of pixels [from, to) of the row, blended as it is computed
+        uchar* row = img.ptr<uchar>(y);
+        auto cover = [&](int from, int to) {
+            uchar* a = alpha + (from - xa);
+            const int n = to - from;
+            switch (s.kind) {
+            case LINE: {
+                const float py = fy - s.y0;
+                for (int i = 0; i < n; ++i) {
+                    const float px = static_cast<float>(from + i) - s.x0;
+                    const float t = clamp01((px * s.dx + py * s.dy) * s.invLen2);
+                    const float ex = px - t * s.dx, ey = py - t * s.dy;
+                    const float d = std::sqrt(ex * ex + ey * ey);
+                    a[i] = aa ? toAlpha(clamp01(reach - d)) : (d < reach ? 255 : 0);
+                }
+                break;
+            }
+            case RING: {
+                const float ddy = fy - s.y0;
+                for (int i = 0; i < n; ++i) {
+                    const float ddx = static_cast<float>(from + i) - s.x0;
+                    const float d = std::abs(std::sqrt(ddx * ddx + ddy * ddy) - s.x1);
+                    a[i] = aa ? toAlpha(clamp01(reach - d)) : (d < reach ? 255 : 0);
+                }
+                break;
+            }
+            case DISC: {
+                const float ddy = fy - s.y0;
+                for (int i = 0; i < n; ++i) {
+                    const float ddx = static_cast<float>(from + i) - s.x0;
+                    const float d = std::sqrt(ddx * ddx + ddy * ddy);
+                    a[i] = aa ? toAlpha(clamp01(s.x1 + 0.5f - d)) : (d <= s.x1 ? 255 : 0);
+                }
+                break;
+            }
+            case BOX:
+                if (aa) {
+                    const float cy = clamp01(std::min(fy + 0.5f, s.y1) - std::max(fy - 0.5f, s.y0));
+                    for (int i = 0; i < n; ++i) {
+                        const float fx = static_cast<float>(from + i);
+                        const float cx = clamp01(std::min(fx + 0.5f, s.x1) - std::max(fx - 0.5f, s.x0));
+                        a[i] = toAlpha(cx * cy);
+                    }
+                } else {
+                    const bool rowIn = fy >= s.y0 && fy < s.y1;
+                    for (int i = 0; i < n; ++i) {
+                        const float fx = static_cast<float>(from + i);
+                        a[i] = (rowIn && fx >= s.x0 && fx < s.x1) ? 255 : 0;
+                    }
+                }
+                break;
+            }
+            blendCoverageRow(row + from * cn, a, n, cn, s.color);
+        };
+
+        if (holeA < holeB) {
+            cover(xa, holeA);
+            cover(holeB, xb);
+        } else {
+            cover(xa, xb);
+        }
+    }
+}
+
+void PrimitiveBatch::render(cv::Mat& img, int lineType) const {
+    if (_prims.empty() || img.empty()) return;
+    const int cn = img.channels();
+    if (img.depth() != CV_8U || (cn != 1 && cn != 3 && cn != 4)) {
+        renderFallback(img, lineType);
+        return;
+    }
+    const bool aa = lineType == cv::LINE_AA;
+    const cv::Rect imageRect(0, 0, img.cols, img.rows);
+
+    // Bound and clip every primitive once
+    std::vector<Prepared> shapes;
+    shapes.reserve(_prims.size());
+    for (const Prim& p : _prims) {
+        Prepared s;
+        s.kind = p.kind;
+        std::copy(p.color, p.color + 4, s.color);
+        s.x0 = p.x0; s.y0 = p.y0; s.x1 = p.x1; s.y1 = p.y1;
+        s.dx = s.dy = s.invLen2 = s.nx = s.ny = 0;
+
+        float minX, minY, maxX, maxY;
+        switch (p.kind) {
+        case LINE: {
+            s.dx = p.x1 - p.x0;
+            s.dy = p.y1 - p.y0;
+            const float len2 = s.dx * s.dx + s.dy * s.dy;
+            float major = 1.0f;
+            if (len2 > 0) {
+                const float len = std::sqrt(len2);
+                s.invLen2 = 1.0f / len2;
+                s.nx = -s.dy / len;
+                s.ny = s.dx / len;
+                major = std::max(std::abs(s.nx), std::abs(s.ny));
+            }
+            // Hairlines without AA keep one pixel per step along the major
+            // axis (8-connected, as LINE_8) instead of a 1 px wide capsule
+            s.reach = aa ? p.halfWidth + 0.5f : (p.halfWidth <= 0.5f ? 0.5f * major : p.halfWidth);
+            minX = std::min(p.x0, p.x1) - s.reach; maxX = std::max(p.x0, p.x1) + s.reach;
+            minY = std::min(p.y0, p.y1) - s.reach; maxY = std::max(p.y0, p.y1) + s.reach;
+            break;
+        }
+        case RING:
+        case DISC:
+            s.reach = p.kind == RING ? p.halfWidth + (aa ? 0.5f : 0.0f) : (aa ? 0.5f : 0.0f);
+            minX = p.x0 - p.x1 - s.reach; maxX = p.x0 + p.x1 + s.reach;
+            minY = p.y0 - p.x1 - s.reach; maxY = p.y0 + p.x1 + s.reach;
+            break;
+        case BOX:
+        default:
+            s.reach = 0;
+            minX = p.x0; maxX = p.x1;
+            minY = p.y0; maxY = p.y1;
+            break;
+        }
+        if (!(maxX >= minX && maxY >= minY)) continue;   // also rejects NaN
+        if (maxX < 0 || maxY < 0 || minX > img.cols || minY > img.rows) continue;
+
+        const float lim = static_cast<float>(std::max(img.cols, img.rows)) + 2.0f;
+        const int bx0 = static_cast<int>(std::floor(std::max(minX, -1.0f)));
+        const int by0 = static_cast<int>(std::floor(std::max(minY, -1.0f)));
+        const int bx1 = static_cast<int>(std::ceil(std::min(maxX, lim))) + 1;
+        const int by1 = static_cast<int>(std::ceil(std::min(maxY, lim))) + 1;
+        s.bounds = cv::Rect(bx0, by0, bx1 - bx0, by1 - by0) & imageRect;
+        if (!s.bounds.empty()) shapes.push_back(s);
+    }
+    if (shapes.empty()) return;
+
+    // Bin into tiles (CSR, submission order kept within each tile)
+    const int tilesX = (img.cols + kTile - 1) / kTile;
+    const int tilesY = (img.rows + kTile - 1) / kTile;
+    const float tileReach = kTile * 0.7072f;   // half diagonal
+
+    auto forEachTile = [&](const Prepared& s, auto&& fn) {
+        const int tx0 = s.bounds.x / kTile, tx1 = (s.bounds.x + s.bounds.width - 1) / kTile;
+        const int ty0 = s.bounds.y / kTile, ty1 = (s.bounds.y + s.bounds.height - 1) / kTile;
+        const bool single = tx0 == tx1 && ty0 == ty1;
+        for (int ty = ty0; ty <= ty1; ++ty) {
+            for (int tx = tx0; tx <= tx1; ++tx) {
+                if (s.kind == LINE && !single) {
+                    // Skip tiles of a long diagonal's bounding box it never enters
+                    const float px = (tx + 0.5f) * kTile - 0.5f - s.x0;
+                    const float py = (ty + 0.5f) * kTile - 0.5f - s.y0;
+                    const float t = clamp01((px * s.dx + py * s.dy) * s.invLen2);
+                    const float ex = px - t * s.dx, ey = py - t * s.dy;
+                    const float r = s.reach + tileReach;
+                    if (ex * ex + ey * ey > r * r) continue;
+                }
+                fn(ty * tilesX + tx);
+            }
+        }
+    };
+
+    std::vector<int> start(static_cast<size_t>(tilesX) * tilesY + 1, 0);
+    for (const Prepared& s : shapes) forEachTile(s, [&](int t) { ++start[t + 1]; });
+    for (size_t t = 1; t < start.size(); ++t) start[t] += start[t - 1];
+    std::vector<int> items(start.back());
+    {
+        std::vector<int> fill(start.begin(), start.end() - 1);
+        for (int i = 0; i < static_cast<int>(shapes.size()); ++i) {
+            forEachTile(shapes[i], [&](int t) { items[fill[t]++] = i; });
+        }
+    }
+
+    // Every pixel belongs to exactly one tile, so tiles never race
+    cv::parallel_for_(cv::Range(0, tilesX * tilesY), [&](const cv::Range& range) {
+        std::vector<uchar> alpha(kTile);
+        for (int t = range.start; t < range.end; ++t) {
+            if (start[t] == start[t + 1]) continue;
+            const cv::Rect tile = cv::Rect((t % tilesX) * kTile, (t / tilesX) * kTile, kTile, kTile) & imageRect;
+            for (int k = start[t]; k < start[t + 1]; ++k) {
+                const Prepared& s = shapes[items[k]];
+                const cv::Rect clip = s.bounds & tile;
+                if (!clip.empty()) rasterize(img, s, clip, alpha.data(), aa);
+            }
+        }
+    });
+}
+
+void PrimitiveBatch::renderFallback(cv::Mat& img, int lineType) const {
+    for (const Prim& p : _prims) {
+        const cv::Scalar color(p.color[0], p.color[1], p.color[2], p.color[3]);
+        const int thickness = std::max(1, cvRound(p.halfWidth * 2));
+        switch (p.kind) {
+        case LINE:
+            cv::line(img, cv::Point(cvRound(p.x0), cvRound(p.y0)), cv::Point(cvRound(p.x1), cvRound(p.y1)),
+                     color, thickness, lineType);
+            break;
+        case RING:
+            cv::circle(img, cv::Point(cvRound(p.x0), cvRound(p.y0)), cvRound(p.x1), color, thickness, lineType);
+            break;
+        case DISC:
+            cv::circle(img, cv::Point(cvRound(p.x0), cvRound(p.y0)), cvRound(p.x1), color, cv::FILLED, lineType);
+            break;
+        case BOX:
+            cv::rectangle(img, cv::Point(cvCeil(p.x0), cvCeil(p.y0)), cv::Point(cvCeil(p.x1) - 1, cvCeil(p.y1) - 1),
+                          color, cv::FILLED, lineType);
+            break;
+        }
+    }
+}
+
+} // namespace visionpipe
@@ -0,0 +1,255 @@
+#include "utils/run_length_blobs.h"
+
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace visionpipe {
+
+double BlobStats::orientation() const {
+    return 0.5 * std::atan2(2.0 * mu11, mu20 - mu02);
+}
+
+namespace {
+
+struct BlobRun {
+    int row;
+    int start;
+    int end;   ///< exclusive
+};
+
+struct Strip {
+    cv::Range rows;
+    std::vector<BlobRun> runs;
+    std::vector<int> rowStart;   ///< Index of the first run of each row, plus end sentinel
+    std::vector<int> parent;
+};
+
+inline int findRoot(std::vector<int>& parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+inline void unite(std::vector<int>& parent, int a, int b) {
+    a = findRoot(parent, a);
+    b = findRoot(parent, b);
+    if (a == b) return;
+    if (a < b) parent[b] = a;
+    else       parent[a] = b;
+}
+
+/// Union every run in [cb, ce) with the runs of [pb, pe) it touches.
+/// `d` is 1 for 8-connectivity (diagonal contact counts), 0 for 4.
+inline void linkRows(const std::vector<BlobRun>& prevRuns, int pb, int pe,
+                     const std::vector<BlobRun>& curRuns, int cb, int ce,
+                     std::vector<int>& parent, int prevOffset, int curOffset, int d) {
+    int j = pb;
+    for (int c = cb; c < ce; ++c) {
+        const BlobRun& cur = curRuns[c];
+        while (j < pe && prevRuns[j].end + d <= cur.start) ++j;
+        for (int k = j; k < pe && prevRuns[k].start < cur.end + d; ++k) {
+            unite(parent, prevOffset + k, curOffset + c);
+        }
+    }
+}
+
+template <typename T, typename Fg>
+void scanRow(const T* p, int cols, int row, Fg fg, std::vector<BlobRun>& out) {
+    int x = 0;
+    while (x < cols) {
+        while (x < cols && !fg(p[x])) ++x;
+        if (x >= cols) break;
+        int start = x;
+        while (x < cols && fg(p[x])) ++x;
+        out.push_back({row, start, x});
+    }
+}
+
+// 8-bit rows: test eight pixels per step while skipping background.
+// anyGreater is exact for t <= 127 (a carry only occurs past a byte >= 128,
+// which is itself foreground); anyLessEq is the classic "has byte < n".
+constexpr uint64_t kOnes  = 0x0101010101010101ULL;
+constexpr uint64_t kHighs = 0x8080808080808080ULL;
+
+inline bool anyGreater(uint64_t w, unsigned t) { return (((w + kOnes * (127 - t)) | w) & kHighs) != 0; }
+inline bool anyLessEq(uint64_t w, unsigned t)  { return ((w - kOnes * (t + 1)) & ~w & kHighs) != 0; }
+
+void scanRow8(const uint8_t* p, int cols, int row, unsigned t, bool invert, std::vector<BlobRun>& out) {
+    const bool swar = t <= 127;
+    int x = 0;
+    while (x < cols) {
+        if (swar) {
+            while (x + 8 <= cols) {
+                uint64_t w;
+                std::memcpy(&w, p + x, 8);
+                if (invert ? anyLessEq(w, t) : anyGreater(w, t)) break;
+                x += 8;
+            }
+        }
+        while (x < cols && ((p[x] > t) == invert)) ++x;
+        if (x >= cols) break;
+        int start = x;
+        while (x < cols && ((p[x] > t) != invert)) ++x;
+        out.push_back({row, start, x});
+    }
+}
+
+void scanStrip(const cv::Mat& img, Strip& s, const BlobAnalysisParams& prm, int d) {
+    s.runs.clear();
+    s.rowStart.clear();
+    s.rowStart.reserve(s.rows.size() + 1);
+    for (int y = s.rows.start; y < s.rows.end; ++y) {
+        s.rowStart.push_back(static_cast<int>(s.runs.size()));
+        switch (img.depth()) {
+            case CV_8U: {
+                if (prm.threshold < 0) {
+                    // Every pixel exceeds a negative threshold.
+                    if (!prm.invert && img.cols > 0) s.runs.push_back({y, 0, img.cols});
+                    break;
+                }
+                // v > 127.5 and v > 127 agree on integers.
+                const unsigned t = static_cast<unsigned>(std::min(std::floor(prm.threshold), 255.0));
+                scanRow8(img.ptr<uint8_t>(y), img.cols, y, t, prm.invert, s.runs);
+                break;
+            }
+            case CV_16U: {
+                const double t = prm.threshold;
+                const bool inv = prm.invert;
+                scanRow(img.ptr<uint16_t>(y), img.cols, y, [t, inv](uint16_t v) { return (v > t) != inv; }, s.runs);
+                break;
+            }
+            default: {
+                const float t = static_cast<float>(prm.threshold);
+                const bool inv = prm.invert;
+                scanRow(img.ptr<float>(y), img.cols, y, [t, inv](float v) { return (v > t) != inv; }, s.runs);
+                break;
+            }
+        }
+    }
+    s.rowStart.push_back(static_cast<int>(s.runs.size()));
+
+    s.parent.resize(s.runs.size());
+    std::iota(s.parent.begin(), s.parent.end(), 0);
+    for (int r = 1; r < s.rows.size(); ++r) {
+        linkRows(s.runs, s.rowStart[r - 1], s.rowStart[r],
+                 s.runs, s.rowStart[r], s.rowStart[r + 1], s.parent, 0, 0, d);
+    }
+}
+
+struct Accumulator {
+    int64_t area = 0;
+    int minX = INT32_MAX, minY = INT32_MAX, maxX = -1, maxY = -1;
+    double sx = 0, sy = 0, sxx = 0, syy = 0, sxy = 0;
+};
+
+inline double sumSquares(double k) { return k * (k + 1.0) * (2.0 * k + 1.0) / 6.0; }
+
+} // namespace
+
+BlobAnalysisResult analyzeBlobs(const cv::Mat& image, const BlobAnalysisParams& params) {
+    BlobAnalysisResult result;
+    if (image.empty()) return result;
+
+    cv::Mat img = image;
+    if (img.channels() == 3)      cv::cvtColor(img, img, cv::COLOR_BGR2GRAY);
+    else if (img.channels() == 4) cv::cvtColor(img, img, cv::COLOR_BGRA2GRAY);
+    if (img.depth() != CV_8U && img.depth() != CV_16U && img.depth() != CV_32F) {
+        img.convertTo(img, CV_32F);
+    }
+
+    const int d = params.connectivity == 4 ? 0 : 1;
+
+    // ---- Scan + label per strip ------------------------------------------
+    int nStrips = params.strips > 0 ? params.strips : cv::getNumThreads();
+    nStrips = std::clamp(nStrips, 1, std::max(1, img.rows / 16));
+    std::vector<Strip> strips(nStrips);
+    for (int i = 0; i < nStrips; ++i) {
+        strips[i].rows = cv::Range(img.rows * i / nStrips, img.rows * (i + 1) / nStrips);
+    }
+    cv::parallel_for_(cv::Range(0, nStrips), [&](const cv::Range& r) {
+        for (int i = r.start; i < r.end; ++i) scanStrip(img, strips[i], params, d);
+    });
+
+    // ---- Merge strips into one forest ------------------------------------
+    std::vector<int> offset(nStrips + 1, 0);
+    for (int i = 0; i < nStrips; ++i) offset[i + 1] = offset[i] + static_cast<int>(strips[i].runs.size());
+    std::vector<int> parent(offset[nStrips]);
+    for (int i = 0; i < nStrips; ++i) {
+        for (size_t k = 0; k < strips[i].parent.size(); ++k) {
+            parent[offset[i] + k] = offset[i] + strips[i].parent[k];
+        }
+    }
+    for (int i = 0; i + 1 < nStrips; ++i) {
+        const Strip& a = strips[i];
+        const Strip& b = strips[i + 1];
+        if (a.rows.size() == 0 || b.rows.size() == 0) continue;
+        const int aRows = a.rows.size();
+        linkRows(a.runs, a.rowStart[aRows - 1], a.rowStart[aRows],
+                 b.runs, b.rowStart[0], b.rowStart[1], parent, offset[i], offset[i + 1], d);
+    }
+
+    // ---- Accumulate moments per component --------------------------------
+    std::vector<int> component(parent.size(), -1);
+    std::vector<Accumulator> acc;
+    for (int i = 0; i < nStrips; ++i) {
+        for (size_t k = 0; k < strips[i].runs.size(); ++k) {
+            const BlobRun& run = strips[i].runs[k];
+            int root = findRoot(parent, offset[i] + static_cast<int>(k));
+            int& c = component[root];
+            if (c < 0) {
+                c = static_cast<int>(acc.size());
+                acc.emplace_back();
+            }
+            Accumulator& a = acc[c];
+            const double n = run.end - run.start;
+            const double y = run.row;
+            const double sumX = n * (run.start + run.end - 1) / 2.0;
+            a.area += run.end - run.start;
+            a.minX = std::min(a.minX, run.start);
+            a.maxX = std::max(a.maxX, run.end - 1);
+            a.minY = std::min(a.minY, run.row);
+            a.maxY = std::max(a.maxY, run.row);
+            a.sx  += sumX;
+            a.sy  += n * y;
+            a.sxx += sumSquares(run.end - 1.0) - sumSquares(run.start - 1.0);
+            a.syy += n * y * y;
+            a.sxy += y * sumX;
+        }
+    }
+    result.runs = parent.size();
+    result.components = acc.size();
+    result.strips = nStrips;
+
+    // ---- Filter ----------------------------------------------------------
+    const BlobFilter& f = params.filter;
+    for (const Accumulator& a : acc) {
+        if (f.minArea > 0 && a.area < f.minArea) continue;
+        if (f.maxArea > 0 && a.area > f.maxArea) continue;
+        BlobStats b;
+        b.area = a.area;
+        b.bbox = cv::Rect(a.minX, a.minY, a.maxX - a.minX + 1, a.maxY - a.minY + 1);
+        const double aspect = static_cast<double>(b.bbox.width) / b.bbox.height;
+        if (f.minAspect > 0 && aspect < f.minAspect) continue;
+        if (f.maxAspect > 0 && aspect > f.maxAspect) continue;
+        if (f.minExtent > 0 && static_cast<double>(a.area) / b.bbox.area() < f.minExtent) continue;
+        const double A = static_cast<double>(a.area);
+        b.centroid = cv::Point2d(a.sx / A, a.sy / A);
+        b.mu20 = a.sxx / A - b.centroid.x * b.centroid.x;
+        b.mu02 = a.syy / A - b.centroid.y * b.centroid.y;
+        b.mu11 = a.sxy / A - b.centroid.x * b.centroid.y;
+        result.blobs.push_back(b);
+    }
+    std::sort(result.blobs.begin(), result.blobs.end(),
+              [](const BlobStats& x, const BlobStats& y) { return x.area > y.area; });
+    if (f.maxBlobs > 0 && static_cast<int>(result.blobs.size()) > f.maxBlobs) {
+        result.blobs.resize(f.maxBlobs);
+    }
+    return result;
+}
+
+} // namespace visionpipe
@@ -0,0 +1,193 @@
+#include "utils/seg_overlay.h"
+#include "utils/primitive_rasterizer.h"
+
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
+
+namespace visionpipe {
+
+namespace {
+
+/// Source sample index of a destination pixel center, clamped.
+inline int sampleIndex(double pos, int size) {
+    return std::min(std::max(static_cast<int>(std::floor(pos)), 0), size - 1);
+}
+
+} // namespace
+
+// ============================================================================
+// Argmax
+// ============================================================================
+
+int segArgmax(const cv::Mat& scores, const std::vector<float>& thresholds, cv::Mat& labels) {
+    if (scores.type() != CV_32F || !scores.isContinuous()) return 0;
+
+    int C = 0, H = 0, W = 0;
+    if (scores.dims == 4 && scores.size[0] == 1) {
+        C = scores.size[1]; H = scores.size[2]; W = scores.size[3];
+    } else if (scores.dims == 3) {
+        C = scores.size[0]; H = scores.size[1]; W = scores.size[2];
+    }
+    if (C <= 0 || C >= kSegIgnore || H <= 0 || W <= 0) return 0;
+
+    std::vector<float> thr(C, -FLT_MAX);
+    if (thresholds.size() == 1) {
+        std::fill(thr.begin(), thr.end(), thresholds[0]);
+    } else {
+        std::copy(thresholds.begin(), thresholds.begin() + std::min<size_t>(thresholds.size(), C), thr.begin());
+    }
+    const bool gated = !thresholds.empty();
+
+    const float* data = scores.ptr<float>();
+    const size_t plane = static_cast<size_t>(H) * W;
+    labels.create(H, W, CV_8UC1);
+
+    // One row of every class plane at a time: the running max stays in L1
+    // and the select loops vectorize
+    cv::parallel_for_(cv::Range(0, H), [&](const cv::Range& range) {
+        std::vector<float> best(W);
+        std::vector<int> arg(W);
+        for (int y = range.start; y < range.end; ++y) {
+            const float* p0 = data + static_cast<size_t>(y) * W;
+            std::copy(p0, p0 + W, best.begin());
+            std::fill(arg.begin(), arg.end(), 0);
+            for (int c = 1; c < C; ++c) {
+                const float* p = p0 + c * plane;
+                for (int x = 0; x < W; ++x) {
+                    const bool g = p[x] > best[x];
+                    best[x] = g ? p[x] : best[x];
+                    arg[x] = g ? c : arg[x];
+                }
+            }
+            uchar* dst = labels.ptr<uchar>(y);
+            if (gated) {
+                for (int x = 0; x < W; ++x) {
+                    dst[x] = best[x] < thr[arg[x]] ? kSegIgnore : static_cast<uchar>(arg[x]);
+                }
+            } else {
+                for (int x = 0; x < W; ++x) dst[x] = static_cast<uchar>(arg[x]);
+            }
+        }
+    });
+    return C;
+}
+
+std::vector<cv::Vec3b> segPalette(int numClasses) {
+    std::vector<cv::Vec3b> palette(std::max(numClasses, 0));
+    for (int i = 0; i < numClasses; ++i) {
+        int r = 0, g = 0, b = 0;
+        for (int j = 0, c = i; j < 8; ++j, c >>= 3) {
+            r |= ((c >> 0) & 1) << (7 - j);
+            g |= ((c >> 1) & 1) << (7 - j);
+            b |= ((c >> 2) & 1) << (7 - j);
+        }
+        palette[i] = cv::Vec3b(static_cast<uchar>(b), static_cast<uchar>(g), static_cast<uchar>(r));
+    }
+    return palette;
+}
+
+// ============================================================================
+// Overlay
+// ============================================================================
+
+void segOverlay(cv::Mat& img, const cv::Mat& labels, const std::vector<cv::Vec3b>& palette,
+                const SegOverlayOptions& opts, std::vector<int>* counts) {
+    std::vector<int> total(palette.size(), 0);
+    if (img.empty() || labels.empty() || labels.type() != CV_8UC1 ||
+        img.depth() != CV_8U || img.channels() < 3) {
+        if (counts) *counts = std::move(total);
+        return;
+    }
+
+    const int cn = img.channels();
+    const int W = img.cols, H = img.rows;
+    const int lw = labels.cols, lh = labels.rows;
+    const double sx = static_cast<double>(lw) / W;
+    const double sy = static_cast<double>(lh) / H;
+    const unsigned a = cv::saturate_cast<uchar>(opts.alpha * 255.0);
+
+    // Label columns per frame column: nearest, and the bilinear pair
+    std::vector<int> xn(W), x0(W), x1(W);
+    for (int x = 0; x < W; ++x) {
+        xn[x] = sampleIndex((x + 0.5) * sx, lw);
+        x0[x] = sampleIndex((x + 0.5) * sx - 0.5, lw);
+        x1[x] = std::min(x0[x] + 1, lw - 1);
+    }
+
+    // Reference colors at label resolution, taken before anything is blended
+    cv::Mat guide;
+    if (opts.edgeAware) {
+        cv::resize(img, guide, labels.size(), 0, 0, cv::INTER_AREA);
+    }
+
+    std::vector<cv::Vec3b> lut(256);
+    std::vector<uchar> draw(256, 0);
+    for (size_t i = 0; i < palette.size() && i < kSegIgnore; ++i) {
+        lut[i] = palette[i];
+        draw[i] = static_cast<int>(i) != opts.skipClass && a > 0;
+    }
+
+    std::mutex totalMutex;
+    cv::parallel_for_(cv::Range(0, H), [&](const cv::Range& range) {
+        std::vector<uchar> row(W);
+        std::vector<int> local(256, 0);
+        for (int y = range.start; y < range.end; ++y) {
+            uchar* d = img.ptr<uchar>(y);
+
+            if (!opts.edgeAware) {
+                const uchar* ln = labels.ptr<uchar>(sampleIndex((y + 0.5) * sy, lh));
+                for (int x = 0; x < W; ++x) row[x] = ln[xn[x]];
+            } else {
+                const int y0 = sampleIndex((y + 0.5) * sy - 0.5, lh);
+                const int y1 = std::min(y0 + 1, lh - 1);
+                const uchar* l0 = labels.ptr<uchar>(y0);
+                const uchar* l1 = labels.ptr<uchar>(y1);
+                const uchar* g0 = guide.ptr<uchar>(y0);
+                const uchar* g1 = guide.ptr<uchar>(y1);
+                for (int x = 0; x < W; ++x) {
+                    const uchar cand[4] = {l0[x0[x]], l0[x1[x]], l1[x0[x]], l1[x1[x]]};
+                    if (cand[0] == cand[1] && cand[0] == cand[2] && cand[0] == cand[3]) {
+                        row[x] = cand[0];
+                        continue;
+                    }
+                    // Border cell: the sample that looks most like this pixel wins
+                    const uchar* ref[4] = {g0 + x0[x] * cn, g0 + x1[x] * cn, g1 + x0[x] * cn, g1 + x1[x] * cn};
+                    const uchar* px = d + x * cn;
+                    int bestK = 0, bestDist = INT_MAX;
+                    for (int k = 0; k < 4; ++k) {
+                        const int dist = std::abs(px[0] - ref[k][0]) + std::abs(px[1] - ref[k][1]) +
+                                         std::abs(px[2] - ref[k][2]);
+                        if (dist < bestDist) {
+                            bestDist = dist;
+                            bestK = k;
+                        }
+                    }
+                    row[x] = cand[bestK];
+                }
+            }
+
+            // Palette LUT + blend, counting labels on the way
+            for (int x = 0; x < W; ++x) {
+                const uchar l = row[x];
+                ++local[l];
+                if (!draw[l]) continue;
+                const cv::Vec3b& c = lut[l];
+                uchar* px = d + x * cn;
+                for (int k = 0; k < 3; ++k) {
+                    px[k] = static_cast<uchar>(div255(px[k] * (255 - a) + c[k] * a));
+                }
+            }
+        }
+        std::lock_guard<std::mutex> lock(totalMutex);
+        for (size_t i = 0; i < total.size() && i < local.size(); ++i) total[i] += local[i];
+    });
+
+    if (counts) *counts = std::move(total);
+}
+
+} // namespace visionpipe
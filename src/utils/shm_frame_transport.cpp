@@ -4,6 +4,7 @@
 #ifndef VISIONPIPE_IPC_USE_ICEORYX2
 
 #include "utils/shm_frame_transport.h"
+#include "utils/default_allocator_hook.h"
 
 #include <sys/mman.h>
 #include <sys/stat.h>
@@ -15,22 +16,31 @@
 #include <mutex>
 #include <unordered_map>
 
+#include <opencv2/core.hpp>
+
 namespace visionpipe {
 
 // ============================================================================
 // Internal bookkeeping
 // ============================================================================
 
+/// Live cv::Mat placements per double-buffer half (this process only).
+struct ShmBufferRefs {
+    std::atomic<int> live[2] = {0, 0};
+};
+
 struct ShmRegion {
     int         fd      = -1;
     void*       addr    = MAP_FAILED;
     size_t      mapSize = 0;
     std::string posixName;           // e.g. "/vp_left_cam"
     uint64_t    lastReadSeq = 0;     // per-process read cursor
+    std::shared_ptr<ShmBufferRefs> refs = std::make_shared<ShmBufferRefs>();
 };
 
 static std::mutex                                    g_shmMutex;
 static std::unordered_map<std::string, ShmRegion>    g_shmRegions;
+static std::atomic<uint64_t>                         g_frameCopies{0};
 
 static std::string shmPosixName(const std::string& name) {
     return "/vp_" + name;
@@ -73,6 +83,154 @@ static ShmRegion* findOrOpen(const std::string& name) {
     return &ins->second;
 }
 
+static ShmRegion* findRegion(const std::string& name) {
+    {
+        std::lock_guard<std::mutex> lk(g_shmMutex);
+        auto it = g_shmRegions.find(name);
+        if (it != g_shmRegions.end()) return &it->second;
+    }
+    return findOrOpen(name);
+}
+
+/// True if no write into the buffer carrying frame @p seq has started since
+/// it was published.  The writer reuses that buffer for frame seq + 2.
+static bool frameIntact(ShmFrameHeader* hdr, uint64_t seq) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return hdr->writingSeq.load(std::memory_order_relaxed) < seq + 2;
+}
+
+// ============================================================================
+// Output placement (ShmOutputScope)
+// ============================================================================
+
+namespace {
+
+/// Armed by ShmOutputScope; consumed by the first matching allocation and
+/// re-armed if that Mat is released while the scope is still open.
+struct ShmOutputHint {
+    bool            owned  = false;    ///< A scope on this thread holds the hint
+    bool            active = false;    ///< The buffer is free to be placed
+    uint8_t*        data   = nullptr;
+    int             rows   = 0;
+    int             cols   = 0;
+    int             type   = -1;
+    int             buffer = 0;
+    uint64_t        seq    = 0;        ///< Frame the buffer will carry
+    ShmFrameHeader* hdr    = nullptr;
+    std::shared_ptr<ShmBufferRefs> refs;
+};
+
+thread_local ShmOutputHint t_outputHint;
+
+/// UMatData::userdata of a Mat placed in shared memory.
+struct ShmPlacement {
+    std::shared_ptr<ShmBufferRefs> refs;
+    int buffer;
+};
+
+/**
+ * Default-allocator wrapper.  Serves the allocation armed on the calling
+ * thread from shared memory and forwards everything else untouched, so
+ * Mats allocated by the fallback keep it as their own allocator.  Installed
+ * only while a ShmOutputScope is armed.
+ */
+class ShmFrameAllocator : public cv::MatAllocator {
+public:
+    ShmFrameAllocator() : hook(this) {}
+
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data0, size_t* step,
+                           cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const override {
+        ShmOutputHint& h = t_outputHint;
+        if (!h.active || data0 || dims != 2 || sizes[0] != h.rows || sizes[1] != h.cols ||
+            type != h.type) {
+            return hook.fallback()->allocate(dims, sizes, type, data0, step, flags, usageFlags);
+        }
+        h.active = false;
+
+        // Announce the frame before anything is written into its buffer so
+        // readers still holding the previous occupant can detect the reuse.
+        h.hdr->writingSeq.store(h.seq, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        const size_t esz = CV_ELEM_SIZE(type);
+        step[1] = esz;
+        step[0] = esz * static_cast<size_t>(sizes[1]);
+
+        auto* u = new cv::UMatData(this);
+        u->data = u->origdata = h.data;
+        u->size = step[0] * static_cast<size_t>(sizes[0]);
+        h.refs->live[h.buffer].fetch_add(1, std::memory_order_relaxed);
+        u->userdata = new ShmPlacement{h.refs, h.buffer};
+        return u;
+    }
+
+    bool allocate(cv::UMatData* u, cv::AccessFlag, cv::UMatUsageFlags) const override {
+        return u != nullptr;
+    }
+
+    void deallocate(cv::UMatData* u) const override {
+        if (!u) return;
+        auto* p = static_cast<ShmPlacement*>(u->userdata);
+        if (p) {
+            // Release: the writer may reuse the buffer once it reads zero.
+            const bool last = p->refs->live[p->buffer].fetch_sub(1, std::memory_order_release) == 1;
+            // A temporary took the buffer and is gone before the scope
+            // ended: leave the buffer for the statement's real output.
+            ShmOutputHint& h = t_outputHint;
+            if (last && h.owned && !h.active && h.refs == p->refs && h.buffer == p->buffer) {
+                h.active = true;
+            }
+            delete p;
+        }
+        delete u;
+    }
+
+    mutable DefaultAllocatorHook hook;
+};
+
+ShmFrameAllocator& shmAllocator() {
+    static ShmFrameAllocator allocator;
+    return allocator;
+}
+
+} // namespace
+
+ShmOutputScope::ShmOutputScope(const std::string& name) {
+    ShmOutputHint& h = t_outputHint;
+    if (h.owned) return;   // an enclosing scope owns this thread's hint
+
+    ShmRegion* reg = findRegion(name);
+    if (!reg) return;
+    auto* hdr = getHeader(*reg);
+
+    uint64_t seq  = hdr->writeSeq.load(std::memory_order_relaxed);
+    int      next = static_cast<int>((seq + 1) & 1);
+    // A Mat from an earlier placement still lives there: fall back to the
+    // heap; shmFrameWrite refuses to copy over it until it is released.
+    if (reg->refs->live[next].load(std::memory_order_acquire) > 0) return;
+
+    shmAllocator().hook.acquire();
+    h.owned  = true;
+    h.active = true;
+    h.data   = reinterpret_cast<uint8_t*>(reg->addr) + hdr->bufferOffset[next];
+    h.rows   = hdr->height;
+    h.cols   = hdr->width;
+    h.type   = hdr->type;
+    h.buffer = next;
+    h.seq    = seq + 1;
+    h.hdr    = hdr;
+    h.refs   = reg->refs;
+    _armed   = true;
+}
+
+ShmOutputScope::~ShmOutputScope() {
+    if (!_armed) return;
+    t_outputHint.owned = false;
+    t_outputHint.active = false;
+    t_outputHint.refs.reset();
+    shmAllocator().hook.release();
+}
+
 // ============================================================================
 // Public API
 // ============================================================================
@@ -116,6 +274,7 @@ bool shmFrameCreate(const std::string& name, int width, int height, int type) {
     // Initialise header (use placement new to value-initialise).
     auto* hdr = new (addr) ShmFrameHeader{};
     hdr->writeSeq.store(0, std::memory_order_relaxed);
+    hdr->writingSeq.store(0, std::memory_order_relaxed);
     hdr->shutdown.store(0, std::memory_order_relaxed);
     hdr->width    = width;
     hdr->height   = height;
@@ -165,13 +324,30 @@ bool shmFrameWrite(const std::string& name, const cv::Mat& frame) {
     int      nextBuf   = static_cast<int>((seq + 1) & 1);
     uint8_t* dst       = reinterpret_cast<uint8_t*>(reg->addr) + hdr->bufferOffset[nextBuf];
 
-    // Continuous frames can be memcpy'd in one shot.
-    if (frame.isContinuous()) {
-        std::memcpy(dst, frame.data, hdr->dataSize);
+    if (frame.data == dst) {
+        // Produced in place under a ShmOutputScope, which already announced
+        // the frame in writingSeq: publishing is just the sequence bump.
     } else {
-        size_t rowBytes = static_cast<size_t>(frame.cols) * frame.elemSize();
-        for (int r = 0; r < frame.rows; ++r) {
-            std::memcpy(dst + r * rowBytes, frame.ptr(r), rowBytes);
+        // A Mat placed there two frames ago is still referenced (cached,
+        // queued, held as a variable): copying would change it under its
+        // user.  Drop this frame instead.
+        if (reg->refs->live[nextBuf].load(std::memory_order_acquire) > 0) {
+            std::cerr << "[shm_write] '" << name << "': the free buffer still holds a "
+                      << "placed frame in use; clone frames kept past the next write\n";
+            return false;
+        }
+        hdr->writingSeq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        g_frameCopies.fetch_add(1, std::memory_order_relaxed);
+        // Continuous frames can be memcpy'd in one shot.
+        if (frame.isContinuous()) {
+            std::memcpy(dst, frame.data, hdr->dataSize);
+        } else {
+            size_t rowBytes = static_cast<size_t>(frame.cols) * frame.elemSize();
+            for (int r = 0; r < frame.rows; ++r) {
+                std::memcpy(dst + r * rowBytes, frame.ptr(r), rowBytes);
+            }
         }
     }
 
@@ -194,26 +370,60 @@ bool shmFrameRead(const std::string& name, cv::Mat& out) {
 
     auto* hdr = getHeader(*reg);
 
-    uint64_t seq = hdr->writeSeq.load(std::memory_order_acquire);
-    if (seq == 0) {
-        // Nothing written yet.
-        return false;
-    }
-
-    // Determine which buffer holds the latest completed frame.
-    int curBuf = static_cast<int>(seq & 1);
-    const uint8_t* src = reinterpret_cast<const uint8_t*>(reg->addr) + hdr->bufferOffset[curBuf];
-
     // Allocate output if needed.
     if (out.cols != hdr->width || out.rows != hdr->height || out.type() != hdr->type) {
         out.create(hdr->height, hdr->width, hdr->type);
     }
 
-    std::memcpy(out.data, src, hdr->dataSize);
+    // A copy the writer lapped (it started refilling the buffer mid-copy)
+    // is torn; retry from the newer frame.
+    constexpr int kReadAttempts = 3;
+    for (int attempt = 0; attempt < kReadAttempts; ++attempt) {
+        uint64_t seq = hdr->writeSeq.load(std::memory_order_acquire);
+        if (seq == 0) {
+            // Nothing written yet.
+            return false;
+        }
+
+        // Determine which buffer holds the latest completed frame.
+        int curBuf = static_cast<int>(seq & 1);
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(reg->addr) + hdr->bufferOffset[curBuf];
+
+        std::memcpy(out.data, src, hdr->dataSize);
+        g_frameCopies.fetch_add(1, std::memory_order_relaxed);
+        if (frameIntact(hdr, seq)) {
+            reg->lastReadSeq = seq;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool shmFrameReadView(const std::string& name, cv::Mat& out, uint64_t& seq) {
+    ShmRegion* reg = findRegion(name);
+    if (!reg) return false;
+
+    auto* hdr = getHeader(*reg);
+    seq = hdr->writeSeq.load(std::memory_order_acquire);
+    if (seq == 0) return false;
+
+    int curBuf = static_cast<int>(seq & 1);
+    uint8_t* src = reinterpret_cast<uint8_t*>(reg->addr) + hdr->bufferOffset[curBuf];
+    out = cv::Mat(hdr->height, hdr->width, hdr->type, src);
     reg->lastReadSeq = seq;
     return true;
 }
 
+uint64_t shmFrameCopyCount() {
+    return g_frameCopies.load(std::memory_order_relaxed);
+}
+
+bool shmFrameValidate(const std::string& name, uint64_t seq) {
+    ShmRegion* reg = findRegion(name);
+    if (!reg) return false;
+    return frameIntact(getHeader(*reg), seq);
+}
+
 void shmFrameSetShutdown(const std::string& name) {
     ShmRegion* reg = nullptr;
     {
@@ -0,0 +1,244 @@
+#include "utils/template_matcher.h"
+#include "utils/fft_engine.h"
+
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace visionpipe {
+
+namespace {
+
+/// Half-width of the refinement window around a projected candidate.
+constexpr int kRefineRadius = 3;
+
+cv::Mat toGray8(const cv::Mat& src) {
+    cv::Mat gray;
+    if (src.channels() == 3)      cv::cvtColor(src, gray, cv::COLOR_BGR2GRAY);
+    else if (src.channels() == 4) cv::cvtColor(src, gray, cv::COLOR_BGRA2GRAY);
+    else                          gray = src;
+    if (gray.depth() != CV_8U) {
+        cv::Mat g8;
+        gray.convertTo(g8, CV_8U);
+        return g8;
+    }
+    return gray;
+}
+
+/// Sum over the w x h window at (x, y) of a CV_64F integral image.
+inline double windowSum(const cv::Mat& integral, int x, int y, int w, int h) {
+    const double* top = integral.ptr<double>(y);
+    const double* bot = integral.ptr<double>(y + h);
+    return bot[x + w] - bot[x] - top[x + w] + top[x];
+}
+
+/// Score convention: higher is better for every method.
+void toScore(cv::Mat& response, int method) {
+    if (method == cv::TM_SQDIFF_NORMED) cv::subtract(1.0, response, response);
+}
+
+struct SearchPlan {
+    int  level = 0;
+    bool fft   = false;
+};
+
+} // namespace
+
+// ============================================================================
+// TemplateModel
+// ============================================================================
+
+TemplateModel::TemplateModel(const cv::Mat& src) : source(src) {
+    levels.push_back(toGray8(src));
+    // Stop once a further pyrDown would drop below 4 px: nothing matches reliably there.
+    while (std::min(levels.back().cols, levels.back().rows) >= 8) {
+        cv::Mat down;
+        cv::pyrDown(levels.back(), down);
+        levels.push_back(down);
+    }
+    for (const cv::Mat& level : levels) {
+        cv::Mat f;
+        level.convertTo(f, CV_32F);
+        cv::Scalar mean = cv::mean(f);
+        cv::Mat zm = f - mean[0];
+        raw.push_back(f);
+        rawNorm.push_back(cv::norm(f));
+        zeroMean.push_back(zm);
+        zeroMeanNorm.push_back(cv::norm(zm));
+    }
+}
+
+// ============================================================================
+// TemplateBank
+// ============================================================================
+
+void TemplateBank::sync(const std::vector<cv::Mat>& templates) {
+    _models.resize(templates.size());
+    for (size_t i = 0; i < templates.size(); ++i) {
+        const auto& m = _models[i];
+        const cv::Mat& t = templates[i];
+        if (m && m->source.data == t.data && m->source.size() == t.size() &&
+            m->source.type() == t.type()) {
+            continue;
+        }
+        _models[i] = std::make_shared<const TemplateModel>(t);
+    }
+}
+
+std::vector<MatchPeak> TemplateBank::match(const cv::Mat& frame, const std::vector<cv::Mat>& templates,
+                                           const TemplateMatchParams& params) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    sync(templates);
+
+    std::vector<MatchPeak> peaks;
+    if (frame.empty() || _models.empty()) return peaks;
+
+    // ---- Search plan per template ----------------------------------------
+    const int frameMin = std::min(frame.cols, frame.rows);
+    std::vector<SearchPlan> plans(_models.size());
+    int topLevel = 0;
+    for (size_t i = 0; i < _models.size(); ++i) {
+        const TemplateModel& m = *_models[i];
+        int level = 0;
+        const int cap = params.maxLevels >= 0 ? params.maxLevels : static_cast<int>(m.levels.size()) - 1;
+        while (level + 1 < static_cast<int>(m.levels.size()) && level + 1 <= cap) {
+            const cv::Mat& next = m.levels[level + 1];
+            if (std::min(next.cols, next.rows) < params.minTemplateSide) break;
+            if ((frameMin >> (level + 1)) < 2 * std::max(next.cols, next.rows)) break;
+            ++level;
+        }
+        plans[i].level = level;
+        plans[i].fft = params.method != cv::TM_SQDIFF_NORMED &&
+                       m.levels[level].total() >= static_cast<size_t>(params.fftMinArea);
+        topLevel = std::max(topLevel, level);
+    }
+
+    // ---- Shared frame pyramid and integral images ------------------------
+    _pyramid.resize(topLevel + 1);
+    _pyramid[0] = toGray8(frame);
+    for (int l = 1; l <= topLevel; ++l) cv::pyrDown(_pyramid[l - 1], _pyramid[l]);
+
+    _sum.resize(topLevel + 1);
+    _sqsum.resize(topLevel + 1);
+    std::vector<bool> needIntegral(topLevel + 1, false);
+    for (const SearchPlan& p : plans) if (p.fft) needIntegral[p.level] = true;
+    for (int l = 0; l <= topLevel; ++l) {
+        if (needIntegral[l]) cv::integral(_pyramid[l], _sum[l], _sqsum[l], CV_64F, CV_64F);
+    }
+
+    // ---- Per-template coarse search + refinement -------------------------
+    std::vector<std::vector<MatchPeak>> perTemplate(_models.size());
+    cv::parallel_for_(cv::Range(0, static_cast<int>(_models.size())), [&](const cv::Range& r) {
+        for (int ti = r.start; ti < r.end; ++ti) {
+            const TemplateModel& m = *_models[ti];
+            const SearchPlan& plan = plans[ti];
+            const cv::Mat& img = _pyramid[plan.level];
+            const cv::Mat& T = m.levels[plan.level];
+            if (img.cols < T.cols || img.rows < T.rows) continue;
+
+            // Dense score map at the coarse level.
+            cv::Mat response;
+            if (plan.fft) {
+                const bool ccoeff = params.method == cv::TM_CCOEFF_NORMED;
+                const cv::Mat& kernel = ccoeff ? m.zeroMean[plan.level] : m.raw[plan.level];
+                const double tnorm = ccoeff ? m.zeroMeanNorm[plan.level] : m.rawNorm[plan.level];
+                cv::Mat corr;
+                FFTEngine::instance().convolve(img, corr, kernel,
+                                               "match:" + _id + ":" + std::to_string(ti) + ":" +
+                                                   std::to_string(plan.level),
+                                               cv::Point(0, 0), cv::BORDER_CONSTANT, CV_32F, false);
+                const int rw = img.cols - T.cols + 1;
+                const int rh = img.rows - T.rows + 1;
+                const double n = static_cast<double>(T.total());
+                const cv::Mat& S = _sum[plan.level];
+                const cv::Mat& SQ = _sqsum[plan.level];
+                response.create(rh, rw, CV_32F);
+                for (int y = 0; y < rh; ++y) {
+                    const float* c = corr.ptr<float>(y);
+                    float* out = response.ptr<float>(y);
+                    for (int x = 0; x < rw; ++x) {
+                        double s1 = windowSum(S, x, y, T.cols, T.rows);
+                        double s2 = windowSum(SQ, x, y, T.cols, T.rows);
+                        double energy = ccoeff ? s2 - s1 * s1 / n : s2;
+                        double denom = tnorm * std::sqrt(std::max(energy, 0.0));
+                        out[x] = denom > 1e-6 ? static_cast<float>(c[x] / denom) : 0.f;
+                    }
+                }
+            } else {
+                cv::matchTemplate(img, T, response, params.method);
+                toScore(response, params.method);
+            }
+
+            // Coarse candidates: greedy maxima with template-sized suppression.
+            const double coarseMin = params.threshold - (plan.level > 0 ? params.coarseSlack : 0.0);
+            const int maxCandidates = std::max(1, params.topK) * 2 + 2;
+            std::vector<MatchPeak> found;
+            for (int c = 0; c < maxCandidates; ++c) {
+                double maxVal;
+                cv::Point loc;
+                cv::minMaxLoc(response, nullptr, &maxVal, nullptr, &loc);
+                if (maxVal < coarseMin) break;
+
+                cv::Rect suppress(loc.x - T.cols / 2, loc.y - T.rows / 2, T.cols, T.rows);
+                response(suppress & cv::Rect(0, 0, response.cols, response.rows)).setTo(-FLT_MAX);
+
+                // Refine down the pyramid inside a small window.
+                cv::Point pos = loc;
+                float score = static_cast<float>(maxVal);
+                bool lost = false;
+                for (int l = plan.level - 1; l >= 0; --l) {
+                    const cv::Mat& li = _pyramid[l];
+                    const cv::Mat& lt = m.levels[l];
+                    cv::Rect roi(pos.x * 2 - kRefineRadius, pos.y * 2 - kRefineRadius,
+                                 lt.cols + 2 * kRefineRadius, lt.rows + 2 * kRefineRadius);
+                    roi &= cv::Rect(0, 0, li.cols, li.rows);
+                    if (roi.width < lt.cols || roi.height < lt.rows) {
+                        lost = true;
+                        break;
+                    }
+                    cv::Mat local;
+                    cv::matchTemplate(li(roi), lt, local, params.method);
+                    toScore(local, params.method);
+                    double best;
+                    cv::Point bestLoc;
+                    cv::minMaxLoc(local, nullptr, &best, nullptr, &bestLoc);
+                    pos = roi.tl() + bestLoc;
+                    score = static_cast<float>(best);
+                }
+                if (lost || score < params.threshold) continue;
+
+                MatchPeak peak;
+                peak.templateIndex = ti;
+                peak.box = cv::Rect(pos, m.levels[0].size());
+                peak.score = score;
+                found.push_back(peak);
+            }
+
+            // Candidates from neighbouring coarse maxima can converge on the
+            // same spot; keep the best of overlapping boxes.
+            std::sort(found.begin(), found.end(),
+                      [](const MatchPeak& a, const MatchPeak& b) { return a.score > b.score; });
+            auto& kept = perTemplate[ti];
+            for (const MatchPeak& p : found) {
+                bool overlaps = false;
+                for (const MatchPeak& k : kept) {
+                    double inter = (p.box & k.box).area();
+                    if (inter > 0.5 * std::min(p.box.area(), k.box.area())) {
+                        overlaps = true;
+                        break;
+                    }
+                }
+                if (!overlaps) kept.push_back(p);
+                if (static_cast<int>(kept.size()) >= params.topK) break;
+            }
+        }
+    });
+
+    for (auto& v : perTemplate) peaks.insert(peaks.end(), v.begin(), v.end());
+    std::sort(peaks.begin(), peaks.end(),
+              [](const MatchPeak& a, const MatchPeak& b) { return a.score > b.score; });
+    return peaks;
+}
+
+} // namespace visionpipe
@@ -0,0 +1,179 @@
+#include "utils/text_renderer.h"
+#include "utils/primitive_rasterizer.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace visionpipe {
+
+// ============================================================================
+// TextRenderer
+// ============================================================================
+
+TextRenderer& TextRenderer::instance() {
+    static TextRenderer renderer;
+    return renderer;
+}
+
+bool TextRenderer::isPrintable(const std::string& text) {
+    for (unsigned char c : text) {
+        if (c < kFirstChar || c >= kFirstChar + kNumChars) return false;
+    }
+    return true;
+}
+
+bool TextRenderer::isSupported(const cv::Mat& img) {
+    return img.depth() == CV_8U && (img.channels() == 1 || img.channels() == 3 || img.channels() == 4);
+}
+
+void TextRenderer::clear() {
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    _atlases.clear();
+}
+
+std::shared_ptr<const TextRenderer::FontMetrics> TextRenderer::metrics(int fontFace) {
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        auto it = _metrics.find(fontFace);
+        if (it != _metrics.end()) return it->second;
+    }
+
+    // At scale 1 and thickness 0 cv::getTextSize reports the raw font units
+    auto fm = std::make_shared<FontMetrics>();
+    for (int i = 0; i < kNumChars; ++i) {
+        fm->advance[i] = cv::getTextSize(std::string(1, static_cast<char>(kFirstChar + i)),
+                                         fontFace, 1.0, 0, nullptr).width;
+    }
+    int base = 0;
+    const cv::Size box = cv::getTextSize("", fontFace, 1.0, 0, &base);
+    fm->baseLine = base;
+    fm->capLine  = box.height - base;
+
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    return _metrics.emplace(fontFace, std::move(fm)).first->second;
+}
+
+std::shared_ptr<const TextRenderer::Atlas> TextRenderer::atlas(int fontFace, double fontScale,
+                                                              int thickness, int lineType) {
+    const AtlasKey key{fontFace, static_cast<int64_t>(cvRound(fontScale * 65536)), thickness, lineType};
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        auto it = _atlases.find(key);
+        if (it != _atlases.end()) return it->second;
+    }
+
+    const auto fm = metrics(fontFace);
+    auto at = std::make_shared<Atlas>();
+    at->hscale = key.hscale;
+
+    // Render each glyph alone at an integer pen position with cv::putText,
+    // then keep only its inked rectangle.  The pad covers strokes that leave
+    // the advance box (italics, script descenders).
+    int base = 0;
+    const cv::Size box = cv::getTextSize("", fontFace, fontScale, thickness, &base);
+    const int pad = thickness + cvRound(fontScale * 32) + 2;
+    std::vector<cv::Mat> masks(kNumChars);
+    int atlasWidth = 0, atlasHeight = 0;
+    for (int i = 0; i < kNumChars; ++i) {
+        const int adv = cvRound(fm->advance[i] * fontScale);
+        cv::Mat canvas = cv::Mat::zeros(box.height + base + 2 * pad, adv + thickness + 2 * pad, CV_8UC1);
+        const cv::Point origin(pad, pad + box.height);
+        cv::putText(canvas, std::string(1, static_cast<char>(kFirstChar + i)), origin,
+                    fontFace, fontScale, cv::Scalar(255), thickness, lineType);
+
+        const cv::Rect ink = cv::boundingRect(canvas);
+        at->glyphs[i].offset = ink.tl() - origin;
+        at->glyphs[i].rect = cv::Rect(atlasWidth, 0, ink.width, ink.height);
+        masks[i] = canvas(ink);
+        atlasWidth += ink.width;
+        atlasHeight = std::max(atlasHeight, ink.height);
+    }
+
+    at->coverage = cv::Mat::zeros(std::max(atlasHeight, 1), std::max(atlasWidth, 1), CV_8UC1);
+    for (int i = 0; i < kNumChars; ++i) {
+        if (!at->glyphs[i].rect.empty()) masks[i].copyTo(at->coverage(at->glyphs[i].rect));
+    }
+
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    // Scales computed per frame would otherwise grow the cache without bound
+    if (_atlases.size() >= kMaxAtlases) _atlases.clear();
+    return _atlases.emplace(key, std::move(at)).first->second;
+}
+
+// ============================================================================
+// Metrics
+// ============================================================================
+
+cv::Size TextRenderer::getTextSize(const std::string& text, int fontFace, double fontScale,
+                                   int thickness, int* baseLine) {
+    if (!isPrintable(text)) return cv::getTextSize(text, fontFace, fontScale, thickness, baseLine);
+
+    // Same arithmetic as cv::getTextSize, from the cached advances
+    const auto fm = metrics(fontFace);
+    double viewX = 0;
+    for (unsigned char c : text) viewX += fm->advance[c - kFirstChar] * fontScale;
+
+    cv::Size size;
+    size.width  = cvRound(viewX + thickness);
+    size.height = cvRound((fm->capLine + fm->baseLine) * fontScale + (thickness + 1) / 2);
+    if (baseLine) *baseLine = cvRound(fm->baseLine * fontScale + thickness * 0.5);
+    return size;
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+void TextRenderer::draw(cv::Mat& img, const Atlas& at, const FontMetrics& fm,
+                        const std::string& text, cv::Point org, const cv::Scalar& color) {
+    const int cn = img.channels();
+    uchar col[4];
+    for (int k = 0; k < 4; ++k) col[k] = cv::saturate_cast<uchar>(color[k]);
+
+    const cv::Rect bounds(0, 0, img.cols, img.rows);
+    int64_t pen = static_cast<int64_t>(org.x) << 16;   // 16.16 fixed point, as in cv::putText
+    for (unsigned char c : text) {
+        const int idx = c - kFirstChar;
+        const Glyph& g = at.glyphs[idx];
+        if (!g.rect.empty()) {
+            const int x = static_cast<int>((pen + (1 << 15)) >> 16) + g.offset.x;
+            const int y = org.y + g.offset.y;
+            const cv::Rect dstRect = cv::Rect(x, y, g.rect.width, g.rect.height) & bounds;
+            for (int r = 0; r < dstRect.height; ++r) {
+                const uchar* a = at.coverage.ptr<uchar>(g.rect.y + dstRect.y - y + r) + g.rect.x + (dstRect.x - x);
+                uchar* d = img.ptr<uchar>(dstRect.y + r) + dstRect.x * cn;
+                blendCoverageRow(d, a, dstRect.width, cn, col);
+            }
+        }
+        pen += fm.advance[idx] * at.hscale;
+    }
+}
+
+void TextRenderer::putText(cv::Mat& img, const std::string& text, cv::Point org, int fontFace,
+                           double fontScale, const cv::Scalar& color, int thickness, int lineType) {
+    if (!isSupported(img) || !isPrintable(text)) {
+        cv::putText(img, text, org, fontFace, fontScale, color, thickness, lineType);
+        return;
+    }
+    const auto at = atlas(fontFace, fontScale, thickness, lineType);
+    draw(img, *at, *metrics(fontFace), text, org, color);
+}
+
+void TextRenderer::putTextBatch(cv::Mat& img, const std::vector<Label>& labels, int fontFace,
+                                double fontScale, int thickness, int lineType) {
+    if (labels.empty()) return;
+    if (!isSupported(img)) {
+        for (const Label& l : labels) {
+            cv::putText(img, l.text, l.org, fontFace, fontScale, l.color, thickness, lineType);
+        }
+        return;
+    }
+    const auto at = atlas(fontFace, fontScale, thickness, lineType);
+    const auto fm = metrics(fontFace);
+    for (const Label& l : labels) {
+        if (isPrintable(l.text)) draw(img, *at, *fm, l.text, l.org, l.color);
+        else cv::putText(img, l.text, l.org, fontFace, fontScale, l.color, thickness, lineType);
+    }
+}
+
+} // namespace visionpipe
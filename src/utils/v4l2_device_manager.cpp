@@ -164,10 +164,115 @@ bool V4L2DeviceManager::prepareDevice(const std::string& devicePath, const V4L2N
         for (auto& sd : cached) std::cout << "  " << sd;
         std::cout << std::endl;
     }
+    V4L2Session& prepared = _sessions[devicePath];
+    if (prepared.negotiatedPixFmt == V4L2_PIX_FMT_MJPEG && config.decodeThreads > 0) {
+        startMjpegFeed(devicePath, prepared);
+    }
     SystemLogger::info(LOG_COMPONENT, "Prepared device: " + devicePath);
     return true;
 }
 
+// ============================================================================
+// MJPEG feed — dequeue on a capture thread, decode on a pool
+// ============================================================================
+void V4L2DeviceManager::startMjpegFeed(const std::string& devicePath, V4L2Session& session) {
+    MjpegDecodeOptions opts;
+    opts.scale = session.config.decodeScale;
+    opts.gray  = session.config.decodeGray;
+
+    auto feed = std::make_shared<MjpegFeed>();
+    feed->pool = std::make_unique<MjpegDecoderPool>(session.config.decodeThreads, opts);
+
+    // The thread only touches the fd and the mmap'd buffers, both of which
+    // outlive it: releaseDevice() joins it before STREAMOFF / munmap / close.
+    // It never takes _mutex, so control writes are not held up by capture;
+    // a control that pauses the stream takes the feed's ioMutex instead.
+    MjpegFeed* f = feed.get();
+    const int fd = session.fd;
+    const bool mplane = session.isMplane;
+    const std::vector<MappedBuffer> buffers = session.buffers;
+    const bool verbose = _verbose;
+    feed->thread = std::thread([f, fd, mplane, buffers, devicePath, verbose]() {
+        static constexpr uint32_t MAX_PLANES = 4;
+        while (!f->stop.load(std::memory_order_acquire)) {
+            const uint64_t pauses = f->pauses.load(std::memory_order_acquire);
+            struct pollfd pfd{};
+            pfd.fd     = fd;
+            pfd.events = POLLIN;
+            int ret = poll(&pfd, 1, 100);
+            if (ret == 0 || (ret < 0 && errno == EINTR)) continue;
+            if (ret < 0) {
+                SystemLogger::error(LOG_COMPONENT, "MJPEG feed poll failed on " + devicePath + ": " + strerror(errno));
+                break;
+            }
+
+            struct v4l2_plane dqPlanes[MAX_PLANES]{};
+            struct v4l2_buffer buf{};
+            buf.type = mplane ? V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE : V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+            if (mplane) {
+                buf.m.planes = dqPlanes;
+                buf.length = MAX_PLANES;
+            }
+            std::unique_lock<std::mutex> io(f->ioMutex);
+            if (xioctl(fd, VIDIOC_DQBUF, &buf) < 0) {
+                if (errno == EAGAIN) continue;
+                // The stream was paused for a control since poll() returned
+                // (EINVAL / EPIPE while it was off): wait for the next frame.
+                if (f->pauses.load(std::memory_order_acquire) != pauses) continue;
+                SystemLogger::error(LOG_COMPONENT, "VIDIOC_DQBUF failed: " + std::string(strerror(errno)));
+                break;
+            }
+
+            // Copy out and give the buffer straight back to the driver, so
+            // the number of frames in decode is not bounded by bufferCount.
+            std::vector<uint8_t> jpeg;
+            uint32_t numDataPlanes = 1;
+            if (buf.index < buffers.size()) {
+                const auto& mb = buffers[buf.index];
+                const uint32_t bytesUsed = mplane ? dqPlanes[0].bytesused : buf.bytesused;
+                const uint8_t* data = static_cast<const uint8_t*>(mb.planes[0].start);
+                jpeg.assign(data, data + bytesUsed);
+                numDataPlanes = static_cast<uint32_t>(mb.planes.size());
+            }
+            if (mplane) {
+                buf.m.planes = dqPlanes;
+                buf.length = numDataPlanes;
+            }
+            if (xioctl(fd, VIDIOC_QBUF, &buf) < 0) {
+                SystemLogger::warning(LOG_COMPONENT, "VIDIOC_QBUF re-enqueue failed: " + std::string(strerror(errno)));
+            }
+            io.unlock();
+
+            uint64_t seq = 0;
+            if (!f->pool->submit(std::move(jpeg), &seq)) break;  // closed
+            if (verbose) {
+                std::cout << "[DEBUG] V4L2: MJPEG feed queued seq=" << seq
+                          << " index=" << buf.index << std::endl;
+            }
+        }
+        // Wake a reader waiting on a frame that will not come
+        f->pool->close();
+    });
+
+    session.mjpegFeed = std::move(feed);
+    if (_verbose) {
+        std::cout << "[DEBUG] V4L2: MJPEG decoder pool on " << devicePath
+                  << " threads=" << session.config.decodeThreads
+                  << " scale=1/" << f->pool->options().scale
+                  << (opts.gray ? " gray" : "") << std::endl;
+    }
+}
+
+void V4L2DeviceManager::stopMjpegFeed(V4L2Session& session) {
+    if (!session.mjpegFeed) return;
+    MjpegFeed& feed = *session.mjpegFeed;
+    feed.stop.store(true, std::memory_order_release);
+    feed.pool->close();  // unblocks a submit() waiting on capacity
+    if (feed.thread.joinable()) feed.thread.join();
+    session.mjpegFeed.reset();
+}
+
 // ============================================================================
 // cachedLinkedSubDevs — return cached BFS result, or live BFS for ephemeral
 // ============================================================================
@@ -480,6 +585,21 @@ bool V4L2DeviceManager::acquireFrame(const std::string& devicePath, cv::Mat& fra
         return false;
     }
 
+    // Pooled MJPEG: the feed thread owns DQBUF/QBUF, only collect the next
+    // decoded frame.  The pool is kept alive by the local reference even if
+    // the session is released while we wait.
+    if (session.mjpegFeed) {
+        std::shared_ptr<MjpegFeed> feed = session.mjpegFeed;
+        lock.unlock();
+        uint64_t seq = 0;
+        if (!feed->pool->next(frame, 2000, &seq)) {
+            SystemLogger::error(LOG_COMPONENT, "MJPEG decoder timeout or feed stopped on " + devicePath);
+            return false;
+        }
+        if (_verbose) std::cout << "[DEBUG] V4L2: MJPEG frame seq=" << seq << " empty=" << frame.empty() << std::endl;
+        return !frame.empty();
+    }
+
     // Capture the fd before releasing the lock — it is stable for the lifetime
     // of the session (only closed in releaseDevice which takes the same mutex).
     const int captFd = session.fd;
@@ -550,8 +670,10 @@ bool V4L2DeviceManager::acquireFrame(const std::string& devicePath, cv::Mat& fra
         cv::Mat uyvy(h, w, CV_8UC2, const_cast<uint8_t*>(data), stride0);
         cv::cvtColor(uyvy, frame, cv::COLOR_YUV2BGR_UYVY);
     } else if (pf == V4L2_PIX_FMT_MJPEG) {
-        std::vector<uint8_t> jpgBuf(data, data + bytesUsed);
-        frame = cv::imdecode(jpgBuf, cv::IMREAD_COLOR);
+        MjpegDecodeOptions opts;
+        opts.scale = sess.config.decodeScale;
+        opts.gray  = sess.config.decodeGray;
+        frame = decodeMjpeg(data, bytesUsed, opts);
         if (frame.empty()) ok = false;
     } else if (pf == V4L2_PIX_FMT_NV12 || pf == V4L2_PIX_FMT_NV21) {
         int cvCode = (pf == V4L2_PIX_FMT_NV12) ? cv::COLOR_YUV2BGR_NV12 : cv::COLOR_YUV2BGR_NV21;
@@ -643,6 +765,9 @@ void V4L2DeviceManager::releaseDevice(const std::string& devicePath) {
 
     V4L2Session& session = it->second;
 
+    // Join the MJPEG feed before its buffers are unmapped
+    stopMjpegFeed(session);
+
     if (session.streaming) {
         if (_verbose) std::cout << "[DEBUG] V4L2: STREAMOFF " << devicePath << std::endl;
         enum v4l2_buf_type type = session.isMplane ? V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE : V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -1134,6 +1259,14 @@ bool V4L2DeviceManager::setControl(const std::string& devicePath,
             ? V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE
             : V4L2_BUF_TYPE_VIDEO_CAPTURE;
 
+        // Keep the MJPEG feed thread out of DQBUF / QBUF until STREAMON;
+        // it treats DQBUF errors during a pause as "no frame yet".
+        std::unique_lock<std::mutex> feedIo;
+        if (sess.mjpegFeed) {
+            feedIo = std::unique_lock<std::mutex>(sess.mjpegFeed->ioMutex);
+            sess.mjpegFeed->pauses.fetch_add(1, std::memory_order_release);
+        }
+
         // 1. STREAMOFF
         if (xioctl(sess.fd, VIDIOC_STREAMOFF, &bufType) < 0) {
             if (_verbose)
@@ -0,0 +1,349 @@
+#include "utils/warp_plan_cache.h"
+
+#include <opencv2/imgproc.hpp>
+#include <opencv2/calib3d.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace visionpipe {
+
+// ============================================================================
+// WarpKeyHasher
+// ============================================================================
+
+WarpKeyHasher& WarpKeyHasher::add(const void* data, size_t bytes) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < bytes; ++i) {
+        _h ^= p[i];
+        _h *= 1099511628211ULL;
+    }
+    return *this;
+}
+
+WarpKeyHasher& WarpKeyHasher::add(const cv::Mat& m) {
+    add(m.rows).add(m.cols).add(m.channels());
+    if (m.empty()) return *this;
+    cv::Mat d;
+    m.convertTo(d, CV_64F);
+    if (!d.isContinuous()) d = d.clone();
+    return add(d.data, d.total() * d.elemSize());
+}
+
+WarpKeyHasher& WarpKeyHasher::addContent(const cv::Mat& m) {
+    add(m.rows).add(m.cols).add(m.type());
+    if (m.empty()) return *this;
+
+    // FNV-1a a byte at a time is far too slow for full-frame maps: hash each
+    // row a 64-bit word at a time on the thread pool, then fold the row hashes.
+    const size_t rowBytes = static_cast<size_t>(m.cols) * m.elemSize();
+    std::vector<uint64_t> rowHash(m.rows);
+    cv::parallel_for_(cv::Range(0, m.rows), [&](const cv::Range& r) {
+        for (int y = r.start; y < r.end; ++y) {
+            const uchar* p = m.ptr<uchar>(y);
+            uint64_t h = 0x9E3779B97F4A7C15ULL ^ rowBytes;
+            size_t i = 0;
+            for (; i + 8 <= rowBytes; i += 8) {
+                uint64_t w;
+                std::memcpy(&w, p + i, 8);
+                h = (h ^ w) * 0xFF51AFD7ED558CCDULL;
+                h ^= h >> 32;
+            }
+            uint64_t tail = 0;
+            std::memcpy(&tail, p + i, rowBytes - i);
+            rowHash[y] = (h ^ tail) * 0xC4CEB9FE1A85EC53ULL;
+        }
+    });
+    return add(rowHash.data(), rowHash.size() * sizeof(uint64_t));
+}
+
+// ============================================================================
+// Map builders
+// ============================================================================
+
+namespace {
+
+enum PlanKind { PLAN_AFFINE = 1, PLAN_PERSPECTIVE = 2, PLAN_UNDISTORT = 3, PLAN_REMAP = 4 };
+
+// Destination tiles of 256 x 16 px keep one tile of a 3-channel 8-bit
+// destination plus its fixed-point maps comfortably inside L2.
+constexpr int kTileCols = 256;
+constexpr int kTileRows = 16;
+
+// Convert a CV_32FC2 coordinate map to the fixed-point representation used by
+// every plan.  Nearest-neighbour plans need no interpolation table.
+std::shared_ptr<WarpPlan> finishPlan(uint64_t key, const cv::Mat& xy, int interpolation,
+                                     int borderMode) {
+    auto plan = std::make_shared<WarpPlan>();
+    plan->key = key;
+    plan->dstSize = xy.size();
+    plan->interpolation = interpolation;
+    plan->borderMode = borderMode;
+    cv::convertMaps(xy, cv::noArray(), plan->map1, plan->map2, CV_16SC2,
+                    interpolation == cv::INTER_NEAREST);
+    return plan;
+}
+
+// Anything beyond the CV_16S range lands on the border after convertMaps anyway.
+inline double clampCoord(double v) {
+    constexpr double kLimit = 32767.0;
+    if (!(v > -kLimit)) return -kLimit;   // also catches NaN
+    return v > kLimit ? kLimit : v;
+}
+
+// Inverse-mapped coordinates for a 3x3 (perspective) or 2x3 (affine) matrix.
+cv::Mat buildCoordMap(const cv::Mat& M, const cv::Size& dstSize, bool perspective) {
+    cv::Mat m64;
+    M.convertTo(m64, CV_64F);
+    cv::Mat inv;
+    if (perspective) {
+        cv::invert(m64, inv);
+    } else {
+        cv::invertAffineTransform(m64, inv);
+    }
+    const double* h = inv.ptr<double>();
+
+    cv::Mat xy(dstSize, CV_32FC2);
+    cv::parallel_for_(cv::Range(0, dstSize.height), [&](const cv::Range& r) {
+        for (int y = r.start; y < r.end; ++y) {
+            auto* row = xy.ptr<cv::Vec2f>(y);
+            if (!perspective) {
+                double bx = h[1] * y + h[2];
+                double by = h[4] * y + h[5];
+                for (int x = 0; x < dstSize.width; ++x) {
+                    row[x][0] = static_cast<float>(h[0] * x + bx);
+                    row[x][1] = static_cast<float>(h[3] * x + by);
+                }
+            } else {
+                double bx = h[1] * y + h[2];
+                double by = h[4] * y + h[5];
+                double bw = h[7] * y + h[8];
+                for (int x = 0; x < dstSize.width; ++x) {
+                    double w = h[6] * x + bw;
+                    if (std::abs(w) < 1e-12) {
+                        row[x] = cv::Vec2f(-1.f, -1.f);  // maps outside → border
+                        continue;
+                    }
+                    w = 1.0 / w;
+                    // Near the horizon 1/w explodes; clamp like cv::warpPerspective
+                    // so the float -> fixed-point conversion never sees inf / NaN.
+                    row[x][0] = static_cast<float>(clampCoord((h[0] * x + bx) * w));
+                    row[x][1] = static_cast<float>(clampCoord((h[3] * x + by) * w));
+                }
+            }
+        }
+    });
+    return xy;
+}
+
+} // namespace
+
+// ============================================================================
+// WarpPlanCache
+// ============================================================================
+
+WarpPlanCache& WarpPlanCache::instance() {
+    static WarpPlanCache inst;
+    return inst;
+}
+
+void WarpPlanCache::touch(uint64_t key) {
+    auto it = std::find(_lru.begin(), _lru.end(), key);
+    if (it != _lru.end()) _lru.erase(it);
+    _lru.push_front(key);
+}
+
+void WarpPlanCache::evictIfNeeded() {
+    while (_plans.size() > _capacity && !_lru.empty()) {
+        _plans.erase(_lru.back());
+        _lru.pop_back();
+    }
+}
+
+template <typename F>
+std::shared_ptr<const WarpPlan> WarpPlanCache::lookup(uint64_t key, bool buildNow, F&& build) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _plans.find(key);
+        if (it != _plans.end()) {
+            ++_stats.hits;
+            touch(key);
+            return it->second;
+        }
+        ++_stats.misses;
+        if (!buildNow && _seenOnce.insert(key).second) {
+            // First sighting.  Bound the set so per-frame transforms that
+            // never repeat cannot grow it without limit.
+            if (_seenOnce.size() > 4 * _capacity) {
+                _seenOnce.clear();
+                _seenOnce.insert(key);
+            }
+            return nullptr;
+        }
+        _seenOnce.erase(key);
+    }
+
+    // Build outside the lock: map generation touches every output pixel.
+    std::shared_ptr<const WarpPlan> plan = build();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++_stats.builds;
+    auto [it, inserted] = _plans.emplace(key, plan);
+    touch(key);
+    evictIfNeeded();
+    return inserted ? plan : it->second;
+}
+
+std::shared_ptr<const WarpPlan> WarpPlanCache::affine(const cv::Mat& M, const cv::Size& /*srcSize*/,
+                                                      const cv::Size& dstSize, int interpolation,
+                                                      int borderMode) {
+    if (M.rows != 2 || M.cols != 3) return nullptr;
+    uint64_t key = WarpKeyHasher().add(int(PLAN_AFFINE)).add(M).add(dstSize)
+                                  .add(interpolation).add(borderMode).value();
+    return lookup(key, false, [&] {
+        return finishPlan(key, buildCoordMap(M, dstSize, false), interpolation, borderMode);
+    });
+}
+
+std::shared_ptr<const WarpPlan> WarpPlanCache::perspective(const cv::Mat& H, const cv::Size& /*srcSize*/,
+                                                           const cv::Size& dstSize, int interpolation,
+                                                           int borderMode) {
+    if (H.rows != 3 || H.cols != 3) return nullptr;
+    uint64_t key = WarpKeyHasher().add(int(PLAN_PERSPECTIVE)).add(H).add(dstSize)
+                                  .add(interpolation).add(borderMode).value();
+    return lookup(key, false, [&] {
+        return finishPlan(key, buildCoordMap(H, dstSize, true), interpolation, borderMode);
+    });
+}
+
+std::shared_ptr<const WarpPlan> WarpPlanCache::undistort(const cv::Mat& K, const cv::Mat& D,
+                                                         const cv::Mat& newK, const cv::Size& size,
+                                                         int interpolation) {
+    uint64_t key = WarpKeyHasher().add(int(PLAN_UNDISTORT)).add(K).add(D).add(newK)
+                                  .add(size).add(interpolation).value();
+    return lookup(key, true, [&] {
+        auto plan = std::make_shared<WarpPlan>();
+        plan->key = key;
+        plan->dstSize = size;
+        plan->interpolation = interpolation;
+        plan->borderMode = cv::BORDER_CONSTANT;
+        cv::initUndistortRectifyMap(K, D, cv::Mat(), newK.empty() ? K : newK, size,
+                                    CV_16SC2, plan->map1, plan->map2);
+        if (interpolation == cv::INTER_NEAREST) plan->map2.release();
+        return plan;
+    });
+}
+
+namespace {
+
+// Which buffer a map lives in, without reading it
+void addIdentity(WarpKeyHasher& h, const cv::Mat& m) {
+    const void* u = m.u;
+    const void* data = m.data;
+    const size_t step = m.step[0];
+    h.add(&u, sizeof(u)).add(&data, sizeof(data)).add(&step, sizeof(step))
+     .add(m.size()).add(m.type());
+}
+
+} // namespace
+
+std::shared_ptr<const WarpPlan> WarpPlanCache::remap(const cv::Mat& map1, const cv::Mat& map2,
+                                                     int interpolation, int borderMode,
+                                                     uint64_t generation1, uint64_t generation2) {
+    // Fixed-point maps are already in plan form
+    if (map1.empty() || map1.type() == CV_16SC2) return nullptr;
+
+    const bool tracked = generation1 != 0 && (map2.empty() || generation2 != 0);
+    uint64_t identity = 0;
+    uint64_t key = 0;
+    if (tracked) {
+        WarpKeyHasher h;
+        addIdentity(h, map1);
+        addIdentity(h, map2);
+        identity = h.add(&generation1, sizeof(generation1)).add(&generation2, sizeof(generation2))
+                    .add(interpolation).add(borderMode).value();
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _remapKeys.find(identity);
+        if (it != _remapKeys.end()) key = it->second;
+    }
+    if (key == 0) {
+        key = WarpKeyHasher().add(int(PLAN_REMAP)).addContent(map1).addContent(map2)
+                             .add(interpolation).add(borderMode).value();
+        if (tracked) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            // Rewritten maps leave stale identities behind; bound them like _seenOnce.
+            if (_remapKeys.size() > 4 * _capacity) _remapKeys.clear();
+            _remapKeys[identity] = key;
+        }
+    }
+    return lookup(key, false, [&] {
+        auto plan = std::make_shared<WarpPlan>();
+        plan->key = key;
+        plan->dstSize = map1.size();
+        plan->interpolation = interpolation;
+        plan->borderMode = borderMode;
+        cv::convertMaps(map1, map2, plan->map1, plan->map2, CV_16SC2,
+                        interpolation == cv::INTER_NEAREST);
+        return plan;
+    });
+}
+
+void WarpPlanCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _plans.clear();
+    _lru.clear();
+    _seenOnce.clear();
+    _remapKeys.clear();
+}
+
+void WarpPlanCache::setCapacity(size_t n) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _capacity = std::max<size_t>(1, n);
+    evictIfNeeded();
+}
+
+WarpPlanCache::Stats WarpPlanCache::stats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Stats s = _stats;
+    s.plans = _plans.size();
+    return s;
+}
+
+// ============================================================================
+// Tiled remap
+// ============================================================================
+
+void tiledRemap(const cv::Mat& src, cv::Mat& dst, const cv::Mat& map1, const cv::Mat& map2,
+                int interpolation, int borderMode, const cv::Scalar& borderValue) {
+    // cv::remap cannot run in place; detach dst from src if they alias.
+    if (dst.data && dst.data == src.data) dst = cv::Mat();
+    dst.create(map1.size(), src.type());
+
+    const int tilesX = (map1.cols + kTileCols - 1) / kTileCols;
+    const int tilesY = (map1.rows + kTileRows - 1) / kTileRows;
+
+    // Row-major tile order: neighbouring tiles read neighbouring source rows,
+    // so the source working set stays small for mild warps.  Each tile is a
+    // ROI of dst, which cv::remap fills in place (nested parallel_for_ calls
+    // inside remap run serially).
+    cv::parallel_for_(cv::Range(0, tilesX * tilesY), [&](const cv::Range& r) {
+        for (int t = r.start; t < r.end; ++t) {
+            int tx = t % tilesX;
+            int ty = t / tilesX;
+            cv::Rect roi(tx * kTileCols, ty * kTileRows,
+                         std::min(kTileCols, map1.cols - tx * kTileCols),
+                         std::min(kTileRows, map1.rows - ty * kTileRows));
+            cv::Mat dstTile = dst(roi);
+            cv::remap(src, dstTile, map1(roi), map2.empty() ? cv::Mat() : map2(roi),
+                      interpolation, borderMode, borderValue);
+        }
+    });
+}
+
+void warpPlanApply(const WarpPlan& plan, const cv::Mat& src, cv::Mat& dst,
+                   const cv::Scalar& borderValue) {
+    tiledRemap(src, dst, plan.map1, plan.map2, plan.interpolation, plan.borderMode, borderValue);
+}
+
+} // namespace visionpipe
@@ -0,0 +1,135 @@
+/**
+ * thinBinary() against a direct sequential implementation of Zhang-Suen and
+ * Guo-Hall: every subiteration tests every foreground pixel against the
+ * unmodified image, then deletes the marked ones, until a whole iteration
+ * deletes nothing.  The frontier-based, strip-parallel version must give the
+ * same skeleton bit for bit, whatever the thread count.
+ */
+
+#include "utils/binary_thinning.h"
+#include "test_check.h"
+
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace visionpipe;
+
+namespace {
+
+// One subiteration over a 0/1 image with a background border.
+bool referenceStep(cv::Mat& img, int sub, ThinningMethod method) {
+    cv::Mat marker = cv::Mat::zeros(img.size(), CV_8UC1);
+    for (int y = 1; y < img.rows - 1; ++y) {
+        for (int x = 1; x < img.cols - 1; ++x) {
+            if (!img.at<uchar>(y, x)) continue;
+            const int p2 = img.at<uchar>(y - 1, x);
+            const int p3 = img.at<uchar>(y - 1, x + 1);
+            const int p4 = img.at<uchar>(y, x + 1);
+            const int p5 = img.at<uchar>(y + 1, x + 1);
+            const int p6 = img.at<uchar>(y + 1, x);
+            const int p7 = img.at<uchar>(y + 1, x - 1);
+            const int p8 = img.at<uchar>(y, x - 1);
+            const int p9 = img.at<uchar>(y - 1, x - 1);
+
+            bool del;
+            if (method == ThinningMethod::ZhangSuen) {
+                const int a = (p2 == 0 && p3 == 1) + (p3 == 0 && p4 == 1) +
+                              (p4 == 0 && p5 == 1) + (p5 == 0 && p6 == 1) +
+                              (p6 == 0 && p7 == 1) + (p7 == 0 && p8 == 1) +
+                              (p8 == 0 && p9 == 1) + (p9 == 0 && p2 == 1);
+                const int b = p2 + p3 + p4 + p5 + p6 + p7 + p8 + p9;
+                const int m1 = sub == 0 ? p2 * p4 * p6 : p2 * p4 * p8;
+                const int m2 = sub == 0 ? p4 * p6 * p8 : p2 * p6 * p8;
+                del = a == 1 && b >= 2 && b <= 6 && m1 == 0 && m2 == 0;
+            } else {
+                const int c = (!p2 & (p3 | p4)) + (!p4 & (p5 | p6)) +
+                              (!p6 & (p7 | p8)) + (!p8 & (p9 | p2));
+                const int n1 = (p9 | p2) + (p3 | p4) + (p5 | p6) + (p7 | p8);
+                const int n2 = (p2 | p3) + (p4 | p5) + (p6 | p7) + (p8 | p9);
+                const int n = n1 < n2 ? n1 : n2;
+                const int m = sub == 0 ? ((p6 | p7 | !p9) & p8) : ((p2 | p3 | !p5) & p4);
+                del = c == 1 && n >= 2 && n <= 3 && m == 0;
+            }
+            marker.at<uchar>(y, x) = del;
+        }
+    }
+    const bool changed = cv::countNonZero(marker) > 0;
+    img &= ~marker;
+    return changed;
+}
+
+cv::Mat referenceThinning(const cv::Mat& src, ThinningMethod method) {
+    cv::Mat img;
+    cv::copyMakeBorder(src, img, 1, 1, 1, 1, cv::BORDER_CONSTANT, cv::Scalar(0));
+    img = img != 0;
+    img /= 255;
+    bool changed = true;
+    while (changed) {
+        changed = referenceStep(img, 0, method);
+        changed |= referenceStep(img, 1, method);
+    }
+    return img(cv::Rect(1, 1, src.cols, src.rows)) * 255;
+}
+
+// Overlapping blobs, strokes and speckle: thick regions that need many
+// iterations, plus thin and isolated pixels that must survive.
+cv::Mat randomShapes(cv::RNG& rng, int rows, int cols) {
+    cv::Mat img = cv::Mat::zeros(rows, cols, CV_8UC1);
+    const int n = 1 + (rows * cols) / 2000;
+    for (int i = 0; i < n; ++i) {
+        const cv::Point c(rng.uniform(0, cols), rng.uniform(0, rows));
+        const int r = rng.uniform(1, std::max(2, std::min(rows, cols) / 4));
+        switch (rng.uniform(0, 3)) {
+            case 0: cv::circle(img, c, r, cv::Scalar(255), cv::FILLED); break;
+            case 1: cv::rectangle(img, cv::Rect(c.x, c.y, r * 2, r), cv::Scalar(255), cv::FILLED); break;
+            default: cv::line(img, c, cv::Point(rng.uniform(0, cols), rng.uniform(0, rows)),
+                              cv::Scalar(255), rng.uniform(1, 6));
+        }
+    }
+    cv::Mat speckle(rows, cols, CV_8UC1);
+    rng.fill(speckle, cv::RNG::UNIFORM, 0, 100);
+    img.setTo(255, speckle < 2);
+    return img;
+}
+
+} // namespace
+
+int main() {
+    const std::vector<cv::Size> sizes = {
+        {1, 1}, {17, 1}, {1, 17}, {3, 3}, {64, 64}, {131, 97}, {640, 480}};
+    const ThinningMethod methods[] = {ThinningMethod::ZhangSuen, ThinningMethod::GuoHall};
+    const char* const names[] = {"zhang-suen", "guo-hall"};
+
+    cv::RNG rng(20241019);
+    const int defaultThreads = cv::getNumThreads();
+    for (const cv::Size& size : sizes) {
+        for (int trial = 0; trial < 3; ++trial) {
+            cv::Mat src = randomShapes(rng, size.height, size.width);
+            if (trial == 2) src = cv::Mat(size, CV_8UC1, cv::Scalar(255));   // solid block
+
+            for (int m = 0; m < 2; ++m) {
+                const cv::Mat expected = referenceThinning(src, methods[m]);
+                for (int threads : {1, defaultThreads}) {
+                    cv::setNumThreads(threads);
+                    cv::Mat actual;
+                    thinBinary(src, actual, methods[m]);
+                    VP_CHECK_SAME(actual, expected,
+                                  names[m] << " " << size.width << "x" << size.height
+                                           << " trial " << trial << " threads " << threads);
+                }
+            }
+        }
+    }
+    cv::setNumThreads(defaultThreads);
+
+    // Any non-zero value is foreground
+    cv::Mat ones = randomShapes(rng, 120, 160) / 255;
+    cv::Mat fromOnes, from255;
+    thinBinary(ones, fromOnes, ThinningMethod::ZhangSuen);
+    thinBinary(ones * 255, from255, ThinningMethod::ZhangSuen);
+    VP_CHECK_SAME(fromOnes, from255, "foreground value other than 255");
+
+    return VP_TEST_RESULT();
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+/**
+ * @file test_check.h
+ * @brief Minimal assertions for the test executables.
+ */
+
+#include <opencv2/core.hpp>
+#include <iostream>
+
+namespace visionpipe {
+namespace test {
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+/// Number of pixels where @p a and @p b differ (-1 if size or type differ).
+inline int mismatches(const cv::Mat& a, const cv::Mat& b) {
+    if (a.size() != b.size() || a.type() != b.type()) return -1;
+    if (a.empty()) return 0;
+    cv::Mat diff;
+    cv::compare(a, b, diff, cv::CMP_NE);
+    return cv::countNonZero(diff.reshape(1));
+}
+
+} // namespace test
+} // namespace visionpipe
+
+#define VP_CHECK(cond, what)                                                        \
+    do {                                                                            \
+        if (!(cond)) {                                                              \
+            ++::visionpipe::test::failures();                                       \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": FAILED " << what << "\n"; \
+        }                                                                           \
+    } while (0)
+
+#define VP_CHECK_SAME(a, b, what)                                                     \
+    do {                                                                              \
+        const int vpMismatch = ::visionpipe::test::mismatches((a), (b));              \
+        VP_CHECK(vpMismatch == 0, what << " (" << vpMismatch << " pixels differ)");   \
+    } while (0)
+
+#define VP_TEST_RESULT()                                                   \
+    (::visionpipe::test::failures() == 0                                  \
+         ? (std::cout << "OK\n", 0)                                        \
+         : (std::cerr << ::visionpipe::test::failures() << " failed\n", 1))
@@ -0,0 +1,104 @@
+/**
+ * packedMorphology() against OpenCV: for every 3 x 3 rect / cross op the
+ * erode / dilate / morphology_ex items route through the packed path, the
+ * result must equal cv::morphologyEx() bit for bit -- including the border
+ * (outside counts as foreground for erosion, background for dilation), row
+ * tails at widths around a word boundary, and a foreground value other
+ * than 255.  Grayscale input and kernels it does not handle must be refused.
+ */
+
+#include "utils/packed_mask.h"
+#include "test_check.h"
+
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace visionpipe;
+
+namespace {
+
+// Blobs, thin strokes and speckle, so every op both grows and removes pixels.
+cv::Mat randomMask(cv::RNG& rng, int rows, int cols, uchar on) {
+    cv::Mat img = cv::Mat::zeros(rows, cols, CV_8UC1);
+    const int n = 1 + (rows * cols) / 1500;
+    for (int i = 0; i < n; ++i) {
+        const cv::Point c(rng.uniform(0, cols), rng.uniform(0, rows));
+        const int r = rng.uniform(1, std::max(2, std::min(rows, cols) / 4));
+        if (rng.uniform(0, 2)) {
+            cv::circle(img, c, r, cv::Scalar(on), cv::FILLED);
+        } else {
+            cv::line(img, c, cv::Point(rng.uniform(0, cols), rng.uniform(0, rows)),
+                     cv::Scalar(on), 1);
+        }
+    }
+    cv::Mat speckle(rows, cols, CV_8UC1);
+    rng.fill(speckle, cv::RNG::UNIFORM, 0, 100);
+    img.setTo(on, speckle < 5);
+    img.setTo(0, speckle > 96);
+    return img;
+}
+
+} // namespace
+
+int main() {
+    // Widths around the 64-pixel word boundary, and degenerate rows / columns
+    const std::vector<cv::Size> sizes = {
+        {1, 1}, {1, 9}, {9, 1}, {63, 7}, {64, 5}, {65, 11}, {130, 40}, {640, 480}};
+    const int ops[] = {cv::MORPH_ERODE, cv::MORPH_DILATE, cv::MORPH_OPEN, cv::MORPH_CLOSE,
+                       cv::MORPH_GRADIENT, cv::MORPH_TOPHAT, cv::MORPH_BLACKHAT};
+    const char* const opNames[] = {"erode", "dilate", "open", "close",
+                                   "gradient", "tophat", "blackhat"};
+    const int shapes[] = {cv::MORPH_RECT, cv::MORPH_CROSS};
+    const char* const shapeNames[] = {"rect", "cross"};
+
+    cv::RNG rng(20241020);
+    for (const cv::Size& size : sizes) {
+        for (int trial = 0; trial < 3; ++trial) {
+            const uchar on = trial == 1 ? 1 : 255;
+            cv::Mat src = randomMask(rng, size.height, size.width, on);
+            if (trial == 2) src = cv::Mat(size, CV_8UC1, cv::Scalar(on));   // solid block
+
+            for (int o = 0; o < 7; ++o) {
+                for (int s = 0; s < 2; ++s) {
+                    const cv::Mat kernel = cv::getStructuringElement(shapes[s], cv::Size(3, 3));
+                    for (int iterations = 1; iterations <= 3; ++iterations) {
+                        const std::string what = std::string(opNames[o]) + " " + shapeNames[s] +
+                            " " + std::to_string(size.width) + "x" + std::to_string(size.height) +
+                            " trial " + std::to_string(trial) +
+                            " iterations " + std::to_string(iterations);
+
+                        cv::Mat actual;
+                        const bool packed = packedMorphology(src, ops[o], 3, shapes[s],
+                                                             iterations, actual);
+                        const bool elementary = ops[o] == cv::MORPH_ERODE || ops[o] == cv::MORPH_DILATE;
+                        if (elementary && iterations < 2) {
+                            VP_CHECK(!packed, what << ": single pass should use OpenCV");
+                            continue;
+                        }
+                        VP_CHECK(packed, what << ": not taken");
+                        if (!packed) continue;
+
+                        cv::Mat expected;
+                        cv::morphologyEx(src, expected, ops[o], kernel, cv::Point(-1, -1), iterations);
+                        VP_CHECK_SAME(actual, expected, what);
+                    }
+                }
+            }
+        }
+    }
+
+    // Refused: grayscale input, other kernel sizes / shapes, hit-or-miss
+    cv::Mat gray(32, 32, CV_8UC1);
+    rng.fill(gray, cv::RNG::UNIFORM, 0, 256);
+    cv::Mat binary = randomMask(rng, 32, 32, 255);
+    cv::Mat unused;
+    VP_CHECK(!packedMorphology(gray, cv::MORPH_OPEN, 3, cv::MORPH_RECT, 1, unused), "grayscale input");
+    VP_CHECK(!packedMorphology(binary, cv::MORPH_OPEN, 5, cv::MORPH_RECT, 1, unused), "5x5 kernel");
+    VP_CHECK(!packedMorphology(binary, cv::MORPH_OPEN, 3, cv::MORPH_ELLIPSE, 1, unused), "ellipse");
+    VP_CHECK(!packedMorphology(binary, cv::MORPH_HITMISS, 3, cv::MORPH_RECT, 1, unused), "hit-or-miss");
+    VP_CHECK(unused.empty(), "refused input leaves the result untouched");
+
+    return VP_TEST_RESULT();
+}
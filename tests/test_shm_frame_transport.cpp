@@ -0,0 +1,78 @@
+/**
+ * Output placement and buffer reuse in the POSIX shm transport.  A frame
+ * placed in the region by a ShmOutputScope lives in one half of the double
+ * buffer; if it is still referenced two writes later (cached, queued, kept
+ * in a variable), the writer must not copy the next heap frame over it.
+ * That write fails, the reader keeps seeing the previous frame, and writing
+ * resumes once the placed frame is released.
+ */
+
+#include "utils/shm_frame_transport.h"
+#include "test_check.h"
+
+#include <opencv2/core.hpp>
+#include <string>
+#include <unistd.h>
+
+using namespace visionpipe;
+
+namespace {
+
+bool filledWith(const cv::Mat& m, int value) {
+    return !m.empty() && cv::countNonZero(m.reshape(1) != value) == 0;
+}
+
+} // namespace
+
+int main() {
+    const std::string region = "vp_test_placed_" + std::to_string(getpid());
+    const cv::Size size(64, 48);
+    const int type = CV_8UC3;
+    if (!shmFrameCreate(region, size.width, size.height, type)) {
+        std::cerr << "shm_create failed\n";
+        return 1;
+    }
+
+    // Frame 1 produced in place
+    cv::Mat held;
+    {
+        ShmOutputScope scope(region);
+        VP_CHECK(scope.armed(), "scope arms on a fresh region");
+        held.create(size, type);
+        held.setTo(cv::Scalar::all(11));
+    }
+    VP_CHECK(shmFrameWrite(region, held), "publish placed frame");
+    cv::Mat view;
+    uint64_t seq = 0;
+    VP_CHECK(shmFrameReadView(region, view, seq) && view.data == held.data,
+             "placed frame is published without a copy");
+
+    // Frame 2 from the heap goes to the other buffer
+    cv::Mat second(size, type, cv::Scalar::all(22));
+    VP_CHECK(shmFrameWrite(region, second), "write into the free buffer");
+
+    // Frame 3 would reuse the placed frame's buffer while it is still held
+    {
+        ShmOutputScope scope(region);
+        VP_CHECK(!scope.armed(), "scope does not arm over a held placement");
+    }
+    cv::Mat third(size, type, cv::Scalar::all(33));
+    VP_CHECK(!shmFrameWrite(region, third), "write over a held placement fails");
+    VP_CHECK(filledWith(held, 11), "held placed frame is unchanged");
+
+    cv::Mat latest;
+    VP_CHECK(shmFrameRead(region, latest) && filledWith(latest, 22),
+             "reader still gets the last published frame");
+
+    // Released: the buffer is reusable again
+    held.release();
+    VP_CHECK(shmFrameWrite(region, third), "write after release");
+    VP_CHECK(shmFrameRead(region, latest) && filledWith(latest, 33), "reader gets the new frame");
+    {
+        ShmOutputScope scope(region);
+        VP_CHECK(scope.armed(), "scope arms again once nothing is held");
+    }
+
+    shmFrameDestroy(region);
+    return VP_TEST_RESULT();
+}